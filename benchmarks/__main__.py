@@ -0,0 +1,125 @@
+"""
+Offline benchmark suite: crawl extraction/parsing, preprocess stages, ml parsing.
+
+Everything runs from the HTML fixtures in benchmarks/fixtures and seeded
+synthetic JSONL corpora, so numbers are comparable between runs and machines
+only differ by hardware. Throughput is reported per unit (page, url, row) along
+with tracemalloc peak/allocation figures from one extra traced repetition.
+
+Usage:
+  python -m benchmarks [--group crawl preprocess ml] [--filter build_document]
+                       [--rows 100000 1000000] [--repeat 5]
+                       [--report out.json] [--save-baseline benchmarks/baseline.json]
+                       [--compare benchmarks/baseline.json] [--tolerance 0.15]
+
+Exit status is 1 when --compare finds a benchmark slower than the baseline by
+more than --tolerance (throughput ratio), so it can gate CI.
+"""
+
+from __future__ import annotations
+
+import argparse
+import logging
+import tempfile
+from pathlib import Path
+from typing import Dict, List, Optional
+
+from . import cases
+from .harness import (
+    Benchmark,
+    Report,
+    compare,
+    environment,
+    format_result,
+    load_baseline,
+    measure,
+    save_report,
+)
+
+
+def build(args: argparse.Namespace, workdir: Path) -> List[Benchmark]:
+    builders = {
+        "crawl": lambda: cases.crawl_cases(fixtures=args.fixtures, loops=args.loops),
+        "preprocess": lambda: cases.preprocess_cases(workdir=workdir, rows=args.rows),
+        "ml": lambda: cases.ml_cases(count=args.responses),
+    }
+    benches: List[Benchmark] = []
+    for group in args.group:
+        try:
+            benches.extend(builders[group]())
+        except ImportError as exc:
+            print(f"[BENCH] skip group {group}: {exc}")
+    if args.filter:
+        benches = [b for b in benches if any(f in b.name for f in args.filter)]
+    return benches
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    ap = argparse.ArgumentParser(description="Run the offline benchmark suite.")
+    ap.add_argument(
+        "--group", nargs="+", choices=cases.GROUPS, default=list(cases.GROUPS)
+    )
+    ap.add_argument(
+        "--filter", nargs="+", default=None, help="Keep names containing any of these"
+    )
+    ap.add_argument(
+        "--rows",
+        nargs="+",
+        type=int,
+        default=[100_000],
+        help="Synthetic corpus sizes for preprocess stages (e.g. 100000 1000000)",
+    )
+    ap.add_argument("--loops", type=int, default=20, help="Pages per crawl repetition")
+    ap.add_argument("--responses", type=int, default=20_000)
+    ap.add_argument("--repeat", type=int, default=5)
+    ap.add_argument("--warmup", type=int, default=1)
+    ap.add_argument(
+        "--no-trace", action="store_true", help="Skip the tracemalloc repetition"
+    )
+    ap.add_argument("--fixtures", type=Path, default=cases.FIXTURES_DIR)
+    ap.add_argument(
+        "--workdir",
+        type=Path,
+        default=None,
+        help="Where synthetic corpora are generated and reused (default: temp dir)",
+    )
+    ap.add_argument("--report", type=Path, default=None, help="Write results JSON")
+    ap.add_argument("--save-baseline", type=Path, default=None)
+    ap.add_argument("--compare", type=Path, default=None, help="Baseline JSON")
+    ap.add_argument("--tolerance", type=float, default=0.15)
+    args = ap.parse_args(argv)
+
+    # parse_grok_response logs a bias warning per positive-heavy reply
+    logging.basicConfig(level=logging.ERROR)
+
+    baseline: Dict[str, float] = load_baseline(args.compare) if args.compare else {}
+    report = Report(environment=environment())
+    with tempfile.TemporaryDirectory(prefix="nps-bench-") as tmp:
+        workdir = args.workdir or Path(tmp)
+        for bench in build(args, workdir):
+            result = measure(
+                bench, repeat=args.repeat, warmup=args.warmup, trace=not args.no_trace
+            )
+            report.results.append(result)
+            print(format_result(result, baseline.get(result.name)))
+
+    if args.report:
+        save_report(report, args.report)
+    if args.save_baseline:
+        save_report(report, args.save_baseline)
+        print(f"[BENCH] baseline saved: {args.save_baseline}")
+
+    if args.compare:
+        regressions = compare(report.results, baseline, tolerance=args.tolerance)
+        for r in regressions:
+            print(
+                f"[BENCH] REGRESSION {r.name}: {r.units_per_sec:.1f}/s vs "
+                f"{r.baseline_units_per_sec:.1f}/s baseline ({r.ratio:.2f}x)"
+            )
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,268 @@
+"""Benchmark definitions, grouped by the package they exercise.
+
+Each ``*_cases`` builder imports its targets lazily: a missing optional
+dependency (numpy for dedup, openai for ``ml``) skips that group with a
+message instead of failing the whole run.
+"""
+
+from __future__ import annotations
+
+import re
+from datetime import datetime
+from pathlib import Path
+from typing import Callable, Dict, List, Sequence, Tuple
+
+from . import corpora
+from .harness import Benchmark
+
+FIXTURES_DIR = Path(__file__).resolve().parent / "fixtures"
+
+FORUM_SITES = ("dcinside", "bobaedream", "mlbpark", "theqoo", "ppomppu")
+
+# (listing page URL, thread URL) each fixture pair was taken from
+FIXTURE_URLS: Dict[str, Tuple[str, str]] = {
+    "dcinside": (
+        "https://gall.dcinside.com/mgallery/board/lists/?id=pension",
+        "https://gall.dcinside.com/mgallery/board/view/?id=pension&no=900001",
+    ),
+    "bobaedream": (
+        "https://www.bobaedream.co.kr/list?code=freeb",
+        "https://www.bobaedream.co.kr/view?code=freeb&No=700001",
+    ),
+    "mlbpark": (
+        "https://mlbpark.donga.com/mp/b.php?b=bullpen",
+        "https://mlbpark.donga.com/mp/b.php?b=bullpen&id=202511000001&m=view",
+    ),
+    "theqoo": (
+        "https://theqoo.net/square",
+        "https://theqoo.net/square/3900000001",
+    ),
+    "ppomppu": (
+        "https://www.ppomppu.co.kr/zboard/zboard.php?id=freeboard",
+        "https://www.ppomppu.co.kr/zboard/view.php?id=freeboard&no=9500001",
+    ),
+    "gdelt": (
+        "",
+        "https://www.example-news.com/article/20251103000123",
+    ),
+}
+
+
+def read_fixture(name: str, fixtures: Path = FIXTURES_DIR) -> str:
+    return (fixtures / name).read_text(encoding="utf-8")
+
+
+def _hrefs(html: str) -> List[str]:
+    return [h.replace("&amp;", "&") for h in re.findall(r'href="([^"]+)"', html)]
+
+
+def _repeat(loops: int, fn: Callable[[], object]) -> Callable[[], int]:
+    def run() -> int:
+        for _ in range(loops):
+            fn()
+        return loops
+
+    return run
+
+
+# ---------------- crawl ----------------
+
+
+def crawl_cases(*, fixtures: Path = FIXTURES_DIR, loops: int = 20) -> List[Benchmark]:
+    from urllib.parse import urljoin
+
+    from crawl.core.config import QualityConfig
+    from crawl.core.discovery.forums import ForumsDiscoverer
+    from crawl.core.extract.extractor import Extractor
+    from crawl.core.fetch.fetcher import Fetcher
+    from crawl.core.models import Candidate, FetchResult
+    from crawl.core.utils import normalize_url
+
+    cases: List[Benchmark] = []
+
+    # URL normalisation over every link on the listing pages, with tracking noise
+    urls: List[str] = []
+    for site in FORUM_SITES:
+        base = FIXTURE_URLS[site][0]
+        for href in _hrefs(read_fixture(f"{site}_list.html", fixtures)):
+            url = urljoin(base, href)
+            urls.append(url)
+            urls.append(f"{url}{'&' if '?' in url else '?'}utm_source=x&fbclid=y")
+
+    def run_normalize() -> int:
+        for url in urls:
+            normalize_url(url)
+        return len(urls)
+
+    cases.append(Benchmark("crawl.normalize_url", "crawl", run_normalize, "url"))
+
+    # Charset detection: declared utf-8 header vs cp949 bytes behind a utf-8 meta
+    fetcher = Fetcher(None, timeout=3)  # type: ignore[arg-type]
+    pages = [read_fixture(f"{site}_view.html", fixtures) for site in FORUM_SITES]
+    utf8 = [p.encode("utf-8") for p in pages]
+    cp949 = [p.encode("cp949", errors="replace") for p in pages]
+
+    def decoder(bodies: Sequence[bytes], content_type: str | None) -> Callable[[], int]:
+        def run() -> int:
+            for _ in range(loops):
+                for body in bodies:
+                    fetcher._decode_bytes(body, content_type, None)
+            return loops * len(bodies)
+
+        return run
+
+    cases.append(
+        Benchmark(
+            "crawl.decode_bytes[utf-8]",
+            "crawl",
+            decoder(utf8, "text/html; charset=utf-8"),
+            "page",
+        )
+    )
+    cases.append(
+        Benchmark(
+            "crawl.decode_bytes[cp949]", "crawl", decoder(cp949, "text/html"), "page"
+        )
+    )
+
+    # Listing parsers (what forum discovery runs per page)
+    discoverer = ForumsDiscoverer(None, 5, "bench", {})
+    for site in FORUM_SITES:
+        base = FIXTURE_URLS[site][0]
+        html = read_fixture(f"{site}_list.html", fixtures)
+        parser = getattr(discoverer, f"_parse_{site}")
+        cases.append(
+            Benchmark(
+                f"crawl.parse_listing[{site}]",
+                "crawl",
+                _repeat(loops, lambda p=parser, b=base, h=html: p(b, h)),
+                "page",
+            )
+        )
+
+    # Full extraction of one thread/article page, comment APIs switched off
+    extractor = Extractor(
+        keywords=["국민연금", "national pension"],
+        allowed_languages=["ko", "en"],
+        quality_config=QualityConfig(min_keyword_hits=0),
+    )
+    extractor.forums_comments_enabled = False
+    fetched_at = datetime(2025, 11, 3, 8, 0, 0)
+    for site in (*FORUM_SITES, "gdelt"):
+        name = "gdelt_article.html" if site == "gdelt" else f"{site}_view.html"
+        html = read_fixture(name, fixtures)
+        url = FIXTURE_URLS[site][1]
+        via = {"type": "gdelt"} if site == "gdelt" else {"type": "forum", "site": site}
+        candidate = Candidate(url=url, source=site, discovered_via=via)
+        result = FetchResult(
+            url=url,
+            fetched_from="live",
+            status_code=200,
+            html=html,
+            snapshot_url=url,
+            encoding="utf-8",
+            fetched_at=fetched_at,
+        )
+        cases.append(
+            Benchmark(
+                f"crawl.build_document[{site}]",
+                "crawl",
+                _repeat(
+                    loops,
+                    lambda c=candidate, r=result: extractor.build_document(
+                        c, r, run_id="bench"
+                    ),
+                ),
+                "page",
+            )
+        )
+    return cases
+
+
+# ---------------- preprocess ----------------
+
+
+def _corpus(workdir: Path, kind: str, rows: int) -> Path:
+    # Reused across runs: generating 1M rows costs more than most stages
+    path = workdir / f"{kind}_{rows}.jsonl"
+    if not path.exists():
+        tmp = path.with_suffix(".tmp")
+        writer = {
+            "gdelt": corpora.write_gdelt_jsonl,
+            "dcinside": corpora.write_dcinside_jsonl,
+        }[kind]
+        writer(tmp, rows)
+        tmp.replace(path)
+    return path
+
+
+def preprocess_cases(*, workdir: Path, rows: Sequence[int]) -> List[Benchmark]:
+    from preprocess.preprocess_dcinside.stage1_models_io import load_raw_posts
+    from preprocess.preprocess_dcinside.stage2_transform import flatten_post
+    from preprocess.preprocess_gdelt.stage1_models_io import load_raw_gdelt
+    from preprocess.preprocess_gdelt.stage2_transform import flatten_article
+
+    workdir.mkdir(parents=True, exist_ok=True)
+    cases: List[Benchmark] = []
+    for n in rows:
+        gdelt = _corpus(workdir, "gdelt", n)
+        dcinside = _corpus(workdir, "dcinside", n)
+
+        def run_gdelt(path: Path = gdelt) -> int:
+            count = 0
+            for raw in load_raw_gdelt(path):
+                flatten_article(raw)
+                count += 1
+            return count
+
+        def run_dcinside(path: Path = dcinside) -> int:
+            count = 0
+            for post in load_raw_posts(path):
+                flatten_post(post)
+                count += 1
+            return count
+
+        cases.append(
+            Benchmark(f"preprocess.gdelt_flatten[{n}]", "preprocess", run_gdelt, "row")
+        )
+        cases.append(
+            Benchmark(
+                f"preprocess.dcinside_flatten[{n}]", "preprocess", run_dcinside, "row"
+            )
+        )
+
+    try:
+        from preprocess.preprocess_gdelt.dedup_gdelt import dedup_jsonl
+    except ImportError as exc:
+        print(f"[BENCH] skip preprocess.dedup_jsonl: {exc}")
+        return cases
+    for n in rows:
+        src = _corpus(workdir, "gdelt", n)
+        out = workdir / f"dedup_{n}.jsonl"
+
+        def run_dedup(src: Path = src, out: Path = out) -> int:
+            return int(dedup_jsonl(src, out)["total"])
+
+        cases.append(
+            Benchmark(f"preprocess.dedup_jsonl[{n}]", "preprocess", run_dedup, "row")
+        )
+    return cases
+
+
+# ---------------- ml ----------------
+
+
+def ml_cases(*, count: int = 20_000) -> List[Benchmark]:
+    from ml.nps_sentiment import parse_grok_response
+
+    responses = corpora.grok_responses(count)
+
+    def run_parse() -> int:
+        for raw in responses:
+            parse_grok_response(raw)
+        return len(responses)
+
+    return [Benchmark("ml.parse_grok_response", "ml", run_parse, "response")]
+
+
+GROUPS = ("crawl", "preprocess", "ml")
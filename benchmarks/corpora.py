@@ -0,0 +1,129 @@
+"""Synthetic, seeded JSONL corpora in the crawler's output format.
+
+Rows look like what ``crawl`` writes (``forum_dcinside.jsonl``, ``gdelt.jsonl``)
+so the preprocess stages read them through their normal loaders. A share of
+GDELT rows are lightly edited re-posts of earlier ones, which gives the
+dedup stage realistic work instead of an all-unique corpus.
+"""
+
+from __future__ import annotations
+
+import json
+import random
+from pathlib import Path
+from typing import List
+
+KO_WORDS = (
+    "국민연금 기금 수익률 보험료 인상 소득대체율 개혁안 고갈 시점 청년 세대 부담 "
+    "노후 준비 수급 연령 정부 발표 국회 논의 연금공단 운용 해외투자 주식 채권 "
+    "댓글 의견 반대 찬성 문제 대책 필요 현실 미래 세금 월급 직장인 자영업자"
+).split()
+EN_WORDS = (
+    "national pension service fund returns reform contribution rate retirees "
+    "lawmakers debate overseas equities bonds replacement ratio government "
+    "parliament proposal deficit generation premium investment report korea"
+).split()
+TAILS = ["(Yonhap)", "- Reuters", "| Korea Herald", "(AP)", "- Korea Times"]
+
+
+def _words(rng: random.Random, vocab: List[str], lo: int, hi: int) -> str:
+    return " ".join(rng.choice(vocab) for _ in range(rng.randint(lo, hi)))
+
+
+def write_gdelt_jsonl(
+    path: Path, rows: int, *, dup_rate: float = 0.2, seed: int = 7
+) -> Path:
+    rng = random.Random(seed)
+    originals: List[tuple[str, str]] = []
+    with path.open("w", encoding="utf-8") as f:
+        for i in range(rows):
+            if originals and rng.random() < dup_rate:
+                title, text = rng.choice(originals)
+                toks = text.split()
+                for pos in range(len(toks)):
+                    if rng.random() < 0.03:
+                        toks[pos] = rng.choice(EN_WORDS)
+                text = " ".join(toks) + " " + rng.choice(TAILS)
+            else:
+                title = _words(rng, EN_WORDS, 6, 12)
+                text = _words(rng, EN_WORDS, 40, 160)
+                if len(originals) < 50_000:
+                    originals.append((title, text))
+            day = 1 + i % 28
+            row = {
+                "id": f"gdelt-{i}",
+                "source": "gdelt",
+                "url": f"https://news.example.com/{i}",
+                "title": title,
+                "text": text,
+                "lang": "en",
+                "published_at": None,
+                "discovered_via": {
+                    "type": "gdelt",
+                    "seendate": f"202511{day:02d}T071500Z",
+                },
+                "extra": {"gdelt": {"domain": "news.example.com"}},
+            }
+            f.write(json.dumps(row, ensure_ascii=False) + "\n")
+    return path
+
+
+def write_dcinside_jsonl(
+    path: Path, rows: int, *, comments: tuple[int, int] = (0, 12), seed: int = 7
+) -> Path:
+    rng = random.Random(seed)
+    with path.open("w", encoding="utf-8") as f:
+        for i in range(rows):
+            day = 1 + i % 28
+            row = {
+                "id": f"dc-{i}",
+                "source": "dcinside",
+                "url": f"https://gall.dcinside.com/board/view/?id=pension&no={i}",
+                "title": _words(rng, KO_WORDS, 3, 8) + " [3]",
+                "text": _words(rng, KO_WORDS, 20, 120) + " - dc official App",
+                "lang": "ko",
+                "published_at": f"2025-11-{day:02d}T07:20:10Z",
+                "crawl": {"fetched_at": f"2025-11-{day:02d}T08:00:00Z"},
+                "extra": {
+                    "forum": {
+                        "comments": [
+                            {
+                                "text": _words(rng, KO_WORDS, 2, 30),
+                                "publishedAt": f"11.{day:02d} 1{j % 10}:0{j % 6}:00",
+                                "author": f"ㅇㅇ{j}",
+                                "id": f"{i}-{j}",
+                            }
+                            for j in range(rng.randint(*comments))
+                        ]
+                    }
+                },
+            }
+            f.write(json.dumps(row, ensure_ascii=False) + "\n")
+    return path
+
+
+def grok_responses(count: int, *, seed: int = 7) -> List[str]:
+    """Raw model replies in the shapes parse_grok_response has to handle."""
+    rng = random.Random(seed)
+    out: List[str] = []
+    for i in range(count):
+        neg = rng.random()
+        neu = rng.random()
+        pos = rng.random()
+        payload = {
+            "is_related": rng.random() > 0.2,
+            "negative": round(neg, 3),
+            "neutral": round(neu, 3),
+            "positive": round(pos, 3),
+            "explanation": _words(rng, KO_WORDS, 5, 15),
+            "text": _words(rng, KO_WORDS, 5, 40),
+        }
+        body = json.dumps(payload, ensure_ascii=False)
+        shape = i % 3
+        if shape == 0:
+            out.append(body)
+        elif shape == 1:
+            out.append(f"```json\n{body}\n```")
+        else:
+            out.append(f"분석 결과입니다.\n{body}\n이상입니다.")
+    return out
@@ -0,0 +1,182 @@
+from __future__ import annotations
+
+import gc
+import json
+import platform
+import statistics
+import sys
+import time
+import tracemalloc
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Callable, Dict, List, Mapping, Optional, Sequence
+
+
+@dataclass(slots=True)
+class Benchmark:
+    """One measured operation.
+
+    ``run`` performs the work once and returns how many units it processed
+    (pages, URLs, rows, ...), so results are comparable as throughput across
+    corpus sizes. ``setup`` runs before every repetition outside the timer,
+    e.g. to remove output files a stage would otherwise append to.
+    """
+
+    name: str
+    group: str
+    run: Callable[[], int]
+    unit: str = "op"
+    setup: Optional[Callable[[], None]] = None
+
+
+@dataclass(slots=True)
+class Result:
+    name: str
+    group: str
+    unit: str
+    units: int
+    repeat: int
+    best_sec: float
+    median_sec: float
+    units_per_sec: float
+    # tracemalloc over one extra repetition (not part of the timings)
+    peak_kib: float
+    allocated_kib: float
+    allocations: int
+
+
+@dataclass(slots=True)
+class Regression:
+    name: str
+    baseline_units_per_sec: float
+    units_per_sec: float
+    ratio: float
+
+
+@dataclass(slots=True)
+class Report:
+    results: List[Result] = field(default_factory=list)
+    environment: Dict[str, str] = field(default_factory=dict)
+
+    def to_json(self) -> Dict[str, object]:
+        return {
+            "environment": self.environment,
+            "results": [asdict(r) for r in self.results],
+        }
+
+
+def environment() -> Dict[str, str]:
+    return {
+        "python": sys.version.split()[0],
+        "implementation": platform.python_implementation(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+    }
+
+
+def _trace(bench: Benchmark) -> tuple[float, float, int]:
+    if bench.setup is not None:
+        bench.setup()
+    gc.collect()
+    tracemalloc.start()
+    try:
+        before = tracemalloc.take_snapshot()
+        bench.run()
+        after = tracemalloc.take_snapshot()
+        _current, peak = tracemalloc.get_traced_memory()
+    finally:
+        tracemalloc.stop()
+    grown = [d for d in after.compare_to(before, "filename") if d.size_diff > 0]
+    allocated = sum(d.size_diff for d in grown)
+    blocks = sum(max(0, d.count_diff) for d in grown)
+    return peak / 1024, allocated / 1024, blocks
+
+
+def measure(
+    bench: Benchmark, *, repeat: int = 5, warmup: int = 1, trace: bool = True
+) -> Result:
+    """Best/median wall time over ``repeat`` runs plus one traced run."""
+    for _ in range(max(0, warmup)):
+        if bench.setup is not None:
+            bench.setup()
+        bench.run()
+    timings: List[float] = []
+    units = 0
+    for _ in range(max(1, repeat)):
+        if bench.setup is not None:
+            bench.setup()
+        gc.collect()
+        t0 = time.perf_counter()
+        units = bench.run()
+        timings.append(time.perf_counter() - t0)
+    peak_kib, allocated_kib, allocations = _trace(bench) if trace else (0.0, 0.0, 0)
+    best = min(timings)
+    return Result(
+        name=bench.name,
+        group=bench.group,
+        unit=bench.unit,
+        units=units,
+        repeat=len(timings),
+        best_sec=round(best, 6),
+        median_sec=round(statistics.median(timings), 6),
+        units_per_sec=round(units / best, 2) if best > 0 else 0.0,
+        peak_kib=round(peak_kib, 1),
+        allocated_kib=round(allocated_kib, 1),
+        allocations=allocations,
+    )
+
+
+def load_baseline(path: Path) -> Dict[str, float]:
+    """{benchmark name: units_per_sec} from a saved report."""
+    payload = json.loads(path.read_text(encoding="utf-8"))
+    return {
+        str(row["name"]): float(row["units_per_sec"])
+        for row in payload.get("results", [])
+    }
+
+
+def save_report(report: Report, path: Path) -> None:
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text(
+        json.dumps(report.to_json(), ensure_ascii=False, indent=2) + "\n",
+        encoding="utf-8",
+    )
+
+
+def compare(
+    results: Sequence[Result],
+    baseline: Mapping[str, float],
+    *,
+    tolerance: float = 0.15,
+) -> List[Regression]:
+    """Benchmarks whose throughput fell more than ``tolerance`` below baseline.
+
+    Names missing from the baseline are new and never count as regressions.
+    """
+    regressions: List[Regression] = []
+    for r in results:
+        base = baseline.get(r.name)
+        if not base or base <= 0:
+            continue
+        ratio = r.units_per_sec / base
+        if ratio < 1.0 - tolerance:
+            regressions.append(
+                Regression(
+                    name=r.name,
+                    baseline_units_per_sec=base,
+                    units_per_sec=r.units_per_sec,
+                    ratio=round(ratio, 3),
+                )
+            )
+    return regressions
+
+
+def format_result(r: Result, baseline: Optional[float] = None) -> str:
+    line = (
+        f"[BENCH] {r.name:<40} {r.best_sec:>9.4f}s "
+        f"{r.units_per_sec:>12.1f} {r.unit}/s "
+        f"peak={r.peak_kib:>9.1f}KiB allocs={r.allocations}"
+    )
+    if baseline:
+        line += f" ({r.units_per_sec / baseline:.2f}x baseline)"
+    return line
@@ -0,0 +1,4 @@
+# common/__init__.py
+"""
+preprocess/ 와 ml/ 가 함께 쓰는 작은 유틸리티 모듈.
+"""
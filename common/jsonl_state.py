@@ -0,0 +1,81 @@
+"""
+덧붙이기만 하는 JSONL 입력을 이어서 처리하기 위한 공용 함수.
+
+  - fingerprint: 처리한 위치와 그 앞뒤 4KB 의 해시 (입력이 새로 쓰였는지 확인)
+  - complete_end / iter_line_range: 줄 단위로 끊어 읽기
+  - load_json_state / save_json_state: 작은 JSON 상태 파일
+
+preprocess/preprocess_merge/incremental.py 의 체크포인트와
+ml/grok_sentiment_cli.py 의 진행 상태(.progress.json)가 함께 쓴다.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import json
+from pathlib import Path
+from typing import Any, Dict, Iterator, Optional, Tuple
+
+FINGERPRINT_BYTES = 4096
+
+
+def _sha1_range(path: Path, start: int, end: int) -> str:
+    if end <= start:
+        return ""
+    with path.open("rb") as f:
+        f.seek(start)
+        return hashlib.sha1(f.read(end - start)).hexdigest()
+
+
+def fingerprint(path: Path, offset: int) -> Dict[str, Any]:
+    return {
+        "offset": offset,
+        "head_sha1": _sha1_range(path, 0, min(offset, FINGERPRINT_BYTES)),
+        "tail_sha1": _sha1_range(path, max(0, offset - FINGERPRINT_BYTES), offset),
+    }
+
+
+def complete_end(path: Path) -> int:
+    """마지막 완전한 줄(줄바꿈으로 끝나는 줄)의 끝 위치."""
+    size = path.stat().st_size
+    with path.open("rb") as f:
+        pos = size
+        while pos > 0:
+            step = min(FINGERPRINT_BYTES, pos)
+            f.seek(pos - step)
+            chunk = f.read(step)
+            nl = chunk.rfind(b"\n")
+            if nl >= 0:
+                return pos - step + nl + 1
+            pos -= step
+    return 0
+
+
+def iter_line_range(
+    path: Path, start: int = 0, end: Optional[int] = None, *, partial: bool = False
+) -> Iterator[Tuple[int, str]]:
+    """
+    [start, end) 의 완전한 줄을 (줄 끝 위치, 줄) 로 돌려준다.
+    end 가 없으면 파일 끝까지 읽고, 줄바꿈으로 끝나지 않는 마지막 줄은 건너뛴다
+    (partial=True 면 그 줄도 돌려준다 — 전체 처리에서 기존 loader 와 같게).
+    """
+    offset = start
+    with path.open("rb") as f:
+        f.seek(start)
+        for raw in f:
+            offset += len(raw)
+            if end is not None and offset > end:
+                return
+            if not raw.endswith(b"\n") and not partial:
+                return
+            yield offset, raw.decode("utf-8")
+
+
+def load_json_state(path: Path, default: Any) -> Any:
+    if not path.exists():
+        return default
+    return json.loads(path.read_text(encoding="utf-8"))
+
+
+def save_json_state(path: Path, state: Any) -> None:
+    path.write_text(json.dumps(state, ensure_ascii=False), encoding="utf-8")
@@ -2,14 +2,20 @@ from __future__ import annotations
 
 import argparse
 import json
+import os
+import socket
 import time
 import logging
 from dataclasses import asdict
 from pathlib import Path
+from typing import Optional
 
-from .core.config import load_config
+from .core.config import CrawlerConfig, load_config
 from .core.pipeline import UnifiedPipeline
+from .core.reextract import reextract_archive
 from .core.auto.runner import AutoCrawler
+from .core.auto.shards import ShardMergeStats, WorkerShard, merge_worker_shards
+from .core.auto.store import SharedStateStore
 
 
 def build_parser() -> argparse.ArgumentParser:
@@ -57,7 +63,15 @@ def build_parser() -> argparse.ArgumentParser:
     # Autocrawl subcommand
     ac = sub.add_parser("autocrawl", help="Run or inspect the auto-crawler")
     ac.add_argument(
-        "action", choices=["run", "status", "plan", "reset"], nargs="?", default="run"
+        "action",
+        choices=["run", "status", "plan", "reset", "enqueue", "work", "merge"],
+        nargs="?",
+        default="run",
+        help=(
+            "run: single-process rounds on the JSON state; enqueue/work: queue "
+            "round windows in --store and run them from any number of workers; "
+            "merge: append new worker shard output to <output.root>"
+        ),
     )
     ac.add_argument("--rounds", type=int, default=1, help="Number of rounds to run")
     ac.add_argument("--sleep-sec", type=float, default=0.0, help="Sleep between rounds")
@@ -89,9 +103,54 @@ def build_parser() -> argparse.ArgumentParser:
         action="store_true",
         help="Do not fetch; only show plan (for plan/status)",
     )
+    ac.add_argument(
+        "--store",
+        type=Path,
+        help="Shared SQLite state/queue (default: <output.root>/_auto_state.sqlite)",
+    )
+    ac.add_argument("--worker-id", help="Worker name in the queue (default: host:pid)")
+    ac.add_argument(
+        "--lease-sec",
+        type=float,
+        default=1800.0,
+        help="Task lease; renewed while running, reclaimed when a worker dies",
+    )
+    ac.add_argument("--max-tasks", type=int, help="Stop a worker after N tasks")
+    ac.add_argument(
+        "--shard",
+        help="Worker output shard under <output.root>/_workers (default: first free)",
+    )
+
+    # Re-extract subcommand (offline, from the raw HTML archive)
+    rx = sub.add_parser(
+        "reextract", help="Re-run extraction over archived raw HTML (no fetching)"
+    )
+    rx.add_argument(
+        "--archive",
+        type=Path,
+        help="Raw archive directory (default: <output.root>/_raw)",
+    )
+    rx.add_argument(
+        "--output",
+        type=Path,
+        help="Output directory (default: <output.root>/reextract/<run_id>)",
+    )
+    rx.add_argument("--workers", type=int, help="Worker processes (default: CPU count)")
+    rx.add_argument(
+        "--chunk-size", type=int, default=200, help="Records per worker task"
+    )
+    rx.add_argument("--limit", type=int, help="Re-extract at most N URLs")
     return parser
 
 
+def _merge_shards(config: CrawlerConfig) -> Optional[ShardMergeStats]:
+    return merge_worker_shards(
+        config.output.root,
+        bloom_capacity=config.output.index_bloom_capacity,
+        bloom_error_rate=config.output.index_bloom_error_rate,
+    )
+
+
 def main(argv: list[str] | None = None) -> int:
     parser = build_parser()
     args = parser.parse_args(argv)
@@ -102,8 +161,10 @@ def main(argv: list[str] | None = None) -> int:
     if args.command == "autocrawl":
         # Configure YouTube quota from config.autocrawl if available
         runner = AutoCrawler(config)
+        store_path = args.store or (config.output.root / "_auto_state.sqlite")
         if args.action == "status":
-            state = runner.state
+            store = SharedStateStore(store_path) if args.store else None
+            state = store.snapshot() if store else runner.state
             payload = {
                 "stored_by_source": state.stored_by_source,
                 "counts": state.counts,
@@ -116,6 +177,14 @@ def main(argv: list[str] | None = None) -> int:
                 },
                 "last_updated": state.last_updated,
             }
+            if store is not None:
+                payload["tasks"] = store.task_counts()
+            print(json.dumps(payload, ensure_ascii=False, indent=2))
+            return 0
+
+        if args.action == "merge":
+            merged = _merge_shards(config)
+            payload = {"merged": asdict(merged) if merged else None}
             print(json.dumps(payload, ensure_ascii=False, indent=2))
             return 0
 
@@ -262,24 +331,94 @@ def main(argv: list[str] | None = None) -> int:
 
         rounds = int(getattr(args, "rounds", 1) or 1)
         sleep_sec = float(getattr(args, "sleep_sec", 0.0) or 0.0)
+        round_kwargs = {
+            "months_back": months_back,
+            "monthly_target_per_source": monthly_target,
+            "round_max_fetch": round_max_fetch,
+            "max_gdelt_windows": max_gdelt_windows,
+            "max_youtube_windows": max_youtube_windows,
+            "max_youtube_keywords": max_youtube_keywords,
+            "include_forums": include_forums,
+            "max_forums_windows": max_forums_windows,
+        }
         results: list[dict] = []
-        for i in range(rounds):
-            stats = runner.run_round(
-                months_back=months_back,
-                monthly_target_per_source=monthly_target,
-                round_max_fetch=round_max_fetch,
-                max_gdelt_windows=max_gdelt_windows,
-                max_youtube_windows=max_youtube_windows,
-                max_youtube_keywords=max_youtube_keywords,
-                include_forums=include_forums,
-                max_forums_windows=max_forums_windows,
+
+        if args.action in ("enqueue", "work"):
+            store = SharedStateStore(store_path)
+            # First use carries the single-process JSON state over
+            store.import_state(runner.state)
+            if acfg and acfg.youtube:
+                store.set_youtube_quota(
+                    acfg.youtube.daily_quota, acfg.youtube.reserve_quota
+                )
+            if args.action == "enqueue":
+                queued = runner.plan_tasks(store, **round_kwargs)
+                payload = {"queued": queued, "tasks": store.task_counts()}
+                print(json.dumps(payload, ensure_ascii=False, indent=2))
+                return 0
+            # Output, index and raw archive are single-writer: one shard each
+            shard = WorkerShard.acquire(config.output.root, args.shard)
+            runner = AutoCrawler(
+                shard.config_for(config), state_path=runner.state_path
             )
-            results.append({"round": i + 1, **stats})
-            if i < rounds - 1 and sleep_sec > 0:
-                time.sleep(sleep_sec)
+            worker_id = args.worker_id or (
+                f"{socket.gethostname()}:{shard.name}:{os.getpid()}"
+            )
+            try:
+                for i in range(rounds):
+                    # Plans only when the queue is drained; otherwise joins it
+                    queued = runner.plan_tasks(store, **round_kwargs)
+                    stats = runner.run_worker(
+                        store,
+                        worker_id=worker_id,
+                        lease_sec=args.lease_sec,
+                        max_tasks=args.max_tasks,
+                    )
+                    results.append({"round": i + 1, "queued": queued, **stats})
+                    if i < rounds - 1 and sleep_sec > 0:
+                        time.sleep(sleep_sec)
+            finally:
+                runner.close()
+                store.close()
+                shard.release()
+            # Best effort: skipped while another worker is merging
+            merged = _merge_shards(config)
+            payload = {
+                "shard": str(shard.path),
+                "results": results,
+                "merged": asdict(merged) if merged else None,
+            }
+            print(json.dumps(payload, ensure_ascii=False, indent=2))
+            return 0
+
+        try:
+            for i in range(rounds):
+                stats = runner.run_round(**round_kwargs)
+                results.append({"round": i + 1, **stats})
+                if i < rounds - 1 and sleep_sec > 0:
+                    time.sleep(sleep_sec)
+        finally:
+            runner.close()
         print(json.dumps({"results": results}, ensure_ascii=False, indent=2))
         return 0
 
+    if args.command == "reextract":
+        archive_root = args.archive or (config.output.root / "_raw")
+        output_root = args.output or (
+            config.output.root / "reextract" / config.runtime.run_id
+        )
+        rx_stats = reextract_archive(
+            config,
+            archive_root,
+            output_root,
+            workers=args.workers,
+            chunk_size=args.chunk_size,
+            limit=args.limit,
+        )
+        payload = {"output": str(output_root), **asdict(rx_stats)}
+        print(json.dumps(payload, ensure_ascii=False, indent=2))
+        return 0
+
     # Default: single pipeline run (backward compatible)
     include: set[str] | None = set(args.only) if args.only else None
     forum_filter: set[str] | None = (
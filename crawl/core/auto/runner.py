@@ -1,14 +1,19 @@
 from __future__ import annotations
 
+import threading
+from contextlib import contextmanager
 from datetime import datetime
 from pathlib import Path
-from typing import Dict, Optional
+from typing import Callable, Dict, Iterator, List, Mapping, Optional, Tuple
 
-from ..config import CrawlerConfig, TimeWindow
-from ..pipeline import UnifiedPipeline
+from ..config import CrawlerConfig, MetricsConfig, TimeWindow
+from ..metrics import MetricsExporters, PipelineMetrics
+from ..models import Candidate, Document
+from ..pipeline import PipelineStats, UnifiedPipeline
 from ..storage.index import DocumentIndex
-from .scheduler import plan_round
+from .scheduler import RoundPlan, plan_round
 from .state import AutoState
+from .store import SharedStateStore, WindowTask
 import logging
 
 logger = logging.getLogger(__name__)
@@ -31,6 +36,28 @@ def _clone_with_timewindow(
     )
 
 
+@contextmanager
+def _keep_leased(
+    store: SharedStateStore, task: WindowTask, lease_sec: float
+) -> Iterator[None]:
+    # Renew the lease in the background while the window's pipeline runs
+    stop = threading.Event()
+
+    def _loop() -> None:
+        while not stop.wait(max(1.0, lease_sec / 3)):
+            if not store.renew(task, lease_sec=lease_sec):
+                logger.warning("Autocrawl task %s lease lost", task.id)
+                return
+
+    thread = threading.Thread(target=_loop, name=f"lease-{task.id}", daemon=True)
+    thread.start()
+    try:
+        yield
+    finally:
+        stop.set()
+        thread.join()
+
+
 class AutoCrawler:
     def __init__(
         self,
@@ -41,8 +68,32 @@ class AutoCrawler:
         self.output_dir = base_config.output.root
         self.state_path = state_path or (self.output_dir / "_auto_state.json")
         self.state = AutoState.load(self.state_path)
+        # Bootstrapped by the first round, not here: `enqueue`/`work` build a
+        # crawler on the base root and must not open its index (single writer)
+        self.index: Optional[DocumentIndex] = None
+        # One metrics registry across rounds so histograms cover the whole
+        # session; exporters start with the first round
+        self.metrics_config = getattr(base_config, "metrics", None) or MetricsConfig()
+        self.metrics = PipelineMetrics(max_hosts=self.metrics_config.max_hosts)
+        self._exporters: Optional[MetricsExporters] = None
+
+    def _bootstrap_index(self) -> None:
         # Bootstrap index once; pipeline will refresh on store
-        self.index = DocumentIndex(self.output_dir)
+        if self.index is None:
+            self.index = DocumentIndex(
+                self.output_dir,
+                bloom_capacity=getattr(
+                    self.base_config.output, "index_bloom_capacity", None
+                ),
+                bloom_error_rate=getattr(
+                    self.base_config.output, "index_bloom_error_rate", 0.001
+                ),
+            )
+
+    def close(self) -> None:
+        if self._exporters is not None:
+            self._exporters.close()
+            self._exporters = None
 
     def _observer(self, state: AutoState):
         def _fn(document, candidate):  # type: ignore[no-untyped-def]
@@ -50,6 +101,45 @@ class AutoCrawler:
 
         return _fn
 
+    def _run_window(
+        self,
+        source: str,
+        start: datetime,
+        end: datetime,
+        *,
+        max_fetch: Optional[int],
+        youtube_keywords: List[str],
+        forum_cursors: Mapping[str, int],
+        store_observer: Callable[[Document, Candidate], None],
+    ) -> Tuple[PipelineStats, Dict[str, int]]:
+        """One source over one window; returns stats and forum pages visited."""
+        if source == "forums":
+            # Build board cursor map from state
+            pipe = UnifiedPipeline(
+                self.base_config,
+                include_sources={"forums"},
+                max_fetch=max_fetch,
+                store_observer=store_observer,
+                metrics=self.metrics,
+                forums_time_window=(start, end),
+                forums_until_date=start,
+                forums_board_cursors=dict(forum_cursors),
+            )
+        else:
+            pipe = UnifiedPipeline(
+                _clone_with_timewindow(self.base_config, start, end),
+                include_sources={source},
+                max_fetch=max_fetch,
+                store_observer=store_observer,
+                metrics=self.metrics,
+                # YouTube windows run with the round's keyword subset
+                source_keyword_filter=(
+                    {"youtube": youtube_keywords} if source == "youtube" else None
+                ),
+            )
+        stats = pipe.run()
+        return stats, dict(pipe.last_forums_pages) if source == "forums" else {}
+
     def run_round(
         self,
         *,
@@ -62,6 +152,9 @@ class AutoCrawler:
         include_forums: bool = True,
         max_forums_windows: int = 1,
     ) -> Dict[str, int]:
+        if self._exporters is None:
+            self._exporters = MetricsExporters(self.metrics, self.metrics_config)
+        self._bootstrap_index()
         # Step 0: decay cooldowns
         self.state.tick_cooldowns()
 
@@ -94,84 +187,150 @@ class AutoCrawler:
         )
 
         # For each planned source, run pipeline with an overridden window
-        # GDELT windows
-        for start, end in plan.windows.get("gdelt", []):
-            cfg = _clone_with_timewindow(self.base_config, start, end)
-            pipe = UnifiedPipeline(
-                cfg,
-                include_sources={"gdelt"},
-                max_fetch=plan.max_fetch,
-                store_observer=self._observer(self.state),
-            )
-            stats = pipe.run()
-            totals["stored"] += stats.stored
-            totals["fetched"] += stats.fetched
-            totals["discovered"] += sum(stats.discovered.values())
-            # cooldown decision for this bucket
-            bucket = f"{start.year:04d}-{start.month:02d}"
-            self.state.apply_cooldown(
-                bucket,
-                "gdelt",
-                stored=stats.stored,
-                fetched=stats.fetched,
-                duplicates_skipped=stats.duplicates_skipped,
+        observer = self._observer(self.state)
+        for source in ("gdelt", "youtube", "forums"):
+            for start, end in plan.windows.get(source, []):
+                stats, forum_pages = self._run_window(
+                    source,
+                    start,
+                    end,
+                    max_fetch=plan.max_fetch,
+                    youtube_keywords=plan.youtube_keywords,
+                    forum_cursors=self.state.forum_cursors,
+                    store_observer=observer,
+                )
+                totals["stored"] += stats.stored
+                totals["fetched"] += stats.fetched
+                totals["discovered"] += sum(stats.discovered.values())
+                # advance cursors based on pages visited
+                for board_url, last_page in forum_pages.items():
+                    self.state.forum_cursors[board_url] = int(last_page) + 1
+                # cooldown decision for this bucket
+                bucket = f"{start.year:04d}-{start.month:02d}"
+                self.state.apply_cooldown(
+                    bucket,
+                    source,
+                    stored=stats.stored,
+                    fetched=stats.fetched,
+                    duplicates_skipped=stats.duplicates_skipped,
+                )
+
+        # Advance rotation cursor to rotate buckets next round
+        self.state.bucket_cursor = (self.state.bucket_cursor + 1) % 120  # keep bounded
+        # Persist state
+        self.state.save(self.state_path)
+        return totals
+
+    # ----- work-queue mode (shared SharedStateStore, several workers) -----
+    def plan_tasks(
+        self,
+        store: SharedStateStore,
+        *,
+        months_back: int,
+        monthly_target_per_source: int,
+        round_max_fetch: Optional[int] = None,
+        max_gdelt_windows: int = 1,
+        max_youtube_windows: int = 1,
+        max_youtube_keywords: int = 2,
+        include_forums: bool = True,
+        max_forums_windows: int = 1,
+    ) -> Optional[int]:
+        """Queue one round of (source, window) tasks unless tasks are still open.
+
+        Same plan as ``run_round``; cooldown tick, quota and cursors are updated
+        in the store's planning transaction. Returns the number of new tasks,
+        or None when another worker's round is still being drained.
+        """
+
+        def planner(state: AutoState) -> RoundPlan:
+            state.tick_cooldowns()
+            plan = plan_round(
+                self.base_config,
+                state,
+                months_back=months_back,
+                monthly_target_per_source=monthly_target_per_source,
+                round_max_fetch=round_max_fetch,
+                max_gdelt_windows=max_gdelt_windows,
+                max_youtube_windows=max_youtube_windows,
+                max_forums_windows=(max_forums_windows if include_forums else 0),
+                max_youtube_keywords=max_youtube_keywords,
+                include_forums=include_forums,
             )
+            state.bucket_cursor = (state.bucket_cursor + 1) % 120  # keep bounded
+            return plan
 
-        # YouTube windows (with keyword subset)
-        for start, end in plan.windows.get("youtube", []):
-            cfg = _clone_with_timewindow(self.base_config, start, end)
-            keywords_filter = {"youtube": plan.youtube_keywords}
-            pipe = UnifiedPipeline(
-                cfg,
-                include_sources={"youtube"},
-                max_fetch=plan.max_fetch,
-                store_observer=self._observer(self.state),
-                source_keyword_filter=keywords_filter,
+        return store.plan_round(planner)
+
+    def run_worker(
+        self,
+        store: SharedStateStore,
+        *,
+        worker_id: str,
+        lease_sec: float = 1800.0,
+        max_tasks: Optional[int] = None,
+    ) -> Dict[str, int]:
+        """Claim and run queued tasks until the queue is empty (or ``max_tasks``).
+
+        Stored documents are counted in the store as they are written; cooldown
+        and forum cursors are applied when the task completes. A task that
+        raises goes back to the queue (up to the store's ``max_attempts``).
+
+        The crawler's output root must belong to this process alone: build it
+        with ``WorkerShard.config_for`` when several workers share a root.
+        """
+        if self._exporters is None:
+            self._exporters = MetricsExporters(self.metrics, self.metrics_config)
+        self._bootstrap_index()
+        totals: Dict[str, int] = {
+            "tasks": 0,
+            "failed": 0,
+            "lost": 0,
+            "stored": 0,
+            "fetched": 0,
+            "discovered": 0,
+        }
+        while max_tasks is None or (
+            totals["tasks"] + totals["failed"] + totals["lost"] < max_tasks
+        ):
+            task = store.claim(worker_id, lease_sec=lease_sec)
+            if task is None:
+                break
+            logger.info(
+                "Autocrawl worker=%s task=%s %s %s→%s",
+                worker_id,
+                task.id,
+                task.source,
+                task.start.isoformat(),
+                task.end.isoformat(),
             )
-            stats = pipe.run()
-            totals["stored"] += stats.stored
-            totals["fetched"] += stats.fetched
-            totals["discovered"] += sum(stats.discovered.values())
-            bucket = f"{start.year:04d}-{start.month:02d}"
-            self.state.apply_cooldown(
-                bucket,
-                "youtube",
+            try:
+                with _keep_leased(store, task, lease_sec):
+                    stats, forum_pages = self._run_window(
+                        task.source,
+                        task.start,
+                        task.end,
+                        max_fetch=task.max_fetch,
+                        youtube_keywords=task.keywords,
+                        forum_cursors=store.forum_cursors(),
+                        store_observer=store.record_stored,
+                    )
+            except Exception as exc:  # noqa: BLE001
+                store.fail(task, repr(exc))
+                totals["failed"] += 1
+                continue
+            discovered = sum(stats.discovered.values())
+            if not store.complete(
+                task,
                 stored=stats.stored,
                 fetched=stats.fetched,
+                discovered=discovered,
                 duplicates_skipped=stats.duplicates_skipped,
-            )
-
-        # Forums windows
-        for start, end in plan.windows.get("forums", []):
-            # Build board cursor map from state
-            cursors = dict(self.state.forum_cursors)
-            pipe = UnifiedPipeline(
-                self.base_config,
-                include_sources={"forums"},
-                max_fetch=plan.max_fetch,
-                store_observer=self._observer(self.state),
-                forums_time_window=(start, end),
-                forums_until_date=start,
-                forums_board_cursors=cursors,
-            )
-            stats = pipe.run()
+                forum_pages=forum_pages,
+            ):
+                totals["lost"] += 1
+                continue
+            totals["tasks"] += 1
             totals["stored"] += stats.stored
             totals["fetched"] += stats.fetched
-            totals["discovered"] += sum(stats.discovered.values())
-            # advance cursors based on pages visited
-            for board_url, last_page in pipe.last_forums_pages.items():
-                self.state.forum_cursors[board_url] = int(last_page) + 1
-            bucket = f"{start.year:04d}-{start.month:02d}"
-            self.state.apply_cooldown(
-                bucket,
-                "forums",
-                stored=stats.stored,
-                fetched=stats.fetched,
-                duplicates_skipped=stats.duplicates_skipped,
-            )
-
-        # Advance rotation cursor to rotate buckets next round
-        self.state.bucket_cursor = (self.state.bucket_cursor + 1) % 120  # keep bounded
-        # Persist state
-        self.state.save(self.state_path)
+            totals["discovered"] += discovered
         return totals
@@ -0,0 +1,227 @@
+from __future__ import annotations
+
+import hashlib
+import json
+import logging
+import os
+import re
+from dataclasses import dataclass, replace
+from pathlib import Path
+from typing import IO, Any, Dict, Optional
+
+from ..config import CrawlerConfig
+from ..storage.index import DocumentIndex
+
+logger = logging.getLogger(__name__)
+
+# Bytes hashed at both ends of the merged prefix of a shard file
+_FINGERPRINT_BYTES = 64 * 1024
+
+
+def _try_lock(fh: IO[bytes]) -> bool:
+    try:
+        import fcntl
+    except ImportError:  # Windows
+        import msvcrt
+
+        try:
+            msvcrt.locking(fh.fileno(), msvcrt.LK_NBLCK, 1)
+        except OSError:
+            return False
+        return True
+    try:
+        fcntl.flock(fh.fileno(), fcntl.LOCK_EX | fcntl.LOCK_NB)
+    except OSError:
+        return False
+    return True
+
+
+class WorkerShard:
+    """Output root owned by exactly one autocrawl worker process at a time.
+
+    JSONL output, the duplicate index (segment/log/Bloom/offsets) and the raw
+    archive assume a single writer per root: compaction, torn-tail truncation
+    and the in-memory ``_recent`` set are all process-local. Work-queue
+    workers therefore write to ``<root>/_workers/<name>`` and hold an
+    exclusive lock on ``<name>.lock`` for their lifetime.
+
+    Without an explicit name the first free slot (w0, w1, ...) is taken, so a
+    restarted worker reuses an existing shard and its index rather than
+    starting an empty one. ``merge_worker_shards`` appends shard output to the
+    base root's JSONL files, where preprocessing reads it, dropping documents
+    another shard already stored. The HTTP response cache stays shared at the
+    base root (its writes are atomic renames).
+    """
+
+    def __init__(self, name: str, path: Path, lock: IO[bytes]) -> None:
+        self.name = name
+        self.path = path
+        self._lock: Optional[IO[bytes]] = lock
+
+    @classmethod
+    def acquire(
+        cls, root: Path, name: Optional[str] = None, *, max_slots: int = 256
+    ) -> "WorkerShard":
+        base = root / "_workers"
+        base.mkdir(parents=True, exist_ok=True)
+        if name is not None:
+            safe = re.sub(r"[^A-Za-z0-9_.-]", "_", name)
+            shard = cls._try(base, safe)
+            if shard is None:
+                raise RuntimeError(f"worker shard {safe!r} is in use by another worker")
+            return shard
+        for slot in range(max_slots):
+            shard = cls._try(base, f"w{slot}")
+            if shard is not None:
+                return shard
+        raise RuntimeError(f"no free worker shard under {base} ({max_slots} in use)")
+
+    @classmethod
+    def _try(cls, base: Path, name: str) -> Optional["WorkerShard"]:
+        fh = open(base / f"{name}.lock", "a+b")
+        if not _try_lock(fh):
+            fh.close()
+            return None
+        fh.seek(0)
+        fh.truncate()
+        fh.write(str(os.getpid()).encode("ascii"))
+        fh.flush()
+        path = base / name
+        path.mkdir(parents=True, exist_ok=True)
+        return cls(name, path, fh)
+
+    def config_for(self, base_config: CrawlerConfig) -> CrawlerConfig:
+        http_cache = base_config.http_cache
+        if http_cache.root is None:
+            http_cache = replace(
+                http_cache, root=base_config.output.root / "_http_cache"
+            )
+        return replace(
+            base_config,
+            output=replace(base_config.output, root=self.path),
+            http_cache=http_cache,
+        )
+
+    def release(self) -> None:
+        # Closing the handle drops the lock (also on process exit)
+        if self._lock is not None:
+            self._lock.close()
+            self._lock = None
+
+
+@dataclass(slots=True)
+class ShardMergeStats:
+    merged: int = 0
+    duplicates: int = 0
+    invalid: int = 0
+    files: int = 0
+
+
+def _sha1_range(fh: IO[bytes], start: int, end: int) -> str:
+    fh.seek(start)
+    return hashlib.sha1(fh.read(max(0, end - start))).hexdigest()
+
+
+def _fingerprint(fh: IO[bytes], offset: int) -> Dict[str, Any]:
+    return {
+        "offset": offset,
+        "head": _sha1_range(fh, 0, min(offset, _FINGERPRINT_BYTES)),
+        "tail": _sha1_range(fh, max(0, offset - _FINGERPRINT_BYTES), offset),
+    }
+
+
+def _resume_offset(fh: IO[bytes], prev: Optional[Dict[str, Any]], size: int) -> int:
+    # A shard file truncated or rewritten since the last merge (torn-tail
+    # repair) is read again from the start; the index drops what is merged
+    offset = int((prev or {}).get("offset", 0) or 0)
+    if not prev or not 0 < offset <= size:
+        return 0
+    return offset if _fingerprint(fh, offset) == prev else 0
+
+
+def merge_worker_shards(
+    root: Path,
+    *,
+    bloom_capacity: Optional[int] = None,
+    bloom_error_rate: float = 0.001,
+) -> Optional[ShardMergeStats]:
+    """Append new lines of every ``<root>/_workers/*/*.jsonl`` to ``<root>``.
+
+    Each shard file is read from where the previous merge stopped (recorded
+    in ``_workers/_merged.json`` with a head/tail fingerprint) up to its last
+    complete line, so merging while workers run is safe. Documents whose id
+    or URL is already in the root's ``DocumentIndex`` are dropped. Returns
+    None when another merge holds ``_workers/merge.lock``.
+
+    The root must not have a crawler of its own running at the same time: its
+    JSONL and index are single-writer, like a shard's.
+    """
+    base = root / "_workers"
+    if not base.is_dir():
+        return ShardMergeStats()
+    lock = open(base / "merge.lock", "a+b")
+    try:
+        if not _try_lock(lock):
+            logger.info("Shard merge already running; skipped")
+            return None
+        state_path = base / "_merged.json"
+        try:
+            state = json.loads(state_path.read_text(encoding="utf-8"))
+        except (OSError, ValueError):
+            state = {}
+        files: Dict[str, Dict[str, Any]] = dict(state.get("files") or {})
+        index = DocumentIndex(
+            root, bloom_capacity=bloom_capacity, bloom_error_rate=bloom_error_rate
+        )
+        stats = ShardMergeStats()
+        for shard_dir in sorted(p for p in base.iterdir() if p.is_dir()):
+            if any(shard_dir.glob("*.jsonl.zst")):
+                logger.warning("Shard %s has zstd output; not merged", shard_dir)
+            for src in sorted(shard_dir.glob("*.jsonl")):
+                key = f"{shard_dir.name}/{src.name}"
+                with src.open("rb") as fh, (root / src.name).open("ab") as out:
+                    size = src.stat().st_size
+                    offset = _resume_offset(fh, files.get(key), size)
+                    fh.seek(offset)
+                    for raw in fh:
+                        if not raw.endswith(b"\n"):
+                            break  # still being written; next merge
+                        offset += len(raw)
+                        try:
+                            record = json.loads(raw)
+                        except ValueError:
+                            record = None
+                        if not isinstance(record, dict):
+                            stats.invalid += int(bool(raw.strip()))
+                            continue
+                        doc_id = str(record.get("id") or "")
+                        url = str(record.get("url") or "")
+                        if (doc_id and index.contains(doc_id)) or (
+                            url and index.contains_url(url)
+                        ):
+                            stats.duplicates += 1
+                            continue
+                        out.write(raw)
+                        if doc_id:
+                            index.add(doc_id)
+                        if url:
+                            index.add_url(url)
+                        stats.merged += 1
+                    files[key] = _fingerprint(fh, offset)
+                stats.files += 1
+        # Lines are on disk before the index and the offsets that skip them:
+        # a crash in between re-reads them and the index drops them
+        index.flush()
+        tmp = state_path.with_name(f"{state_path.name}.{os.getpid()}.tmp")
+        tmp.write_text(json.dumps({"files": files}), encoding="utf-8")
+        tmp.replace(state_path)
+        logger.info(
+            "Merged %d shard file(s): %d new, %d duplicate, %d invalid lines",
+            stats.files,
+            stats.merged,
+            stats.duplicates,
+            stats.invalid,
+        )
+        return stats
+    finally:
+        lock.close()
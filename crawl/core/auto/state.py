@@ -25,6 +25,31 @@ def _parse_iso(value: Optional[str]) -> Optional[datetime]:
         return None
 
 
+def stored_bucket(document: Document, candidate: Candidate) -> str:
+    """Month bucket a stored document counts toward."""
+    # Prefer published_at, fallback to candidate timestamp, else now
+    dt = (
+        _parse_iso(document.published_at)
+        or candidate.timestamp
+        or datetime.now(timezone.utc)
+    )
+    return _month_bucket(dt)
+
+
+def needs_cooldown(
+    *,
+    stored: int,
+    fetched: int,
+    duplicates_skipped: int,
+    min_stored_threshold: int = 1,
+    max_dup_ratio: float = 0.8,
+) -> bool:
+    """True when a window yielded too little new material to retry it soon."""
+    total = max(1, fetched + max(0, duplicates_skipped))
+    dup_ratio = duplicates_skipped / total
+    return stored < min_stored_threshold or dup_ratio >= max_dup_ratio
+
+
 @dataclass(slots=True)
 class YouTubeQuota:
     daily_quota: int = 1000
@@ -129,13 +154,7 @@ class AutoState:
         )
 
     def record_stored(self, document: Document, candidate: Candidate) -> None:
-        # Prefer published_at, fallback to candidate timestamp, else now
-        dt = (
-            _parse_iso(document.published_at)
-            or candidate.timestamp
-            or datetime.now(timezone.utc)
-        )
-        bucket = _month_bucket(dt)
+        bucket = stored_bucket(document, candidate)
         per_src = self.counts.setdefault(bucket, {})
         per_src[candidate.source] = int(per_src.get(candidate.source, 0)) + 1
         self.stored_by_source[candidate.source] = (
@@ -166,8 +185,12 @@ class AutoState:
         max_dup_ratio: float = 0.8,
         cooldown_rounds: int = 3,
     ) -> None:
-        total = max(1, fetched + max(0, duplicates_skipped))
-        dup_ratio = duplicates_skipped / total
-        if stored < min_stored_threshold or dup_ratio >= max_dup_ratio:
+        if needs_cooldown(
+            stored=stored,
+            fetched=fetched,
+            duplicates_skipped=duplicates_skipped,
+            min_stored_threshold=min_stored_threshold,
+            max_dup_ratio=max_dup_ratio,
+        ):
             per_src = self.cooldowns.setdefault(bucket, {})
             per_src[source] = max(per_src.get(source, 0), cooldown_rounds)
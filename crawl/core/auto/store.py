@@ -0,0 +1,459 @@
+from __future__ import annotations
+
+import json
+import logging
+import sqlite3
+import threading
+import time
+from contextlib import contextmanager
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Dict, Iterator, List, Mapping, Optional
+
+from ..models import Candidate, Document
+from ..utils import normalize_url
+from .scheduler import RoundPlan
+from .state import AutoState, YouTubeQuota, needs_cooldown, stored_bucket
+
+logger = logging.getLogger(__name__)
+
+_SCHEMA = """
+CREATE TABLE IF NOT EXISTS meta (key TEXT PRIMARY KEY, value TEXT NOT NULL);
+CREATE TABLE IF NOT EXISTS counts (
+    bucket TEXT NOT NULL,
+    source TEXT NOT NULL,
+    n INTEGER NOT NULL,
+    PRIMARY KEY (bucket, source)
+);
+CREATE TABLE IF NOT EXISTS stored_by_source (
+    source TEXT PRIMARY KEY,
+    n INTEGER NOT NULL
+);
+CREATE TABLE IF NOT EXISTS cooldowns (
+    bucket TEXT NOT NULL,
+    source TEXT NOT NULL,
+    rounds INTEGER NOT NULL,
+    PRIMARY KEY (bucket, source)
+);
+-- Normalized URLs already counted, shared by every worker shard
+CREATE TABLE IF NOT EXISTS stored_urls (url TEXT PRIMARY KEY);
+CREATE TABLE IF NOT EXISTS forum_cursors (
+    board TEXT PRIMARY KEY,
+    page INTEGER NOT NULL
+);
+CREATE TABLE IF NOT EXISTS tasks (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    round INTEGER NOT NULL,
+    source TEXT NOT NULL,
+    start TEXT NOT NULL,
+    "end" TEXT NOT NULL,
+    keywords TEXT NOT NULL,
+    max_fetch INTEGER,
+    status TEXT NOT NULL,
+    worker TEXT,
+    lease_until REAL,
+    attempts INTEGER NOT NULL DEFAULT 0,
+    result TEXT,
+    error TEXT,
+    updated_at REAL NOT NULL
+);
+-- A window is queued at most once while it is pending or leased
+CREATE UNIQUE INDEX IF NOT EXISTS tasks_open
+    ON tasks (source, start) WHERE status IN ('pending', 'leased');
+CREATE INDEX IF NOT EXISTS tasks_status ON tasks (status, id);
+"""
+
+
+@dataclass(slots=True)
+class WindowTask:
+    id: int
+    source: str
+    start: datetime
+    end: datetime
+    keywords: List[str] = field(default_factory=list)
+    max_fetch: Optional[int] = None
+    worker: str = ""
+    attempts: int = 0
+
+    @property
+    def bucket(self) -> str:
+        return f"{self.start.year:04d}-{self.start.month:02d}"
+
+
+class SharedStateStore:
+    """Autocrawl state and window task queue shared by several worker processes.
+
+    A SQLite database in WAL mode replaces the JSON state file for work-queue
+    mode. Every mutation is its own ``BEGIN IMMEDIATE`` transaction, so workers
+    never overwrite each other's counts, forum cursors or YouTube quota:
+
+    - planning (cooldown tick, ``plan_round``, quota and cursor updates and the
+      task inserts) happens in one transaction, and only while no task is open,
+      so two workers reaching an empty queue at once plan a single round;
+    - ``claim`` leases the oldest pending task (or one whose lease expired
+      because its worker died) for ``lease_sec``; ``renew`` extends it;
+    - ``record_stored`` increments the month counters per stored document,
+      once per URL: shards dedup only their own output, so a page another
+      shard already stored is not counted again;
+    - ``complete`` applies the cooldown decision and advances forum cursors
+      (never backwards) with the task result.
+
+    WAL needs shared memory, so all workers must open the database on one
+    host's local filesystem (not NFS/SMB).
+    """
+
+    def __init__(
+        self,
+        path: Path,
+        *,
+        busy_timeout_sec: float = 30.0,
+        max_attempts: int = 3,
+    ) -> None:
+        self.path = path
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        self.busy_timeout_sec = busy_timeout_sec
+        self.max_attempts = max(1, int(max_attempts))
+        self._local = threading.local()
+        conn = self._conn()
+        conn.execute("PRAGMA journal_mode=WAL")
+        conn.executescript(_SCHEMA)
+
+    # ----- connection / transactions -----
+    def _conn(self) -> sqlite3.Connection:
+        # sqlite3 connections are per thread; store observers run on pipeline threads
+        conn = getattr(self._local, "conn", None)
+        if conn is None:
+            conn = sqlite3.connect(
+                self.path, timeout=self.busy_timeout_sec, isolation_level=None
+            )
+            conn.execute("PRAGMA synchronous=NORMAL")
+            self._local.conn = conn
+            self._local.depth = 0
+        return conn
+
+    @contextmanager
+    def transaction(self) -> Iterator[sqlite3.Connection]:
+        """Write transaction; nested calls join the outer one."""
+        conn = self._conn()
+        if self._local.depth:
+            self._local.depth += 1
+            try:
+                yield conn
+            finally:
+                self._local.depth -= 1
+            return
+        conn.execute("BEGIN IMMEDIATE")
+        self._local.depth = 1
+        try:
+            yield conn
+        except BaseException:
+            conn.execute("ROLLBACK")
+            raise
+        else:
+            conn.execute("COMMIT")
+        finally:
+            self._local.depth = 0
+
+    def close(self) -> None:
+        conn = getattr(self._local, "conn", None)
+        if conn is not None:
+            conn.close()
+            self._local.conn = None
+
+    def _get_meta(self, conn: sqlite3.Connection, key: str, default: str) -> str:
+        row = conn.execute("SELECT value FROM meta WHERE key = ?", (key,)).fetchone()
+        return str(row[0]) if row else default
+
+    def _set_meta(self, conn: sqlite3.Connection, key: str, value: Any) -> None:
+        conn.execute(
+            "INSERT INTO meta (key, value) VALUES (?, ?) "
+            "ON CONFLICT (key) DO UPDATE SET value = excluded.value",
+            (key, str(value)),
+        )
+
+    # ----- state snapshot -----
+    def snapshot(self) -> AutoState:
+        """Current shared state as an ``AutoState`` (read-only copy)."""
+        conn = self._conn()
+        state = AutoState()
+        for bucket, source, n in conn.execute("SELECT bucket, source, n FROM counts"):
+            state.counts.setdefault(bucket, {})[source] = int(n)
+        state.stored_by_source = {
+            source: int(n)
+            for source, n in conn.execute("SELECT source, n FROM stored_by_source")
+        }
+        for bucket, source, rounds in conn.execute(
+            "SELECT bucket, source, rounds FROM cooldowns"
+        ):
+            state.cooldowns.setdefault(bucket, {})[source] = int(rounds)
+        state.forum_cursors = {
+            board: int(page)
+            for board, page in conn.execute("SELECT board, page FROM forum_cursors")
+        }
+        state.youtube = YouTubeQuota(
+            daily_quota=int(self._get_meta(conn, "youtube.daily_quota", "1000")),
+            reserve_quota=int(self._get_meta(conn, "youtube.reserve_quota", "200")),
+            used_today=int(self._get_meta(conn, "youtube.used_today", "0")),
+            period_start_utc=self._get_meta(conn, "youtube.period_start_utc", ""),
+        )
+        state.youtube_kw_cursor = int(self._get_meta(conn, "youtube_kw_cursor", "0"))
+        state.bucket_cursor = int(self._get_meta(conn, "bucket_cursor", "0"))
+        state.last_updated = self._get_meta(conn, "last_updated", "")
+        return state
+
+    def _save_planner_fields(self, conn: sqlite3.Connection, state: AutoState) -> None:
+        conn.execute("DELETE FROM cooldowns")
+        conn.executemany(
+            "INSERT INTO cooldowns (bucket, source, rounds) VALUES (?, ?, ?)",
+            [
+                (bucket, source, int(rounds))
+                for bucket, by_src in state.cooldowns.items()
+                for source, rounds in by_src.items()
+            ],
+        )
+        yt = state.youtube
+        self._set_meta(conn, "youtube.daily_quota", yt.daily_quota)
+        self._set_meta(conn, "youtube.reserve_quota", yt.reserve_quota)
+        self._set_meta(conn, "youtube.used_today", yt.used_today)
+        self._set_meta(conn, "youtube.period_start_utc", yt.period_start_utc)
+        self._set_meta(conn, "youtube_kw_cursor", state.youtube_kw_cursor)
+        self._set_meta(conn, "bucket_cursor", state.bucket_cursor)
+        self._touch(conn)
+
+    def _touch(self, conn: sqlite3.Connection) -> None:
+        self._set_meta(conn, "last_updated", datetime.now(timezone.utc).isoformat())
+
+    def import_state(self, state: AutoState) -> bool:
+        """Seed an empty store from a JSON-era ``AutoState``; False if not empty."""
+        with self.transaction() as conn:
+            if self._get_meta(conn, "imported", ""):
+                return False
+            self._set_meta(conn, "imported", datetime.now(timezone.utc).isoformat())
+            conn.executemany(
+                "INSERT OR REPLACE INTO counts (bucket, source, n) VALUES (?, ?, ?)",
+                [
+                    (bucket, source, int(n))
+                    for bucket, by_src in state.counts.items()
+                    for source, n in by_src.items()
+                ],
+            )
+            conn.executemany(
+                "INSERT OR REPLACE INTO stored_by_source (source, n) VALUES (?, ?)",
+                list(state.stored_by_source.items()),
+            )
+            conn.executemany(
+                "INSERT OR REPLACE INTO forum_cursors (board, page) VALUES (?, ?)",
+                list(state.forum_cursors.items()),
+            )
+            self._save_planner_fields(conn, state)
+        return True
+
+    def set_youtube_quota(self, daily_quota: int, reserve_quota: int) -> None:
+        with self.transaction() as conn:
+            self._set_meta(conn, "youtube.daily_quota", int(daily_quota))
+            self._set_meta(conn, "youtube.reserve_quota", int(reserve_quota))
+
+    # ----- planning -----
+    def open_tasks(self) -> int:
+        row = self._conn().execute(
+            "SELECT COUNT(*) FROM tasks WHERE status IN ('pending', 'leased')"
+        ).fetchone()
+        return int(row[0])
+
+    def task_counts(self) -> Dict[str, int]:
+        return {
+            str(status): int(n)
+            for status, n in self._conn().execute(
+                "SELECT status, COUNT(*) FROM tasks GROUP BY status"
+            )
+        }
+
+    def _enqueue(self, conn: sqlite3.Connection, plan: RoundPlan, round_no: int) -> int:
+        """Insert the plan's windows as pending tasks; returns how many were new."""
+        now = time.time()
+        added = 0
+        for source, windows in plan.windows.items():
+            keywords = plan.youtube_keywords if source == "youtube" else []
+            for start, end in windows:
+                cur = conn.execute(
+                    "INSERT OR IGNORE INTO tasks (round, source, start, \"end\", "
+                    "keywords, max_fetch, status, updated_at) "
+                    "VALUES (?, ?, ?, ?, ?, ?, 'pending', ?)",
+                    (
+                        round_no,
+                        source,
+                        start.isoformat(),
+                        end.isoformat(),
+                        json.dumps(keywords, ensure_ascii=False),
+                        plan.max_fetch,
+                        now,
+                    ),
+                )
+                added += cur.rowcount
+        return added
+
+    def plan_round(self, planner: Any) -> Optional[int]:
+        """Run ``planner(state) -> RoundPlan`` atomically and queue its windows.
+
+        Returns the number of queued tasks, or None when tasks were still open
+        (another worker planned; the caller should just drain the queue).
+        """
+        with self.transaction() as conn:
+            if self.open_tasks():
+                return None
+            state = self.snapshot()
+            plan: RoundPlan = planner(state)
+            round_no = int(self._get_meta(conn, "round", "0")) + 1
+            self._set_meta(conn, "round", round_no)
+            self._save_planner_fields(conn, state)
+            return self._enqueue(conn, plan, round_no)
+
+    # ----- workers -----
+    def claim(self, worker: str, *, lease_sec: float) -> Optional[WindowTask]:
+        now = time.time()
+        with self.transaction() as conn:
+            while True:
+                row = conn.execute(
+                    "SELECT id, source, start, \"end\", keywords, max_fetch, attempts "
+                    "FROM tasks WHERE status = 'pending' "
+                    "OR (status = 'leased' AND lease_until < ?) ORDER BY id LIMIT 1",
+                    (now,),
+                ).fetchone()
+                if row is None:
+                    return None
+                task_id, source, start, end, keywords, max_fetch, attempts = row
+                if int(attempts) < self.max_attempts:
+                    break
+                # Lease expired on the last attempt (worker died): give up on it
+                conn.execute(
+                    "UPDATE tasks SET status = 'failed', error = 'lease expired', "
+                    "updated_at = ? WHERE id = ?",
+                    (now, task_id),
+                )
+            conn.execute(
+                "UPDATE tasks SET status = 'leased', worker = ?, lease_until = ?, "
+                "attempts = attempts + 1, updated_at = ? WHERE id = ?",
+                (worker, now + lease_sec, now, task_id),
+            )
+        return WindowTask(
+            id=int(task_id),
+            source=str(source),
+            start=datetime.fromisoformat(start),
+            end=datetime.fromisoformat(end),
+            keywords=list(json.loads(keywords or "[]")),
+            max_fetch=int(max_fetch) if max_fetch is not None else None,
+            worker=worker,
+            attempts=int(attempts) + 1,
+        )
+
+    def renew(self, task: WindowTask, *, lease_sec: float) -> bool:
+        """Extend the lease; False if the task was taken over by another worker."""
+        now = time.time()
+        with self.transaction() as conn:
+            cur = conn.execute(
+                "UPDATE tasks SET lease_until = ?, updated_at = ? "
+                "WHERE id = ? AND status = 'leased' AND worker = ?",
+                (now + lease_sec, now, task.id, task.worker),
+            )
+        return cur.rowcount == 1
+
+    def record_stored(self, document: Document, candidate: Candidate) -> bool:
+        """Count a stored document; False if another shard already stored it."""
+        bucket = stored_bucket(document, candidate)
+        url = normalize_url(getattr(document, "url", None) or candidate.url)
+        with self.transaction() as conn:
+            if url:
+                cur = conn.execute(
+                    "INSERT OR IGNORE INTO stored_urls (url) VALUES (?)", (url,)
+                )
+                if cur.rowcount == 0:
+                    return False
+            conn.execute(
+                "INSERT INTO counts (bucket, source, n) VALUES (?, ?, 1) "
+                "ON CONFLICT (bucket, source) DO UPDATE SET n = n + 1",
+                (bucket, candidate.source),
+            )
+            conn.execute(
+                "INSERT INTO stored_by_source (source, n) VALUES (?, 1) "
+                "ON CONFLICT (source) DO UPDATE SET n = n + 1",
+                (candidate.source,),
+            )
+            self._touch(conn)
+        return True
+
+    def forum_cursors(self) -> Dict[str, int]:
+        return {
+            board: int(page)
+            for board, page in self._conn().execute(
+                "SELECT board, page FROM forum_cursors"
+            )
+        }
+
+    def complete(
+        self,
+        task: WindowTask,
+        *,
+        stored: int,
+        fetched: int,
+        discovered: int,
+        duplicates_skipped: int,
+        forum_pages: Optional[Mapping[str, int]] = None,
+        cooldown_rounds: int = 3,
+    ) -> bool:
+        """Mark the task done and apply its effects; False if the lease was lost."""
+        result = {
+            "stored": stored,
+            "fetched": fetched,
+            "discovered": discovered,
+            "duplicates_skipped": duplicates_skipped,
+        }
+        with self.transaction() as conn:
+            cur = conn.execute(
+                "UPDATE tasks SET status = 'done', result = ?, lease_until = NULL, "
+                "updated_at = ? WHERE id = ? AND worker = ? AND status = 'leased'",
+                (json.dumps(result), time.time(), task.id, task.worker),
+            )
+            if cur.rowcount != 1:
+                # Lease expired and the task was re-claimed: the new owner's
+                # result decides cursors and cooldown
+                logger.warning(
+                    "Autocrawl task %s lease lost by %s; result dropped",
+                    task.id,
+                    task.worker,
+                )
+                return False
+            # Cursors only move forward: a slower worker must not rewind them
+            conn.executemany(
+                "INSERT INTO forum_cursors (board, page) VALUES (?, ?) "
+                "ON CONFLICT (board) DO UPDATE SET page = MAX(page, excluded.page)",
+                [(board, int(last) + 1) for board, last in (forum_pages or {}).items()],
+            )
+            if needs_cooldown(
+                stored=stored, fetched=fetched, duplicates_skipped=duplicates_skipped
+            ):
+                conn.execute(
+                    "INSERT INTO cooldowns (bucket, source, rounds) VALUES (?, ?, ?) "
+                    "ON CONFLICT (bucket, source) "
+                    "DO UPDATE SET rounds = MAX(rounds, excluded.rounds)",
+                    (task.bucket, task.source, cooldown_rounds),
+                )
+            self._touch(conn)
+        return True
+
+    def fail(self, task: WindowTask, error: str) -> None:
+        """Return the task to the queue, or mark it failed after max_attempts."""
+        status = "failed" if task.attempts >= self.max_attempts else "pending"
+        with self.transaction() as conn:
+            conn.execute(
+                "UPDATE tasks SET status = ?, error = ?, lease_until = NULL, "
+                "updated_at = ? WHERE id = ? AND worker = ? AND status = 'leased'",
+                (status, error[:2000], time.time(), task.id, task.worker),
+            )
+        logger.warning(
+            "Autocrawl task %s %s failed (attempt %d): %s",
+            task.id,
+            task.source,
+            task.attempts,
+            error,
+        )
@@ -17,6 +17,19 @@ class TimeWindow:
 @dataclass(slots=True)
 class OutputConfig:
     root: Path
+    # Bloom pre-filter in front of the duplicate index (None/0 disables)
+    index_bloom_capacity: Optional[int] = None
+    index_bloom_error_rate: float = 0.001
+    # "sync" (open/write/close per document) or "buffered" (writer thread)
+    writer: str = "sync"
+    # Optional output compression for the buffered writer: None or "zstd"
+    compression: Optional[str] = None
+    writer_batch_size: int = 200
+    writer_flush_interval_sec: float = 1.0
+    writer_queue_size: int = 1000
+    # Persist fetched HTML into <root>/_raw segments for offline re-extraction
+    raw_archive: bool = False
+    raw_archive_segment_mb: int = 256
 
 
 @dataclass(slots=True)
@@ -27,6 +40,30 @@ class CrawlLimits:
     fetch_pause_sec: float = 0.1
     obey_robots: bool = False
     per_host_pause_sec: dict[str, float] = field(default_factory=dict)
+    # "threads" (blocking per-host sleeps) or "async" (per-host token buckets)
+    fetch_mode: str = "threads"
+    # Requests a host may receive back-to-back after idling (async mode only)
+    per_host_burst: float = 1.0
+    # Stream discovered candidates into fetch workers instead of a barrier
+    stream_discovery: bool = False
+    candidate_queue_size: int = 1000
+    # Cross-source candidate order: "priority" (strict) or "weighted" (fair)
+    candidate_order: str = "priority"
+    source_weights: dict[str, float] = field(default_factory=dict)
+    # Extraction in a separate process pool (0 = on the fetch threads)
+    extract_processes: int = 0
+    # Queued + running extractions before fetch results wait (0 = 4 per process)
+    extract_queue_size: int = 0
+    # Minimum spacing of forum comment API requests per host (all threads)
+    comment_pause_sec: dict[str, float] = field(default_factory=dict)
+    # Forum boards whose listing pages are crawled in parallel (1 = sequential)
+    forum_discovery_concurrency: int = 8
+
+
+FETCH_MODES = ("threads", "async")
+CANDIDATE_ORDERS = ("priority", "weighted")
+PREFILTER_MODES = ("skip", "deprioritize")
+WRITER_MODES = ("sync", "buffered")
 
 
 @dataclass(slots=True)
@@ -50,6 +87,14 @@ class GdeltSourceConfig:
     enabled: bool = True
     max_concurrency: int = 4
     max_days_back: Optional[int] = None
+    # Bounds of the adaptive request spacing (pause_between_requests is the start)
+    min_interval_sec: float = 0.2
+    max_interval_sec: float = 30.0
+    # Persistent per-(keyword, window) results under <output>/_gdelt_cache:
+    # closed windows are final, live ones re-queried incrementally after the TTL
+    cache_enabled: bool = True
+    cache_live_ttl_sec: float = 3600.0
+    cache_settle_sec: float = 86400.0
 
 
 @dataclass(slots=True)
@@ -67,6 +112,47 @@ class ForumsSourceConfig:
     sites: dict[str, ForumSiteConfig] = field(default_factory=dict)
 
 
+@dataclass(slots=True)
+class HttpCacheConfig:
+    # On-disk response cache with ETag/Last-Modified revalidation
+    enabled: bool = False
+    # Defaults to <output.root>/_http_cache
+    root: Optional[Path] = None
+    # Serve from disk without revalidating while younger than the TTL
+    default_ttl_sec: float = 0.0
+    ttl_sec: dict[str, float] = field(default_factory=dict)
+    # Forum listing pages (page 1 changes constantly; keep this short)
+    listing_ttl_sec: float = 0.0
+    # Eviction caps (0 = unbounded): entry age and total body size
+    max_age_sec: float = 30 * 86400.0
+    max_mb: int = 2048
+
+
+@dataclass(slots=True)
+class PrefilterConfig:
+    # Score forum candidates by title before fetching (see crawl.core.prefilter)
+    enabled: bool = False
+    # skip: drop off-topic titles; deprioritize: fetch them after the rest
+    mode: str = "deprioritize"
+    # Board URLs (substring match) whose threads are on-topic regardless of title
+    topical_boards: List[str] = field(default_factory=list)
+    # Share of would-be-skipped candidates fetched anyway to estimate recall
+    audit_rate: float = 0.05
+
+
+@dataclass(slots=True)
+class MetricsConfig:
+    # Stage histograms are always collected (see crawl.core.metrics); these
+    # only control export. Prometheus text on http://<host>:<port>/metrics
+    prometheus_port: Optional[int] = None
+    prometheus_host: str = "127.0.0.1"
+    # Periodically rewritten JSON snapshot (None disables)
+    json_path: Optional[Path] = None
+    json_interval_sec: float = 30.0
+    # Distinct host labels before further hosts are folded into "other"
+    max_hosts: int = 200
+
+
 @dataclass(slots=True)
 class CrawlerConfig:
     keywords: List[str]
@@ -79,6 +165,9 @@ class CrawlerConfig:
     gdelt: GdeltSourceConfig
     forums: ForumsSourceConfig = field(default_factory=ForumsSourceConfig)
     autocrawl: "AutocrawlConfig | None" = None
+    http_cache: HttpCacheConfig = field(default_factory=HttpCacheConfig)
+    prefilter: PrefilterConfig = field(default_factory=PrefilterConfig)
+    metrics: MetricsConfig = field(default_factory=MetricsConfig)
 
 
 @dataclass(slots=True)
@@ -168,11 +257,95 @@ def load_config(
 
     output_cfg = params.get("output", {})
     output_root = Path(output_cfg.get("root", "data_crawl"))
+    raw_bloom_capacity = output_cfg.get("index_bloom_capacity")
+    writer_mode = str(output_cfg.get("writer", "sync")).strip().lower()
+    if writer_mode not in WRITER_MODES:
+        raise ValueError(
+            f"output.writer must be one of {WRITER_MODES}, got: {writer_mode}"
+        )
+    compression = output_cfg.get("compression")
+    if compression is not None:
+        compression = str(compression).strip().lower() or None
+    if compression not in (None, "zstd"):
+        raise ValueError(f"output.compression must be null or zstd: {compression}")
+    output = OutputConfig(
+        root=output_root,
+        index_bloom_capacity=(
+            int(raw_bloom_capacity) if raw_bloom_capacity is not None else None
+        ),
+        index_bloom_error_rate=float(output_cfg.get("index_bloom_error_rate", 0.001)),
+        writer=writer_mode,
+        compression=compression,
+        writer_batch_size=int(output_cfg.get("writer_batch_size", 200)),
+        writer_flush_interval_sec=float(
+            output_cfg.get("writer_flush_interval_sec", 1.0)
+        ),
+        writer_queue_size=int(output_cfg.get("writer_queue_size", 1000)),
+        raw_archive=bool(output_cfg.get("raw_archive", False)),
+        raw_archive_segment_mb=max(
+            1, int(output_cfg.get("raw_archive_segment_mb", 256))
+        ),
+    )
+
+    cache_cfg = params.get("http_cache") or {}
+    raw_cache_root = cache_cfg.get("root")
+    http_cache = HttpCacheConfig(
+        enabled=bool(cache_cfg.get("enabled", False)),
+        root=Path(raw_cache_root) if raw_cache_root else None,
+        default_ttl_sec=max(0.0, float(cache_cfg.get("default_ttl_sec", 0.0))),
+        ttl_sec={
+            str(source).strip().lower(): max(0.0, float(ttl))
+            for source, ttl in (cache_cfg.get("ttl_sec", {}) or {}).items()
+            if str(source).strip()
+        },
+        listing_ttl_sec=max(0.0, float(cache_cfg.get("listing_ttl_sec", 0.0))),
+        max_age_sec=max(0.0, float(cache_cfg.get("max_age_sec", 30 * 86400.0))),
+        max_mb=max(0, int(cache_cfg.get("max_mb", 2048))),
+    )
+
+    prefilter_cfg = params.get("prefilter") or {}
+    prefilter_mode = str(prefilter_cfg.get("mode", "deprioritize")).strip().lower()
+    if prefilter_mode not in PREFILTER_MODES:
+        raise ValueError(
+            f"prefilter.mode must be one of {PREFILTER_MODES}, got: {prefilter_mode}"
+        )
+    prefilter = PrefilterConfig(
+        enabled=bool(prefilter_cfg.get("enabled", False)),
+        mode=prefilter_mode,
+        topical_boards=[
+            str(b).strip()
+            for b in (prefilter_cfg.get("topical_boards", []) or [])
+            if str(b).strip()
+        ],
+        audit_rate=min(1.0, max(0.0, float(prefilter_cfg.get("audit_rate", 0.05)))),
+    )
+
+    metrics_cfg = params.get("metrics") or {}
+    raw_metrics_port = metrics_cfg.get("prometheus_port")
+    raw_metrics_json = metrics_cfg.get("json_path")
+    metrics = MetricsConfig(
+        prometheus_port=int(raw_metrics_port) if raw_metrics_port is not None else None,
+        prometheus_host=str(metrics_cfg.get("prometheus_host", "127.0.0.1")),
+        json_path=Path(raw_metrics_json) if raw_metrics_json else None,
+        json_interval_sec=max(1.0, float(metrics_cfg.get("json_interval_sec", 30.0))),
+        max_hosts=max(1, int(metrics_cfg.get("max_hosts", 200))),
+    )
 
     crawl_cfg = params.get("crawl", {})
     run_id = _ensure_run_id(crawl_cfg.get("run_id"))
 
     limits_cfg = params.get("limits", {})
+    fetch_mode = str(limits_cfg.get("fetch_mode", "threads")).strip().lower()
+    if fetch_mode not in FETCH_MODES:
+        raise ValueError(
+            f"limits.fetch_mode must be one of {FETCH_MODES}, got: {fetch_mode}"
+        )
+    candidate_order = str(limits_cfg.get("candidate_order", "priority")).strip().lower()
+    if candidate_order not in CANDIDATE_ORDERS:
+        raise ValueError(
+            "limits.candidate_order must be one of "
+            f"{CANDIDATE_ORDERS}, got: {candidate_order}"
+        )
     limits = CrawlLimits(
         max_candidates_per_source=int(limits_cfg.get("max_candidates_per_source", 500)),
         request_timeout_sec=int(limits_cfg.get("request_timeout_sec", 30)),
@@ -184,6 +357,26 @@ def load_config(
             for host, pause in (limits_cfg.get("per_host_pause_sec", {}) or {}).items()
             if str(host).strip()
         },
+        fetch_mode=fetch_mode,
+        per_host_burst=max(1.0, float(limits_cfg.get("per_host_burst", 1.0))),
+        stream_discovery=bool(limits_cfg.get("stream_discovery", False)),
+        candidate_queue_size=max(1, int(limits_cfg.get("candidate_queue_size", 1000))),
+        candidate_order=candidate_order,
+        extract_processes=max(0, int(limits_cfg.get("extract_processes", 0))),
+        comment_pause_sec={
+            str(host).strip().lower(): max(0.0, float(pause))
+            for host, pause in (limits_cfg.get("comment_pause_sec", {}) or {}).items()
+            if str(host).strip()
+        },
+        extract_queue_size=max(0, int(limits_cfg.get("extract_queue_size", 0))),
+        source_weights={
+            str(source).strip().lower(): max(0.0, float(weight))
+            for source, weight in (limits_cfg.get("source_weights", {}) or {}).items()
+            if str(source).strip()
+        },
+        forum_discovery_concurrency=max(
+            1, int(limits_cfg.get("forum_discovery_concurrency", 8))
+        ),
     )
 
     quality_cfg = params.get("quality", {})
@@ -193,6 +386,7 @@ def load_config(
 
     sources_cfg = params.get("sources", {})
     gdelt_cfg = sources_cfg.get("gdelt", {})
+    gdelt_cache_cfg = gdelt_cfg.get("cache") or {}
     forums_cfg = sources_cfg.get("forums", {})
 
     gdelt = GdeltSourceConfig(
@@ -209,6 +403,11 @@ def load_config(
             if gdelt_cfg.get("max_days_back") is not None
             else None
         ),
+        min_interval_sec=float(gdelt_cfg.get("min_interval_sec", 0.2)),
+        max_interval_sec=float(gdelt_cfg.get("max_interval_sec", 30.0)),
+        cache_enabled=bool(gdelt_cache_cfg.get("enabled", True)),
+        cache_live_ttl_sec=float(gdelt_cache_cfg.get("live_ttl_sec", 3600.0)),
+        cache_settle_sec=float(gdelt_cache_cfg.get("settle_sec", 86400.0)),
     )
 
     # Forums: dynamically map unknown site keys into ForumSiteConfig instances
@@ -278,11 +477,14 @@ def load_config(
         keywords=keywords,
         lang=lang_list,
         time_window=TimeWindow(start_date=start_date, end_date=end_date),
-        output=OutputConfig(root=output_root),
+        output=output,
         runtime=RuntimeParams(run_id=run_id),
         limits=limits,
         quality=quality,
         gdelt=gdelt,
         forums=forums,
         autocrawl=autocrawl,
+        http_cache=http_cache,
+        prefilter=prefilter,
+        metrics=metrics,
     )
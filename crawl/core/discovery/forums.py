@@ -2,16 +2,21 @@ from __future__ import annotations
 
 import logging
 import re
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime, timezone
 from time import sleep
 from typing import Any, Dict, List, Mapping, Optional, Tuple, Callable
 from urllib.parse import urljoin, urlparse, urlencode, parse_qsl
 
 import requests
-from bs4 import BeautifulSoup
+from bs4 import BeautifulSoup, SoupStrainer
 
-from ..models import Candidate
+from ..metrics import PipelineMetrics, url_host
+from ..models import Candidate, CandidateSink
 from ..utils import normalize_url
+from ..fetch.cache import ResponseCache
 from ..fetch.fetcher import RobotsCache
 
 logger = logging.getLogger(__name__)
@@ -25,6 +30,20 @@ opaque mapping of site->config objects and read attributes dynamically.
 """
 
 
+# Listing parsers only look at thread links and the table rows around them
+_LISTING_STRAINER = SoupStrainer(["tr", "a"])
+
+
+def _listing_soup(html: str) -> BeautifulSoup:
+    """Parse a listing page in one pass, keeping only rows and loose links.
+
+    Scripts, head, navigation and sidebars never become tree nodes, which is
+    most of a forum listing page. Rows keep their cells, so ``td`` selectors
+    and ``find_parent("tr")`` work as on the full tree.
+    """
+    return BeautifulSoup(html, "html.parser", parse_only=_LISTING_STRAINER)
+
+
 def _update_query_param(url: str, key: str, value: str) -> str:
     parsed = urlparse(url)
     query = dict(parse_qsl(parsed.query, keep_blank_values=True))
@@ -51,8 +70,20 @@ class ForumsDiscoverer:
         window_end: Optional[datetime] = None,
         until_date: Optional[datetime] = None,
         board_cursors: Optional[Mapping[str, int]] = None,
+        cache: Optional[ResponseCache] = None,
+        metrics: Optional[PipelineMetrics] = None,
+        max_concurrency: int = 8,
     ) -> None:
         self.session = session
+        # Boards crawled in parallel; listing requests stay serialized per host
+        self.max_concurrency = max(1, int(max_concurrency))
+        self._host_locks: Dict[str, threading.Lock] = {}
+        self._host_locks_guard = threading.Lock()
+        self._next_request_at: Dict[str, float] = {}
+        # Optional response cache for listing pages (listing_ttl_sec + 304s)
+        self.cache = cache
+        # discover_page latency per site/host
+        self.metrics = metrics or PipelineMetrics()
         self.timeout = request_timeout
         self.sites_config = sites_config
         self.robots = RobotsCache(session, request_timeout, user_agent)
@@ -102,7 +133,7 @@ class ForumsDiscoverer:
     def _parse_dcinside(
         self, base_url: str, html: str
     ) -> List[Tuple[str, Optional[str], Dict[str, Optional[str]]]]:
-        soup = BeautifulSoup(html, "html.parser")
+        soup = _listing_soup(html)
         items: List[Tuple[str, Optional[str], Dict[str, Optional[str]]]] = []
         for a in soup.select("td.gall_tit a[href]"):
             href = self._get_href(a) or ""
@@ -139,7 +170,7 @@ class ForumsDiscoverer:
     def _parse_bobaedream(
         self, base_url: str, html: str
     ) -> List[Tuple[str, Optional[str], Dict[str, Optional[str]]]]:
-        soup = BeautifulSoup(html, "html.parser")
+        soup = _listing_soup(html)
         items: List[Tuple[str, Optional[str], Dict[str, Optional[str]]]] = []
         # Support both legacy /board/bbs_view? and current /view? patterns
         links = soup.select('a[href*="/board/bbs_view?"], a[href*="/view?code="]')
@@ -165,7 +196,7 @@ class ForumsDiscoverer:
     def _parse_mlbpark(
         self, base_url: str, html: str
     ) -> List[Tuple[str, Optional[str], Dict[str, Optional[str]]]]:
-        soup = BeautifulSoup(html, "html.parser")
+        soup = _listing_soup(html)
         items: List[Tuple[str, Optional[str], Dict[str, Optional[str]]]] = []
         # MLBPark links can be like /mp/b.php?b=bullpen&m=view&idx=... or sometimes without m=view
         for a in soup.select('a[href*="/mp/b.php"]'):
@@ -192,7 +223,7 @@ class ForumsDiscoverer:
     def _parse_theqoo(
         self, base_url: str, html: str
     ) -> List[Tuple[str, Optional[str], Dict[str, Optional[str]]]]:
-        soup = BeautifulSoup(html, "html.parser")
+        soup = _listing_soup(html)
         items: List[Tuple[str, Optional[str], Dict[str, Optional[str]]]] = []
         for a in soup.select('a[href*="/square/"]'):
             href = self._get_href(a) or ""
@@ -219,7 +250,7 @@ class ForumsDiscoverer:
     def _parse_ppomppu(
         self, base_url: str, html: str
     ) -> List[Tuple[str, Optional[str], Dict[str, Optional[str]]]]:
-        soup = BeautifulSoup(html, "html.parser")
+        soup = _listing_soup(html)
         items: List[Tuple[str, Optional[str], Dict[str, Optional[str]]]] = []
         # Current board id from listing URL (e.g., id=freeboard)
         current_board: Optional[str] = None
@@ -283,8 +314,18 @@ class ForumsDiscoverer:
             "ppomppu": self._parse_ppomppu,
         }.get(site)
 
-    def discover(self) -> Dict[str, List[Candidate]]:
-        per_site: Dict[str, List[Candidate]] = {}
+    def discover(
+        self, sink: Optional[CandidateSink] = None
+    ) -> Dict[str, List[Candidate]]:
+        """Crawl listing pages; ``sink`` receives each page's new candidates.
+
+        Boards run concurrently (up to ``max_concurrency``); pages within a
+        board stay sequential because ``until_date`` and the cursor depend on
+        their order. Requests to one host are serialized and spaced by the
+        site's ``pause_between_requests``, so discovery takes about as long as
+        the slowest site instead of the sum of all sites.
+        """
+        tasks: List[Tuple[str, Any, Callable[..., Any], str]] = []
         for site, cfg in self.sites_config.items():
             if not cfg or not getattr(cfg, "enabled", False):
                 continue
@@ -292,131 +333,207 @@ class ForumsDiscoverer:
             if not parser:
                 logger.debug("No parser for forum site=%s", site)
                 continue
-            all_candidates: List[Candidate] = []
-            obey_robots = bool(getattr(cfg, "obey_robots", True))
-            for board_url in cfg.boards:
-                if not board_url:
+            tasks.extend((site, cfg, parser, b) for b in cfg.boards if b)
+
+        sink_lock = threading.Lock()
+
+        def board_sink(batch: List[Candidate]) -> None:
+            if sink is not None:
+                with sink_lock:
+                    sink(batch)
+
+        def run(task: Tuple[str, Any, Callable[..., Any], str]) -> List[Candidate]:
+            site, cfg, parser, board_url = task
+            return self._discover_board(site, cfg, parser, board_url, board_sink)
+
+        workers = min(self.max_concurrency, len(tasks))
+        if workers <= 1:
+            results = [run(task) for task in tasks]
+        else:
+            with ThreadPoolExecutor(
+                max_workers=workers, thread_name_prefix="forums"
+            ) as ex:
+                results = list(ex.map(run, tasks))
+
+        # Same order as the sequential crawl: config site order, then boards
+        per_site: Dict[str, List[Candidate]] = {}
+        for site, cfg in self.sites_config.items():
+            if cfg and getattr(cfg, "enabled", False) and self._get_parser(site):
+                per_site[site] = []
+        for (site, _cfg, _parser, _board), board_candidates in zip(tasks, results):
+            per_site[site].extend(board_candidates)
+        for site, candidates in per_site.items():
+            logger.info("ForumsDiscoverer site=%s discovered=%d", site, len(candidates))
+        return per_site
+
+    def _discover_board(
+        self,
+        site: str,
+        cfg: Any,
+        parser: Callable[
+            [str, str], List[Tuple[str, Optional[str], Dict[str, Optional[str]]]]
+        ],
+        board_url: str,
+        sink: CandidateSink,
+    ) -> List[Candidate]:
+        all_candidates: List[Candidate] = []
+        obey_robots = bool(getattr(cfg, "obey_robots", True))
+        seen_norm: set[str] = set()
+        # Start from saved cursor, advance up to max_pages for this round
+        start_page = int(self.board_cursors.get(board_url, 1))
+        last_page_visited = start_page - 1
+        for page in range(start_page, start_page + cfg.max_pages):
+            page_url = self._build_page_url(site, board_url, page)
+            # robots check on listing page (can be overridden per-site)
+            if obey_robots and not self.robots.allowed(page_url):
+                logger.debug("Discovery robots disallow: %s", page_url)
+                continue
+            try:
+                resp = self._paced_listing(site, page_url, cfg.pause_between_requests)
+                if resp.status_code >= 400:
+                    logger.debug(
+                        "Listing fetch failed %s status=%s",
+                        page_url,
+                        resp.status_code,
+                    )
+                    break
+                posts: List[
+                    Tuple[str, Optional[str], Dict[str, Optional[str]]]
+                ] = parser(board_url, resp.text)
+            except requests.RequestException as exc:
+                logger.debug("Listing request error: url=%s error=%s", page_url, exc)
+                break
+            # Normalize and de-dup within board
+            page_oldest_ts: Optional[datetime] = None
+            page_start = len(all_candidates)
+            for entry in posts:
+                if isinstance(entry, tuple) and len(entry) == 3:
+                    url, title, meta = entry
+                else:
                     continue
-                seen_norm: set[str] = set()
-                # Start from saved cursor, advance up to max_pages for this round
-                start_page = int(self.board_cursors.get(board_url, 1))
-                last_page_visited = start_page - 1
-                for page in range(start_page, start_page + cfg.max_pages):
-                    page_url = self._build_page_url(site, board_url, page)
-                    # robots check on listing page (can be overridden per-site)
-                    if obey_robots and not self.robots.allowed(page_url):
-                        logger.debug("Discovery robots disallow: %s", page_url)
-                        continue
-                    try:
-                        resp = self.session.get(page_url, timeout=self.timeout)
-                        if resp.status_code >= 400:
-                            logger.debug(
-                                "Listing fetch failed %s status=%s",
-                                page_url,
-                                resp.status_code,
-                            )
-                            break
-                        posts: List[
-                            Tuple[str, Optional[str], Dict[str, Optional[str]]]
-                        ] = parser(board_url, resp.text)
-                    except requests.RequestException as exc:
-                        logger.debug(
-                            "Listing request error: url=%s error=%s", page_url, exc
-                        )
-                        break
-                    # Normalize and de-dup within board
-                    page_oldest_ts: Optional[datetime] = None
-                    for entry in posts:
-                        if isinstance(entry, tuple) and len(entry) == 3:
-                            url, title, meta = entry
-                        else:
-                            continue
-                        if not url:
-                            continue
-                        norm = normalize_url(url)
-                        if norm in seen_norm:
-                            continue
-                        seen_norm.add(norm)
-                        # parse timestamp
-                        ts: Optional[datetime] = None
-                        published_at = (
-                            meta.get("published_at") if isinstance(meta, dict) else None
-                        )
-                        if published_at and isinstance(published_at, str):
-                            ts = self._parse_datetime_guess(published_at)
-                        # normalize to UTC-aware for comparison
-                        ts_aware: Optional[datetime] = None
-                        if ts is not None:
-                            ts_aware = (
-                                ts if ts.tzinfo else ts.replace(tzinfo=timezone.utc)
-                            )
-                            ts_aware = ts_aware.astimezone(timezone.utc)
-                            # time-window filtering: keep only posts within [start, end)
-                            if self.window_start and ts_aware < self.window_start:
-                                ts_aware = None
-                            if (
-                                ts_aware
-                                and self.window_end
-                                and ts_aware >= self.window_end
-                            ):
-                                ts_aware = None
-                        # If filtering by time window but timestamp missing, keep candidate
-                        # (we will not use it to advance until_date and will rely on post-fetch
-                        # extraction to infer published_at).
-                        all_candidates.append(
-                            Candidate(
-                                url=url,
-                                source=site,
-                                discovered_via={
-                                    "type": "forum",
-                                    "site": site,
-                                    "board": board_url,
-                                    "page": page,
-                                },
-                                title=title,
-                                snapshot_url=None,
-                                timestamp=ts_aware,
-                                extra={
-                                    "forum": {"site": site, "board": board_url},
-                                    # Hint to fetcher to bypass robots if discovery already did
-                                    # (only set when site explicitly disabled robots obedience)
-                                    **(
-                                        {"robots_override": True}
-                                        if not obey_robots
-                                        else {}
-                                    ),
-                                },
-                            )
-                        )
-                        # track oldest ts on this page
-                        if ts_aware is not None:
-                            if page_oldest_ts is None or ts_aware < page_oldest_ts:
-                                page_oldest_ts = ts_aware
-                        if len(all_candidates) >= cfg.per_board_limit:
-                            break
-                    if len(all_candidates) >= cfg.per_board_limit:
-                        last_page_visited = page
-                        break
-                    last_page_visited = page
-                    # stop when we paged past the until_date threshold
+                if not url:
+                    continue
+                norm = normalize_url(url)
+                if norm in seen_norm:
+                    continue
+                seen_norm.add(norm)
+                # parse timestamp
+                ts: Optional[datetime] = None
+                published_at = (
+                    meta.get("published_at") if isinstance(meta, dict) else None
+                )
+                if published_at and isinstance(published_at, str):
+                    ts = self._parse_datetime_guess(published_at)
+                # normalize to UTC-aware for comparison
+                ts_aware: Optional[datetime] = None
+                if ts is not None:
+                    ts_aware = (
+                        ts if ts.tzinfo else ts.replace(tzinfo=timezone.utc)
+                    )
+                    ts_aware = ts_aware.astimezone(timezone.utc)
+                    # time-window filtering: keep only posts within [start, end)
+                    if self.window_start and ts_aware < self.window_start:
+                        ts_aware = None
                     if (
-                        self.until_date
-                        and page_oldest_ts
-                        and page_oldest_ts < self.until_date
+                        ts_aware
+                        and self.window_end
+                        and ts_aware >= self.window_end
                     ):
-                        break
-                    sleep(cfg.pause_between_requests)
-                # record last page visited (for cursor advancement)
-                self.last_board_pages[board_url] = max(
-                    last_page_visited, start_page - 1
+                        ts_aware = None
+                # If filtering by time window but timestamp missing, keep candidate
+                # (we will not use it to advance until_date and will rely on post-fetch
+                # extraction to infer published_at).
+                all_candidates.append(
+                    Candidate(
+                        url=url,
+                        source=site,
+                        discovered_via={
+                            "type": "forum",
+                            "site": site,
+                            "board": board_url,
+                            "page": page,
+                        },
+                        title=title,
+                        snapshot_url=None,
+                        timestamp=ts_aware,
+                        extra={
+                            "forum": {"site": site, "board": board_url},
+                            # Hint to fetcher to bypass robots if discovery already did
+                            # (only set when site explicitly disabled robots obedience)
+                            **(
+                                {"robots_override": True}
+                                if not obey_robots
+                                else {}
+                            ),
+                        },
+                    )
                 )
-            per_site[site] = all_candidates
-            logger.info(
-                "ForumsDiscoverer site=%s discovered=%d", site, len(all_candidates)
-            )
-        return per_site
+                # track oldest ts on this page
+                if ts_aware is not None:
+                    if page_oldest_ts is None or ts_aware < page_oldest_ts:
+                        page_oldest_ts = ts_aware
+                if len(all_candidates) >= cfg.per_board_limit:
+                    break
+            if sink is not None and len(all_candidates) > page_start:
+                sink(all_candidates[page_start:])
+            if len(all_candidates) >= cfg.per_board_limit:
+                last_page_visited = page
+                break
+            last_page_visited = page
+            # stop when we paged past the until_date threshold
+            if (
+                self.until_date
+                and page_oldest_ts
+                and page_oldest_ts < self.until_date
+            ):
+                break
+        # record last page visited (for cursor advancement)
+        with self._host_locks_guard:
+            self.last_board_pages[board_url] = max(last_page_visited, start_page - 1)
+        return all_candidates
+
+    def _paced_listing(self, site: str, page_url: str, pause: float) -> Any:
+        """Fetch one listing page, at least ``pause`` after the last one to its host.
+
+        Same scheme as Fetcher's per-host locks: requests to one host are
+        serialized, different hosts proceed in parallel. A page served from disk
+        made no request, so it does not push the host's next slot back.
+        """
+        host = url_host(page_url)
+        key = host or site
+        with self._host_locks_guard:
+            lock = self._host_locks.setdefault(key, threading.Lock())
+        with lock:
+            wait = self._next_request_at.get(key, 0.0) - time.monotonic()
+            if wait > 0:
+                sleep(wait)
+                self.metrics.inc("pace_sleep_sec", wait, source=site, host=host)
+            try:
+                with self.metrics.time("discover_page", source=site, host=host):
+                    resp = self._get_listing(page_url)
+            except requests.RequestException:
+                self._next_request_at[key] = time.monotonic() + pause
+                raise
+            if not self._served_from_disk(resp):
+                self._next_request_at[key] = time.monotonic() + pause
+            return resp
 
     # ----- helpers -----
+    def _get_listing(self, page_url: str) -> Any:
+        if self.cache is None:
+            return self.session.get(page_url, timeout=self.timeout)
+        return self.cache.get(
+            self.session,
+            page_url,
+            ttl=self.cache.listing_ttl_sec,
+            timeout=self.timeout,
+        )
+
+    def _served_from_disk(self, resp: Any) -> bool:
+        if not getattr(resp, "from_cache", False):
+            return False
+        return not getattr(resp, "not_modified", False)
+
     def _parse_datetime_guess(self, s: str) -> Optional[datetime]:
         s = (s or "").strip()
         if not s:
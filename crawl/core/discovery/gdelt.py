@@ -1,16 +1,20 @@
 from __future__ import annotations
 
 import logging
+import time
 from dataclasses import dataclass
 from datetime import datetime, timedelta, timezone
 from time import sleep
-from typing import Iterable, List, Optional, Set, Tuple
+from typing import Any, Dict, Iterable, List, Optional, Set, Tuple
 from concurrent.futures import ThreadPoolExecutor, as_completed
 import threading
 
 import requests
 
-from ..models import Candidate
+from ..fetch.limiter import AimdLimiter
+from ..metrics import PipelineMetrics, url_host
+from ..models import Candidate, CandidateSink
+from .gdelt_cache import GdeltWindowCache
 
 logger = logging.getLogger(__name__)
 
@@ -20,11 +24,15 @@ class GdeltConfig:
     max_records_per_keyword: int = 75
     chunk_days: int = 30
     overlap_days: int = 0
+    # Initial spacing between request starts; the limiter adapts it between
+    # min_interval_sec and max_interval_sec (see crawl.core.fetch.limiter)
     pause_between_requests: float = 1.0
     max_attempts: int = 3
     rate_limit_backoff_sec: float = 5.0
     max_concurrency: int = 4
     max_days_back: Optional[int] = None
+    min_interval_sec: float = 0.2
+    max_interval_sec: float = 30.0
 
 
 class GdeltDiscoverer:
@@ -39,8 +47,14 @@ class GdeltDiscoverer:
         end_date: Optional[datetime],
         request_timeout: int,
         config: GdeltConfig | None = None,
+        metrics: PipelineMetrics | None = None,
+        cache: GdeltWindowCache | None = None,
     ) -> None:
         self.session = session
+        # discover_page latency (one API query), limiter waits and 429 counts
+        self.metrics = metrics or PipelineMetrics()
+        # Optional persistent results per (query, window); see gdelt_cache
+        self.cache = cache
         self.keywords = [kw for kw in keywords if kw.strip()]
         self.languages = [lang.lower() for lang in languages]
         self.start_date = start_date
@@ -57,12 +71,26 @@ class GdeltDiscoverer:
             self.config.max_attempts = 1
         if self.config.rate_limit_backoff_sec < 0:
             self.config.rate_limit_backoff_sec = 0.0
+        # One limiter for every worker: a 429 slows all of them down at once
+        self.limiter = AimdLimiter(
+            max(1, int(self.config.max_concurrency)),
+            interval=self.config.pause_between_requests,
+            min_interval=min(
+                self.config.min_interval_sec, self.config.pause_between_requests
+            ),
+            max_interval=self.config.max_interval_sec,
+            base_backoff=self.config.rate_limit_backoff_sec,
+        )
 
     def _iter_windows(self) -> Iterable[tuple[datetime, datetime]]:
         end = self.end_date or datetime.now(timezone.utc)
         start = self.start_date
         if self.config.max_days_back and self.config.max_days_back > 0:
             clamp_start = end - timedelta(days=self.config.max_days_back)
+            # Day-aligned so repeated runs on one day reuse the same windows
+            clamp_start = clamp_start.replace(
+                hour=0, minute=0, second=0, microsecond=0
+            )
             if clamp_start > start:
                 start = clamp_start
         if start.tzinfo is None:
@@ -116,30 +144,24 @@ class GdeltDiscoverer:
         params["enddatetime"] = window_end_inclusive.strftime("%Y%m%d%H%M%S")
         return params
 
-    def discover(self) -> List[Candidate]:
-        windows = list(self._iter_windows())
-        tasks: List[Tuple[str, datetime, datetime]] = []
-        for keyword in self.keywords:
-            if len(keyword.strip()) < 3:
-                continue
-            for window_start, window_end in windows:
-                tasks.append((keyword, window_start, window_end))
-
-        seen_urls: Set[str] = set()
-        seen_lock = threading.Lock()
-        results: List[Candidate] = []
-
-        def worker(kw: str, ws: datetime, we: datetime) -> List[Candidate]:
-            params = self._build_params(kw, ws, we)
-            attempt = 0
-            response = None
-            while attempt < self.config.max_attempts:
+    def _request(
+        self, kw: str, ws: datetime, we: datetime, params: dict[str, str]
+    ) -> Optional[List[Dict[str, Any]]]:
+        """One API query through the shared limiter; None when it failed."""
+        attempt = 0
+        response = None
+        while attempt < self.config.max_attempts:
+            with self.limiter.slot() as slot:
+                self.metrics.inc("limiter_wait_sec", slot.waited, source="gdelt")
                 try:
-                    response = self.session.get(
-                        self.API_URL,
-                        params=params,
-                        timeout=self.request_timeout,
-                    )
+                    with self.metrics.time(
+                        "discover_page", source="gdelt", host=url_host(self.API_URL)
+                    ):
+                        response = self.session.get(
+                            self.API_URL,
+                            params=params,
+                            timeout=self.request_timeout,
+                        )
                     if response.status_code == 429:
                         retry_after = response.headers.get("Retry-After")
                         wait = None
@@ -148,19 +170,24 @@ class GdeltDiscoverer:
                                 wait = float(retry_after)
                             except ValueError:
                                 wait = None
-                        if wait is None:
-                            wait = self.config.rate_limit_backoff_sec * (2**attempt)
+                        wait = slot.rate_limited(wait)
                         logger.info(
-                            "GDELT 429 rate-limited. Sleeping %.1fs (attempt %d)",
+                            "GDELT 429 rate-limited. Pausing %.1fs (attempt %d, "
+                            "limit=%d, interval=%.2fs)",
                             wait,
                             attempt + 1,
+                            self.limiter.limit,
+                            self.limiter.interval,
                         )
-                        sleep(wait)
+                        self.metrics.inc("rate_limited", source="gdelt")
+                        response = None
                         attempt += 1
                         continue
                     response.raise_for_status()
+                    slot.ok()
                     break
                 except requests.RequestException as exc:
+                    response = None
                     attempt += 1
                     logger.warning(
                         "GDELT request failed: kw=%s window=%s-%s attempt=%d error=%s",
@@ -170,27 +197,65 @@ class GdeltDiscoverer:
                         attempt,
                         exc,
                     )
-                    if attempt < self.config.max_attempts:
-                        sleep(self.config.rate_limit_backoff_sec * attempt)
-                    else:
-                        response = None
-                        break
-            if response is None:
-                return []
-            try:
-                payload = response.json()
-            except ValueError as exc:
-                logger.warning(
-                    "GDELT JSON decode failed: kw=%s window=%s-%s error=%s",
-                    kw,
-                    ws.date(),
-                    we.date(),
-                    exc,
-                )
-                return []
-            articles = payload.get("articles", [])
+            if attempt < self.config.max_attempts:
+                sleep(self.config.rate_limit_backoff_sec * attempt)
+        if response is None:
+            return None
+        try:
+            payload = response.json()
+        except ValueError as exc:
+            logger.warning(
+                "GDELT JSON decode failed: kw=%s window=%s-%s error=%s",
+                kw,
+                ws.date(),
+                we.date(),
+                exc,
+            )
+            return None
+        articles = payload.get("articles", []) if isinstance(payload, dict) else []
+        return [a for a in articles if isinstance(a, dict)]
+
+    def _articles(self, kw: str, ws: datetime, we: datetime) -> List[Dict[str, Any]]:
+        """Articles for one keyword×window, from the window cache when fresh."""
+        params = self._build_params(kw, ws, we)
+        if self.cache is None:
+            return self._request(kw, ws, we, params) or []
+        key = self.cache.key(params, ws)
+        entry = self.cache.get(key)
+        hit, since = self.cache.plan(entry, ws, we)
+        if hit and entry is not None:
+            self.metrics.inc("gdelt_cache_hits", source="gdelt")
+            return self.cache.articles(entry, we)
+        if since is not None and since > ws:
+            self.metrics.inc("gdelt_cache_incremental", source="gdelt")
+            params = self._build_params(kw, since, we)
+        fetched_at = time.time()
+        articles = self._request(kw, ws, we, params)
+        if articles is None:
+            # Keep serving what we had; the next run retries the query
+            return self.cache.articles(entry, we) if entry is not None else []
+        entry = self.cache.put(
+            key, articles, start=ws, end=we, previous=entry, fetched_at=fetched_at
+        )
+        return self.cache.articles(entry, we)
+
+    def discover(self, sink: Optional[CandidateSink] = None) -> List[Candidate]:
+        """Run all keyword×window queries; ``sink`` receives each batch early."""
+        windows = list(self._iter_windows())
+        tasks: List[Tuple[str, datetime, datetime]] = []
+        for keyword in self.keywords:
+            if len(keyword.strip()) < 3:
+                continue
+            for window_start, window_end in windows:
+                tasks.append((keyword, window_start, window_end))
+
+        seen_urls: Set[str] = set()
+        seen_lock = threading.Lock()
+        results: List[Candidate] = []
+
+        def worker(kw: str, ws: datetime, we: datetime) -> List[Candidate]:
             batch: List[Candidate] = []
-            for article in articles:
+            for article in self._articles(kw, ws, we):
                 url = article.get("url")
                 if not url:
                     continue
@@ -229,22 +294,27 @@ class GdeltDiscoverer:
                         extra={"gdelt": article},
                     )
                 )
-            if self.config.pause_between_requests:
-                sleep(self.config.pause_between_requests)
             return batch
 
         max_workers = max(1, int(self.config.max_concurrency))
         if len(tasks) <= 1 or max_workers == 1:
             for kw, ws, we in tasks:
-                results.extend(worker(kw, ws, we))
+                batch = worker(kw, ws, we)
+                results.extend(batch)
+                if sink is not None and batch:
+                    sink(batch)
         else:
             with ThreadPoolExecutor(max_workers=max_workers) as ex:
                 futures = [ex.submit(worker, kw, ws, we) for kw, ws, we in tasks]
                 for fut in as_completed(futures):
                     try:
-                        results.extend(fut.result())
+                        batch = fut.result()
                     except Exception as exc:  # noqa: BLE001
                         logger.debug("GDELT worker error: %s", exc)
+                        continue
+                    results.extend(batch)
+                    if sink is not None and batch:
+                        sink(batch)
 
         logger.info("GDELT discovered %d candidates", len(results))
         return results
@@ -0,0 +1,158 @@
+from __future__ import annotations
+
+import hashlib
+import json
+import logging
+import os
+import time
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Dict, List, Mapping, Optional, Tuple
+
+logger = logging.getLogger(__name__)
+
+
+class GdeltWindowCache:
+    """Persistent GDELT DOC API results keyed by (query params, window start).
+
+    One JSON file per key under ``root/<ab>/<sha1>.json`` holding the merged
+    ``articles``, the covered ``end`` and ``fetched_at`` (epoch seconds) of the
+    last query. The end is not part of the key because a window that is still
+    open ends at "now" and grows from run to run.
+
+    Freshness policy (``plan``):
+    - a window that had been closed for ``settle_sec`` when it was last fetched
+      is final (GDELT has finished indexing it) and is never queried again;
+    - a still-open ("live") window is served from cache for ``live_ttl_sec``,
+      then re-queried only from ``fetched_at - settle_sec`` (or the old end) to
+      the new end, and the new articles are merged into the entry.
+    """
+
+    def __init__(
+        self,
+        root: Path,
+        *,
+        live_ttl_sec: float = 3600.0,
+        settle_sec: float = 86400.0,
+    ) -> None:
+        self.root = root
+        self.root.mkdir(parents=True, exist_ok=True)
+        self.live_ttl_sec = max(0.0, float(live_ttl_sec))
+        self.settle_sec = max(0.0, float(settle_sec))
+
+    @staticmethod
+    def key(params: Mapping[str, str], start: datetime) -> str:
+        # Date bounds are excluded from params: incremental queries narrow them
+        base = {
+            k: v
+            for k, v in params.items()
+            if k not in ("startdatetime", "enddatetime")
+        }
+        raw = json.dumps(
+            {"params": base, "start": start.isoformat()},
+            sort_keys=True,
+            ensure_ascii=False,
+        )
+        return hashlib.sha1(raw.encode("utf-8")).hexdigest()
+
+    def _path(self, key: str) -> Path:
+        return self.root / key[:2] / f"{key}.json"
+
+    def get(self, key: str) -> Optional[Dict[str, Any]]:
+        try:
+            entry = json.loads(self._path(key).read_text(encoding="utf-8"))
+        except (OSError, ValueError):
+            return None
+        if not isinstance(entry, dict) or not isinstance(entry.get("articles"), list):
+            return None
+        return entry
+
+    @staticmethod
+    def _end(entry: Mapping[str, Any]) -> Optional[datetime]:
+        try:
+            return datetime.fromisoformat(str(entry.get("end")))
+        except ValueError:
+            return None
+
+    def is_final(self, entry: Mapping[str, Any]) -> bool:
+        end = self._end(entry)
+        fetched_at = float(entry.get("fetched_at", 0.0))
+        return end is not None and fetched_at >= end.timestamp() + self.settle_sec
+
+    def articles(
+        self, entry: Mapping[str, Any], end: datetime
+    ) -> List[Dict[str, Any]]:
+        """Cached articles seen before ``end`` (entries may cover a longer span)."""
+        cached_end = self._end(entry)
+        rows = list(entry.get("articles", []))
+        if cached_end is None or end >= cached_end:
+            return rows
+        bound = end.astimezone(timezone.utc).strftime("%Y%m%dT%H%M%SZ")
+        return [a for a in rows if str(a.get("seendate") or "") < bound]
+
+    def plan(
+        self,
+        entry: Optional[Mapping[str, Any]],
+        start: datetime,
+        end: datetime,
+        now: Optional[float] = None,
+    ) -> Tuple[bool, Optional[datetime]]:
+        """(serve the cached entry as is, start of the query to run otherwise).
+
+        ``(True, None)`` is a hit; ``(False, start)`` a full query;
+        ``(False, since)`` with ``since > start`` an incremental one.
+        """
+        cached_end = self._end(entry) if entry is not None else None
+        if entry is None or cached_end is None:
+            return False, start
+        now = time.time() if now is None else now
+        fetched_at = float(entry.get("fetched_at", 0.0))
+        if end <= cached_end and self.is_final(entry):
+            return True, None
+        if now - fetched_at < self.live_ttl_sec:
+            return True, None
+        # Everything GDELT had indexed before (fetched_at - settle) is cached
+        settled = datetime.fromtimestamp(fetched_at - self.settle_sec, timezone.utc)
+        return False, max(start, min(cached_end, settled))
+
+    def put(
+        self,
+        key: str,
+        articles: List[Dict[str, Any]],
+        *,
+        start: datetime,
+        end: datetime,
+        previous: Optional[Mapping[str, Any]] = None,
+        fetched_at: Optional[float] = None,
+    ) -> Dict[str, Any]:
+        """Store ``articles`` merged after ``previous`` ones; returns the entry.
+
+        The entry's end only grows, so a shorter request cannot shrink it.
+        """
+        merged: List[Dict[str, Any]] = []
+        seen: set[str] = set()
+        for article in [*(previous or {}).get("articles", []), *articles]:
+            url = article.get("url") if isinstance(article, dict) else None
+            if not url or url in seen:
+                continue
+            seen.add(url)
+            merged.append(article)
+        if previous is not None:
+            cached_end = self._end(previous)
+            if cached_end is not None and cached_end > end:
+                end = cached_end
+        entry = {
+            "start": start.isoformat(),
+            "end": end.isoformat(),
+            "fetched_at": time.time() if fetched_at is None else fetched_at,
+            "articles": merged,
+        }
+        path = self._path(key)
+        path.parent.mkdir(parents=True, exist_ok=True)
+        tmp = path.with_name(f"{path.name}.{os.getpid()}.{id(entry)}.tmp")
+        try:
+            tmp.write_text(json.dumps(entry, ensure_ascii=False), encoding="utf-8")
+            os.replace(tmp, path)
+        except OSError as exc:
+            logger.warning("GDELT cache write failed: %s", exc)
+        return entry
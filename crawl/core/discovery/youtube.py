@@ -7,7 +7,7 @@ from typing import Iterable, List, Optional
 
 import requests
 
-from ..models import Candidate
+from ..models import Candidate, CandidateSink
 
 logger = logging.getLogger(__name__)
 
@@ -35,7 +35,7 @@ class YouTubeDiscoverer:
         self.end_date = end_date
         self.config = config or YouTubeConfig()
 
-    def discover(self) -> List[Candidate]:
+    def discover(self, sink: Optional[CandidateSink] = None) -> List[Candidate]:
         if not self.api_key:
             logger.info("Skipping YouTube discoverer because API key is missing.")
             return []
@@ -47,6 +47,7 @@ class YouTubeDiscoverer:
             published_before = self.end_date.isoformat().replace("+00:00", "Z")
 
         for keyword in self.keywords:
+            batch_start = len(candidates)
             params = {
                 "key": self.api_key,
                 "part": "snippet",
@@ -131,5 +132,7 @@ class YouTubeDiscoverer:
                         extra={"youtube": details.get(vid, {})},
                     )
                 )
+            if sink is not None and len(candidates) > batch_start:
+                sink(candidates[batch_start:])
         logger.info("YouTube discovered %d candidates", len(candidates))
         return candidates
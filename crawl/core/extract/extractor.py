@@ -2,25 +2,44 @@ from __future__ import annotations
 
 import json
 import logging
+import time
+from contextlib import contextmanager
 from datetime import datetime
 from dataclasses import dataclass
-from typing import Dict, Iterable, List, Optional, Tuple, cast
+from typing import Dict, Iterable, Iterator, List, Optional, Tuple, cast
 
 from langdetect import DetectorFactory, LangDetectException, detect
 import trafilatura
 import os
 import re
+import threading
 import requests
 from urllib.parse import parse_qs, urlparse, unquote
 
 from ..models import Candidate, Document, FetchResult
 from ..config import QualityConfig
+from ..keywords import KeywordMatcher
 from ..utils import normalize_url, sha1_hex
+from .parsed import ParsedHtml
+from .sessions import CommentSessionPool, auth_failed
 
 logger = logging.getLogger(__name__)
 
 DetectorFactory.seed = 0
 
+# Loose date(time) patterns scanned over forum text and raw HTML
+_DATETIME_PATTERNS = [
+    re.compile(
+        r"(?P<y4>\d{4})[./-](?P<m>\d{1,2})[./-](?P<d>\d{1,2})"
+        r"(?:\s+(?P<h>\d{1,2}):(?P<min>\d{2})(?::(?P<s>\d{2}))?)?"
+    ),
+    re.compile(
+        r"(?P<y2>\d{2})[./-](?P<m>\d{1,2})[./-](?P<d>\d{1,2})"
+        r"(?:\s+(?P<h>\d{1,2}):(?P<min>\d{2})(?::(?P<s>\d{2}))?)?"
+    ),
+]
+_WS_RE = re.compile(r"\s+")
+
 
 @dataclass(slots=True)
 class ExtractionResult:
@@ -38,7 +57,8 @@ class Extractor:
         quality_config: QualityConfig,
     ) -> None:
         self.keywords = [kw for kw in keywords if kw.strip()]
-        self.keywords_lower = [kw.lower() for kw in self.keywords]
+        # One compiled pass per document instead of a scan per keyword
+        self.keyword_matcher = KeywordMatcher(self.keywords)
         self.allowed_languages = [lang.lower() for lang in allowed_languages]
         self.quality_config = quality_config
         self.youtube_api_key = os.environ.get("YOUTUBE_API_KEY")
@@ -86,6 +106,10 @@ class Extractor:
             self.youtube_comments_pages = 0
             self.forums_comments_enabled = False
 
+        # Offline mode (re-extraction from the raw archive): never call the
+        # comment APIs; reuse comments stored with the archived candidate.
+        self.offline = False
+
         # Optional cookies for sites that gate comment APIs
         self.theqoo_cookies = os.environ.get("THEQOO_COOKIES")
         self.ppomppu_cookies = os.environ.get("PPOMPPU_COOKIES")
@@ -94,14 +118,45 @@ class Extractor:
         self.theqoo_pw = os.environ.get("THEQOO_PW")
         self.ppomppu_id = os.environ.get("PPOMPPU_ID")
         self.ppomppu_pw = os.environ.get("PPOMPPU_PW")
+        # Comment endpoint sessions, kept across documents; the pipeline
+        # swaps in a pool that shares its adapter and cookie jar
+        self.comment_sessions = CommentSessionPool()
+        # Page being built by build_document on this thread (see _page)
+        self._local = threading.local()
+
+    @contextmanager
+    def _span(self, stage: str) -> Iterator[None]:
+        # Seconds per stage of the document being built (see last_spans)
+        t0 = time.monotonic()
+        try:
+            yield
+        finally:
+            spans = getattr(self._local, "spans", None)
+            if spans is not None:
+                spans[stage] = spans.get(stage, 0.0) + time.monotonic() - t0
+
+    def last_spans(self) -> Dict[str, float]:
+        """Stage seconds (trafilatura, comment_fetch, quality) of the last
+        build_document on this thread, for PipelineMetrics."""
+        return dict(getattr(self._local, "last_spans", None) or {})
+
+    def _page(self, html: Optional[str]) -> ParsedHtml:
+        """Parsed view of ``html``, shared while ``build_document`` runs."""
+        page = getattr(self._local, "page", None)
+        if page is not None and page.html is (html or ""):
+            return page
+        return ParsedHtml(html)
 
     def _fallback_title_from_html(self, html: str) -> Optional[str]:
         if not html:
             return None
-        try:
-            from bs4 import BeautifulSoup  # lazy import
+        page = self._page(html)
+        return page.memo("fallback_title", lambda: self._title_from_soup(page.soup))
 
-            soup = BeautifulSoup(html, "html.parser")
+    def _title_from_soup(self, soup) -> Optional[str]:  # type: ignore[no-untyped-def]
+        if soup is None:
+            return None
+        try:
             # Prefer OpenGraph title
             og = soup.select_one('meta[property="og:title"]')
             if og and og.get("content"):
@@ -143,7 +198,8 @@ class Extractor:
                 authors=authors,
                 published_at=published_at,
             )
-        # fallback plain text
+        # Fallback plain text: the formats differ in post-processing, so an
+        # empty JSON result does not guarantee an empty plain-text one
         try:
             # Default behavior returns plain text when output_format is omitted
             text_plain = trafilatura.extract(html, url=url)
@@ -181,11 +237,9 @@ class Extractor:
         else:
             reasons.append(f"lang={lang}")
 
-        text_lower = blended.lower()
-        keyword_hits = sum(1 for kw in self.keywords_lower if kw and kw in text_lower)
-        coverage = (
-            keyword_hits / len(self.keywords_lower) if self.keywords_lower else 0.0
-        )
+        keyword_hits = len(self.keyword_matcher.counts(blended))
+        distinct = len(self.keyword_matcher)
+        coverage = keyword_hits / distinct if distinct else 0.0
         if keyword_hits >= self.quality_config.min_keyword_hits:
             score += 0.2
         else:
@@ -247,21 +301,11 @@ class Extractor:
     def _iter_datetimes_from_text(self, text: str) -> List[Tuple[datetime, bool]]:
         if not text:
             return []
-        cleaned = re.sub(r"\s+", " ", text)
+        cleaned = _WS_RE.sub(" ", text)
         results: List[Tuple[datetime, bool]] = []
         seen: set[Tuple[str, bool]] = set()
-        patterns = [
-            (
-                r"(?P<y4>\d{4})[./-](?P<m>\d{1,2})[./-](?P<d>\d{1,2})"
-                r"(?:\s+(?P<h>\d{1,2}):(?P<min>\d{2})(?::(?P<s>\d{2}))?)?"
-            ),
-            (
-                r"(?P<y2>\d{2})[./-](?P<m>\d{1,2})[./-](?P<d>\d{1,2})"
-                r"(?:\s+(?P<h>\d{1,2}):(?P<min>\d{2})(?::(?P<s>\d{2}))?)?"
-            ),
-        ]
-        for pattern in patterns:
-            for match in re.finditer(pattern, cleaned):
+        for pattern in _DATETIME_PATTERNS:
+            for match in pattern.finditer(cleaned):
                 groups = match.groupdict()
                 y_str = groups.get("y4") or groups.get("y2")
                 if not y_str:
@@ -308,11 +352,10 @@ class Extractor:
 
         site = (candidate.source or "").lower()
 
-        if site == "dcinside" and fetch_result.html:
+        page = self._page(fetch_result.html)
+        if site == "dcinside" and page.soup is not None:
             try:
-                from bs4 import BeautifulSoup  # type: ignore
-
-                soup = BeautifulSoup(fetch_result.html, "html.parser")
+                soup = page.soup
                 selector_hits: List[Tuple[datetime, bool]] = []
                 for el in soup.select(
                     "span.gall_date, td.gall_date, div.gall_date, span.date, span.write_time"
@@ -333,10 +376,14 @@ class Extractor:
             except Exception:  # noqa: BLE001
                 pass
 
-        for payload in (extraction.text, fetch_result.html):
-            if not payload:
-                continue
-            dt_candidates.extend(self._iter_datetimes_from_text(payload))
+        if extraction.text:
+            dt_candidates.extend(self._iter_datetimes_from_text(extraction.text))
+        if page.html:
+            dt_candidates.extend(
+                page.memo(
+                    "html_datetimes", lambda: self._iter_datetimes_from_text(page.html)
+                )
+            )
 
         forum_meta = (
             candidate.extra.get("forum") if isinstance(candidate.extra, dict) else None
@@ -371,7 +418,26 @@ class Extractor:
         fetch_result: FetchResult,
         run_id: str,
     ) -> tuple[Optional[Document], Optional[Dict[str, object]]]:
-        extraction = self._run_trafilatura(fetch_result.html or "", candidate.url)
+        # Every helper below shares one parse of the page (see _page)
+        previous = getattr(self._local, "page", None)
+        previous_spans = getattr(self._local, "spans", None)
+        self._local.page = ParsedHtml(fetch_result.html)
+        self._local.spans = {}
+        try:
+            return self._build_document(candidate, fetch_result, run_id)
+        finally:
+            self._local.last_spans = self._local.spans
+            self._local.page = previous
+            self._local.spans = previous_spans
+
+    def _build_document(
+        self,
+        candidate: Candidate,
+        fetch_result: FetchResult,
+        run_id: str,
+    ) -> tuple[Optional[Document], Optional[Dict[str, object]]]:
+        with self._span("trafilatura"):
+            extraction = self._run_trafilatura(fetch_result.html or "", candidate.url)
         if not extraction or not extraction.text:
             # Try YouTube augmentation even if HTML extraction failed
             if candidate.source == "youtube":
@@ -395,7 +461,8 @@ class Extractor:
         # YouTube comment/description augmentation
         if candidate.source == "youtube":
             try:
-                extraction = self._augment_youtube(candidate, extraction)
+                with self._span("comment_fetch"):
+                    extraction = self._augment_youtube(candidate, extraction)
             except Exception as exc:  # noqa: BLE001
                 logger.debug("YouTube augmentation failed: %s", exc)
 
@@ -422,14 +489,15 @@ class Extractor:
                 parts = [c.get("text", "") for c in comments if isinstance(c, dict)]
                 quality_text = "\n".join(p for p in parts if p)
 
-        lang = self._detect_lang(
-            quality_text or extraction.title or candidate.title or ""
-        )
-        quality = self._build_quality(
-            quality_text or "",
-            lang,
-            title=extraction.title or candidate.title,
-        )
+        with self._span("quality"):
+            lang = self._detect_lang(
+                quality_text or extraction.title or candidate.title or ""
+            )
+            quality = self._build_quality(
+                quality_text or "",
+                lang,
+                title=extraction.title or candidate.title,
+            )
         if cast(int, quality["keyword_hits"]) < self.quality_config.min_keyword_hits:
             return None, {
                 "status": "quality-reject",
@@ -513,8 +581,19 @@ class Extractor:
             if "v" in qs and qs["v"]:
                 video_id = qs["v"][0]
 
+        if self.offline and isinstance(video_details, dict):
+            for c in video_details.get("comments") or []:
+                if isinstance(c, dict) and c.get("text"):
+                    comments_texts.append(str(c["text"]))
+                    comments_meta.append(c)
+
         # Fetch comments (best-effort, optional pagination/replies)
-        if self.youtube_api_key and video_id and self.youtube_comments_pages > 0:
+        if (
+            not self.offline
+            and self.youtube_api_key
+            and video_id
+            and self.youtube_comments_pages > 0
+        ):
             try:
                 url = "https://www.googleapis.com/youtube/v3/commentThreads"
                 params = {
@@ -739,11 +818,8 @@ class Extractor:
         # Some ppomppu pages use malformed duplicate class attributes that html.parser
         # drops; retry with lxml parser when raw HTML is available.
         if site == "ppomppu" and html:
-            try:
-                from bs4 import BeautifulSoup  # type: ignore
-
-                soup_lxml = BeautifulSoup(html, "lxml")
-            except Exception:  # noqa: BLE001
+            soup_lxml = self._page(html).soup_lxml
+            if soup_lxml is None:
                 return None
             return _extract_with_soup(soup_lxml)
 
@@ -973,9 +1049,11 @@ class Extractor:
             "Chrome/128.0.0.0 Safari/537.36",
         )
 
-        session = requests.Session()
+        session = self.comment_sessions.session("dcinside")
+        self.comment_sessions.prime(
+            "dcinside", candidate.url, {"User-Agent": user_agent}
+        )
         try:
-            session.get(candidate.url, headers={"User-Agent": user_agent}, timeout=20)
             resp = session.post(
                 "https://gall.dcinside.com/board/comment/",
                 headers={
@@ -1066,9 +1144,11 @@ class Extractor:
             "Chrome/128.0.0.0 Safari/537.36",
         )
 
-        session = requests.Session()
+        session = self.comment_sessions.session("bobaedream")
+        self.comment_sessions.prime(
+            "bobaedream", candidate.url, {"User-Agent": user_agent}
+        )
         try:
-            session.get(candidate.url, headers={"User-Agent": user_agent}, timeout=20)
             params = {
                 "tb": tb_value,
                 "code": board_code,
@@ -1158,9 +1238,11 @@ class Extractor:
             "Chrome/128.0.0.0 Safari/537.36",
         )
 
-        session = requests.Session()
+        session = self.comment_sessions.session("mlbpark")
+        self.comment_sessions.prime(
+            "mlbpark", candidate.url, {"User-Agent": user_agent}
+        )
         try:
-            session.get(candidate.url, headers={"User-Agent": user_agent}, timeout=20)
             resp = session.get(
                 "https://mlbpark.donga.com/mp/b.php",
                 params={"b": board, "id": article_id, "m": "reply"},
@@ -1246,12 +1328,12 @@ class Extractor:
             "AppleWebKit/537.36 (KHTML, like Gecko) "
             "Chrome/128.0.0.0 Safari/537.36",
         )
-        session = requests.Session()
+        session = self.comment_sessions.session("theqoo")
         try:
             base_headers = {"User-Agent": user_agent}
             if self.theqoo_cookies:
                 base_headers["Cookie"] = self.theqoo_cookies
-            session.get(candidate.url, headers=base_headers, timeout=20)
+            self.comment_sessions.prime("theqoo", candidate.url, base_headers)
             resp = session.get(
                 "https://theqoo.net/index.php",
                 params={
@@ -1267,9 +1349,11 @@ class Extractor:
                 },
                 timeout=20,
             )
-            if resp.status_code >= 400:
-                # Try login once if credentials are available
-                if self._maybe_login_theqoo(session):
+            if resp.status_code >= 400 or auth_failed(resp):
+                # Log in only when the endpoint asks for it (credentials set)
+                if auth_failed(resp) and self.comment_sessions.login(
+                    "theqoo", self._maybe_login_theqoo
+                ):
                     resp = session.get(
                         "https://theqoo.net/index.php",
                         params={
@@ -1285,7 +1369,7 @@ class Extractor:
                         },
                         timeout=20,
                     )
-                    if resp.status_code >= 400:
+                    if resp.status_code >= 400 or auth_failed(resp):
                         return []
                 else:
                     return []
@@ -1308,35 +1392,6 @@ class Extractor:
             nodes = c_soup.select(sel)
             if nodes:
                 break
-        if not nodes:
-            # If no nodes found, try logging in once and retry
-            if self._maybe_login_theqoo(session):
-                try:
-                    resp = session.get(
-                        "https://theqoo.net/index.php",
-                        params={
-                            "module": "board",
-                            "act": "dispBoardContentCommentList",
-                            "mid": mid,
-                            "document_srl": doc_id,
-                        },
-                        headers={
-                            "User-Agent": user_agent,
-                            "Referer": candidate.url,
-                            "X-Requested-With": "XMLHttpRequest",
-                        },
-                        timeout=20,
-                    )
-                    if resp.status_code < 400:
-                        from bs4 import BeautifulSoup  # type: ignore
-
-                        c_soup = BeautifulSoup(resp.text, "html.parser")
-                        for sel in selectors:
-                            nodes = c_soup.select(sel)
-                            if nodes:
-                                break
-                except Exception:  # noqa: BLE001
-                    nodes = []
         if not nodes:
             return []
 
@@ -1475,13 +1530,16 @@ class Extractor:
                 "AppleWebKit/537.36 (KHTML, like Gecko) "
                 "Chrome/128.0.0.0 Safari/537.36",
             )
-            session = requests.Session()
+            session = self.comment_sessions.session("ppomppu")
             base_headers = {"User-Agent": user_agent}
             if self.ppomppu_cookies:
                 base_headers["Cookie"] = self.ppomppu_cookies
-            session.get(candidate.url, headers=base_headers, timeout=20)
+            self.comment_sessions.prime("ppomppu", candidate.url, base_headers)
             from bs4 import BeautifulSoup  # type: ignore
 
+            # Set when an endpoint answers with an auth failure (see login below)
+            auth_denied: List[bool] = []
+
             # 1) comment.php (primary)
             def _try_comment_php() -> List[dict]:
                 out: List[dict] = []
@@ -1501,6 +1559,9 @@ class Extractor:
                         },
                         timeout=20,
                     )
+                    if auth_failed(resp):
+                        auth_denied.append(True)
+                        return out
                     if resp.status_code >= 400 or not resp.text:
                         return out
                     c_soup = BeautifulSoup(resp.text, "html.parser")
@@ -1603,6 +1664,9 @@ class Extractor:
                         },
                         timeout=15,
                     )
+                    if auth_failed(resp):
+                        auth_denied.append(True)
+                        continue
                     if resp.status_code >= 400 or not resp.text:
                         continue
                     c_soup = BeautifulSoup(resp.text, "html.parser")
@@ -1634,8 +1698,11 @@ class Extractor:
                         return items
                 except requests.RequestException:
                     continue
-            # If still empty, try logging in once and retry endpoints
-            if not items and self._maybe_login_ppomppu(session, candidate.url):
+            # Log in and retry only if an endpoint asked for auth; a post
+            # without comments is not a reason to log in again
+            if not items and auth_denied and self.comment_sessions.login(
+                "ppomppu", lambda s: self._maybe_login_ppomppu(s, candidate.url)
+            ):
                 # Try comment.php again after login
                 items.extend(_try_comment_php())
                 if items:
@@ -1741,6 +1808,21 @@ class Extractor:
         except requests.RequestException:
             return False
 
+    def _fetch_forum_comments(  # type: ignore[no-untyped-def]
+        self, site: str, candidate: Candidate, soup
+    ) -> List[dict]:
+        if site == "dcinside":
+            return self._fetch_comments_dcinside(candidate, soup)
+        if site == "bobaedream":
+            return self._fetch_comments_bobaedream(candidate, soup)
+        if site == "mlbpark":
+            return self._fetch_comments_mlbpark(candidate, soup)
+        if site == "theqoo":
+            return self._fetch_comments_theqoo(candidate, soup)
+        if site == "ppomppu":
+            return self._fetch_comments_ppomppu(candidate, soup)
+        return []
+
     def _augment_forum(
         self,
         candidate: Candidate,
@@ -1750,13 +1832,10 @@ class Extractor:
         html = fetch_result.html or ""
         if not html:
             return extraction
-        try:
-            from bs4 import BeautifulSoup  # lazy import
-        except Exception:  # noqa: BLE001
+        soup = self._page(html).soup
+        if soup is None:
             return extraction
 
-        soup = BeautifulSoup(html, "html.parser")
-
         site = (candidate.source or "").lower()
         body_text = self._extract_forum_body_text(site, soup, html)
         author = self._extract_forum_author(site, soup)
@@ -1784,19 +1863,16 @@ class Extractor:
             )
 
         comments: List[dict] = []
-        try:
-            if site == "dcinside":
-                comments = self._fetch_comments_dcinside(candidate, soup)
-            elif site == "bobaedream":
-                comments = self._fetch_comments_bobaedream(candidate, soup)
-            elif site == "mlbpark":
-                comments = self._fetch_comments_mlbpark(candidate, soup)
-            elif site == "theqoo":
-                comments = self._fetch_comments_theqoo(candidate, soup)
-            elif site == "ppomppu":
-                comments = self._fetch_comments_ppomppu(candidate, soup)
-        except Exception:  # noqa: BLE001
-            comments = []
+        if self.offline:
+            stored = (candidate.extra or {}).get("forum") or {}
+            if isinstance(stored, dict) and isinstance(stored.get("comments"), list):
+                comments = [c for c in stored["comments"] if isinstance(c, dict)]
+        else:
+            try:
+                with self._span("comment_fetch"):
+                    comments = self._fetch_forum_comments(site, candidate, soup)
+            except Exception:  # noqa: BLE001
+                comments = []
 
         if not comments and site != "dcinside":
             comments = self._extract_comments_generic(soup)
@@ -0,0 +1,57 @@
+from __future__ import annotations
+
+import logging
+from typing import Any, Callable, Dict, Optional, TypeVar
+
+logger = logging.getLogger(__name__)
+
+T = TypeVar("T")
+
+_UNSET = object()
+
+
+def parse_html(html: str, parser: str) -> Any:
+    if not html:
+        return None
+    try:
+        from bs4 import BeautifulSoup  # lazy import
+
+        return BeautifulSoup(html, parser)
+    except Exception as exc:  # noqa: BLE001
+        logger.debug("HTML parse (%s) failed: %s", parser, exc)
+        return None
+
+
+class ParsedHtml:
+    """One fetched page, parsed at most once per parser and shared by helpers.
+
+    ``soup`` is the html.parser tree every forum selector is tuned for;
+    ``soup_lxml`` is only built for the few fallbacks that need lxml's more
+    forgiving recovery. ``memo`` caches derived values (fallback title, date
+    scans) so ``build_document`` fallbacks do not recompute them.
+    """
+
+    __slots__ = ("html", "_soup", "_soup_lxml", "_memo")
+
+    def __init__(self, html: Optional[str]) -> None:
+        self.html = html or ""
+        self._soup: Any = _UNSET
+        self._soup_lxml: Any = _UNSET
+        self._memo: Dict[str, Any] = {}
+
+    @property
+    def soup(self) -> Any:
+        if self._soup is _UNSET:
+            self._soup = parse_html(self.html, "html.parser")
+        return self._soup
+
+    @property
+    def soup_lxml(self) -> Any:
+        if self._soup_lxml is _UNSET:
+            self._soup_lxml = parse_html(self.html, "lxml")
+        return self._soup_lxml
+
+    def memo(self, key: str, compute: Callable[[], T]) -> T:
+        if key not in self._memo:
+            self._memo[key] = compute()
+        return self._memo[key]
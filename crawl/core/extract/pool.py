@@ -0,0 +1,148 @@
+from __future__ import annotations
+
+import logging
+import multiprocessing
+import threading
+import time
+from concurrent.futures import Future, ProcessPoolExecutor
+from typing import Any, Dict, Iterable, List, Mapping, Optional, Tuple
+
+from ..config import QualityConfig
+from ..models import Candidate, Document, FetchResult
+from .extractor import Extractor
+from .sessions import CommentSessionPool
+
+logger = logging.getLogger(__name__)
+
+# (candidate as mutated by augmentation, document, quality info, seconds,
+#  per-stage seconds from Extractor.last_spans)
+ExtractOutcome = Tuple[
+    Candidate, Optional[Document], Optional[dict], float, Dict[str, float]
+]
+
+# Per-process extractor, built once by the pool initializer
+_EXTRACTOR: Optional[Extractor] = None
+_RUN_ID = ""
+
+
+def init_extract_worker(
+    keywords: List[str],
+    lang: List[str],
+    quality: QualityConfig,
+    run_id: str,
+    offline: bool = False,
+    comment_sessions: Optional[Mapping[str, Any]] = None,
+) -> None:
+    global _EXTRACTOR, _RUN_ID
+    extractor = Extractor(keywords, lang, quality)
+    extractor.offline = offline
+    if comment_sessions is not None:
+        # See CommentSessionPool.worker_kwargs
+        extractor.comment_sessions = CommentSessionPool(**comment_sessions)
+    _EXTRACTOR = extractor
+    _RUN_ID = run_id
+
+
+def worker_extractor() -> Tuple[Extractor, str]:
+    if _EXTRACTOR is None:
+        raise RuntimeError("extract worker not initialized")
+    return _EXTRACTOR, _RUN_ID
+
+
+def extract_in_worker(
+    candidate: Candidate, fetch_result: FetchResult
+) -> ExtractOutcome:
+    extractor, run_id = worker_extractor()
+    t0 = time.monotonic()
+    document, quality_info = extractor.build_document(
+        candidate, fetch_result, run_id=run_id
+    )
+    # The candidate travels back because augmentation (comments) mutates it
+    return (
+        candidate,
+        document,
+        quality_info,
+        time.monotonic() - t0,
+        extractor.last_spans(),
+    )
+
+
+class ExtractStage:
+    """Process-pool extraction stage with bounded submission.
+
+    ``submit`` blocks while ``max_pending`` extractions are queued or running,
+    which pushes back on the fetch stage instead of buffering HTML without
+    limit. Workers are spawned (not forked) because the pipeline process
+    already runs discovery, writer and fetch threads. ``comment_sessions``
+    (from ``CommentSessionPool.worker_kwargs``) gives each worker the
+    pipeline's adapter, cookies and comment pacing.
+    """
+
+    def __init__(
+        self,
+        keywords: Iterable[str],
+        lang: Iterable[str],
+        quality: QualityConfig,
+        run_id: str,
+        *,
+        workers: int,
+        max_pending: Optional[int] = None,
+        comment_sessions: Optional[Mapping[str, Any]] = None,
+    ) -> None:
+        self.workers = max(1, int(workers))
+        self.max_pending = max(self.workers, int(max_pending or self.workers * 4))
+        self._pool = ProcessPoolExecutor(
+            max_workers=self.workers,
+            mp_context=multiprocessing.get_context("spawn"),
+            initializer=init_extract_worker,
+            initargs=(
+                list(keywords),
+                list(lang),
+                quality,
+                run_id,
+                False,
+                dict(comment_sessions) if comment_sessions is not None else None,
+            ),
+        )
+        self._slots = threading.BoundedSemaphore(self.max_pending)
+        self._lock = threading.Lock()
+        self.pending = 0
+        self.max_pending_seen = 0
+        self.submitted = 0
+        self.backpressure_sec = 0.0
+
+    def submit(
+        self, candidate: Candidate, fetch_result: FetchResult
+    ) -> "Future[ExtractOutcome]":
+        t0 = time.monotonic()
+        self._slots.acquire()
+        waited = time.monotonic() - t0
+        with self._lock:
+            self.backpressure_sec += waited
+            self.pending += 1
+            self.submitted += 1
+            self.max_pending_seen = max(self.max_pending_seen, self.pending)
+        try:
+            fut = self._pool.submit(extract_in_worker, candidate, fetch_result)
+        except Exception:
+            self._release()
+            raise
+        fut.add_done_callback(lambda _f: self._release())
+        return fut
+
+    def _release(self) -> None:
+        with self._lock:
+            self.pending -= 1
+        self._slots.release()
+
+    def metrics(self) -> Dict[str, float]:
+        with self._lock:
+            return {
+                "extract_workers": self.workers,
+                "extract_submitted": self.submitted,
+                "extract_pending_max": self.max_pending_seen,
+                "extract_backpressure_sec": round(self.backpressure_sec, 3),
+            }
+
+    def close(self) -> None:
+        self._pool.shutdown(wait=True)
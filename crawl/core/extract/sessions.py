@@ -0,0 +1,186 @@
+from __future__ import annotations
+
+import logging
+import threading
+import time
+from typing import Any, Callable, Dict, Mapping, Optional
+from urllib.parse import urlparse
+
+import requests
+from requests.adapters import HTTPAdapter
+from requests.cookies import RequestsCookieJar
+
+from ..metrics import PipelineMetrics
+
+logger = logging.getLogger(__name__)
+
+# A login is not attempted again for this long (per site), whatever its outcome
+LOGIN_RETRY_SEC = 300.0
+# Status codes that mean the comment endpoint wants a (fresh) login
+AUTH_FAILURE_STATUS = (401, 403)
+
+
+def _host(url: str) -> str:
+    host = (urlparse(url).hostname or "").lower()
+    return host[4:] if host.startswith("www.") else host
+
+
+def auth_failed(resp: requests.Response) -> bool:
+    """Whether ``resp`` signals missing auth: 401/403 or a redirect to a login page.
+
+    An empty comment list is not such a signal; most posts have no comments.
+    """
+    if resp.status_code in AUTH_FAILURE_STATUS:
+        return True
+    urls = [r.headers.get("Location", "") for r in getattr(resp, "history", [])]
+    urls.append(getattr(resp, "url", "") or "")
+    return any("login" in url.lower() for url in urls)
+
+
+class _PacedSession(requests.Session):
+    """Session whose requests wait out the pool's per-host interval."""
+
+    def __init__(self, pool: "CommentSessionPool") -> None:
+        super().__init__()
+        self._pool = pool
+
+    def request(  # type: ignore[override]
+        self, method: str, url: str, *args: Any, **kwargs: Any
+    ) -> requests.Response:
+        self._pool.wait_turn(url)
+        return super().request(method, url, *args, **kwargs)
+
+
+class CommentSessionPool:
+    """Per-site sessions for forum comment endpoints, reused across documents.
+
+    Sessions mount ``adapter`` (the pipeline passes its own, so comment calls
+    share its keep-alive connection pool) and share one cookie jar, so
+    cookies set while fetching the article page, cookie priming and logins
+    carry over to later documents. ``prime`` replaces the per-document
+    article re-GET: it only runs when the jar has no cookies for the host,
+    at most once per site. Requests to a host listed in
+    ``per_host_pause_sec`` are spaced by that interval across all threads.
+    """
+
+    def __init__(
+        self,
+        *,
+        adapter: Optional[HTTPAdapter] = None,
+        cookies: Optional[RequestsCookieJar] = None,
+        per_host_pause_sec: Optional[Mapping[str, float]] = None,
+        metrics: Optional[PipelineMetrics] = None,
+    ) -> None:
+        self.adapter = adapter
+        self.cookies = cookies if cookies is not None else RequestsCookieJar()
+        self.per_host_pause_sec = {
+            str(k).lower(): max(0.0, float(v))
+            for k, v in (per_host_pause_sec or {}).items()
+        }
+        self._sessions: Dict[str, requests.Session] = {}
+        self._primed: set[str] = set()
+        self._logins: Dict[str, tuple[float, bool]] = {}
+        self._site_locks: Dict[str, threading.Lock] = {}
+        self._next_at: Dict[str, float] = {}
+        self._lock = threading.Lock()
+        self.metrics = metrics or PipelineMetrics()
+
+    def worker_kwargs(self, processes: int = 1) -> Dict[str, Any]:
+        """Picklable constructor kwargs for a pool in an extraction process.
+
+        The adapter (its retry and pool settings; connections are rebuilt) and
+        a copy of the cookie jar carry over. Processes cannot share pacing
+        state, so each one spaces requests ``processes`` times wider and the
+        combined rate per host stays at the configured one.
+        """
+        scale = max(1, int(processes))
+        return {
+            "adapter": self.adapter,
+            "cookies": self.cookies.copy(),
+            "per_host_pause_sec": {
+                host: pause * scale for host, pause in self.per_host_pause_sec.items()
+            },
+        }
+
+    def _site_lock(self, site: str) -> threading.Lock:
+        with self._lock:
+            return self._site_locks.setdefault(site, threading.Lock())
+
+    def session(self, site: str) -> requests.Session:
+        with self._lock:
+            session = self._sessions.get(site)
+            if session is None:
+                session = _PacedSession(self)
+                session.cookies = self.cookies
+                if self.adapter is not None:
+                    session.mount("https://", self.adapter)
+                    session.mount("http://", self.adapter)
+                self._sessions[site] = session
+            return session
+
+    def _pause_for(self, host: str) -> float:
+        if host in self.per_host_pause_sec:
+            return self.per_host_pause_sec[host]
+        for key, pause in self.per_host_pause_sec.items():
+            if host.endswith(f".{key}"):
+                return pause
+        return 0.0
+
+    def wait_turn(self, url: str) -> None:
+        host = _host(url)
+        pause = self._pause_for(host) if host else 0.0
+        if pause <= 0:
+            return
+        # Reserve the next slot for this host, then sleep outside the lock
+        with self._lock:
+            now = time.monotonic()
+            start = max(now, self._next_at.get(host, 0.0))
+            self._next_at[host] = start + pause
+        if start > now:
+            time.sleep(start - now)
+            self.metrics.inc("comment_pause_sec", start - now, host=host)
+
+    def _has_cookies_for(self, host: str) -> bool:
+        for cookie in self.cookies:
+            domain = (cookie.domain or "").lstrip(".").lower()
+            if domain.startswith("www."):
+                domain = domain[4:]
+            if domain and (host == domain or host.endswith(f".{domain}")):
+                return True
+        return False
+
+    def prime(
+        self,
+        site: str,
+        url: str,
+        headers: Optional[Mapping[str, str]] = None,
+        timeout: float = 20,
+    ) -> None:
+        """Obtain site cookies once, unless the article fetch already set them."""
+        with self._site_lock(site):
+            if site in self._primed:
+                return
+            self._primed.add(site)
+            if self._has_cookies_for(_host(url)):
+                return
+            try:
+                self.session(site).get(
+                    url, headers=dict(headers or {}), timeout=timeout
+                )
+            except requests.RequestException as exc:
+                logger.debug("Cookie priming failed for %s: %s", site, exc)
+
+    def login(self, site: str, login: Callable[[requests.Session], bool]) -> bool:
+        """Run ``login`` for ``site``, serialized, on an ``auth_failed`` signal.
+
+        Within ``LOGIN_RETRY_SEC`` of the last attempt the outcome of that
+        attempt is returned instead: threads that hit the same auth failure
+        retry with the fresh session, and a failed login is not repeated.
+        """
+        with self._site_lock(site):
+            last = self._logins.get(site)
+            if last is not None and time.monotonic() - last[0] < LOGIN_RETRY_SEC:
+                return last[1]
+            ok = bool(login(self.session(site)))
+            self._logins[site] = (time.monotonic(), ok)
+            return ok
@@ -0,0 +1,257 @@
+from __future__ import annotations
+
+import asyncio
+import logging
+import queue
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from datetime import datetime
+from typing import Callable, Dict, Iterable, Iterator, Optional, TypeVar
+
+from ..models import Candidate, FetchResult
+from .fetcher import Fetcher
+
+logger = logging.getLogger(__name__)
+
+T = TypeVar("T")
+
+_DONE = object()
+
+
+def _failed_result(cand: Candidate) -> FetchResult:
+    # No body: callers treat it like any other failed fetch (status 0 = no
+    # response)
+    return FetchResult(
+        url=cand.url,
+        fetched_from="error",
+        status_code=0,
+        html=None,
+        snapshot_url=None,
+        encoding=None,
+        fetched_at=datetime.utcnow(),
+    )
+
+
+class TokenBucket:
+    """Per-host token bucket driven by a single asyncio event loop.
+
+    ``interval`` is the minimum spacing between request starts (1 / rate) and
+    ``capacity`` the number of requests that may be issued back-to-back after
+    the host has been idle. Not thread-safe; only touched from the loop.
+    """
+
+    def __init__(
+        self,
+        interval: float,
+        capacity: float = 1.0,
+        clock: Callable[[], float] = time.monotonic,
+    ) -> None:
+        self.interval = max(0.0, float(interval))
+        self.capacity = max(1.0, float(capacity))
+        self._clock = clock
+        self._tokens = self.capacity
+        self._updated = clock()
+        self.waited_sec = 0.0
+
+    def _refill(self) -> None:
+        now = self._clock()
+        if self.interval > 0:
+            self._tokens = min(
+                self.capacity, self._tokens + (now - self._updated) / self.interval
+            )
+        else:
+            self._tokens = self.capacity
+        self._updated = now
+
+    def delay(self) -> float:
+        """Seconds until one token is available (0.0 if ready now)."""
+        self._refill()
+        if self._tokens >= 1.0:
+            return 0.0
+        return (1.0 - self._tokens) * self.interval
+
+    async def acquire(self) -> None:
+        while True:
+            wait = self.delay()
+            if wait <= 0:
+                self._tokens -= 1.0
+                return
+            self.waited_sec += wait
+            await asyncio.sleep(wait)
+
+    def touch(self) -> None:
+        # Restart the refill clock at the actual request start so time spent
+        # waiting for a global slot does not shorten the spacing to the next one.
+        self._updated = self._clock()
+
+
+class AsyncFetchEngine:
+    """Schedule fetches through per-host token buckets and a global slot limit.
+
+    Candidates wait for their host's token *before* taking a global slot, so a
+    slow, heavily-paced host (e.g. dcinside at 2.5s) only occupies one slot at a
+    time instead of parking every worker behind a host lock. The blocking
+    ``requests`` call runs on an I/O thread pool; ``process`` (extraction) runs
+    on a separate pool after the slot is released so CPU work never delays I/O.
+    """
+
+    def __init__(
+        self,
+        fetcher: Fetcher,
+        concurrency: int,
+        *,
+        burst: float = 1.0,
+        process_workers: Optional[int] = None,
+    ) -> None:
+        self.fetcher = fetcher
+        self.concurrency = max(1, int(concurrency))
+        self.burst = max(1.0, float(burst))
+        # Threads running ``process``; defaults to ``concurrency``
+        self.process_workers = max(1, int(process_workers or self.concurrency))
+        self.active = 0
+        self.max_active = 0
+        # Scheduled-but-unfinished cap for streaming input; large enough that
+        # one paced host waiting on tokens does not starve the others.
+        self.max_pending = max(64, self.concurrency * 8)
+        self._buckets: Dict[str, TokenBucket] = {}
+        self._gates: Dict[str, asyncio.Lock] = {}
+
+    def host_wait_seconds(self) -> Dict[str, float]:
+        return {
+            host: round(bucket.waited_sec, 3)
+            for host, bucket in self._buckets.items()
+            if bucket.waited_sec > 0
+        }
+
+    def _bucket_for(self, host: str, interval: float) -> TokenBucket:
+        bucket = self._buckets.get(host)
+        if bucket is None:
+            bucket = TokenBucket(interval, capacity=self.burst)
+            self._buckets[host] = bucket
+        return bucket
+
+    def run(
+        self,
+        candidates: Iterable[Candidate],
+        process: Callable[[Candidate, Optional[FetchResult], float], T],
+    ) -> Iterator[T]:
+        """Fetch all candidates and yield ``process`` results as they complete.
+
+        The event loop runs on a background thread; results are handed back
+        through a queue so the caller can consume them (and update stats)
+        on its own thread, exactly like ``as_completed`` in thread mode.
+
+        Lists are scheduled all at once. Any other iterable (e.g. a streaming
+        candidate queue) is pulled lazily on a feeder thread with at most
+        ``max_pending`` candidates scheduled but unfinished at a time.
+        """
+        results: "queue.Queue[object]" = queue.Queue()
+
+        def _runner() -> None:
+            try:
+                asyncio.run(self._main(candidates, process, results))
+            except Exception as exc:  # noqa: BLE001
+                logger.warning("Async fetch loop crashed: %s", exc, exc_info=True)
+            finally:
+                results.put(_DONE)
+
+        thread = threading.Thread(target=_runner, name="async-fetch", daemon=True)
+        thread.start()
+        while True:
+            item = results.get()
+            if item is _DONE:
+                break
+            yield item  # type: ignore[misc]
+        thread.join()
+
+    async def _main(
+        self,
+        items: Iterable[Candidate],
+        process: Callable[[Candidate, Optional[FetchResult], float], T],
+        results: "queue.Queue[object]",
+    ) -> None:
+        loop = asyncio.get_running_loop()
+        slots = asyncio.Semaphore(self.concurrency)
+        with (
+            ThreadPoolExecutor(
+                max_workers=self.concurrency, thread_name_prefix="fetch"
+            ) as io_pool,
+            ThreadPoolExecutor(
+                max_workers=self.process_workers, thread_name_prefix="extract"
+            ) as cpu_pool,
+        ):
+
+            async def _one(cand: Candidate) -> None:
+                try:
+                    t0 = time.monotonic()
+                    # Fresh cache hits need neither a host token nor a slot
+                    fetch_result: Optional[FetchResult] = await loop.run_in_executor(
+                        io_pool, self.fetcher.fetch_cached, cand
+                    )
+                    if fetch_result is not None:
+                        elapsed = time.monotonic() - t0
+                        out = await loop.run_in_executor(
+                            cpu_pool, process, cand, fetch_result, elapsed
+                        )
+                        results.put(out)
+                        return
+                    host, interval = self.fetcher.pacing_for(cand.url)
+                    if host and interval > 0:
+                        gate = self._gates.setdefault(host, asyncio.Lock())
+                        bucket = self._bucket_for(host, interval)
+                        # FIFO per host: only one waiter sleeps on the bucket and
+                        # it releases the gate as soon as it holds a slot.
+                        async with gate:
+                            await bucket.acquire()
+                            await slots.acquire()
+                            bucket.touch()
+                    else:
+                        await slots.acquire()
+                    t0 = time.monotonic()
+                    self.active += 1
+                    self.max_active = max(self.max_active, self.active)
+                    try:
+                        fetch_result = await loop.run_in_executor(
+                            io_pool, self.fetcher.fetch_unpaced, cand
+                        )
+                    finally:
+                        self.active -= 1
+                        slots.release()
+                    elapsed = time.monotonic() - t0
+                    out = await loop.run_in_executor(
+                        cpu_pool, process, cand, fetch_result, elapsed
+                    )
+                    results.put(out)
+                except Exception as exc:  # noqa: BLE001
+                    logger.warning(
+                        "Async fetch task failed for url=%s error=%s",
+                        getattr(cand, "url", "<unknown>"),
+                        exc,
+                        exc_info=True,
+                    )
+                    # Still report the candidate, so the caller counts the
+                    # failure and releases whatever it holds for the URL
+                    try:
+                        results.put(process(cand, _failed_result(cand), 0.0))
+                    except Exception:  # noqa: BLE001
+                        logger.exception("Failure result not delivered")
+
+            if isinstance(items, (list, tuple)):
+                await asyncio.gather(*(_one(c) for c in items))
+                return
+            # Streaming input: a blocking iterator pulled off-loop, bounded
+            it = iter(items)
+            pending: set[asyncio.Future] = set()
+            with ThreadPoolExecutor(max_workers=1, thread_name_prefix="feed") as feed:
+                while True:
+                    cand = await loop.run_in_executor(feed, next, it, None)
+                    if cand is None:
+                        break
+                    pending.add(asyncio.ensure_future(_one(cand)))
+                    if len(pending) >= self.max_pending:
+                        _, pending = await asyncio.wait(
+                            pending, return_when=asyncio.FIRST_COMPLETED
+                        )
+            if pending:
+                await asyncio.gather(*pending)
@@ -0,0 +1,338 @@
+from __future__ import annotations
+
+import hashlib
+import json
+import logging
+import os
+import threading
+import time
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Dict, Mapping, Optional
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass(slots=True)
+class CachedResponse:
+    """Minimal response view shared by live and cached fetches.
+
+    ``from_cache`` means the body came from disk (fresh within TTL or
+    revalidated); ``not_modified`` means the server answered 304 to a
+    conditional request, i.e. the content is unchanged since it was stored.
+    """
+
+    url: str
+    status_code: int
+    body: bytes
+    content_type: Optional[str]
+    apparent_encoding: Optional[str]
+    stored_at: float
+    from_cache: bool = False
+    not_modified: bool = False
+
+    @property
+    def text(self) -> str:
+        # Same precedence as requests: header charset, then detected encoding
+        encoding: Optional[str] = None
+        if self.content_type and "charset=" in self.content_type.lower():
+            lower = self.content_type.lower()
+            encoding = lower.split("charset=")[-1].split(";")[0].strip()
+        for enc in (encoding, self.apparent_encoding, "utf-8"):
+            if not enc:
+                continue
+            try:
+                return self.body.decode(enc, errors="replace")
+            except LookupError:
+                continue
+        return self.body.decode("utf-8", errors="replace")
+
+
+class ResponseCache:
+    """On-disk HTTP response cache with conditional revalidation.
+
+    Layout under ``root``:
+    - ``meta/<ab>/<sha1(url)>.json``: status, ETag/Last-Modified, content type,
+      stored_at and the body digest
+    - ``blobs/<ab>/<sha1(body)>``: content-addressed bodies (identical pages
+      reached through different URLs are stored once)
+
+    ``get`` serves entries younger than the source's TTL straight from disk;
+    older entries are revalidated with If-None-Match/If-Modified-Since and a
+    304 refreshes ``stored_at`` and returns the cached body.
+
+    ``max_age_sec``/``max_bytes`` bound the directory (0 = no limit): ``prune``
+    runs on open and whenever stored blobs pass ``max_bytes``, dropping entries
+    older than ``max_age_sec`` and then the least recently stored ones until
+    the blobs fit in ``PRUNE_TARGET`` of the cap. A blob goes with the last
+    entry that references it.
+    """
+
+    PRUNE_TARGET = 0.8
+
+    def __init__(
+        self,
+        root: Path,
+        *,
+        default_ttl_sec: float = 0.0,
+        ttl_sec: Optional[Mapping[str, float]] = None,
+        listing_ttl_sec: float = 0.0,
+        max_age_sec: float = 0.0,
+        max_bytes: int = 0,
+    ) -> None:
+        self.root = root
+        self.meta_dir = root / "meta"
+        self.blob_dir = root / "blobs"
+        self.meta_dir.mkdir(parents=True, exist_ok=True)
+        self.blob_dir.mkdir(parents=True, exist_ok=True)
+        self.default_ttl_sec = max(0.0, float(default_ttl_sec))
+        self.ttl_sec: Dict[str, float] = {
+            str(k): max(0.0, float(v)) for k, v in (ttl_sec or {}).items()
+        }
+        self.listing_ttl_sec = max(0.0, float(listing_ttl_sec))
+        self.max_age_sec = max(0.0, float(max_age_sec))
+        self.max_bytes = max(0, int(max_bytes))
+        self.hits = 0
+        self.revalidated = 0
+        self.misses = 0
+        self.evicted = 0
+        self._lock = threading.Lock()
+        self._blob_bytes = 0
+        if self.max_age_sec or self.max_bytes:
+            self.prune()
+
+    def ttl_for(self, source: Optional[str]) -> float:
+        if source and source in self.ttl_sec:
+            return self.ttl_sec[source]
+        return self.default_ttl_sec
+
+    # ---------- storage ----------
+    def _meta_path(self, url: str) -> Path:
+        key = hashlib.sha1(url.encode("utf-8")).hexdigest()
+        return self.meta_dir / key[:2] / f"{key}.json"
+
+    def _blob_path(self, digest: str) -> Path:
+        return self.blob_dir / digest[:2] / digest
+
+    @staticmethod
+    def _write_atomic(path: Path, data: bytes) -> None:
+        path.parent.mkdir(parents=True, exist_ok=True)
+        tmp = path.with_name(f"{path.name}.{os.getpid()}.{id(data)}.tmp")
+        tmp.write_bytes(data)
+        os.replace(tmp, path)
+
+    def lookup(self, url: str) -> Optional[Dict[str, Any]]:
+        try:
+            entry = json.loads(self._meta_path(url).read_text(encoding="utf-8"))
+        except (OSError, ValueError):
+            return None
+        return entry if isinstance(entry, dict) else None
+
+    def load_body(self, entry: Mapping[str, Any]) -> Optional[bytes]:
+        digest = entry.get("body_sha1")
+        if not isinstance(digest, str):
+            return None
+        try:
+            return self._blob_path(digest).read_bytes()
+        except OSError:
+            return None
+
+    def _save_entry(self, url: str, entry: Mapping[str, Any]) -> None:
+        data = json.dumps(entry, ensure_ascii=False).encode("utf-8")
+        self._write_atomic(self._meta_path(url), data)
+
+    def store(
+        self,
+        url: str,
+        status_code: int,
+        body: bytes,
+        headers: Mapping[str, str],
+        apparent_encoding: Optional[str] = None,
+    ) -> Dict[str, Any]:
+        digest = hashlib.sha1(body).hexdigest()
+        blob = self._blob_path(digest)
+        added = 0
+        if not blob.exists():
+            self._write_atomic(blob, body)
+            added = len(body)
+        entry: Dict[str, Any] = {
+            "url": url,
+            "status_code": status_code,
+            "etag": headers.get("ETag"),
+            "last_modified": headers.get("Last-Modified"),
+            "content_type": headers.get("Content-Type"),
+            "apparent_encoding": apparent_encoding,
+            "body_sha1": digest,
+            "stored_at": time.time(),
+        }
+        self._save_entry(url, entry)
+        if added:
+            # Only after the entry exists, or prune would take the blob as orphan
+            with self._lock:
+                self._blob_bytes += added
+                over = bool(self.max_bytes) and self._blob_bytes > self.max_bytes
+            if over:
+                self.prune()
+        return entry
+
+    def prune(self) -> int:
+        """Evict expired and least recently stored entries; returns the count.
+
+        Other processes sharing the directory may race with this; a reader
+        that loses its blob sees a miss and refetches.
+        """
+        with self._lock:
+            now = time.time()
+            entries: list[tuple[float, Path, Optional[str]]] = []
+            refs: Dict[str, int] = {}
+            for meta in self.meta_dir.glob("*/*.json"):
+                try:
+                    entry = json.loads(meta.read_text(encoding="utf-8"))
+                    stored_at = float(entry.get("stored_at") or 0.0)
+                    digest = entry.get("body_sha1")
+                except (OSError, ValueError, AttributeError, TypeError):
+                    stored_at, digest = 0.0, None
+                if not isinstance(digest, str):
+                    digest = None
+                entries.append((stored_at, meta, digest))
+                if digest is not None:
+                    refs[digest] = refs.get(digest, 0) + 1
+            sizes: Dict[str, int] = {}
+            for blob in self.blob_dir.glob("*/*"):
+                try:
+                    sizes[blob.name] = blob.stat().st_size
+                except OSError:
+                    continue
+            total = sum(sizes.values())
+
+            def _drop_blob(digest: str) -> None:
+                nonlocal total
+                try:
+                    self._blob_path(digest).unlink()
+                except OSError:
+                    pass
+                total -= sizes.pop(digest, 0)
+
+            # Orphans: blobs whose entries are gone (e.g. an earlier crash)
+            for digest in [d for d in sizes if d not in refs]:
+                _drop_blob(digest)
+
+            entries.sort(key=lambda item: item[0])
+            target = int(self.max_bytes * self.PRUNE_TARGET)
+            removed = 0
+            for stored_at, meta, digest in entries:
+                expired = digest is None or (
+                    self.max_age_sec and now - stored_at > self.max_age_sec
+                )
+                if not expired and not (self.max_bytes and total > target):
+                    # Sorted by age: nothing left is expired either
+                    break
+                try:
+                    meta.unlink()
+                except OSError:
+                    pass
+                removed += 1
+                if digest is not None:
+                    refs[digest] -= 1
+                    if refs[digest] == 0:
+                        _drop_blob(digest)
+            self._blob_bytes = total
+            self.evicted += removed
+        if removed:
+            logger.info("HTTP cache pruned %d entries (%d bytes left)", removed, total)
+        return removed
+
+    # ---------- read-through ----------
+    def _from_entry(
+        self,
+        url: str,
+        entry: Mapping[str, Any],
+        body: bytes,
+        *,
+        not_modified: bool = False,
+    ) -> CachedResponse:
+        return CachedResponse(
+            url=url,
+            status_code=int(entry.get("status_code") or 200),
+            body=body,
+            content_type=entry.get("content_type"),
+            apparent_encoding=entry.get("apparent_encoding"),
+            stored_at=float(entry.get("stored_at") or 0.0),
+            from_cache=True,
+            not_modified=not_modified,
+        )
+
+    def fresh(
+        self, url: str, *, source: Optional[str] = None, ttl: Optional[float] = None
+    ) -> Optional[CachedResponse]:
+        """Return the cached response if it is younger than the TTL."""
+        ttl = self.ttl_for(source) if ttl is None else ttl
+        if ttl <= 0:
+            return None
+        entry = self.lookup(url)
+        if entry is None:
+            return None
+        if time.time() - float(entry.get("stored_at") or 0.0) >= ttl:
+            return None
+        body = self.load_body(entry)
+        if body is None:
+            return None
+        self.hits += 1
+        return self._from_entry(url, entry, body)
+
+    def get(
+        self,
+        session: Any,
+        url: str,
+        *,
+        source: Optional[str] = None,
+        ttl: Optional[float] = None,
+        headers: Optional[Mapping[str, str]] = None,
+        timeout: Optional[float] = None,
+    ) -> CachedResponse:
+        """Fetch ``url`` through the cache; network errors propagate."""
+        cached = self.fresh(url, source=source, ttl=ttl)
+        if cached is not None:
+            return cached
+        entry = self.lookup(url)
+        body = self.load_body(entry) if entry is not None else None
+        req_headers = dict(headers or {})
+        if entry is not None and body is not None:
+            if entry.get("etag"):
+                req_headers["If-None-Match"] = str(entry["etag"])
+            if entry.get("last_modified"):
+                req_headers["If-Modified-Since"] = str(entry["last_modified"])
+        response = session.get(url, headers=req_headers, timeout=timeout)
+        if response.status_code == 304 and entry is not None and body is not None:
+            self.revalidated += 1
+            refreshed = dict(entry)
+            refreshed["stored_at"] = time.time()
+            try:
+                self._save_entry(url, refreshed)
+            except OSError as exc:
+                logger.debug("Cache refresh failed for %s: %s", url, exc)
+            return self._from_entry(url, refreshed, body, not_modified=True)
+
+        self.misses += 1
+        content = response.content or b""
+        content_type = response.headers.get("Content-Type")
+        apparent: Optional[str] = None
+        if not content_type or "charset=" not in content_type.lower():
+            apparent = getattr(response, "apparent_encoding", None)
+        stored_at = time.time()
+        if 200 <= response.status_code < 300:
+            try:
+                entry = self.store(
+                    url, response.status_code, content, response.headers, apparent
+                )
+                stored_at = float(entry["stored_at"])
+            except OSError as exc:
+                logger.debug("Cache store failed for %s: %s", url, exc)
+        return CachedResponse(
+            url=url,
+            status_code=response.status_code,
+            body=content,
+            content_type=content_type,
+            apparent_encoding=apparent,
+            stored_at=stored_at,
+        )
@@ -3,7 +3,7 @@ from __future__ import annotations
 import logging
 import time
 from dataclasses import dataclass, field
-from datetime import datetime
+from datetime import datetime, timezone
 from typing import Optional
 from urllib.parse import urlparse
 from urllib.robotparser import RobotFileParser
@@ -12,7 +12,9 @@ from threading import Lock
 import requests
 import os
 
+from ..metrics import PipelineMetrics
 from ..models import Candidate, FetchResult
+from .cache import CachedResponse, ResponseCache
 
 logger = logging.getLogger(__name__)
 
@@ -81,15 +83,21 @@ class Fetcher:
         session: requests.Session,
         timeout: int,
         config: FetcherConfig | None = None,
+        cache: ResponseCache | None = None,
+        metrics: PipelineMetrics | None = None,
     ) -> None:
         self.session = session
         self.timeout = timeout
         self.config = config or FetcherConfig()
+        # Optional on-disk response cache (TTL + conditional revalidation)
+        self.cache = cache
         self.robots: RobotsCache | None = None
         if self.config.obey_robots:
             self.robots = RobotsCache(session, timeout, self.config.user_agent)
         self._host_locks: dict[str, Lock] = {}
         self._last_fetch_at: dict[str, float] = {}
+        # fetch/decode histograms, host lock wait and pacing sleep counters
+        self.metrics = metrics or PipelineMetrics()
 
     def _normalize_host(self, url: str) -> Optional[str]:
         try:
@@ -185,6 +193,36 @@ class Fetcher:
             logger.debug("Live fetch disallowed by robots: %s", candidate.url)
             return None
         headers = {"User-Agent": self.config.user_agent}
+        host = self._normalize_host(candidate.url)
+        if self.cache is not None:
+            t0 = time.monotonic()
+            try:
+                cached = self.cache.get(
+                    self.session,
+                    candidate.url,
+                    source=candidate.source,
+                    headers=headers,
+                    timeout=self.timeout,
+                )
+            except Exception as exc:  # noqa: BLE001
+                logger.debug("Live fetch failed: %s", exc)
+                return None
+            finally:
+                self.metrics.observe(
+                    "fetch",
+                    time.monotonic() - t0,
+                    source=candidate.source,
+                    host=host,
+                )
+            if cached.status_code >= 400:
+                logger.debug(
+                    "Live fetch failed: status=%s url=%s",
+                    cached.status_code,
+                    candidate.url,
+                )
+                return None
+            return self._result_from_cached(candidate, cached)
+        t0 = time.monotonic()
         try:
             response = self.session.get(
                 candidate.url, headers=headers, timeout=self.timeout
@@ -193,11 +231,19 @@ class Fetcher:
         except Exception as exc:  # noqa: BLE001
             logger.debug("Live fetch failed: %s", exc)
             return None
+        finally:
+            self.metrics.observe(
+                "fetch", time.monotonic() - t0, source=candidate.source, host=host
+            )
+        t1 = time.monotonic()
         html, encoding = self._decode_bytes(
             response.content,
             response.headers.get("Content-Type"),
             getattr(response, "apparent_encoding", None),
         )
+        self.metrics.observe(
+            "decode", time.monotonic() - t1, source=candidate.source, host=host
+        )
         return FetchResult(
             url=candidate.url,
             fetched_from="live",
@@ -208,21 +254,85 @@ class Fetcher:
             fetched_at=datetime.utcnow(),
         )
 
+    def _result_from_cached(
+        self, candidate: Candidate, cached: CachedResponse
+    ) -> FetchResult:
+        t0 = time.monotonic()
+        html, encoding = self._decode_bytes(
+            cached.body, cached.content_type, cached.apparent_encoding
+        )
+        self.metrics.observe(
+            "decode",
+            time.monotonic() - t0,
+            source=candidate.source,
+            host=self._normalize_host(candidate.url),
+        )
+        fetched_at = datetime.utcnow()
+        if cached.from_cache:
+            # Keep the time the content was actually retrieved
+            fetched_at = datetime.fromtimestamp(cached.stored_at, timezone.utc)
+            fetched_at = fetched_at.replace(tzinfo=None)
+        return FetchResult(
+            url=candidate.url,
+            fetched_from="cache" if cached.from_cache else "live",
+            status_code=cached.status_code,
+            html=html,
+            snapshot_url=candidate.url,
+            encoding=encoding,
+            fetched_at=fetched_at,
+            not_modified=cached.not_modified,
+        )
+
+    def fetch_cached(self, candidate: Candidate) -> Optional[FetchResult]:
+        """Return a fresh (within TTL) cached result without touching the network."""
+        if self.cache is None:
+            return None
+        try:
+            cached = self.cache.fresh(candidate.url, source=candidate.source)
+        except Exception:  # noqa: BLE001
+            return None
+        if cached is None:
+            return None
+        return self._result_from_cached(candidate, cached)
+
+    def pacing_for(self, url: str) -> tuple[Optional[str], float]:
+        """Return (normalized host, minimum seconds between requests to it)."""
+        host = self._normalize_host(url)
+        host_pause = self._host_pause(host) or 0.0
+        return host, max(self.config.pause_seconds, host_pause)
+
+    def fetch_unpaced(self, candidate: Candidate) -> Optional[FetchResult]:
+        # For schedulers that apply per-host pacing themselves (async engine)
+        return self._fetch_live(candidate)
+
     def fetch(self, candidate: Candidate) -> Optional[FetchResult]:
-        # Only live fetch (snapshots/CC removed)
-        host = self._normalize_host(candidate.url)
+        # Only live fetch (snapshots/CC removed), optionally through the cache
+        cached = self.fetch_cached(candidate)
+        if cached is not None:
+            return cached
+        host, pause = self.pacing_for(candidate.url)
         host_pause = self._host_pause(host) or 0.0
-        pause = max(self.config.pause_seconds, host_pause)
 
+        source = candidate.source
         if host_pause > 0 and host:
             lock = self._host_locks.setdefault(host, Lock())
+            t0 = time.monotonic()
             with lock:
+                self.metrics.inc(
+                    "host_lock_wait_sec",
+                    time.monotonic() - t0,
+                    source=source,
+                    host=host,
+                )
                 last = self._last_fetch_at.get(host, 0.0)
                 if last > 0:
                     elapsed = time.monotonic() - last
                     wait = pause - elapsed
                     if wait > 0:
                         time.sleep(wait)
+                        self.metrics.inc(
+                            "pace_sleep_sec", wait, source=source, host=host
+                        )
                 result = self._fetch_live(candidate)
                 self._last_fetch_at[host] = time.monotonic()
                 return result
@@ -230,4 +340,5 @@ class Fetcher:
         result = self._fetch_live(candidate)
         if result and pause > 0:
             time.sleep(pause)
+            self.metrics.inc("pace_sleep_sec", pause, source=source, host=host)
         return result
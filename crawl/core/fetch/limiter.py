@@ -0,0 +1,130 @@
+from __future__ import annotations
+
+import random
+import threading
+import time
+from contextlib import contextmanager
+from typing import Iterator, Optional
+
+
+class _Slot:
+    def __init__(self, limiter: "AimdLimiter", waited: float) -> None:
+        self._limiter = limiter
+        # Seconds acquire() blocked (pause, spacing or concurrency)
+        self.waited = waited
+
+    def ok(self) -> None:
+        self._limiter.on_success()
+
+    def rate_limited(self, retry_after: Optional[float] = None) -> float:
+        return self._limiter.on_rate_limit(retry_after)
+
+
+class AimdLimiter:
+    """Concurrency limit and request spacing shared by all workers of one API.
+
+    Additive increase / multiplicative decrease on two knobs:
+
+    - success: the in-flight limit grows by ``1/limit`` (about +1 per window of
+      successes) and the spacing between request starts shrinks by
+      ``interval_step`` down to ``min_interval``;
+    - 429: the limit halves, the spacing doubles (up to ``max_interval``) and
+      every worker pauses for Retry-After, or an exponential backoff when the
+      server gives none.
+
+    Decreases are applied at most once per ``cooldown`` seconds so the answers
+    of requests already in flight do not collapse the limit in one burst.
+    """
+
+    def __init__(
+        self,
+        max_concurrency: int,
+        *,
+        initial: Optional[int] = None,
+        interval: float = 0.0,
+        min_interval: float = 0.0,
+        max_interval: float = 60.0,
+        interval_step: float = 0.1,
+        cooldown: float = 2.0,
+        base_backoff: float = 5.0,
+        max_backoff: float = 120.0,
+    ) -> None:
+        self.max_limit = max(1, int(max_concurrency))
+        start = initial if initial is not None else self.max_limit
+        self._limit = float(max(1, min(start, self.max_limit)))
+        self.min_interval = max(0.0, float(min_interval))
+        self.max_interval = max(self.min_interval, float(max_interval))
+        self.interval = min(self.max_interval, max(self.min_interval, interval))
+        self.interval_step = max(0.0, float(interval_step))
+        self.cooldown = max(0.0, float(cooldown))
+        self.base_backoff = max(0.0, float(base_backoff))
+        self.max_backoff = max(self.base_backoff, float(max_backoff))
+
+        self.in_flight = 0
+        self.rate_limited = 0
+        self._strikes = 0  # consecutive 429s (backoff exponent)
+        self._paused_until = 0.0
+        self._next_start = 0.0
+        self._last_decrease = float("-inf")
+        self._cond = threading.Condition()
+
+    @property
+    def limit(self) -> int:
+        return int(self._limit)
+
+    def acquire(self) -> float:
+        """Block until a request may start; returns the seconds waited."""
+        t0 = time.monotonic()
+        with self._cond:
+            while True:
+                now = time.monotonic()
+                ready_at = max(self._paused_until, self._next_start)
+                if now >= ready_at and self.in_flight < self.limit:
+                    self.in_flight += 1
+                    self._next_start = now + self.interval
+                    return now - t0
+                wait = ready_at - now
+                self._cond.wait(timeout=wait if wait > 0 else None)
+
+    def release(self) -> None:
+        with self._cond:
+            self.in_flight -= 1
+            self._cond.notify_all()
+
+    @contextmanager
+    def slot(self) -> Iterator[_Slot]:
+        waited = self.acquire()
+        try:
+            yield _Slot(self, waited)
+        finally:
+            self.release()
+
+    def on_success(self) -> None:
+        with self._cond:
+            self._strikes = 0
+            if self._limit < self.max_limit:
+                self._limit = min(
+                    float(self.max_limit), self._limit + 1.0 / self._limit
+                )
+            self.interval = max(self.min_interval, self.interval - self.interval_step)
+            self._cond.notify_all()
+
+    def on_rate_limit(self, retry_after: Optional[float] = None) -> float:
+        """Back off after a 429; returns the pause applied to all workers."""
+        with self._cond:
+            now = time.monotonic()
+            self.rate_limited += 1
+            self._strikes += 1
+            if now - self._last_decrease >= self.cooldown:
+                self._limit = max(1.0, self._limit * 0.5)
+                self.interval = min(
+                    self.max_interval,
+                    max(self.interval * 2, self.min_interval, self.interval_step),
+                )
+                self._last_decrease = now
+            if retry_after is None:
+                backoff = self.base_backoff * 2 ** (self._strikes - 1)
+                retry_after = min(self.max_backoff, backoff) * random.uniform(0.5, 1.0)
+            self._paused_until = max(self._paused_until, now + max(0.0, retry_after))
+            self._cond.notify_all()
+            return retry_after
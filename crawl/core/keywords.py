@@ -0,0 +1,117 @@
+from __future__ import annotations
+
+import re
+import unicodedata
+from typing import Dict, Iterable, Iterator, List
+
+_WS_RE = re.compile(r"\s+")
+
+
+def fold_text(text: str) -> str:
+    """Matching form of a keyword: NFKC, case-folded, whitespace removed.
+
+    Dropping whitespace makes "국민 연금" and "국 민 연 금" the same key as
+    "국민연금"; NFKC folds full-width Latin ("ＮＰＳ") onto ASCII. Documents are
+    not folded this way (see ``KeywordMatcher``).
+    """
+    if not text:
+        return ""
+    return _WS_RE.sub("", unicodedata.normalize("NFKC", text)).casefold()
+
+
+def _fold_document(text: str) -> str:
+    # Whitespace is kept so the matcher can tell word boundaries
+    return unicodedata.normalize("NFKC", text).casefold()
+
+
+def _spaced(key: str) -> str:
+    return r"\s*".join(re.escape(ch) for ch in key)
+
+
+class KeywordMatcher:
+    """Compiled multi-keyword matcher that reports every hit in one pass.
+
+    Keywords are folded (``fold_text``) and compiled with optional whitespace
+    between their characters into a single lookahead alternation (longest
+    first), so the regex engine visits each text position once and yields the
+    longest keyword starting there; keywords that are prefixes of that match
+    start at the same position and are credited from a table built up front.
+    This counts overlapping occurrences exactly, e.g. "국민연금공단" hits
+    국민연금공단, 국민연금 and 연금.
+
+    A hit that spans whitespace ("국 민 연금") must start a word, so the gap
+    between two words cannot fake one: "공연 금지" is not 연금 and
+    "plan pseudo" is not NPS. Keywords whose folded forms coincide (spacing or
+    case variants) are one keyword: only the first configured one is
+    credited, so a single occurrence counts once.
+    """
+
+    def __init__(self, keywords: Iterable[str]) -> None:
+        self.keywords = [kw for kw in keywords if kw and kw.strip()]
+        # First configured keyword per folded key; later variants are aliases
+        self._credited: Dict[str, str] = {}
+        for kw in self.keywords:
+            key = fold_text(kw)
+            if key:
+                self._credited.setdefault(key, kw)
+        patterns = sorted(self._credited, key=len, reverse=True)
+        # Every folded keyword that starts a longer one (itself included)
+        self._prefixes: Dict[str, List[str]] = {
+            p: [q for q in patterns if p.startswith(q)] for p in patterns
+        }
+        # One capture group per keyword: lastindex tells which one matched
+        alternation = "|".join(f"({_spaced(p)})" for p in patterns)
+        self._regex = re.compile(f"(?=(?:{alternation}))") if patterns else None
+        self._patterns = patterns
+
+    def __len__(self) -> int:
+        # Distinct keywords after folding, the denominator for coverage
+        return len(self._credited)
+
+    def _iter_hits(self, text: str) -> Iterator[str]:
+        """Folded keys of every accepted hit, in text order."""
+        if self._regex is None or not text:
+            return
+        folded = _fold_document(text)
+        for match in self._regex.finditer(folded):
+            group = match.lastindex or 0
+            start = match.start(group)
+            at_word_start = start == 0 or not folded[start - 1].isalnum()
+            span = match.group(group)
+            longest = self._patterns[group - 1]
+            for key in self._prefixes[longest]:
+                if at_word_start or not _spans_space(span, len(key)):
+                    yield key
+
+    def counts(self, text: str) -> Dict[str, int]:
+        """Occurrences per keyword (first configured variant); no-hit omitted."""
+        folded: Dict[str, int] = {}
+        for key in self._iter_hits(text):
+            folded[key] = folded.get(key, 0) + 1
+        result: Dict[str, int] = {}
+        # _credited is in configuration order
+        for key, kw in self._credited.items():
+            n = folded.get(key, 0)
+            if n:
+                result[kw] = n
+        return result
+
+    def hits(self, text: str) -> List[str]:
+        """Keywords present in ``text``, in configuration order."""
+        return list(self.counts(text))
+
+    def matches(self, text: str) -> bool:
+        """True as soon as any keyword occurs; stops at the first hit."""
+        return next(self._iter_hits(text), None) is not None
+
+
+def _spans_space(span: str, length: int) -> bool:
+    """Whether the first ``length`` non-space characters of ``span`` contain a gap."""
+    seen = 0
+    for ch in span:
+        if ch.isspace():
+            return True
+        seen += 1
+        if seen == length:
+            return False
+    return False
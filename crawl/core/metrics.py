@@ -0,0 +1,424 @@
+from __future__ import annotations
+
+import bisect
+import json
+import logging
+import os
+import threading
+import time
+from contextlib import contextmanager
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from pathlib import Path
+from urllib.parse import urlparse
+from typing import (
+    TYPE_CHECKING,
+    Dict,
+    Iterator,
+    List,
+    Mapping,
+    Optional,
+    Sequence,
+    Tuple,
+)
+
+if TYPE_CHECKING:
+    from .config import MetricsConfig
+
+logger = logging.getLogger(__name__)
+
+# Upper bounds (seconds) of the latency buckets; +Inf is implicit
+LATENCY_BUCKETS: Tuple[float, ...] = (
+    0.001,
+    0.005,
+    0.01,
+    0.025,
+    0.05,
+    0.1,
+    0.25,
+    0.5,
+    1.0,
+    2.5,
+    5.0,
+    10.0,
+    30.0,
+    60.0,
+)
+
+# Stages recorded by the pipeline and its components
+STAGES = (
+    "discover_page",
+    "fetch",
+    "decode",
+    "extract",
+    "trafilatura",
+    "comment_fetch",
+    "quality",
+    "store",
+)
+
+OTHER_HOST = "other"
+
+_LabelKey = Tuple[str, str, str]  # (name, source, host)
+
+
+def url_host(url: str) -> Optional[str]:
+    """Host label for ``url``: lower-cased, without port or leading ``www.``."""
+    try:
+        host = (urlparse(url).hostname or "").lower()
+    except ValueError:
+        return None
+    return (host[4:] if host.startswith("www.") else host) or None
+
+
+class Histogram:
+    """Fixed-bucket latency histogram (cumulative on export, like Prometheus)."""
+
+    __slots__ = ("bounds", "counts", "count", "sum", "max")
+
+    def __init__(self, bounds: Sequence[float] = LATENCY_BUCKETS) -> None:
+        self.bounds = tuple(bounds)
+        self.counts = [0] * (len(self.bounds) + 1)
+        self.count = 0
+        self.sum = 0.0
+        self.max = 0.0
+
+    def observe(self, value: float) -> None:
+        value = max(0.0, float(value))
+        self.counts[bisect.bisect_left(self.bounds, value)] += 1
+        self.count += 1
+        self.sum += value
+        if value > self.max:
+            self.max = value
+
+    def merge(self, other: "Histogram") -> None:
+        for i, c in enumerate(other.counts):
+            self.counts[i] += c
+        self.count += other.count
+        self.sum += other.sum
+        self.max = max(self.max, other.max)
+
+    def quantile(self, q: float) -> float:
+        """Estimate by linear interpolation inside the bucket holding rank q."""
+        if self.count == 0:
+            return 0.0
+        rank = q * self.count
+        seen = 0
+        for i, c in enumerate(self.counts):
+            if c and seen + c >= rank:
+                lo = self.bounds[i - 1] if i > 0 else 0.0
+                hi = self.bounds[i] if i < len(self.bounds) else self.max
+                hi = min(hi, self.max)
+                return lo + (hi - lo) * max(0.0, rank - seen) / c
+            seen += c
+        return self.max
+
+    def as_dict(self) -> Dict[str, object]:
+        return {
+            "count": self.count,
+            "sum": round(self.sum, 6),
+            "max": round(self.max, 6),
+            "p50": round(self.quantile(0.5), 6),
+            "p90": round(self.quantile(0.9), 6),
+            "p99": round(self.quantile(0.99), 6),
+            "buckets": dict(
+                zip([*map(str, self.bounds), "+Inf"], self.counts, strict=True)
+            ),
+        }
+
+
+class PipelineMetrics:
+    """Thread-safe latency histograms and counters tagged by source and host.
+
+    ``observe`` records one duration for a stage (see ``STAGES``); ``inc`` adds
+    to a counter such as seconds spent waiting on a host lock. Once
+    ``max_hosts`` distinct hosts have been seen, further hosts are folded into
+    ``"other"`` so a broad GDELT run cannot grow the label set without bound.
+    Components take an optional instance and create a private one otherwise,
+    so recording never needs a ``None`` check.
+    """
+
+    def __init__(
+        self,
+        *,
+        buckets: Sequence[float] = LATENCY_BUCKETS,
+        max_hosts: int = 200,
+    ) -> None:
+        self.buckets = tuple(buckets)
+        self.max_hosts = max(1, int(max_hosts))
+        self.started_at = time.time()
+        self._lock = threading.Lock()
+        self._histograms: Dict[_LabelKey, Histogram] = {}
+        self._counters: Dict[_LabelKey, float] = {}
+        self._hosts: set[str] = set()
+
+    def _host_label(self, host: Optional[str]) -> str:
+        if not host:
+            return ""
+        if host in self._hosts:
+            return host
+        if len(self._hosts) >= self.max_hosts:
+            return OTHER_HOST
+        self._hosts.add(host)
+        return host
+
+    def observe(
+        self,
+        stage: str,
+        seconds: float,
+        *,
+        source: Optional[str] = None,
+        host: Optional[str] = None,
+    ) -> None:
+        with self._lock:
+            key = (stage, source or "", self._host_label(host))
+            hist = self._histograms.get(key)
+            if hist is None:
+                hist = self._histograms[key] = Histogram(self.buckets)
+            hist.observe(seconds)
+
+    def observe_spans(
+        self,
+        spans: Mapping[str, float],
+        *,
+        source: Optional[str] = None,
+        host: Optional[str] = None,
+    ) -> None:
+        for stage, seconds in spans.items():
+            self.observe(stage, seconds, source=source, host=host)
+
+    def inc(
+        self,
+        name: str,
+        value: float = 1.0,
+        *,
+        source: Optional[str] = None,
+        host: Optional[str] = None,
+    ) -> None:
+        if not value:
+            return
+        with self._lock:
+            key = (name, source or "", self._host_label(host))
+            self._counters[key] = self._counters.get(key, 0.0) + value
+
+    @contextmanager
+    def time(
+        self,
+        stage: str,
+        *,
+        source: Optional[str] = None,
+        host: Optional[str] = None,
+    ) -> Iterator[None]:
+        t0 = time.monotonic()
+        try:
+            yield
+        finally:
+            self.observe(stage, time.monotonic() - t0, source=source, host=host)
+
+    # ----- reading -----
+
+    def stage_histogram(self, stage: str, source: Optional[str] = None) -> Histogram:
+        """One stage merged over hosts (and over sources unless given)."""
+        merged = Histogram(self.buckets)
+        with self._lock:
+            for (name, src, _host), hist in self._histograms.items():
+                if name == stage and (source is None or src == source):
+                    merged.merge(hist)
+        return merged
+
+    def counter(self, name: str, source: Optional[str] = None) -> float:
+        with self._lock:
+            return sum(
+                v
+                for (n, src, _host), v in self._counters.items()
+                if n == name and (source is None or src == source)
+            )
+
+    def summary(self) -> Dict[str, float]:
+        """Flat per-stage p50/p99 and counter totals (for PipelineStats)."""
+        with self._lock:
+            stages = sorted({k[0] for k in self._histograms})
+            counters = sorted({k[0] for k in self._counters})
+        out: Dict[str, float] = {}
+        for stage in stages:
+            hist = self.stage_histogram(stage)
+            out[f"{stage}_p50_sec"] = round(hist.quantile(0.5), 4)
+            out[f"{stage}_p99_sec"] = round(hist.quantile(0.99), 4)
+        for name in counters:
+            out[name] = round(self.counter(name), 3)
+        return out
+
+    def snapshot(self) -> Dict[str, object]:
+        with self._lock:
+            histograms: List[Dict[str, object]] = [
+                {"stage": k[0], "source": k[1], "host": k[2], **h.as_dict()}
+                for k, h in sorted(self._histograms.items())
+            ]
+            counters: List[Dict[str, object]] = [
+                {"name": k[0], "source": k[1], "host": k[2], "value": round(v, 6)}
+                for k, v in sorted(self._counters.items())
+            ]
+        return {
+            "started_at": self.started_at,
+            "generated_at": time.time(),
+            "histograms": histograms,
+            "counters": counters,
+        }
+
+    def to_prometheus(self, prefix: str = "crawler") -> str:
+        """Prometheus text exposition format (version 0.0.4)."""
+        lines: List[str] = []
+        with self._lock:
+            hist_items = sorted(self._histograms.items())
+            counter_items = sorted(self._counters.items())
+
+        if hist_items:
+            name = f"{prefix}_stage_seconds"
+            lines.append(f"# HELP {name} Latency of pipeline stages.")
+            lines.append(f"# TYPE {name} histogram")
+            for (stage, source, host), hist in hist_items:
+                labels = _labels(stage=stage, source=source, host=host)
+                cumulative = 0
+                for bound, count in zip(
+                    [*map(repr, hist.bounds), "+Inf"], hist.counts, strict=True
+                ):
+                    cumulative += count
+                    lines.append(
+                        f'{name}_bucket{{{labels},le="{bound}"}} {cumulative}'
+                    )
+                lines.append(f"{name}_sum{{{labels}}} {hist.sum:.6f}")
+                lines.append(f"{name}_count{{{labels}}} {hist.count}")
+
+        seen: set[str] = set()
+        for (counter, source, host), value in counter_items:
+            name = f"{prefix}_{counter}_total"
+            if name not in seen:
+                seen.add(name)
+                lines.append(f"# TYPE {name} counter")
+            lines.append(f"{name}{{{_labels(source=source, host=host)}}} {value:.6f}")
+        return "\n".join(lines) + "\n"
+
+
+def _escape(value: str) -> str:
+    return value.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
+
+
+def _labels(**labels: str) -> str:
+    return ",".join(f'{k}="{_escape(v)}"' for k, v in labels.items())
+
+
+# ----- exporters -----
+
+
+class MetricsServer:
+    """Serve ``/metrics`` (Prometheus text) and ``/metrics.json`` on a thread."""
+
+    def __init__(
+        self, metrics: PipelineMetrics, port: int, host: str = "127.0.0.1"
+    ) -> None:
+        self.metrics = metrics
+
+        registry = metrics
+
+        class _Handler(BaseHTTPRequestHandler):
+            def do_GET(self) -> None:  # noqa: N802
+                if self.path.rstrip("/") == "/metrics":
+                    body = registry.to_prometheus().encode("utf-8")
+                    ctype = "text/plain; version=0.0.4; charset=utf-8"
+                elif self.path.rstrip("/") == "/metrics.json":
+                    body = json.dumps(registry.snapshot()).encode("utf-8")
+                    ctype = "application/json"
+                else:
+                    self.send_error(404)
+                    return
+                self.send_response(200)
+                self.send_header("Content-Type", ctype)
+                self.send_header("Content-Length", str(len(body)))
+                self.end_headers()
+                self.wfile.write(body)
+
+            def log_message(self, format: str, *args: object) -> None:
+                logger.debug("metrics endpoint: " + format, *args)
+
+        self._server = ThreadingHTTPServer((host, int(port)), _Handler)
+        self._server.daemon_threads = True
+        self.port = self._server.server_address[1]
+        self._thread = threading.Thread(
+            target=self._server.serve_forever, name="metrics-http", daemon=True
+        )
+
+    def start(self) -> "MetricsServer":
+        self._thread.start()
+        host, port = self._server.server_address[:2]
+        logger.info("Metrics endpoint on http://%s:%d/metrics", host, port)
+        return self
+
+    def close(self) -> None:
+        self._server.shutdown()
+        self._server.server_close()
+        self._thread.join(timeout=5)
+
+
+class JsonSnapshotWriter:
+    """Rewrite ``path`` with ``PipelineMetrics.snapshot()`` every interval."""
+
+    def __init__(
+        self, metrics: PipelineMetrics, path: Path, interval_sec: float = 30.0
+    ) -> None:
+        self.metrics = metrics
+        self.path = Path(path)
+        self.interval_sec = max(0.1, float(interval_sec))
+        self._stop = threading.Event()
+        self._thread = threading.Thread(
+            target=self._loop, name="metrics-json", daemon=True
+        )
+
+    def start(self) -> "JsonSnapshotWriter":
+        self._thread.start()
+        return self
+
+    def write(self) -> None:
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        tmp = self.path.with_name(self.path.name + ".tmp")
+        tmp.write_text(
+            json.dumps(self.metrics.snapshot(), ensure_ascii=False), encoding="utf-8"
+        )
+        os.replace(tmp, self.path)
+
+    def _loop(self) -> None:
+        while not self._stop.wait(self.interval_sec):
+            try:
+                self.write()
+            except OSError as exc:
+                logger.warning("Metrics snapshot write failed: %s", exc)
+
+    def close(self) -> None:
+        self._stop.set()
+        self._thread.join(timeout=5)
+        try:
+            self.write()
+        except OSError as exc:
+            logger.warning("Metrics snapshot write failed: %s", exc)
+
+
+class MetricsExporters:
+    """The exporters enabled in ``MetricsConfig``, started and stopped together."""
+
+    def __init__(self, metrics: PipelineMetrics, config: "MetricsConfig") -> None:
+        self.server: Optional[MetricsServer] = None
+        self.snapshots: Optional[JsonSnapshotWriter] = None
+        if config.prometheus_port is not None:
+            self.server = MetricsServer(
+                metrics, config.prometheus_port, config.prometheus_host
+            ).start()
+        if config.json_path is not None:
+            self.snapshots = JsonSnapshotWriter(
+                metrics, config.json_path, config.json_interval_sec
+            ).start()
+
+    def close(self) -> None:
+        if self.server is not None:
+            self.server.close()
+            self.server = None
+        if self.snapshots is not None:
+            self.snapshots.close()
+            self.snapshots = None
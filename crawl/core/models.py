@@ -2,7 +2,7 @@ from __future__ import annotations
 
 from dataclasses import dataclass, field
 from datetime import datetime
-from typing import Any, Dict, List, Optional
+from typing import Any, Callable, Dict, List, Optional
 
 
 @dataclass(slots=True)
@@ -16,6 +16,10 @@ class Candidate:
     extra: Dict[str, Any] = field(default_factory=dict)
 
 
+# Receives candidate batches as discoverers produce them (streaming mode)
+CandidateSink = Callable[[List[Candidate]], None]
+
+
 @dataclass(slots=True)
 class FetchResult:
     url: str
@@ -25,6 +29,8 @@ class FetchResult:
     snapshot_url: Optional[str]
     encoding: Optional[str]
     fetched_at: datetime
+    # Server answered 304 to a conditional request (content unchanged)
+    not_modified: bool = False
 
 
 @dataclass(slots=True)
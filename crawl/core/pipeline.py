@@ -2,10 +2,29 @@ from __future__ import annotations
 
 import logging
 import os
-from dataclasses import dataclass
-from typing import Callable, Dict, Iterable, List, Mapping, Optional, Tuple, cast
+from collections import deque
+from dataclasses import dataclass, field
+from typing import (
+    Callable,
+    Deque,
+    Dict,
+    Iterable,
+    Iterator,
+    List,
+    Mapping,
+    Optional,
+    Tuple,
+    cast,
+)
 from datetime import datetime
-from concurrent.futures import ThreadPoolExecutor, as_completed
+from concurrent.futures import (
+    FIRST_COMPLETED,
+    Future,
+    ThreadPoolExecutor,
+    as_completed,
+    wait,
+)
+import threading
 import time
 from urllib.parse import urlparse
 
@@ -15,15 +34,24 @@ from requests.adapters import HTTPAdapter
 from tqdm import tqdm
 from urllib3.util.retry import Retry
 
-from .config import CrawlerConfig, load_config
+from .config import CrawlerConfig, MetricsConfig, load_config
 from .discovery.gdelt import GdeltConfig, GdeltDiscoverer
+from .discovery.gdelt_cache import GdeltWindowCache
 from .discovery.youtube import YouTubeDiscoverer
 from .discovery.forums import ForumsDiscoverer
 from .extract.extractor import Extractor
+from .extract.pool import ExtractStage
+from .extract.sessions import CommentSessionPool
+from .fetch.async_engine import AsyncFetchEngine
+from .fetch.cache import ResponseCache
 from .fetch.fetcher import Fetcher, FetcherConfig
-from .models import Candidate, Document, FetchResult
+from .metrics import MetricsExporters, PipelineMetrics, url_host
+from .models import Candidate, CandidateSink, Document, FetchResult
+from .prefilter import TitlePrefilter
+from .scheduling import DEFAULT_SOURCE_PRIORITY, CandidateQueue, CandidateScheduler
+from .storage.archive import RawHtmlArchive
 from .storage.index import DocumentIndex
-from .storage.writer import MultiSourceJsonlWriter
+from .storage.writer import BufferedJsonlWriter, MultiSourceJsonlWriter
 from .utils import normalize_url
 
 load_dotenv()
@@ -42,6 +70,10 @@ class PipelineStats:
     index_duplicates: int
     extraction_failed: int
     timings_sec: Dict[str, float]
+    # Conditional fetches answered 304 (extracted from the cached body)
+    not_modified: int = 0
+    # Queue depths / parallelism per stage (fetch, extract, candidate queue)
+    stage_metrics: Dict[str, float] = field(default_factory=dict)
 
 
 class UnifiedPipeline:
@@ -58,8 +90,17 @@ class UnifiedPipeline:
         ] = None,
         forums_until_date: Optional[datetime] = None,
         forums_board_cursors: Optional[Mapping[str, int]] = None,
+        metrics: Optional[PipelineMetrics] = None,
     ) -> None:
         self.config = config
+        # Stage histograms/counters (crawl.core.metrics). A registry passed in
+        # (autocrawl: one per process) is exported by its owner; otherwise this
+        # run exports its own as configured under ``metrics:``.
+        self.metrics_config = getattr(config, "metrics", None) or MetricsConfig()
+        self._owns_metrics = metrics is None
+        self.metrics = metrics or PipelineMetrics(
+            max_hosts=self.metrics_config.max_hosts
+        )
         # Optional limiter to run only selected sources
         # Accepted values: {"gdelt", "youtube", "forums"}
         self.include_sources = include_sources
@@ -78,6 +119,18 @@ class UnifiedPipeline:
             respect_retry_after_header=True,
         )
         self.fetch_concurrency = max(1, int(config.limits.fetch_concurrency))
+        self.fetch_mode = getattr(config.limits, "fetch_mode", "threads")
+        # Overlap discovery with fetching through a bounded candidate queue
+        self.stream_discovery = bool(getattr(config.limits, "stream_discovery", False))
+        self.candidate_queue_size = int(
+            getattr(config.limits, "candidate_queue_size", 1000)
+        )
+        self.candidate_order = getattr(config.limits, "candidate_order", "priority")
+        # Optional process-pool extraction stage (see crawl.core.extract.pool)
+        self.extract_processes = int(getattr(config.limits, "extract_processes", 0))
+        self.extract_queue_size = int(getattr(config.limits, "extract_queue_size", 0))
+        self.source_weights = dict(getattr(config.limits, "source_weights", {}) or {})
+        self._discovery_sink: Optional[CandidateSink] = None
         pool_size = max(10, self.fetch_concurrency * 2)
         adapter = HTTPAdapter(
             max_retries=retry,
@@ -86,6 +139,17 @@ class UnifiedPipeline:
         )
         self.session.mount("https://", adapter)
         self.session.mount("http://", adapter)
+        self.http_cache: Optional[ResponseCache] = None
+        cache_cfg = getattr(config, "http_cache", None)
+        if cache_cfg is not None and cache_cfg.enabled:
+            self.http_cache = ResponseCache(
+                cache_cfg.root or (config.output.root / "_http_cache"),
+                default_ttl_sec=cache_cfg.default_ttl_sec,
+                ttl_sec=cache_cfg.ttl_sec,
+                listing_ttl_sec=cache_cfg.listing_ttl_sec,
+                max_age_sec=cache_cfg.max_age_sec,
+                max_bytes=cache_cfg.max_mb * 1024 * 1024,
+            )
         self.fetcher = Fetcher(
             self.session,
             timeout=config.limits.request_timeout_sec,
@@ -94,6 +158,8 @@ class UnifiedPipeline:
                 obey_robots=config.limits.obey_robots,
                 per_host_pause_sec=getattr(config.limits, "per_host_pause_sec", {}),
             ),
+            cache=self.http_cache,
+            metrics=self.metrics,
         )
         self.session.headers.update({"User-Agent": self.fetcher.config.user_agent})
         self.extractor = Extractor(
@@ -101,9 +167,51 @@ class UnifiedPipeline:
             config.lang,
             config.quality,
         )
-        # Write to per-source JSONL files
-        self.storage = MultiSourceJsonlWriter(config.output.root)
-        self.index = DocumentIndex(self.storage.output_dir)
+        # Comment APIs reuse the page fetch's connections and cookies
+        self.extractor.comment_sessions = CommentSessionPool(
+            adapter=adapter,
+            cookies=self.session.cookies,
+            per_host_pause_sec=getattr(config.limits, "comment_pause_sec", {}),
+            metrics=self.metrics,
+        )
+        # Title relevance check before fetching forum threads
+        self.prefilter: Optional[TitlePrefilter] = None
+        prefilter_cfg = getattr(config, "prefilter", None)
+        if prefilter_cfg is not None and prefilter_cfg.enabled:
+            self.prefilter = TitlePrefilter(config.keywords, prefilter_cfg)
+        # Write to per-source JSONL files. Documents enter the index only once
+        # the writer reports them on disk (_commit_written); until then the
+        # pending sets keep in-run duplicates out.
+        out = config.output
+        self._written: Deque[Document] = deque()
+        self._pending_ids: set[str] = set()
+        self._pending_urls: set[str] = set()
+        self.storage: MultiSourceJsonlWriter
+        if getattr(out, "writer", "sync") == "buffered":
+            self.storage = BufferedJsonlWriter(
+                out.root,
+                batch_size=out.writer_batch_size,
+                flush_interval_sec=out.writer_flush_interval_sec,
+                queue_size=out.writer_queue_size,
+                compression=out.compression,
+                on_written=self._written.extend,
+            )
+        else:
+            self.storage = MultiSourceJsonlWriter(
+                out.root, on_written=self._written.extend
+            )
+        self.index = DocumentIndex(
+            self.storage.output_dir,
+            bloom_capacity=getattr(config.output, "index_bloom_capacity", None),
+            bloom_error_rate=getattr(config.output, "index_bloom_error_rate", 0.001),
+        )
+        # Compressed raw HTML of every fetched page (see crawl.core.reextract)
+        self.raw_archive: Optional[RawHtmlArchive] = None
+        if getattr(out, "raw_archive", False):
+            segment_mb = int(getattr(out, "raw_archive_segment_mb", 256))
+            self.raw_archive = RawHtmlArchive(
+                out.root / "_raw", segment_max_bytes=segment_mb * 1024 * 1024
+            )
         # Optional per-source keyword filter (e.g., limit YouTube keywords to save quota)
         self._source_keyword_filter = source_keyword_filter
         self._forums_time_window = forums_time_window
@@ -140,6 +248,16 @@ class UnifiedPipeline:
             return False
         return True
 
+    def _gdelt_cache(self) -> Optional[GdeltWindowCache]:
+        gdelt_cfg = self.config.gdelt
+        if not getattr(gdelt_cfg, "cache_enabled", False):
+            return None
+        return GdeltWindowCache(
+            self.config.output.root / "_gdelt_cache",
+            live_ttl_sec=gdelt_cfg.cache_live_ttl_sec,
+            settle_sec=gdelt_cfg.cache_settle_sec,
+        )
+
     def discover(self) -> Dict[str, List[Candidate]]:
         discoveries: Dict[str, List[Candidate]] = {}
 
@@ -148,7 +266,7 @@ class UnifiedPipeline:
             return not self.include_sources or key in self.include_sources
 
         # GDELT discoverer (can be disabled via config)
-        gdelt_candidates: List[Candidate] = []
+        gdelt = None
         if _should_run("gdelt") and getattr(self.config.gdelt, "enabled", True):
             gdelt = GdeltDiscoverer(
                 session=self.session,
@@ -170,9 +288,12 @@ class UnifiedPipeline:
                     rate_limit_backoff_sec=self.config.gdelt.rate_limit_backoff_sec,
                     max_concurrency=self.config.gdelt.max_concurrency,
                     max_days_back=self.config.gdelt.max_days_back,
+                    min_interval_sec=self.config.gdelt.min_interval_sec,
+                    max_interval_sec=self.config.gdelt.max_interval_sec,
                 ),
+                metrics=self.metrics,
+                cache=self._gdelt_cache(),
             )
-            gdelt_candidates = gdelt.discover()
         yt = None
         if _should_run("youtube"):
             yt = YouTubeDiscoverer(
@@ -208,14 +329,41 @@ class UnifiedPipeline:
                 ),
                 until_date=self._forums_until_date,
                 board_cursors=self._forums_board_cursors,
+                cache=self.http_cache,
+                metrics=self.metrics,
+                max_concurrency=self.config.limits.forum_discovery_concurrency,
             )
 
+        # In streaming mode every discoverer pushes batches into the sink as it
+        # goes, so run them side by side; otherwise keep the sequential order.
+        sink = self._discovery_sink
+        jobs: Dict[str, Callable[[], object]] = {}
+        if gdelt is not None:
+            jobs["gdelt"] = lambda: gdelt.discover(sink=sink)
+        if yt is not None:
+            jobs["youtube"] = lambda: yt.discover(sink=sink)
+        if forums is not None:
+            jobs["forums"] = lambda: forums.discover(sink=sink)
+        results: Dict[str, object] = {}
+        if sink is None or len(jobs) <= 1:
+            for key, job in jobs.items():
+                results[key] = job()
+        else:
+            with ThreadPoolExecutor(max_workers=len(jobs)) as executor:
+                futures = {key: executor.submit(job) for key, job in jobs.items()}
+                for key, fut in futures.items():
+                    results[key] = fut.result()
+
         if _should_run("gdelt"):
-            discoveries["gdelt"] = self._trim_candidates(gdelt_candidates)
+            discoveries["gdelt"] = self._trim_candidates(
+                cast(List[Candidate], results.get("gdelt", []))
+            )
         if yt is not None:
-            discoveries["youtube"] = self._trim_candidates(yt.discover())
+            discoveries["youtube"] = self._trim_candidates(
+                cast(List[Candidate], results["youtube"])
+            )
         if forums is not None:
-            forum_results = forums.discover()
+            forum_results = cast(Dict[str, List[Candidate]], results["forums"])
             # expose pages visited per board for cursor advancement
             try:
                 self.last_forums_pages = dict(forums.last_board_pages)
@@ -225,47 +373,119 @@ class UnifiedPipeline:
                 discoveries[site] = self._trim_candidates(cands)
         return discoveries
 
+    def _admit_candidate(self, candidate: Candidate, seen: set[str]) -> bool:
+        """URL sanity checks + normalized-URL dedupe shared by both run modes."""
+        if not candidate.url or not self._is_valid_url(candidate.url):
+            return False
+        lowered = candidate.url.lower()
+        if lowered.endswith("/robots.txt") or lowered.endswith("robots.txt"):
+            return False
+        norm = normalize_url(candidate.url)
+        if norm.endswith("/") or norm.count("/") <= 2:
+            # Skip bare domain/homepage captures
+            return False
+        if norm in seen:
+            return False
+        seen.add(norm)
+        return True
+
+    def _new_scheduler(self) -> CandidateScheduler:
+        tier = None
+        if self.prefilter is not None and self.prefilter.config.mode == "deprioritize":
+            tier = self.prefilter.tier
+        return CandidateScheduler(
+            DEFAULT_SOURCE_PRIORITY,
+            policy=self.candidate_order,
+            weights=self.source_weights,
+            tier=tier,
+        )
+
+    def _start_streaming_discovery(
+        self, seen: set[str]
+    ) -> tuple[CandidateQueue, threading.Thread, Dict[str, object]]:
+        """Run discovery on a producer thread feeding a bounded priority queue."""
+        cand_queue = CandidateQueue(
+            maxsize=self.candidate_queue_size, scheduler=self._new_scheduler()
+        )
+        emitted: set[int] = set()
+        per_source: Dict[str, int] = {}
+        max_total = self.config.limits.max_candidates_per_source
+        lock = threading.Lock()
+        outcome: Dict[str, object] = {"discovered": {}, "elapsed": 0.0}
+
+        def _emit(batch: List[Candidate]) -> None:
+            for cand in batch:
+                with lock:
+                    if id(cand) in emitted:
+                        continue
+                    emitted.add(id(cand))
+                    count = per_source.get(cand.source, 0)
+                    if count >= max_total:
+                        continue
+                    per_source[cand.source] = count + 1
+                    if not self._admit_candidate(cand, seen):
+                        continue
+                cand_queue.put(cand)
+
+        def _produce() -> None:
+            t0 = time.monotonic()
+            self._discovery_sink = _emit
+            try:
+                discovered = self.discover()
+                outcome["discovered"] = discovered
+                # Discoverers that do not stream are picked up here
+                for cands in discovered.values():
+                    _emit(cands)
+            except Exception as exc:  # noqa: BLE001
+                outcome["error"] = exc
+            finally:
+                self._discovery_sink = None
+                outcome["elapsed"] = time.monotonic() - t0
+                cand_queue.close()
+
+        producer = threading.Thread(target=_produce, name="discovery", daemon=True)
+        producer.start()
+        return cand_queue, producer, outcome
+
     def run(self) -> PipelineStats:
+        exporters: Optional[MetricsExporters] = None
+        if self._owns_metrics:
+            exporters = MetricsExporters(self.metrics, self.metrics_config)
+        try:
+            return self._run()
+        finally:
+            if exporters is not None:
+                exporters.close()
+
+    def _run(self) -> PipelineStats:
         logger.info("Starting unified pipeline: run_id=%s", self.config.runtime.run_id)
         t_start_total = time.monotonic()
-        t_start = time.monotonic()
-        discovered = self.discover()
-        t_discovery = time.monotonic() - t_start
-
-        unique_candidates: Dict[str, Candidate] = {}
-        for source, candidates in discovered.items():
-            for candidate in candidates:
-                if not candidate.url or not self._is_valid_url(candidate.url):
-                    continue
-                lowered = candidate.url.lower()
-                if lowered.endswith("/robots.txt") or lowered.endswith("robots.txt"):
-                    continue
-                norm = normalize_url(candidate.url)
-                if norm.endswith("/") or norm.count("/") <= 2:
-                    # Skip bare domain/homepage captures
-                    continue
-                if norm not in unique_candidates:
-                    unique_candidates[norm] = candidate
-
-        # prioritize forums and gdelt first, youtube last (meta only)
-        ordered_sources = [
-            "dcinside",
-            "bobaedream",
-            "mlbpark",
-            "theqoo",
-            "ppomppu",
-            "gdelt",
-            "youtube",
-        ]
-        all_candidates: List[Candidate] = []
-        for source in ordered_sources:
-            for candidate in unique_candidates.values():
-                if candidate.source == source:
-                    all_candidates.append(candidate)
-        # append any remaining candidates whose source wasn't in the ordered list
-        remaining = [c for c in unique_candidates.values() if c not in all_candidates]
-        all_candidates.extend(remaining)
-        logger.info("Total unique candidates: %d", len(all_candidates))
+        seen_norms: set[str] = set()
+        discovered: Dict[str, List[Candidate]] = {}
+        t_discovery = 0.0
+        cand_queue: Optional[CandidateQueue] = None
+        producer: Optional[threading.Thread] = None
+        outcome: Dict[str, object] = {}
+        source_iter: Iterable[Candidate]
+        total_hint: Optional[int] = None
+
+        if self.stream_discovery:
+            cand_queue, producer, outcome = self._start_streaming_discovery(seen_norms)
+            source_iter = cand_queue
+        else:
+            t_start = time.monotonic()
+            discovered = self.discover()
+            t_discovery = time.monotonic() - t_start
+
+            # Per-source buckets: forums and gdelt first, youtube last (meta only)
+            scheduler = self._new_scheduler()
+            for candidates in discovered.values():
+                for candidate in candidates:
+                    if self._admit_candidate(candidate, seen_norms):
+                        scheduler.push(candidate)
+            all_candidates = scheduler.drain()
+            logger.info("Total unique candidates: %d", len(all_candidates))
+            source_iter = all_candidates
 
         fetched = 0
         stored = 0
@@ -274,25 +494,46 @@ class UnifiedPipeline:
         quality_rejected = 0
         index_duplicates = 0
         extraction_failed = 0
+        not_modified = 0
+        # Counted by the gating generator, which may run on the async feeder
+        # thread; merged into duplicates/index_duplicates after the run.
+        pre_fetch_duplicates = 0
 
         t_fetch = 0.0
         t_extract = 0.0
         t_store = 0.0
+        # Per-stage parallelism/queue-depth metrics, reported in PipelineStats
+        stage_metrics: Dict[str, float] = {}
+        extract_stage: Optional[ExtractStage] = None
 
-        attempted = 0
-        task_candidates: List[Candidate] = []
-        for candidate in all_candidates:
-            if self.max_fetch is not None and attempted >= self.max_fetch:
-                break
-            attempted += 1
-            try:
-                if self.index.contains_url(candidate.url):
-                    duplicates += 1
-                    index_duplicates += 1
+        def _gate(cands: Iterable[Candidate]) -> Iterator[Candidate]:
+            nonlocal pre_fetch_duplicates
+            attempted = 0
+            for candidate in cands:
+                if self.max_fetch is not None and attempted >= self.max_fetch:
+                    if cand_queue is not None:
+                        # Stop accepting discoveries; producers drop the rest
+                        cand_queue.close()
+                    break
+                # Skipped titles do not count against max_fetch
+                if self.prefilter is not None and not self.prefilter.admit(candidate):
                     continue
-            except Exception:  # noqa: BLE001
-                pass
-            task_candidates.append(candidate)
+                attempted += 1
+                try:
+                    if self.index.contains_url(candidate.url):
+                        pre_fetch_duplicates += 1
+                        if self.prefilter is not None:
+                            self.prefilter.forget(candidate)
+                        continue
+                except Exception:  # noqa: BLE001
+                    pass
+                yield candidate
+
+        if cand_queue is None:
+            task_candidates: Iterable[Candidate] = list(_gate(source_iter))
+            total_hint = len(cast(List[Candidate], task_candidates))
+        else:
+            task_candidates = _gate(source_iter)
 
         def _process_candidate(
             cand: Candidate,
@@ -304,16 +545,61 @@ class UnifiedPipeline:
             float,
             float,
         ]:
+            cand, fetch_result, fetch_elapsed = _fetch_candidate(cand)
+            return _extract_candidate(cand, fetch_result, fetch_elapsed)
+
+        def _fetch_candidate(
+            cand: Candidate,
+        ) -> tuple[Candidate, Optional[FetchResult], float]:
             t0 = time.monotonic()
             fetch_result = self.fetcher.fetch(cand)
-            fetch_elapsed = time.monotonic() - t0
+            return cand, fetch_result, time.monotonic() - t0
+
+        def _safe_fetch_candidate(
+            cand: Candidate,
+        ) -> tuple[Candidate, Optional[FetchResult], float]:
+            try:
+                return _fetch_candidate(cand)
+            except Exception as exc:  # noqa: BLE001
+                logger.warning(
+                    "Fetch failed for url=%s error=%s",
+                    getattr(cand, "url", "<unknown>"),
+                    exc,
+                    exc_info=True,
+                )
+                return cand, None, 0.0
+
+        def _needs_extraction(fetch_result: Optional[FetchResult]) -> bool:
+            return bool(fetch_result and fetch_result.html)
+
+        def _extract_candidate(
+            cand: Candidate,
+            fetch_result: Optional[FetchResult],
+            fetch_elapsed: float,
+        ) -> tuple[
+            Candidate,
+            Optional[FetchResult],
+            Optional[Document],
+            Optional[dict],
+            float,
+            float,
+        ]:
             if not fetch_result or not fetch_result.html:
                 return cand, None, None, None, fetch_elapsed, 0.0
+            if extract_stage is not None:
+                # Runs on an async-engine worker thread; waits for the process
+                fut = extract_stage.submit(cand, fetch_result)
+                return _staged_result(fut, cand, fetch_result, fetch_elapsed)
             t1 = time.monotonic()
             document, quality_info = self.extractor.build_document(
                 cand, fetch_result, run_id=self.config.runtime.run_id
             )
             extract_elapsed = time.monotonic() - t1
+            self.metrics.observe_spans(
+                self.extractor.last_spans(),
+                source=cand.source,
+                host=url_host(cand.url),
+            )
             return (
                 cand,
                 fetch_result,
@@ -344,6 +630,29 @@ class UnifiedPipeline:
                 )
                 return cand, None, None, None, 0.0, 0.0
 
+        def _safe_extract_candidate(
+            cand: Candidate,
+            fetch_result: Optional[FetchResult],
+            fetch_elapsed: float,
+        ) -> tuple[
+            Candidate,
+            Optional[FetchResult],
+            Optional[Document],
+            Optional[dict],
+            float,
+            float,
+        ]:
+            try:
+                return _extract_candidate(cand, fetch_result, fetch_elapsed)
+            except Exception as exc:  # noqa: BLE001
+                logger.warning(
+                    "Processing failed for url=%s error=%s",
+                    getattr(cand, "url", "<unknown>"),
+                    exc,
+                    exc_info=True,
+                )
+                return cand, None, None, None, fetch_elapsed, 0.0
+
         def _handle_result(
             res: tuple[
                 Candidate,
@@ -355,7 +664,8 @@ class UnifiedPipeline:
             ],
         ) -> None:
             nonlocal fetched, stored, duplicates, failed_fetch, quality_rejected
-            nonlocal index_duplicates, extraction_failed, t_fetch, t_extract, t_store
+            nonlocal index_duplicates, extraction_failed, not_modified
+            nonlocal t_fetch, t_extract, t_store
             try:
                 (
                     cand,
@@ -371,14 +681,37 @@ class UnifiedPipeline:
                     failed_fetch += 1
                     return
                 fetched += 1
+                if fetch_result.not_modified:
+                    # 304s still extract from the cached body: candidates here
+                    # already missed the index, so the page was never stored
+                    # (earlier quality reject, writer crash, changed keywords)
+                    not_modified += 1
+                host = url_host(cand.url)
+                if extract_elapsed > 0:
+                    self.metrics.observe(
+                        "extract", extract_elapsed, source=cand.source, host=host
+                    )
+                if self.raw_archive is not None:
+                    t2 = time.monotonic()
+                    try:
+                        self.raw_archive.append(
+                            cand, fetch_result, run_id=self.config.runtime.run_id
+                        )
+                    except Exception as exc:  # noqa: BLE001
+                        logger.warning("Raw archive append failed: %s", exc)
+                    t_store += time.monotonic() - t2
                 if not document:
                     if quality_info and quality_info.get("status") == "quality-reject":
                         quality_rejected += 1
+                        if self.prefilter is not None:
+                            self.prefilter.observe(cand, relevant=False)
                     else:
                         extraction_failed += 1
                     return
                 if document.extra is None:
                     document.extra = {}
+                if self.prefilter is not None:
+                    self.prefilter.observe(cand, relevant=True)
                 fetch_meta = cast(dict, document.extra.setdefault("fetch", {}))
                 fetch_meta.update(
                     {
@@ -387,9 +720,13 @@ class UnifiedPipeline:
                         "fetched_from": fetch_result.fetched_from,
                     }
                 )
+                self._commit_written()
                 try:
-                    if self.index.contains(document.id) or self.index.contains_url(
-                        document.url
+                    if (
+                        document.id in self._pending_ids
+                        or normalize_url(document.url) in self._pending_urls
+                        or self.index.contains(document.id)
+                        or self.index.contains_url(document.url)
                     ):
                         duplicates += 1
                         index_duplicates += 1
@@ -397,10 +734,15 @@ class UnifiedPipeline:
                 except Exception:  # noqa: BLE001
                     pass
                 t2 = time.monotonic()
+                self._pending_ids.add(document.id)
+                self._pending_urls.add(normalize_url(document.url))
                 self.storage.append(document)
-                self.index.add(document.id)
-                self.index.add_url(document.url)
-                t_store += time.monotonic() - t2
+                self._commit_written()
+                store_elapsed = time.monotonic() - t2
+                t_store += store_elapsed
+                self.metrics.observe(
+                    "store", store_elapsed, source=cand.source, host=host
+                )
                 stored += 1
                 if self.store_observer is not None:
                     try:
@@ -420,31 +762,193 @@ class UnifiedPipeline:
                     exc,
                     exc_info=True,
                 )
+            finally:
+                # Every terminal outcome releases the prefilter's pending entry
+                if self.prefilter is not None and res:
+                    self.prefilter.forget(res[0])
 
-        if not task_candidates:
-            pass
-        elif self.fetch_concurrency <= 1 or len(task_candidates) == 1:
-            for cand in tqdm(task_candidates, desc="Fetch+Extract", unit="doc"):
-                _handle_result(_safe_process_candidate(cand))
-        else:
+        def _iter_threaded(cands: Iterable[Candidate]) -> Iterator[Optional[tuple]]:
+            # Bounded in-flight submission so a streaming source is not drained
+            # into the executor's unbounded work queue.
+            max_inflight = self.fetch_concurrency * 2
             with ThreadPoolExecutor(max_workers=self.fetch_concurrency) as executor:
-                futures = [
-                    executor.submit(_safe_process_candidate, cand)
-                    for cand in task_candidates
-                ]
-                for fut in tqdm(
-                    as_completed(futures),
-                    total=len(futures),
-                    desc="Fetch+Extract",
-                    unit="doc",
-                ):
-                    try:
-                        res = fut.result()
-                    except Exception as exc:  # noqa: BLE001
-                        failed_fetch += 1
-                        logger.warning("Worker crashed: %s", exc, exc_info=True)
+                inflight: set[Future] = set()
+                for cand in cands:
+                    inflight.add(executor.submit(_safe_process_candidate, cand))
+                    stage_metrics["fetch_inflight_max"] = max(
+                        stage_metrics.get("fetch_inflight_max", 0), len(inflight)
+                    )
+                    if len(inflight) < max_inflight:
                         continue
-                    _handle_result(res)
+                    done, inflight = wait(inflight, return_when=FIRST_COMPLETED)
+                    for fut in done:
+                        yield _future_result(fut)
+                for fut in as_completed(inflight):
+                    yield _future_result(fut)
+
+        def _staged_result(
+            fut: Future,
+            cand: Candidate,
+            fetch_result: FetchResult,
+            fetch_elapsed: float,
+        ) -> tuple[
+            Candidate,
+            Optional[FetchResult],
+            Optional[Document],
+            Optional[dict],
+            float,
+            float,
+        ]:
+            try:
+                cand_out, document, quality_info, extract_elapsed, spans = fut.result()
+            except Exception as exc:  # noqa: BLE001
+                logger.warning(
+                    "Extraction failed for url=%s error=%s",
+                    cand.url,
+                    exc,
+                    exc_info=True,
+                )
+                return cand, fetch_result, None, None, fetch_elapsed, 0.0
+            self.metrics.observe_spans(
+                spans, source=cand.source, host=url_host(cand.url)
+            )
+            return (
+                cand_out,
+                fetch_result,
+                document,
+                quality_info,
+                fetch_elapsed,
+                extract_elapsed,
+            )
+
+        def _iter_two_stage(cands: Iterable[Candidate]) -> Iterator[Optional[tuple]]:
+            # Fetch threads only do I/O; HTML goes to the extraction processes.
+            # Submitting to a full extract stage blocks here, which in turn
+            # stops new fetches from being scheduled (backpressure).
+            assert extract_stage is not None
+            max_inflight = self.fetch_concurrency * 2
+            fetching: set[Future] = set()
+            extracting: Dict[Future, tuple[Candidate, FetchResult, float]] = {}
+
+            def _step() -> Iterator[Optional[tuple]]:
+                done, _ = wait(fetching | set(extracting), return_when=FIRST_COMPLETED)
+                for fut in done:
+                    if fut in fetching:
+                        fetching.discard(fut)
+                        fetched_res = _future_result(fut)
+                        if fetched_res is None:
+                            yield None
+                            continue
+                        cand, fetch_result, fetch_elapsed = fetched_res
+                        if not _needs_extraction(fetch_result):
+                            yield _extract_candidate(cand, fetch_result, fetch_elapsed)
+                            continue
+                        ext = extract_stage.submit(cand, fetch_result)
+                        extracting[ext] = (cand, fetch_result, fetch_elapsed)
+                    else:
+                        cand, fetch_result, fetch_elapsed = extracting.pop(fut)
+                        yield _staged_result(fut, cand, fetch_result, fetch_elapsed)
+
+            with ThreadPoolExecutor(max_workers=self.fetch_concurrency) as executor:
+                for cand in cands:
+                    fetching.add(executor.submit(_safe_fetch_candidate, cand))
+                    stage_metrics["fetch_inflight_max"] = max(
+                        stage_metrics.get("fetch_inflight_max", 0), len(fetching)
+                    )
+                    while len(fetching) >= max_inflight:
+                        yield from _step()
+                while fetching or extracting:
+                    yield from _step()
+
+        def _future_result(fut: Future) -> Optional[tuple]:
+            try:
+                return fut.result()
+            except Exception as exc:  # noqa: BLE001
+                logger.warning("Worker crashed: %s", exc, exc_info=True)
+                return None
+
+        results: Iterable[Optional[tuple]]
+        engine: Optional[AsyncFetchEngine] = None
+        if self.extract_processes > 0 and total_hint != 0:
+            extract_stage = ExtractStage(
+                self.config.keywords,
+                self.config.lang,
+                self.config.quality,
+                self.config.runtime.run_id,
+                workers=self.extract_processes,
+                max_pending=self.extract_queue_size or None,
+                comment_sessions=self.extractor.comment_sessions.worker_kwargs(
+                    self.extract_processes
+                ),
+            )
+        if total_hint == 0:
+            results = []
+        elif self.fetch_mode == "async":
+            engine = AsyncFetchEngine(
+                self.fetcher,
+                self.fetch_concurrency,
+                burst=getattr(self.config.limits, "per_host_burst", 1.0),
+                # Threads waiting on extraction processes must not cap them
+                process_workers=(
+                    extract_stage.max_pending if extract_stage is not None else None
+                ),
+            )
+            results = engine.run(task_candidates, _safe_extract_candidate)
+        elif extract_stage is not None:
+            results = _iter_two_stage(task_candidates)
+        elif self.fetch_concurrency <= 1 or total_hint == 1:
+            results = (_safe_process_candidate(c) for c in task_candidates)
+        else:
+            results = _iter_threaded(task_candidates)
+        for res in tqdm(results, total=total_hint, desc="Fetch+Extract", unit="doc"):
+            if res is None:
+                failed_fetch += 1
+                continue
+            _handle_result(res)
+        if self.prefilter is not None:
+            self.prefilter.clear_pending()
+        if engine is not None:
+            host_waits = engine.host_wait_seconds()
+            logger.debug("Per-host token wait (sec): %s", host_waits)
+            for host, waited in host_waits.items():
+                self.metrics.inc("host_token_wait_sec", waited, host=host)
+            stage_metrics["fetch_inflight_max"] = engine.max_active
+        if extract_stage is not None:
+            extract_stage.close()
+            stage_metrics.update(extract_stage.metrics())
+
+        if producer is not None and cand_queue is not None:
+            cand_queue.close()
+            producer.join()
+            discovered = cast(Dict[str, List[Candidate]], outcome.get("discovered", {}))
+            t_discovery = float(cast(float, outcome.get("elapsed", 0.0)))
+            logger.info(
+                "Total unique candidates: %d (max queue depth %d)",
+                len(seen_norms),
+                cand_queue.max_depth,
+            )
+            stage_metrics["candidate_queue_max"] = cand_queue.max_depth
+        duplicates += pre_fetch_duplicates
+        index_duplicates += pre_fetch_duplicates
+        if self.prefilter is not None:
+            stage_metrics.update(self.prefilter.metrics())
+        if self._owns_metrics:
+            # p50/p99 per stage and lock/sleep totals of this run
+            stage_metrics.update(self.metrics.summary())
+
+        # Drain buffered output before the index that references it is flushed
+        t2 = time.monotonic()
+        writer_error: Optional[BaseException] = None
+        try:
+            self.storage.close()
+        except Exception as exc:  # noqa: BLE001
+            # Unwritten documents stay out of the index and are refetched
+            logger.error("Output writer failed; unwritten documents not indexed")
+            writer_error = exc
+        self._commit_written()
+        if self.raw_archive is not None:
+            self.raw_archive.close()
+        t_store += time.monotonic() - t2
 
         stats = PipelineStats(
             discovered={k: len(v) for k, v in discovered.items()},
@@ -455,6 +959,8 @@ class UnifiedPipeline:
             quality_rejected=quality_rejected,
             index_duplicates=index_duplicates,
             extraction_failed=extraction_failed,
+            not_modified=not_modified,
+            stage_metrics=stage_metrics,
             timings_sec={
                 "discovery": round(t_discovery, 3),
                 "fetch": round(t_fetch, 3),
@@ -469,8 +975,22 @@ class UnifiedPipeline:
             stats.timings_sec,
         )
         self.index.flush()
+        if writer_error is not None:
+            raise writer_error
+        error = outcome.get("error")
+        if isinstance(error, BaseException):
+            raise error
         return stats
 
+    def _commit_written(self) -> None:
+        """Index documents the writer has confirmed on disk."""
+        while self._written:
+            document = self._written.popleft()
+            self.index.add(document.id)
+            self.index.add_url(document.url)
+            self._pending_ids.discard(document.id)
+            self._pending_urls.discard(normalize_url(document.url))
+
 
 def run_pipeline() -> PipelineStats:
     config = load_config()
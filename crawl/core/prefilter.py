@@ -0,0 +1,149 @@
+from __future__ import annotations
+
+import threading
+from dataclasses import dataclass
+from typing import Dict, Iterable, Optional
+
+from .config import PrefilterConfig
+from .keywords import KeywordMatcher
+from .models import Candidate
+from .utils import sha1_hex
+
+
+@dataclass(slots=True)
+class PrefilterOutcomes:
+    scored: int = 0
+    # Off-topic by title: skipped (skip mode) or fetched last (deprioritize)
+    flagged: int = 0
+    skipped: int = 0
+    # Flagged candidates fetched anyway; their outcome estimates recall
+    audited: int = 0
+    # Post-extraction quality outcome of fetched, scored candidates
+    passed_relevant: int = 0
+    passed_rejected: int = 0
+    flagged_relevant: int = 0
+    flagged_rejected: int = 0
+
+
+class TitlePrefilter:
+    """Pre-fetch relevance check for forum candidates.
+
+    A forum candidate is on-topic when its listing title contains a keyword
+    (``KeywordMatcher``) or its board is listed in ``topical_boards``;
+    candidates without a title cannot be judged and pass. Other sources are
+    discovered by keyword queries already and are never flagged.
+
+    Precision and recall are measured against the extractor's quality gate:
+    ``observe`` records whether a fetched candidate was stored or rejected.
+    In skip mode only the ``audit_rate`` sample of flagged candidates is
+    fetched, so their rejects/hits are scaled up to estimate the misses.
+    """
+
+    def __init__(self, keywords: Iterable[str], config: PrefilterConfig) -> None:
+        self.config = config
+        self.matcher = KeywordMatcher(keywords)
+        self.topical_boards = [b.lower() for b in config.topical_boards]
+        self.outcomes = PrefilterOutcomes()
+        self._flagged: Dict[str, bool] = {}
+        self._lock = threading.Lock()
+
+    @staticmethod
+    def _is_forum(candidate: Candidate) -> bool:
+        via = candidate.discovered_via
+        return isinstance(via, dict) and via.get("type") == "forum"
+
+    def on_topic(self, candidate: Candidate) -> Optional[bool]:
+        """True/False for forum candidates; None when not scored."""
+        if not self._is_forum(candidate):
+            return None
+        board = str(candidate.discovered_via.get("board") or "").lower()
+        if board and any(b in board for b in self.topical_boards):
+            return True
+        title = (candidate.title or "").strip()
+        if not title or not len(self.matcher):
+            return True
+        return self.matcher.matches(title)
+
+    def tier(self, candidate: Candidate) -> int:
+        """Scheduling tier for deprioritize mode (flagged candidates last)."""
+        return 1 if self.on_topic(candidate) is False else 0
+
+    def _audit(self, url: str) -> bool:
+        # Deterministic per URL so reruns audit the same sample
+        rate = self.config.audit_rate
+        return rate > 0 and int(sha1_hex(url)[:8], 16) < rate * 0x100000000
+
+    def admit(self, candidate: Candidate) -> bool:
+        """Record the decision for ``candidate``; False means skip the fetch."""
+        verdict = self.on_topic(candidate)
+        if verdict is None:
+            return True
+        flagged = not verdict
+        admitted = True
+        with self._lock:
+            self.outcomes.scored += 1
+            if flagged:
+                self.outcomes.flagged += 1
+                if self.config.mode == "skip":
+                    if self._audit(candidate.url):
+                        self.outcomes.audited += 1
+                    else:
+                        self.outcomes.skipped += 1
+                        admitted = False
+            if admitted:
+                self._flagged[candidate.url] = flagged
+        return admitted
+
+    def observe(self, candidate: Candidate, relevant: bool) -> None:
+        """Feed back the quality outcome of a fetched candidate."""
+        with self._lock:
+            flagged = self._flagged.pop(candidate.url, None)
+            if flagged is None:
+                return
+            o = self.outcomes
+            if flagged:
+                if relevant:
+                    o.flagged_relevant += 1
+                else:
+                    o.flagged_rejected += 1
+            elif relevant:
+                o.passed_relevant += 1
+            else:
+                o.passed_rejected += 1
+
+    def forget(self, candidate: Candidate) -> None:
+        """Drop the pending decision of a candidate that ended without a verdict.
+
+        Fetch failures, extraction errors and index duplicates say nothing
+        about precision/recall; no-op once ``observe`` has consumed the entry.
+        """
+        with self._lock:
+            self._flagged.pop(candidate.url, None)
+
+    def clear_pending(self) -> None:
+        # End of a run: anything left was lost with a crashed worker
+        with self._lock:
+            self._flagged.clear()
+
+    def metrics(self) -> Dict[str, float]:
+        with self._lock:
+            o = self.outcomes
+            # Skip mode fetched only a sample of the flagged candidates
+            scale = 1.0
+            if self.config.mode == "skip" and o.audited:
+                scale = o.flagged / o.audited
+            missed = o.flagged_relevant * scale
+            passed = o.passed_relevant + o.passed_rejected
+            found = o.passed_relevant + missed
+            return {
+                "prefilter_scored": o.scored,
+                "prefilter_flagged": o.flagged,
+                "prefilter_skipped": o.skipped,
+                "prefilter_audited": o.audited,
+                "prefilter_precision": (
+                    round(o.passed_relevant / passed, 3) if passed else 0.0
+                ),
+                "prefilter_recall": (
+                    round(o.passed_relevant / found, 3) if found else 0.0
+                ),
+            }
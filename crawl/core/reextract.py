@@ -0,0 +1,161 @@
+from __future__ import annotations
+
+import logging
+import os
+import time
+from concurrent.futures import ProcessPoolExecutor, as_completed
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, Iterable, List, Optional, Tuple
+
+from tqdm import tqdm
+
+from .config import CrawlerConfig
+from .extract.pool import init_extract_worker, worker_extractor
+from .models import Document
+from .storage.archive import (
+    RawHtmlArchive,
+    candidate_from_meta,
+    fetch_result_from_meta,
+)
+from .storage.writer import MultiSourceJsonlWriter
+from .utils import normalize_url
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass(slots=True)
+class ReextractStats:
+    records: int = 0
+    unique_urls: int = 0
+    stored: int = 0
+    quality_rejected: int = 0
+    extraction_failed: int = 0
+    failed: int = 0
+    timings_sec: Dict[str, float] = field(default_factory=dict)
+
+
+def _extract_chunk(
+    segment: str, offsets: List[int]
+) -> Tuple[List[Document], Dict[str, int]]:
+    extractor, run_id = worker_extractor()
+    docs: List[Document] = []
+    counts = {"quality_rejected": 0, "extraction_failed": 0, "failed": 0}
+    with open(segment, "rb") as fh:
+        for offset in offsets:
+            try:
+                meta, html = RawHtmlArchive.read_html(fh, offset)
+                candidate = candidate_from_meta(meta)
+                fetch_result = fetch_result_from_meta(meta, html)
+                document, quality = extractor.build_document(
+                    candidate, fetch_result, run_id=run_id
+                )
+            except Exception as exc:  # noqa: BLE001
+                logger.debug("Re-extract failed at %s:%d: %s", segment, offset, exc)
+                counts["failed"] += 1
+                continue
+            if document is None:
+                if quality and quality.get("status") == "quality-reject":
+                    counts["quality_rejected"] += 1
+                else:
+                    counts["extraction_failed"] += 1
+                continue
+            extra = document.extra if isinstance(document.extra, dict) else {}
+            extra["fetch"] = dict(meta.get("fetch") or {}, reextracted=True)
+            document.extra = extra
+            docs.append(document)
+    return docs, counts
+
+
+def _plan_chunks(
+    archive: RawHtmlArchive, chunk_size: int, limit: Optional[int]
+) -> Tuple[int, List[Tuple[str, List[int]]]]:
+    """Keep the latest record per normalized URL; chunk offsets per segment."""
+    latest: Dict[str, Tuple[Path, int]] = {}
+    records = 0
+    for rec in archive.iter_records():
+        records += 1
+        url = str(rec.meta.get("url") or "")
+        if not url:
+            continue
+        latest[normalize_url(url)] = (rec.segment, rec.offset)
+    by_segment: Dict[Path, List[int]] = {}
+    items: Iterable[Tuple[Path, int]] = latest.values()
+    if limit is not None:
+        items = list(items)[:limit]
+    for segment, offset in items:
+        by_segment.setdefault(segment, []).append(offset)
+    chunks: List[Tuple[str, List[int]]] = []
+    for segment, offsets in sorted(by_segment.items()):
+        offsets.sort()  # sequential reads within a segment
+        for i in range(0, len(offsets), chunk_size):
+            chunks.append((str(segment), offsets[i : i + chunk_size]))
+    return records, chunks
+
+
+def reextract_archive(
+    config: CrawlerConfig,
+    archive_root: Path,
+    output_root: Path,
+    *,
+    workers: Optional[int] = None,
+    chunk_size: int = 200,
+    limit: Optional[int] = None,
+) -> ReextractStats:
+    """Run ``Extractor.build_document`` over the raw HTML archive.
+
+    Work is split into per-segment chunks of record offsets; each worker
+    process opens the segment itself, so only offsets and finished documents
+    cross the process boundary. ``workers=1`` runs in-process.
+    """
+    t_start = time.monotonic()
+    stats = ReextractStats()
+    archive = RawHtmlArchive(archive_root)
+    records, chunks = _plan_chunks(archive, max(1, int(chunk_size)), limit)
+    stats.records = records
+    stats.unique_urls = sum(len(offsets) for _, offsets in chunks)
+    t_plan = time.monotonic() - t_start
+    logger.info(
+        "Re-extracting %d unique URLs (%d archived records, %d chunks)",
+        stats.unique_urls,
+        records,
+        len(chunks),
+    )
+
+    writer = MultiSourceJsonlWriter(output_root)
+    run_id = f"reextract-{config.runtime.run_id}"
+    # Archived candidates carry their comments; never hit comment APIs here
+    initargs = (config.keywords, config.lang, config.quality, run_id, True)
+
+    def _collect(docs: List[Document], counts: Dict[str, int]) -> None:
+        for doc in docs:
+            writer.append(doc)
+        stats.stored += len(docs)
+        stats.quality_rejected += counts["quality_rejected"]
+        stats.extraction_failed += counts["extraction_failed"]
+        stats.failed += counts["failed"]
+
+    n_workers = workers or os.cpu_count() or 1
+    if n_workers <= 1 or len(chunks) <= 1:
+        init_extract_worker(*initargs)
+        for segment, offsets in tqdm(chunks, desc="Re-extract", unit="chunk"):
+            _collect(*_extract_chunk(segment, offsets))
+    else:
+        with ProcessPoolExecutor(
+            max_workers=n_workers, initializer=init_extract_worker, initargs=initargs
+        ) as pool:
+            futures = [pool.submit(_extract_chunk, s, o) for s, o in chunks]
+            for fut in tqdm(
+                as_completed(futures), total=len(futures), desc="Re-extract"
+            ):
+                try:
+                    _collect(*fut.result())
+                except Exception as exc:  # noqa: BLE001
+                    logger.warning("Re-extract worker crashed: %s", exc)
+    writer.close()
+    stats.timings_sec = {
+        "plan": round(t_plan, 3),
+        "total": round(time.monotonic() - t_start, 3),
+    }
+    logger.info("Re-extract completed stats=%s", stats)
+    return stats
@@ -0,0 +1,223 @@
+from __future__ import annotations
+
+import heapq
+import itertools
+import threading
+from datetime import timezone
+from typing import (
+    Callable,
+    Dict,
+    Iterator,
+    List,
+    Mapping,
+    Optional,
+    Sequence,
+    Tuple,
+)
+
+from .models import Candidate
+
+# Forums and GDELT first, YouTube last (meta only)
+DEFAULT_SOURCE_PRIORITY: tuple[str, ...] = (
+    "dcinside",
+    "bobaedream",
+    "mlbpark",
+    "theqoo",
+    "ppomppu",
+    "gdelt",
+    "youtube",
+)
+
+ORDER_POLICIES = ("priority", "weighted")
+
+_HeapEntry = Tuple[int, int, float, int, Candidate]
+
+
+def _recency_key(candidate: Candidate) -> Tuple[int, float]:
+    # Newest first; undated candidates keep discovery order after dated ones
+    ts = candidate.timestamp
+    if ts is None:
+        return (1, 0.0)
+    if ts.tzinfo is None:
+        ts = ts.replace(tzinfo=timezone.utc)
+    return (0, -ts.timestamp())
+
+
+class CandidateScheduler:
+    """Per-source candidate buckets with a pluggable cross-source policy.
+
+    Each source keeps a heap ordered by ``tier`` (lower first, default 0),
+    then recency (newest ``timestamp`` first), then discovery order. Across
+    sources:
+    - ``priority``: always serve the highest-priority non-empty source
+      (``priority`` order, unknown sources after, in first-seen order).
+    - ``weighted``: smooth weighted round-robin over non-empty sources using
+      ``weights`` (default 1), so one large or slow source cannot starve the
+      others while ties still follow ``priority``.
+
+    Push/pop are O(log n). Not thread-safe; see ``CandidateQueue``.
+    """
+
+    def __init__(
+        self,
+        priority: Sequence[str] = DEFAULT_SOURCE_PRIORITY,
+        *,
+        policy: str = "priority",
+        weights: Optional[Mapping[str, float]] = None,
+        tier: Optional[Callable[[Candidate], int]] = None,
+    ) -> None:
+        if policy not in ORDER_POLICIES:
+            raise ValueError(f"Unknown candidate order policy: {policy}")
+        self.priority: List[str] = list(priority)
+        self.policy = policy
+        self.weights: Dict[str, float] = {
+            str(k): max(0.0, float(v)) for k, v in (weights or {}).items()
+        }
+        self.tier = tier
+        self._buckets: Dict[str, List[_HeapEntry]] = {}
+        self._order: List[str] = []
+        self._first_seen: Dict[str, int] = {}
+        self._credit: Dict[str, float] = {}
+        self._seq = itertools.count()
+        self._size = 0
+
+    def _rank(self, source: str) -> Tuple[int, int]:
+        try:
+            return (self.priority.index(source), 0)
+        except ValueError:
+            return (len(self.priority), self._first_seen[source])
+
+    def _weight(self, source: str) -> float:
+        return self.weights.get(source, 1.0)
+
+    def push(self, candidate: Candidate) -> None:
+        bucket = self._buckets.get(candidate.source)
+        if bucket is None:
+            bucket = []
+            self._buckets[candidate.source] = bucket
+            self._first_seen[candidate.source] = len(self._first_seen)
+            self._order.append(candidate.source)
+            self._order.sort(key=self._rank)
+        tier = self.tier(candidate) if self.tier is not None else 0
+        dated, recency = _recency_key(candidate)
+        heapq.heappush(bucket, (tier, dated, recency, next(self._seq), candidate))
+        self._size += 1
+
+    def _pick_weighted(self) -> Optional[str]:
+        active = [s for s in self._order if self._buckets[s]]
+        if not active:
+            return None
+        total = 0.0
+        best: Optional[str] = None
+        for source in active:
+            weight = self._weight(source)
+            total += weight
+            self._credit[source] = self._credit.get(source, 0.0) + weight
+            # _order is priority-sorted, so ties resolve to the higher priority
+            if best is None or self._credit[source] > self._credit[best]:
+                best = source
+        if best is not None:
+            self._credit[best] -= total
+        return best
+
+    def pop(self) -> Optional[Candidate]:
+        if not self._size:
+            return None
+        source: Optional[str] = None
+        if self.policy == "weighted":
+            source = self._pick_weighted()
+        else:
+            source = next((s for s in self._order if self._buckets[s]), None)
+        if source is None:
+            return None
+        bucket = self._buckets[source]
+        entry = heapq.heappop(bucket)
+        if not bucket:
+            # Idle sources do not bank credit while empty
+            self._credit.pop(source, None)
+        self._size -= 1
+        return entry[-1]
+
+    def drain(self) -> List[Candidate]:
+        out: List[Candidate] = []
+        while self._size:
+            cand = self.pop()
+            if cand is None:
+                break
+            out.append(cand)
+        return out
+
+    def depth_by_source(self) -> Dict[str, int]:
+        return {s: len(b) for s, b in self._buckets.items() if b}
+
+    def __len__(self) -> int:
+        return self._size
+
+
+class CandidateQueue:
+    """Bounded, thread-safe wrapper around ``CandidateScheduler``.
+
+    Producers (discoverers) ``put`` candidates and block while ``maxsize``
+    candidates are queued; the consumer iterates and receives candidates in
+    scheduler order. ``close()`` ends iteration once the queue drains.
+    """
+
+    def __init__(
+        self,
+        priority: Sequence[str] = DEFAULT_SOURCE_PRIORITY,
+        maxsize: int = 1000,
+        *,
+        scheduler: Optional[CandidateScheduler] = None,
+    ) -> None:
+        self.scheduler = scheduler or CandidateScheduler(priority)
+        self.maxsize = max(1, int(maxsize))
+        self._closed = False
+        self._cond = threading.Condition()
+        self.max_depth = 0
+
+    def put(self, candidate: Candidate, timeout: Optional[float] = None) -> bool:
+        """Enqueue; returns False if the queue was closed (candidate dropped)."""
+        with self._cond:
+            while len(self.scheduler) >= self.maxsize and not self._closed:
+                if not self._cond.wait(timeout):
+                    return False
+            if self._closed:
+                return False
+            self.scheduler.push(candidate)
+            self.max_depth = max(self.max_depth, len(self.scheduler))
+            self._cond.notify_all()
+            return True
+
+    def get(self) -> Optional[Candidate]:
+        """Block until a candidate is available; None once closed and drained."""
+        with self._cond:
+            while not len(self.scheduler) and not self._closed:
+                self._cond.wait()
+            cand = self.scheduler.pop()
+            if cand is not None:
+                self._cond.notify_all()
+            return cand
+
+    def close(self) -> None:
+        with self._cond:
+            self._closed = True
+            self._cond.notify_all()
+
+    def __len__(self) -> int:
+        with self._cond:
+            return len(self.scheduler)
+
+    def __iter__(self) -> Iterator[Candidate]:
+        while True:
+            cand = self.get()
+            if cand is None:
+                return
+            yield cand
+
+
+__all__ = [
+    "DEFAULT_SOURCE_PRIORITY",
+    "ORDER_POLICIES",
+    "CandidateQueue",
+    "CandidateScheduler",
+]
@@ -0,0 +1,234 @@
+from __future__ import annotations
+
+import json
+import logging
+import os
+import re
+import struct
+import threading
+import zlib
+from dataclasses import dataclass
+from datetime import datetime
+from pathlib import Path
+from typing import IO, Any, Dict, Iterator, List, Optional, Tuple
+
+from ..models import Candidate, FetchResult
+
+logger = logging.getLogger(__name__)
+
+_MAGIC = b"NPSR"
+# magic, codec (0 = zlib), meta length, compressed body length
+_HEADER = struct.Struct("<4sBII")
+_CODEC_ZLIB = 0
+_SEGMENT_RE = re.compile(r"^raw_(\d{6})\.seg$")
+
+
+@dataclass(slots=True)
+class ArchiveRecord:
+    segment: Path
+    offset: int
+    meta: Dict[str, Any]
+
+
+def _iso(value: Optional[datetime]) -> Optional[str]:
+    return value.isoformat() if value is not None else None
+
+
+def _parse_iso(value: Any) -> Optional[datetime]:
+    if not isinstance(value, str) or not value:
+        return None
+    try:
+        return datetime.fromisoformat(value)
+    except ValueError:
+        return None
+
+
+class RawHtmlArchive:
+    """Append-only archive of fetched HTML in packed, compressed segments.
+
+    Segments are ``raw_000001.seg``, ``raw_000002.seg``, ... under ``root``.
+    Each record is a fixed header, a JSON metadata blob (candidate fields plus
+    fetch metadata) and the zlib-compressed HTML, so a reader can walk the
+    metadata and seek past bodies. A torn tail left by a crash is truncated
+    when the archive is reopened for writing.
+    """
+
+    def __init__(
+        self,
+        root: Path,
+        *,
+        segment_max_bytes: int = 256 * 1024 * 1024,
+        level: int = 6,
+    ) -> None:
+        self.root = root
+        self.root.mkdir(parents=True, exist_ok=True)
+        self.segment_max_bytes = max(1, int(segment_max_bytes))
+        self.level = int(level)
+        self._lock = threading.Lock()
+        self._fh: Optional[IO[bytes]] = None
+        self._segment: Optional[Path] = None
+
+    # ---------- segments ----------
+    def segments(self) -> List[Path]:
+        found: List[Tuple[int, Path]] = []
+        for path in self.root.glob("raw_*.seg"):
+            m = _SEGMENT_RE.match(path.name)
+            if m:
+                found.append((int(m.group(1)), path))
+        return [p for _, p in sorted(found)]
+
+    def _segment_path(self, number: int) -> Path:
+        return self.root / f"raw_{number:06d}.seg"
+
+    def _open_for_append(self) -> IO[bytes]:
+        if self._fh is not None:
+            return self._fh
+        segments = self.segments()
+        if segments:
+            path = segments[-1]
+            valid = self._valid_length(path)
+            if valid != path.stat().st_size:
+                logger.warning("Truncating torn raw archive tail: %s", path)
+                os.truncate(path, valid)
+        else:
+            path = self._segment_path(1)
+        self._segment = path
+        self._fh = path.open("ab")
+        return self._fh
+
+    def _rotate(self) -> None:
+        assert self._fh is not None and self._segment is not None
+        self._fh.close()
+        m = _SEGMENT_RE.match(self._segment.name)
+        number = int(m.group(1)) + 1 if m else len(self.segments()) + 1
+        self._segment = self._segment_path(number)
+        self._fh = self._segment.open("ab")
+
+    @staticmethod
+    def _valid_length(path: Path) -> int:
+        size = path.stat().st_size
+        offset = 0
+        with path.open("rb") as fh:
+            while offset + _HEADER.size <= size:
+                fh.seek(offset)
+                try:
+                    magic, _codec, meta_len, body_len = _HEADER.unpack(
+                        fh.read(_HEADER.size)
+                    )
+                except struct.error:
+                    break
+                end = offset + _HEADER.size + meta_len + body_len
+                if magic != _MAGIC or end > size:
+                    break
+                offset = end
+        return offset
+
+    # ---------- writing ----------
+    def append(
+        self,
+        candidate: Candidate,
+        fetch_result: FetchResult,
+        *,
+        run_id: Optional[str] = None,
+    ) -> None:
+        if not fetch_result.html:
+            return
+        meta = {
+            "url": candidate.url,
+            "source": candidate.source,
+            "discovered_via": candidate.discovered_via,
+            "title": candidate.title,
+            "timestamp": _iso(candidate.timestamp),
+            "snapshot_url": fetch_result.snapshot_url,
+            "extra": candidate.extra,
+            "fetch": {
+                "url": fetch_result.url,
+                "fetched_from": fetch_result.fetched_from,
+                "status_code": fetch_result.status_code,
+                "encoding": fetch_result.encoding,
+                "fetched_at": _iso(fetch_result.fetched_at),
+            },
+            "run_id": run_id,
+        }
+        meta_bytes = json.dumps(meta, ensure_ascii=False, default=str).encode("utf-8")
+        body = zlib.compress(fetch_result.html.encode("utf-8"), self.level)
+        header = _HEADER.pack(_MAGIC, _CODEC_ZLIB, len(meta_bytes), len(body))
+        with self._lock:
+            fh = self._open_for_append()
+            if fh.tell() and fh.tell() >= self.segment_max_bytes:
+                self._rotate()
+                fh = self._open_for_append()
+            fh.write(header + meta_bytes + body)
+
+    def flush(self) -> None:
+        with self._lock:
+            if self._fh is not None:
+                self._fh.flush()
+
+    def close(self) -> None:
+        with self._lock:
+            if self._fh is not None:
+                self._fh.close()
+                self._fh = None
+
+    # ---------- reading ----------
+    @staticmethod
+    def iter_segment(path: Path) -> Iterator[ArchiveRecord]:
+        """Yield metadata for every complete record, skipping the bodies."""
+        size = path.stat().st_size
+        offset = 0
+        with path.open("rb") as fh:
+            while offset + _HEADER.size <= size:
+                fh.seek(offset)
+                magic, _codec, meta_len, body_len = _HEADER.unpack(
+                    fh.read(_HEADER.size)
+                )
+                end = offset + _HEADER.size + meta_len + body_len
+                if magic != _MAGIC or end > size:
+                    break
+                try:
+                    meta = json.loads(fh.read(meta_len).decode("utf-8"))
+                except ValueError:
+                    meta = None
+                if isinstance(meta, dict):
+                    yield ArchiveRecord(segment=path, offset=offset, meta=meta)
+                offset = end
+
+    def iter_records(self) -> Iterator[ArchiveRecord]:
+        for path in self.segments():
+            yield from self.iter_segment(path)
+
+    @staticmethod
+    def read_html(fh: IO[bytes], offset: int) -> Tuple[Dict[str, Any], str]:
+        fh.seek(offset)
+        magic, codec, meta_len, body_len = _HEADER.unpack(fh.read(_HEADER.size))
+        if magic != _MAGIC or codec != _CODEC_ZLIB:
+            raise ValueError(f"Bad raw archive record at offset {offset}")
+        meta = json.loads(fh.read(meta_len).decode("utf-8"))
+        html = zlib.decompress(fh.read(body_len)).decode("utf-8")
+        return meta, html
+
+
+def candidate_from_meta(meta: Dict[str, Any]) -> Candidate:
+    return Candidate(
+        url=str(meta.get("url") or ""),
+        source=str(meta.get("source") or "unknown"),
+        discovered_via=meta.get("discovered_via") or {},
+        title=meta.get("title"),
+        timestamp=_parse_iso(meta.get("timestamp")),
+        snapshot_url=meta.get("snapshot_url"),
+        extra=meta.get("extra") or {},
+    )
+
+
+def fetch_result_from_meta(meta: Dict[str, Any], html: str) -> FetchResult:
+    fetch = meta.get("fetch") or {}
+    return FetchResult(
+        url=str(fetch.get("url") or meta.get("url") or ""),
+        fetched_from=str(fetch.get("fetched_from") or "archive"),
+        status_code=int(fetch.get("status_code") or 200),
+        html=html,
+        snapshot_url=meta.get("snapshot_url"),
+        encoding=fetch.get("encoding"),
+        fetched_at=_parse_iso(fetch.get("fetched_at")) or datetime.utcnow(),
+    )
@@ -0,0 +1,81 @@
+from __future__ import annotations
+
+import math
+import os
+import struct
+from pathlib import Path
+from typing import Optional
+
+_MAGIC = b"NPSBLM1\n"
+_HEADER = struct.Struct("<QQQQ")  # m_bits, k, capacity, count
+
+
+class BloomFilter:
+    """Fixed-size Bloom filter over pre-hashed keys (e.g. SHA1 digests).
+
+    Uses Kirsch–Mitzenmacher double hashing on the first 16 bytes of the
+    key, so callers should pass a uniformly distributed digest. Sized for
+    ``capacity`` keys at ``error_rate`` (≈1.8 bytes/key at 0.1%).
+    """
+
+    def __init__(self, capacity: int, error_rate: float = 0.001) -> None:
+        capacity = max(1, int(capacity))
+        error_rate = min(max(float(error_rate), 1e-9), 0.5)
+        m_bits = int(math.ceil(-capacity * math.log(error_rate) / (math.log(2) ** 2)))
+        self.m_bits = max(8, m_bits)
+        self.k = max(1, int(round(self.m_bits / capacity * math.log(2))))
+        self.capacity = capacity
+        self.count = 0
+        self._bits = bytearray((self.m_bits + 7) // 8)
+
+    def _positions(self, key: bytes):  # type: ignore[no-untyped-def]
+        h1 = int.from_bytes(key[-20:-12], "little")
+        h2 = int.from_bytes(key[-12:-4], "little") | 1
+        m = self.m_bits
+        for i in range(self.k):
+            yield (h1 + i * h2) % m
+
+    def add(self, key: bytes) -> None:
+        bits = self._bits
+        for pos in self._positions(key):
+            bits[pos >> 3] |= 1 << (pos & 7)
+        self.count += 1
+
+    def __contains__(self, key: bytes) -> bool:
+        bits = self._bits
+        for pos in self._positions(key):
+            if not bits[pos >> 3] & (1 << (pos & 7)):
+                return False
+        return True
+
+    @property
+    def saturated(self) -> bool:
+        return self.count > self.capacity
+
+    def save(self, path: Path) -> None:
+        tmp = path.with_suffix(path.suffix + ".tmp")
+        with tmp.open("wb") as fh:
+            fh.write(_MAGIC)
+            fh.write(_HEADER.pack(self.m_bits, self.k, self.capacity, self.count))
+            fh.write(self._bits)
+        os.replace(tmp, path)
+
+    @classmethod
+    def load(cls, path: Path) -> Optional["BloomFilter"]:
+        try:
+            with path.open("rb") as fh:
+                if fh.read(len(_MAGIC)) != _MAGIC:
+                    return None
+                m_bits, k, capacity, count = _HEADER.unpack(fh.read(_HEADER.size))
+                bits = bytearray(fh.read())
+        except (OSError, struct.error):
+            return None
+        if len(bits) != (m_bits + 7) // 8:
+            return None
+        bloom = cls.__new__(cls)
+        bloom.m_bits = m_bits
+        bloom.k = k
+        bloom.capacity = capacity
+        bloom.count = count
+        bloom._bits = bits
+        return bloom
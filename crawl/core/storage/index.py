@@ -1,86 +1,333 @@
 from __future__ import annotations
 
+import hashlib
+import io
 import json
+import logging
+import mmap
+import os
 from pathlib import Path
-from typing import Set
+from typing import Any, Dict, Optional, Set
 
 from ..utils import normalize_url
+from .bloom import BloomFilter
+
+logger = logging.getLogger(__name__)
+
+# Fixed-width record: 1-byte kind tag + 20-byte SHA1 digest
+_KIND_ID = b"I"
+_KIND_URL = b"U"
+_RECORD_SIZE = 21
+
+
+def _optional_zstd() -> Any:
+    try:
+        import zstandard  # type: ignore[import-not-found]
+    except Exception:  # noqa: BLE001
+        return None
+    return zstandard
+
+
+def _digest(kind: bytes, value: str) -> bytes:
+    return kind + hashlib.sha1(value.encode("utf-8")).digest()
 
 
 class DocumentIndex:
-    def __init__(self, output_dir: Path) -> None:
-        # Unified index lives alongside output JSONL
-        self.path = output_dir / "_index.json"
-        self.path.parent.mkdir(parents=True, exist_ok=True)
-        self.ids: Set[str] = set()
-        self.urls: Set[str] = set()
-        if self.path.exists():
-            try:
-                data = json.loads(self.path.read_text(encoding="utf-8"))
-                if isinstance(data, dict):
-                    ids = data.get("ids", [])
-                    urls = data.get("urls", [])
-                else:
-                    ids = data
-                    urls = []
-                self.ids.update(str(entry) for entry in ids)
-                self.urls.update(str(entry) for entry in urls)
-            except (json.JSONDecodeError, OSError):
-                # Corrupt or unreadable index; start fresh
-                self.ids = set()
-                self.urls = set()
-            self._dirty = False
+    """Persistent URL/ID index kept next to the output JSONL files.
+
+    On-disk layout (all under ``output_dir``):
+    - ``_index.seg``: compacted, sorted fixed-width records, memory-mapped and
+      binary-searched, so opening the index does not load it into RAM.
+    - ``_index.log``: append-only records added since the last compaction.
+    - ``_index.offsets.json``: per-JSONL byte offsets; only tails appended
+      after the recorded offset are rescanned on open.
+    - ``_index.bloom`` (optional): Bloom filter over every record, checked
+      before the exact store so most "not seen" lookups never touch it.
+
+    A legacy ``_index.json`` is imported once when no segment/log exists.
+    """
+
+    COMPACT_THRESHOLD = 50_000
+
+    def __init__(
+        self,
+        output_dir: Path,
+        *,
+        bloom_capacity: Optional[int] = None,
+        bloom_error_rate: float = 0.001,
+    ) -> None:
+        self.output_dir = output_dir
+        self.output_dir.mkdir(parents=True, exist_ok=True)
+        self.path = output_dir / "_index.json"  # legacy format (read-only)
+        self.seg_path = output_dir / "_index.seg"
+        self.log_path = output_dir / "_index.log"
+        self.offsets_path = output_dir / "_index.offsets.json"
+        self.bloom_path = output_dir / "_index.bloom"
+        self._bloom: Optional[BloomFilter] = None
+        self._bloom_dirty = False
+        self._bloom_error_rate = float(bloom_error_rate)
+        self._seg_map: Optional[mmap.mmap] = None
+        self._seg_count = 0
+        self._recent: Set[bytes] = set()
+        self._pending = bytearray()
+        self._log_records = 0
+        self._offsets: Dict[str, Dict[str, object]] = {}
+        self._offsets_dirty = False
+
+        fresh = not self.seg_path.exists() and not self.log_path.exists()
+        self._open_segment()
+        self._load_log()
+        if bloom_capacity:
+            self._open_bloom(int(bloom_capacity))
+        if fresh and self.path.exists():
+            self._import_legacy()
+        self._load_offsets()
+        self._scan_jsonl_tails()
+        self.flush()
+
+    # ---------- on-disk segment / log ----------
+    def _open_segment(self) -> None:
+        if self._seg_map is not None:
+            self._seg_map.close()
+            self._seg_map = None
+        self._seg_count = 0
+        try:
+            size = self.seg_path.stat().st_size
+        except OSError:
+            return
+        if size < _RECORD_SIZE:
+            return
+        with self.seg_path.open("rb") as fh:
+            self._seg_map = mmap.mmap(fh.fileno(), 0, access=mmap.ACCESS_READ)
+        self._seg_count = size // _RECORD_SIZE
+
+    def _load_log(self) -> None:
+        try:
+            data = self.log_path.read_bytes()
+        except OSError:
+            return
+        usable = len(data) - (len(data) % _RECORD_SIZE)
+        for pos in range(0, usable, _RECORD_SIZE):
+            self._recent.add(data[pos : pos + _RECORD_SIZE])
+        self._log_records = usable // _RECORD_SIZE
+        if usable != len(data):
+            # Torn write from a crash: drop the partial record
+            logger.warning("Truncating partial record in %s", self.log_path)
+            with self.log_path.open("r+b") as fh:
+                fh.truncate(usable)
+
+    def _in_segment(self, record: bytes) -> bool:
+        seg = self._seg_map
+        if seg is None:
+            return False
+        lo, hi = 0, self._seg_count
+        while lo < hi:
+            mid = (lo + hi) // 2
+            start = mid * _RECORD_SIZE
+            probe = seg[start : start + _RECORD_SIZE]
+            if probe == record:
+                return True
+            if probe < record:
+                lo = mid + 1
+            else:
+                hi = mid
+        return False
+
+    def _iter_records(self):  # type: ignore[no-untyped-def]
+        if self._seg_map is not None:
+            seg = self._seg_map
+            for pos in range(0, self._seg_count * _RECORD_SIZE, _RECORD_SIZE):
+                yield seg[pos : pos + _RECORD_SIZE]
+        yield from self._recent
+
+    def _has(self, record: bytes) -> bool:
+        if self._bloom is not None and record not in self._bloom:
+            return False
+        return record in self._recent or self._in_segment(record)
+
+    def _put(self, record: bytes) -> None:
+        if self._has(record):
+            return
+        self._recent.add(record)
+        self._pending += record
+        if self._bloom is not None:
+            self._bloom.add(record)
+            self._bloom_dirty = True
+
+    # ---------- bloom pre-filter ----------
+    def _open_bloom(self, capacity: int) -> None:
+        total = self._seg_count + len(self._recent)
+        bloom = BloomFilter.load(self.bloom_path)
+        # Stale (crash before save, other writer) or undersized: rebuild
+        if bloom is None or bloom.count != total or bloom.capacity < capacity:
+            self._rebuild_bloom(max(capacity, total * 2))
+        else:
+            self._bloom = bloom
+
+    def _rebuild_bloom(self, capacity: int) -> None:
+        bloom = BloomFilter(capacity, self._bloom_error_rate)
+        for record in self._iter_records():
+            bloom.add(record)
+        self._bloom = bloom
+        self._bloom_dirty = True
+
+    def compact(self) -> None:
+        """Merge the append log into the sorted segment and truncate the log."""
+        self._write_pending()
+        records: Set[bytes] = set(self._iter_records())
+        tmp = self.seg_path.with_suffix(".seg.tmp")
+        with tmp.open("wb") as fh:
+            for record in sorted(records):
+                fh.write(record)
+            fh.flush()
+            os.fsync(fh.fileno())
+        if self._seg_map is not None:
+            self._seg_map.close()
+            self._seg_map = None
+        os.replace(tmp, self.seg_path)
+        self.log_path.write_bytes(b"")
+        self._recent.clear()
+        self._log_records = 0
+        self._open_segment()
+
+    def _write_pending(self) -> None:
+        if not self._pending:
+            return
+        with self.log_path.open("ab") as fh:
+            fh.write(self._pending)
+        self._log_records += len(self._pending) // _RECORD_SIZE
+        self._pending = bytearray()
+
+    def _import_legacy(self) -> None:
+        try:
+            data = json.loads(self.path.read_text(encoding="utf-8"))
+        except (json.JSONDecodeError, OSError):
+            # Corrupt or unreadable legacy index; JSONL scan rebuilds it
+            return
+        if isinstance(data, dict):
+            ids = data.get("ids", [])
+            urls = data.get("urls", [])
         else:
-            self._dirty = False
-        # Always bootstrap/refresh from existing JSONL files to keep URLs set
-        for jsonl_file in self.path.parent.glob("*.jsonl"):
+            ids = data
+            urls = []
+        for entry in ids:
+            self._put(_digest(_KIND_ID, str(entry)))
+        for entry in urls:
+            # Legacy entries are already normalized
+            self._put(_digest(_KIND_URL, str(entry)))
+
+    # ---------- JSONL tail scanning ----------
+    def _load_offsets(self) -> None:
+        try:
+            data = json.loads(self.offsets_path.read_text(encoding="utf-8"))
+        except (json.JSONDecodeError, OSError):
+            return
+        if isinstance(data, dict):
+            files = data.get("files", {})
+            self._offsets = {str(k): v for k, v in files.items() if isinstance(v, dict)}
+
+    @staticmethod
+    def _head_fingerprint(fh, length: int) -> str:  # type: ignore[no-untyped-def]
+        fh.seek(0)
+        return hashlib.sha1(fh.read(length)).hexdigest()
+
+    def _scan_jsonl_tails(self) -> None:
+        files = sorted(self.output_dir.glob("*.jsonl"))
+        zstd = _optional_zstd()
+        if zstd is not None:
+            files += sorted(self.output_dir.glob("*.jsonl.zst"))
+        for jsonl_file in files:
+            name = jsonl_file.name
+            prev = self._offsets.get(name) or {}
             try:
-                with jsonl_file.open("r", encoding="utf-8") as fh:
-                    for line in fh:
-                        line = line.strip()
-                        if not line:
-                            continue
-                        try:
-                            record = json.loads(line)
-                        except json.JSONDecodeError:
-                            continue
-                        doc_id = record.get("id")
-                        url = record.get("url")
-                        if isinstance(doc_id, str):
-                            if doc_id not in self.ids:
-                                self.ids.add(doc_id)
-                                self._dirty = True
-                        if isinstance(url, str):
-                            norm = normalize_url(url)
-                            if norm and norm not in self.urls:
-                                self.urls.add(norm)
-                                self._dirty = True
+                size = jsonl_file.stat().st_size
+                with jsonl_file.open("rb") as fh:
+                    start = int(prev.get("offset", 0) or 0)
+                    head_len = int(prev.get("head_len", 0) or 0)
+                    # Rewritten or truncated file: rescan from the beginning
+                    if start > size or (
+                        prev.get("head") != self._head_fingerprint(fh, head_len)
+                    ):
+                        start = 0
+                    if prev and start == size:
+                        continue
+                    fh.seek(start)
+                    if name.endswith(".zst"):
+                        offset = self._scan_zstd_tail(zstd, fh, start, size)
+                    else:
+                        offset = start
+                        for raw in fh:
+                            if not raw.endswith(b"\n"):
+                                break  # partial trailing line; pick up next time
+                            offset += len(raw)
+                            self._index_line(raw)
+                    head_len = min(256, offset)
+                    head = self._head_fingerprint(fh, head_len)
             except OSError:
                 continue
+            self._offsets[name] = {"offset": offset, "head": head, "head_len": head_len}
+            self._offsets_dirty = True
+
+    def _scan_zstd_tail(self, zstd: Any, fh: Any, start: int, size: int) -> int:
+        # Writers end a frame on every flush, so recorded offsets sit on frame
+        # boundaries; a torn final frame leaves the offset where it was.
+        reader = zstd.ZstdDecompressor().stream_reader(fh, read_across_frames=True)
+        try:
+            for raw in io.BufferedReader(reader):
+                if raw.endswith(b"\n"):
+                    self._index_line(raw)
+        except zstd.ZstdError:
+            logger.warning("Incomplete zstd frame in %s; will retry", fh.name)
+            return start
+        return size
 
+    def _index_line(self, raw: bytes) -> None:
+        line = raw.strip()
+        if not line:
+            return
+        try:
+            record = json.loads(line)
+        except (json.JSONDecodeError, UnicodeDecodeError):
+            return
+        if not isinstance(record, dict):
+            return
+        doc_id = record.get("id")
+        url = record.get("url")
+        if isinstance(doc_id, str):
+            self.add(doc_id)
+        if isinstance(url, str):
+            self.add_url(url)
+
+    # ---------- public API ----------
     def contains(self, doc_id: str) -> bool:
-        return doc_id in self.ids
+        return self._has(_digest(_KIND_ID, doc_id))
 
     def contains_url(self, url: str) -> bool:
         norm = normalize_url(url)
-        return norm in self.urls
+        return self._has(_digest(_KIND_URL, norm))
 
     def add(self, doc_id: str) -> None:
-        if doc_id not in self.ids:
-            self.ids.add(doc_id)
-            self._dirty = True
+        self._put(_digest(_KIND_ID, doc_id))
 
     def add_url(self, url: str) -> None:
         norm = normalize_url(url)
-        if norm and norm not in self.urls:
-            self.urls.add(norm)
-            self._dirty = True
+        if norm:
+            self._put(_digest(_KIND_URL, norm))
 
     def flush(self) -> None:
-        if not self._dirty:
-            return
-        payload = {"ids": sorted(self.ids), "urls": sorted(self.urls)}
-        self.path.write_text(
-            json.dumps(payload, ensure_ascii=False, indent=2), encoding="utf-8"
-        )
-        self._dirty = False
+        self._write_pending()
+        if self._log_records >= self.COMPACT_THRESHOLD:
+            self.compact()
+        if self._bloom is not None:
+            if self._bloom.saturated:
+                # Keep the false-positive rate bounded as the corpus grows
+                self._rebuild_bloom(self._bloom.capacity * 2)
+            if self._bloom_dirty:
+                self._bloom.save(self.bloom_path)
+                self._bloom_dirty = False
+        if self._offsets_dirty:
+            payload = {"version": 2, "files": self._offsets}
+            tmp = self.offsets_path.with_suffix(".json.tmp")
+            tmp.write_text(json.dumps(payload, ensure_ascii=False), encoding="utf-8")
+            os.replace(tmp, self.offsets_path)
+            self._offsets_dirty = False
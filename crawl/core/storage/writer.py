@@ -1,10 +1,39 @@
 from __future__ import annotations
 
 import json
+import logging
+import queue
+import threading
+import time
 from pathlib import Path
+from typing import IO, Any, Callable, Dict, List, Optional
 
 from ..models import Document
 
+logger = logging.getLogger(__name__)
+
+# Called with the documents of each batch once it is on disk
+WrittenCallback = Callable[[List[Document]], None]
+
+
+def document_to_record(document: Document) -> Dict[str, Any]:
+    return {
+        "id": document.id,
+        "source": document.source,
+        "url": document.url,
+        "snapshot_url": document.snapshot_url,
+        "title": document.title,
+        "text": document.text,
+        "lang": document.lang,
+        "published_at": document.published_at,
+        "authors": document.authors,
+        "discovered_via": document.discovered_via,
+        "quality": document.quality,
+        "dup": document.dup,
+        "crawl": document.crawl,
+        "extra": document.extra,
+    }
+
 
 class MultiSourceJsonlWriter:
     """Write documents into separate JSONL files per source.
@@ -12,12 +41,20 @@ class MultiSourceJsonlWriter:
     Rules:
     - Forums go to `forum_{source}.jsonl` (e.g., forum_dcinside.jsonl)
     - Other sources go to `{source}.jsonl` (e.g., gdelt.jsonl, youtube.jsonl)
+
+    ``on_written`` is called with the documents once their lines are written,
+    so callers can index them only after they reach disk.
     """
 
-    def __init__(self, output_root: Path) -> None:
+    suffix = ".jsonl"
+
+    def __init__(
+        self, output_root: Path, *, on_written: Optional[WrittenCallback] = None
+    ) -> None:
         self.output_root = output_root
         self.output_dir = output_root
         self.output_dir.mkdir(parents=True, exist_ok=True)
+        self.on_written = on_written
 
     def _file_path_for(self, document: Document) -> Path:
         discovered_type = None
@@ -25,28 +62,211 @@ class MultiSourceJsonlWriter:
             discovered_type = document.discovered_via.get("type")
         source = document.source or "unknown"
         if discovered_type == "forum":
-            file_name = f"forum_{source}.jsonl"
+            file_name = f"forum_{source}{self.suffix}"
         else:
-            file_name = f"{source}.jsonl"
+            file_name = f"{source}{self.suffix}"
         return self.output_dir / file_name
 
     def append(self, document: Document) -> None:
         file_path = self._file_path_for(document)
         with file_path.open("a", encoding="utf-8") as fh:
-            record = {
-                "id": document.id,
-                "source": document.source,
-                "url": document.url,
-                "snapshot_url": document.snapshot_url,
-                "title": document.title,
-                "text": document.text,
-                "lang": document.lang,
-                "published_at": document.published_at,
-                "authors": document.authors,
-                "discovered_via": document.discovered_via,
-                "quality": document.quality,
-                "dup": document.dup,
-                "crawl": document.crawl,
-                "extra": document.extra,
-            }
+            record = document_to_record(document)
             fh.write(json.dumps(record, ensure_ascii=False) + "\n")
+        if self.on_written is not None:
+            self.on_written([document])
+
+    def flush(self) -> None:
+        """No-op; every append is written through."""
+
+    def close(self) -> None:
+        """No-op; kept for interface parity with BufferedJsonlWriter."""
+
+
+class _FlushRequest:
+    __slots__ = ("done",)
+
+    def __init__(self) -> None:
+        self.done = threading.Event()
+
+
+_STOP = object()
+
+
+class BufferedJsonlWriter(MultiSourceJsonlWriter):
+    """Background-thread JSONL writer with batching and optional zstd.
+
+    ``append`` only enqueues (blocking when the bounded queue is full, so the
+    pipeline gets backpressure instead of unbounded memory). The writer
+    thread keeps one handle per output file open, serializes records and
+    writes them in batches when ``batch_size`` records or ``flush_interval_sec``
+    have accumulated, or when ``flush()`` is called.
+
+    With ``compression="zstd"`` files are named ``*.jsonl.zst``; every flush
+    ends a zstd frame, so the file is always a valid concatenation of frames.
+
+    A failed write is sticky: the failed batch is dropped (``on_written`` never
+    sees it) and every later ``append``/``flush``/``close`` raises, so the
+    caller stops storing instead of silently losing documents.
+    """
+
+    def __init__(
+        self,
+        output_root: Path,
+        *,
+        batch_size: int = 200,
+        flush_interval_sec: float = 1.0,
+        queue_size: int = 1000,
+        compression: Optional[str] = None,
+        zstd_level: int = 3,
+        on_written: Optional[WrittenCallback] = None,
+    ) -> None:
+        super().__init__(output_root, on_written=on_written)
+        self.batch_size = max(1, int(batch_size))
+        self.flush_interval_sec = max(0.0, float(flush_interval_sec))
+        self._zstd: Any = None
+        self._zstd_level = int(zstd_level)
+        if compression == "zstd":
+            try:
+                import zstandard  # type: ignore[import-not-found]
+
+                self._zstd = zstandard
+                self.suffix = ".jsonl.zst"
+            except Exception:  # noqa: BLE001
+                logger.warning("zstandard not installed; writing plain JSONL instead")
+        elif compression:
+            raise ValueError(f"Unsupported output compression: {compression}")
+        self._queue: "queue.Queue[object]" = queue.Queue(maxsize=max(1, queue_size))
+        self._handles: Dict[Path, IO[bytes]] = {}
+        self._streams: Dict[Path, Any] = {}
+        self._buffers: Dict[Path, List[bytes]] = {}
+        self._buffered_docs: List[Document] = []
+        self._buffered = 0
+        self._error: Optional[BaseException] = None
+        self._thread: Optional[threading.Thread] = None
+        self._lock = threading.Lock()
+
+    # ---------- producer side ----------
+    def _ensure_thread(self) -> None:
+        with self._lock:
+            if self._thread is None:
+                self._thread = threading.Thread(
+                    target=self._run, name="jsonl-writer", daemon=True
+                )
+                self._thread.start()
+
+    def append(self, document: Document) -> None:
+        self._raise_pending_error()
+        self._ensure_thread()
+        self._queue.put(document)
+
+    def flush(self) -> None:
+        if self._thread is None:
+            return
+        req = _FlushRequest()
+        self._queue.put(req)
+        req.done.wait()
+        self._raise_pending_error()
+
+    def close(self) -> None:
+        """Flush, close file handles and stop the thread (restarted on append)."""
+        with self._lock:
+            thread, self._thread = self._thread, None
+        if thread is None:
+            return
+        self._queue.put(_STOP)
+        thread.join()
+        self._raise_pending_error()
+
+    def _raise_pending_error(self) -> None:
+        if self._error is not None:
+            raise RuntimeError("JSONL writer thread failed") from self._error
+
+    # ---------- writer thread ----------
+    def _run(self) -> None:
+        last_flush = time.monotonic()
+        while True:
+            timeout = None
+            if self._buffered:
+                deadline = last_flush + self.flush_interval_sec
+                timeout = max(0.0, deadline - time.monotonic())
+            try:
+                item = self._queue.get(timeout=timeout)
+            except queue.Empty:
+                item = None
+            try:
+                if item is _STOP:
+                    self._write_buffers()
+                    self._close_handles()
+                    return
+                if isinstance(item, _FlushRequest):
+                    self._write_buffers()
+                    item.done.set()
+                    last_flush = time.monotonic()
+                    continue
+                if isinstance(item, Document):
+                    path = self._file_path_for(item)
+                    line = json.dumps(document_to_record(item), ensure_ascii=False)
+                    self._buffers.setdefault(path, []).append(
+                        (line + "\n").encode("utf-8")
+                    )
+                    self._buffered_docs.append(item)
+                    self._buffered += 1
+                if self._buffered >= self.batch_size or (
+                    self._buffered
+                    and time.monotonic() - last_flush >= self.flush_interval_sec
+                ):
+                    self._write_buffers()
+                    last_flush = time.monotonic()
+            except Exception as exc:  # noqa: BLE001
+                logger.warning("JSONL writer failed: %s", exc, exc_info=True)
+                if self._error is None:
+                    self._error = exc
+                self._buffers.clear()
+                self._buffered_docs = []
+                self._buffered = 0
+                if isinstance(item, _FlushRequest):
+                    item.done.set()
+                elif item is _STOP:
+                    try:
+                        self._close_handles()
+                    except Exception:  # noqa: BLE001
+                        pass
+                    return
+
+    def _handle_for(self, path: Path) -> Any:
+        stream = self._streams.get(path)
+        if stream is not None:
+            return stream
+        fh = path.open("ab")
+        self._handles[path] = fh
+        if self._zstd is not None:
+            compressor = self._zstd.ZstdCompressor(level=self._zstd_level)
+            stream = compressor.stream_writer(fh, closefd=False)
+        else:
+            stream = fh
+        self._streams[path] = stream
+        return stream
+
+    def _write_buffers(self) -> None:
+        for path, lines in self._buffers.items():
+            if not lines:
+                continue
+            stream = self._handle_for(path)
+            stream.write(b"".join(lines))
+            if self._zstd is not None:
+                stream.flush(self._zstd.FLUSH_FRAME)
+            self._handles[path].flush()
+        self._buffers.clear()
+        written, self._buffered_docs = self._buffered_docs, []
+        self._buffered = 0
+        if written and self.on_written is not None:
+            self.on_written(written)
+
+    def _close_handles(self) -> None:
+        for path, fh in self._handles.items():
+            stream = self._streams.get(path)
+            if stream is not None and stream is not fh:
+                stream.close()
+            fh.close()
+        self._handles.clear()
+        self._streams.clear()
@@ -0,0 +1,145 @@
+# ml/adaptive_limit.py
+"""
+API 동시 요청 수를 응답 상태에 맞춰 조절하는 AIMD 리미터 (표준 라이브러리만 사용).
+
+  - 성공: 지연이 latency_target 이하면 한도를 천천히 올린다 (한도만큼 성공하면 +1).
+  - 429 (rate limit): 한도를 절반으로 줄이고, Retry-After(없으면 지수 백오프)
+    동안 새 요청을 멈춘다.
+  - 지연이 latency_target 을 넘으면 한도를 decrease_factor 배로 줄인다.
+    (줄이는 건 cooldown 초에 한 번만: 이미 나가 있던 요청들의 응답으로
+    연달아 줄어드는 것을 막는다)
+
+사용 예:
+  limiter = AdaptiveLimiter(max_limit=16, initial=4)
+  with limiter.slot() as slot:
+      result = call_api()
+      slot.ok()          # 성공 시 (지연은 slot 이 잰다)
+"""
+
+from __future__ import annotations
+
+import random
+import threading
+import time
+from contextlib import contextmanager
+from typing import Iterator, Optional
+
+
+def is_rate_limit_error(exc: BaseException) -> bool:
+    """openai.RateLimitError 또는 status_code == 429 인 예외."""
+    if type(exc).__name__ == "RateLimitError":
+        return True
+    status = getattr(exc, "status_code", None)
+    if status is None:
+        status = getattr(getattr(exc, "response", None), "status_code", None)
+    return status == 429
+
+
+def retry_after_seconds(exc: BaseException) -> Optional[float]:
+    """응답 헤더의 Retry-After (초) 값. 없거나 숫자가 아니면 None."""
+    headers = getattr(getattr(exc, "response", None), "headers", None) or {}
+    value = headers.get("retry-after") or headers.get("Retry-After")
+    try:
+        return max(0.0, float(value)) if value is not None else None
+    except (TypeError, ValueError):
+        return None
+
+
+class _Slot:
+    def __init__(self, limiter: "AdaptiveLimiter") -> None:
+        self._limiter = limiter
+        self._started = time.monotonic()
+
+    def ok(self) -> None:
+        self._limiter.on_success(time.monotonic() - self._started)
+
+    def rate_limited(self, retry_after: Optional[float] = None) -> None:
+        self._limiter.on_rate_limit(retry_after)
+
+
+class AdaptiveLimiter:
+    def __init__(
+        self,
+        max_limit: int,
+        *,
+        initial: Optional[int] = None,
+        min_limit: int = 1,
+        latency_target: Optional[float] = 30.0,
+        decrease_factor: float = 0.7,
+        cooldown: float = 5.0,
+        base_backoff: float = 2.0,
+        max_backoff: float = 60.0,
+    ) -> None:
+        self.max_limit = max(1, max_limit)
+        self.min_limit = max(1, min(min_limit, self.max_limit))
+        start = initial if initial is not None else self.max_limit
+        self._limit = float(max(self.min_limit, min(start, self.max_limit)))
+        self.latency_target = latency_target
+        self.decrease_factor = decrease_factor
+        self.cooldown = cooldown
+        self.base_backoff = base_backoff
+        self.max_backoff = max_backoff
+
+        self.in_flight = 0
+        self.rate_limited = 0
+        self.slow = 0
+        self._strikes = 0  # 연속 429 횟수 (백오프 지수)
+        self._paused_until = 0.0
+        self._last_decrease = 0.0
+        self._cond = threading.Condition()
+
+    @property
+    def limit(self) -> int:
+        return int(self._limit)
+
+    def acquire(self) -> None:
+        with self._cond:
+            while True:
+                wait = self._paused_until - time.monotonic()
+                if wait <= 0 and self.in_flight < self.limit:
+                    self.in_flight += 1
+                    return
+                self._cond.wait(timeout=wait if wait > 0 else None)
+
+    def release(self) -> None:
+        with self._cond:
+            self.in_flight -= 1
+            self._cond.notify_all()
+
+    @contextmanager
+    def slot(self) -> Iterator[_Slot]:
+        self.acquire()
+        try:
+            yield _Slot(self)
+        finally:
+            self.release()
+
+    def _decrease(self, factor: float, now: float) -> None:
+        if now - self._last_decrease < self.cooldown:
+            return
+        self._limit = max(float(self.min_limit), self._limit * factor)
+        self._last_decrease = now
+
+    def on_success(self, latency: float) -> None:
+        with self._cond:
+            self._strikes = 0
+            if self.latency_target is not None and latency > self.latency_target:
+                self.slow += 1
+                self._decrease(self.decrease_factor, time.monotonic())
+            elif self._limit < self.max_limit:
+                self._limit = min(
+                    float(self.max_limit), self._limit + 1.0 / self._limit
+                )
+            self._cond.notify_all()
+
+    def on_rate_limit(self, retry_after: Optional[float] = None) -> None:
+        with self._cond:
+            now = time.monotonic()
+            self.rate_limited += 1
+            self._strikes += 1
+            self._decrease(0.5, now)
+            if retry_after is None:
+                backoff = self.base_backoff * 2 ** (self._strikes - 1)
+                retry_after = min(self.max_backoff, backoff) * random.uniform(0.5, 1.0)
+            self._paused_until = max(self._paused_until, now + retry_after)
+            self._cond.notify_all()
@@ -5,13 +5,18 @@ import json
 import os
 import re
 from dataclasses import dataclass
-from typing import Any, Dict, Optional
+from typing import Any, Dict, List, Optional, Sequence, Tuple
 
-from openai import OpenAI
+from openai import OpenAI, RateLimitError
 from dotenv import load_dotenv  # ✅ .env 읽기용
-from tenacity import retry, stop_after_attempt, wait_fixed  # retry
+from tenacity import (  # retry
+    retry,
+    retry_if_not_exception_type,
+    stop_after_attempt,
+    wait_random_exponential,
+)
 
-from ml.prompts import SYSTEM_PROMPT_NPS
+from ml.prompts import SYSTEM_PROMPT_NPS, SYSTEM_PROMPT_NPS_BATCH
 
 SYSTEM_PROMPT = SYSTEM_PROMPT_NPS
 
@@ -38,6 +43,18 @@ def load_config() -> GrokConfig:
     return GrokConfig(api_key=api_key, base_url=base_url, model=model)
 
 
+# 배치 요청에서 항목 하나의 응답(JSON 객체 한 개)에 잡는 토큰 수
+BATCH_ITEM_MAX_TOKENS = 200
+
+
+def estimate_tokens(text: str) -> int:
+    """
+    입력 토큰 수 대략 추정 (배치 크기 제한용, 넉넉하게):
+    한글은 글자당 1토큰 안팎, 영어는 3~4글자당 1토큰이라 UTF-8 바이트/3 으로 잡는다.
+    """
+    return len(text.encode("utf-8")) // 3 + 1
+
+
 # # 🔥 DCInside 관련성 강제 보정용 키워드 패턴 (확장: 미납, 개혁, 다단계, 파산 등 추가)
 # DCINSIDE_NPS_PATTERN = re.compile(
 #     r"(국민연금|연금공단|\bNPS\b|national pension|연금|기금|고갈|수익률|보험료|수급|노후|소득대체율|미납|개혁|다단계|파산)",
@@ -48,9 +65,12 @@ def load_config() -> GrokConfig:
 class GrokClient:
     def __init__(self, config: Optional[GrokConfig] = None) -> None:
         self.config = config or load_config()
+        # SDK 자체 재시도(기본 2회)는 끈다: 429 를 SDK 가 삼키면 AdaptiveLimiter
+        # (ml/adaptive_limit.py)가 한도를 줄이지 못한다. 재시도는 tenacity/limiter 몫.
         self.client = OpenAI(
             base_url=self.config.base_url,
             api_key=self.config.api_key,
+            max_retries=0,
         )
         self.model = self.config.model
 
@@ -177,7 +197,78 @@ class GrokClient:
         ]
         return "\n".join(str(x) for x in header_lines)
 
-    @retry(stop=stop_after_attempt(3), wait=wait_fixed(2))
+    def build_batch_prompt(self, items: Sequence[Tuple[str, Dict[str, Any]]]) -> str:
+        """항목마다 build_user_prompt 와 같은 헤더를 ITEM_START/ITEM_END 로 감싼다."""
+        blocks = []
+        for i, (text, meta) in enumerate(items):
+            blocks.append(
+                "\n".join(
+                    str(x)
+                    for x in (
+                        f"ITEM_START id={i}",
+                        f"source: {meta.get('source')}",
+                        f"doc_type: {meta.get('doc_type')}",
+                        f"lang: {meta.get('lang')}",
+                        f"published_at: {meta.get('published_at')}",
+                        "COMMENT_START",
+                        text,
+                        "COMMENT_END",
+                        "ITEM_END",
+                    )
+                )
+            )
+        return (
+            f"아래는 분석 대상 텍스트 {len(items)}개입니다.\n\n"
+            + "\n\n".join(blocks)
+        )
+
+    def _extract_json_array(self, text: str) -> List[Any]:
+        text = text.strip()
+        m = re.search(r"\[.*\]", text, re.DOTALL)
+        if m:
+            parsed = json.loads(m.group(0))
+        else:
+            # 배열 대신 {"results": [...]} 로 돌려주는 경우
+            parsed = self._extract_json(text).get("results")
+        if not isinstance(parsed, list):
+            raise ValueError(f"JSON 배열을 찾을 수 없음: {text[:200]}")
+        return parsed
+
+    def _batch_items(self, parsed: List[Any], n: int) -> List[Optional[Dict[str, Any]]]:
+        """
+        응답 배열을 항목 순서에 맞춘다. "id" 가 있으면 id 로, 없으면 길이가 같을 때만
+        순서대로 맞춘다. 형식이 맞지 않는 항목은 None.
+        """
+        by_id: Dict[int, Dict[str, Any]] = {}
+        for item in parsed:
+            if isinstance(item, dict) and isinstance(item.get("id"), int):
+                by_id.setdefault(item["id"], item)
+        if not by_id and len(parsed) == n:
+            by_id = {i: item for i, item in enumerate(parsed) if isinstance(item, dict)}
+
+        items: List[Optional[Dict[str, Any]]] = []
+        for i in range(n):
+            item = by_id.get(i)
+            if item is None or not isinstance(item.get("is_related"), bool):
+                items.append(None)
+                continue
+            try:
+                for k in ("negative", "neutral", "positive"):
+                    float(item.get(k, 0.0) or 0.0)
+            except (TypeError, ValueError):
+                items.append(None)
+                continue
+            items.append(item)
+        return items
+
+    # 429 는 여기서 재시도하지 않는다: 호출한 쪽(ml/adaptive_limit.py)이
+    # 동시 요청 수를 줄이고 기다렸다가 다시 보낸다.
+    @retry(
+        stop=stop_after_attempt(3),
+        wait=wait_random_exponential(multiplier=1, max=20),
+        retry=retry_if_not_exception_type(RateLimitError),
+        reraise=True,
+    )
     def analyze_sentiment(self, text: str, meta: Dict[str, Any]) -> Dict[str, Any]:
         if not text or not text.strip():
             return {
@@ -207,3 +298,53 @@ class GrokClient:
             {**parsed, "text": text, "source": meta.get("source")}
         )
         return normalized
+
+    @retry(
+        stop=stop_after_attempt(3),
+        wait=wait_random_exponential(multiplier=1, max=20),
+        retry=retry_if_not_exception_type(RateLimitError),
+        reraise=True,
+    )
+    def analyze_sentiment_batch(
+        self, items: Sequence[Tuple[str, Dict[str, Any]]]
+    ) -> List[Optional[Dict[str, Any]]]:
+        """
+        (text, meta) 여러 개를 한 번의 요청으로 분석한다 (SYSTEM_PROMPT_NPS_BATCH).
+        반환 리스트는 items 와 같은 순서이고, 응답에서 형식이 맞지 않았던 항목은
+        None 이다 (호출한 쪽이 analyze_sentiment 로 한 건씩 다시 요청).
+        응답 전체를 JSON 배열로 읽지 못하면 예외 (tenacity 재시도 대상).
+        """
+        results: List[Optional[Dict[str, Any]]] = [None] * len(items)
+        send: List[int] = []
+        for i, (text, _) in enumerate(items):
+            if text and text.strip():
+                send.append(i)
+            else:
+                results[i] = self.analyze_sentiment(text, {})
+        if not send:
+            return results
+
+        user_content = self.build_batch_prompt([items[i] for i in send])
+        completion = self.client.chat.completions.create(
+            model=self.model,
+            messages=[
+                {"role": "system", "content": SYSTEM_PROMPT_NPS_BATCH},
+                {"role": "user", "content": user_content},
+            ],
+            temperature=0.1,
+            max_tokens=64 + BATCH_ITEM_MAX_TOKENS * len(send),
+        )
+
+        raw = completion.choices[0].message.content or ""
+        parsed = self._batch_items(self._extract_json_array(raw), len(send))
+        for i, item in zip(send, parsed):
+            if item is None:
+                continue
+            text, meta = items[i]
+            try:
+                results[i] = self._normalize_result(
+                    {**item, "text": text, "source": meta.get("source")}
+                )
+            except (TypeError, ValueError):
+                results[i] = None
+        return results
@@ -4,12 +4,38 @@ from __future__ import annotations
 import argparse
 import json
 import logging
-from concurrent.futures import ThreadPoolExecutor, as_completed
-from dataclasses import dataclass
+import os
+from concurrent.futures import FIRST_COMPLETED, Future, ThreadPoolExecutor, wait
+from dataclasses import asdict, dataclass, replace
+from itertools import islice
 from pathlib import Path
-from typing import Any, Dict, List, Optional, Tuple
+from typing import (
+    Any,
+    BinaryIO,
+    Callable,
+    Dict,
+    Iterator,
+    List,
+    Optional,
+    Tuple,
+    TypeVar,
+)
+
+from common.jsonl_state import (
+    fingerprint,
+    iter_line_range,
+    load_json_state,
+    save_json_state,
+)
 
-from .grok_client import GrokClient  # , DCINSIDE_NPS_PATTERN  # 패턴 import
+from .adaptive_limit import AdaptiveLimiter, is_rate_limit_error, retry_after_seconds
+from .grok_client import (  # , DCINSIDE_NPS_PATTERN  # 패턴 import
+    GrokClient,
+    estimate_tokens,
+)
+from .nps_sentiment import LocalTier
+from .prompts import BATCH_PROMPT_VERSION, PROMPT_VERSION
+from .result_cache import SentimentCache
 
 
 logger = logging.getLogger(__name__)
@@ -106,30 +132,28 @@ def extract_text_and_meta(obj: Dict[str, Any]) -> TextAndMeta:
 # ---------- JSONL 입출력 ----------
 
 
-def read_jsonl(path: str | Path, limit: Optional[int] = None) -> List[Dict[str, Any]]:
+def iter_jsonl(
+    path: str | Path, start: int = 0
+) -> Iterator[Tuple[int, Dict[str, Any]]]:
+    """JSONL 을 start 바이트부터 읽어 (줄 끝 위치, 레코드) 로 돌려준다."""
     p = Path(path)
     if not p.exists():
         raise FileNotFoundError(f"입력 파일을 찾을 수 없습니다: {p}")
 
-    records: List[Dict[str, Any]] = []
-    with p.open("r", encoding="utf-8") as f:
-        for line_no, line in enumerate(f, start=1):
-            line = line.strip()
-            if not line:
-                continue
-            try:
-                obj = json.loads(line)
-            except json.JSONDecodeError as exc:
-                logger.warning(
-                    "[WARN] 라인 %d JSON 파싱 실패, 스킵: %s", line_no, str(exc)
-                )
-                continue
-            records.append(obj)
-            if limit is not None and len(records) >= limit:
-                break
-
-    logger.info("[INFO] 입력에서 %d개 레코드 로드", len(records))
-    return records
+    for line_no, (offset, line) in enumerate(
+        iter_line_range(p, start, partial=True), start=1
+    ):
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            obj = json.loads(line)
+        except json.JSONDecodeError as exc:
+            logger.warning(
+                "[WARN] 라인 %d JSON 파싱 실패, 스킵: %s", line_no, str(exc)
+            )
+            continue
+        yield offset, obj
 
 
 def write_jsonl(path: str | Path, records: List[Dict[str, Any]]) -> None:
@@ -143,112 +167,623 @@ def write_jsonl(path: str | Path, records: List[Dict[str, Any]]) -> None:
             f.write("\n")
 
 
+def _is_parquet(path: str | Path) -> bool:
+    return Path(path).suffix.lower() == ".parquet"
+
+
+def iter_records(
+    path: str | Path, skip: int = 0, start: Optional[int] = None
+) -> Iterator[Tuple[Optional[int], Dict[str, Any]]]:
+    """
+    JSONL 또는 .parquet 데이터셋(preprocess_merge/columnar.py) 입력을 하나씩 읽어
+    (다음 레코드를 읽을 바이트 위치, 레코드) 로 돌려준다 (Parquet 은 위치 None).
+    재시작할 때 JSONL 은 start 위치로 바로 넘어가고, Parquet 은 skip 개를 건너뛴다.
+    """
+    if not _is_parquet(path):
+        records: Iterator[Tuple[Optional[int], Dict[str, Any]]]
+        if start is not None:
+            records = iter_jsonl(path, start)
+        else:
+            records = islice(iter_jsonl(path), skip, None)
+        yield from records
+        return
+
+    # lazy import: pyarrow 는 선택 의존성
+    from preprocess.preprocess_merge.columnar import iter_parquet_records
+
+    if not Path(path).exists():
+        raise FileNotFoundError(f"입력 파일을 찾을 수 없습니다: {path}")
+    for obj in islice(iter_parquet_records(path), skip, None):
+        yield None, obj
+
+
+def write_records(path: str | Path, records: List[Dict[str, Any]]) -> None:
+    """출력 경로가 .parquet 이면 source/month 파티션 Parquet 데이터셋으로 쓴다."""
+    if not _is_parquet(path):
+        write_jsonl(path, records)
+        return
+
+    from preprocess.preprocess_merge.columnar import write_parquet_dataset
+
+    write_parquet_dataset(path, records)
+
+
+# ---------- 진행 상태 (중단 후 재시작) ----------
+
+
+@dataclass
+class Progress:
+    done: int = 0  # 출력에 쓴 레코드 수 (= 다음에 처리할 입력 인덱스)
+    output_bytes: int = 0  # 출력 JSONL 에서 그 레코드들이 차지하는 바이트
+    input_offset: Optional[int] = None  # JSONL 입력에서 다음에 읽을 위치
+    input_fingerprint: Optional[Dict[str, Any]] = None
+
+
+def progress_path(output_path: str | Path) -> Path:
+    p = Path(output_path)
+    return p.with_name(p.name + ".progress.json")
+
+
+def load_progress(input_path: str | Path, output_path: str | Path) -> Progress:
+    """
+    지난 실행의 진행 상태. 출력이 그보다 짧거나, 입력의 처리한 앞부분이
+    바뀌었으면 처음부터 다시 한다.
+    """
+    state_file = progress_path(output_path)
+    try:
+        progress = Progress(**load_json_state(state_file, {}))
+    except (TypeError, json.JSONDecodeError):
+        logger.warning("[WARN] 진행 상태 파일을 읽을 수 없어 처음부터: %s", state_file)
+        return Progress()
+
+    out = Path(output_path)
+    if progress.done and (
+        not out.exists() or out.stat().st_size < progress.output_bytes
+    ):
+        logger.warning("[WARN] 출력이 진행 상태보다 짧아 처음부터 다시 처리합니다.")
+        return Progress()
+
+    if progress.input_offset is not None:
+        in_path = Path(input_path)
+        if (
+            in_path.stat().st_size < progress.input_offset
+            or fingerprint(in_path, progress.input_offset)
+            != progress.input_fingerprint
+        ):
+            logger.warning("[WARN] 입력이 바뀌어 처음부터 다시 처리합니다.")
+            return Progress()
+    return progress
+
+
+class OrderedWriter:
+    """
+    결과를 입력 순서(인덱스)대로 바로바로 출력에 이어 쓴다. 먼저 끝난 뒤쪽
+    레코드는 앞 레코드가 끝날 때까지 잡아 둔다 (크기는 실행 창(window)이 제한).
+    JSONL 출력은 checkpoint_every 건마다 진행 상태를 저장해서, 중단돼도 다음
+    실행(resume)이 이미 쓴 레코드를 건너뛴다. 분석 실패(ERROR_RESULT) 레코드를
+    쓴 뒤로는 저장하는 진행 상태가 첫 실패 레코드 앞에 머문다: resume 하면
+    거기서부터 다시 분석한다 (그 뒤에 성공한 레코드는 캐시에서 바로 나온다).
+    .parquet 출력은 끝에 한 번에 쓴다 (재시작 불가).
+    """
+
+    def __init__(
+        self,
+        input_path: str | Path,
+        output_path: str | Path,
+        progress: Progress,
+        checkpoint_every: int = 100,
+    ) -> None:
+        self.input_path = Path(input_path)
+        self.output_path = Path(output_path)
+        self.progress = progress
+        self.checkpoint_every = max(1, checkpoint_every)
+        self.written = 0  # 이번 실행에서 쓴 수
+        self.related = 0
+        self.failed = 0
+        # 첫 분석 실패 레코드를 쓰기 직전의 진행 상태 (이후 체크포인트는 이것을 저장)
+        self._resume_from: Optional[Progress] = None
+        self._held: Dict[int, Tuple[Dict[str, Any], Optional[int]]] = {}
+        self._rows: Optional[List[Dict[str, Any]]] = None
+        self._fw: Optional[BinaryIO] = None
+
+        self.output_path.parent.mkdir(parents=True, exist_ok=True)
+        if _is_parquet(self.output_path):
+            self._rows = []
+            return
+        if progress.done:
+            self._fw = self.output_path.open("r+b")
+            self._fw.truncate(progress.output_bytes)
+            self._fw.seek(progress.output_bytes)
+        else:
+            self._fw = self.output_path.open("wb")
+
+    @property
+    def next_index(self) -> int:
+        return self.progress.done
+
+    def put(
+        self, idx: int, record: Dict[str, Any], input_offset: Optional[int]
+    ) -> None:
+        self._held[idx] = (record, input_offset)
+        while self.progress.done in self._held:
+            record, offset = self._held.pop(self.progress.done)
+            self._write(record, offset)
+
+    def _write(self, record: Dict[str, Any], input_offset: Optional[int]) -> None:
+        if record.get(ERROR_KEY):
+            self.failed += 1
+            if self._resume_from is None:
+                self._resume_from = replace(self.progress)
+        if self._fw is not None:
+            line = (json.dumps(record, ensure_ascii=False) + "\n").encode("utf-8")
+            self._fw.write(line)
+            self.progress.output_bytes += len(line)
+        else:
+            assert self._rows is not None
+            self._rows.append(record)
+        self.progress.done += 1
+        self.progress.input_offset = input_offset
+        self.written += 1
+        self.related += 1 if record.get("is_related") else 0
+        if self.written % self.checkpoint_every == 0:
+            self.checkpoint()
+
+    def checkpoint(self) -> None:
+        if self._fw is None:
+            return
+        self._fw.flush()
+        os.fsync(self._fw.fileno())
+        progress = self._resume_from or self.progress
+        if progress.input_offset is not None:
+            progress.input_fingerprint = fingerprint(
+                self.input_path, progress.input_offset
+            )
+        state_file = progress_path(self.output_path)
+        tmp = state_file.with_name(state_file.name + ".tmp")
+        save_json_state(tmp, asdict(progress))
+        os.replace(tmp, state_file)
+
+    def close(self) -> None:
+        if self._held:
+            logger.warning(
+                "[WARN] 앞 레코드가 끝나지 않아 쓰지 못한 결과 %d개 (다음 실행에서 다시 처리)",
+                len(self._held),
+            )
+        if self._resume_from is not None:
+            logger.warning(
+                "[WARN] 분석 실패 %d건: 진행 상태는 첫 실패(index=%d)에서 멈췄습니다 "
+                "(--resume 으로 다시 분석)",
+                self.failed,
+                self._resume_from.done,
+            )
+        if self._fw is not None:
+            self.checkpoint()
+            self._fw.close()
+        elif self._rows is not None:
+            write_records(self.output_path, self._rows)
+
+
 # ---------- 개별 레코드 분석 ----------
 
+# 빈 텍스트일 때 쓰는 결과 (규칙에 맞게 무관 처리)
+UNRELATED_RESULT: Dict[str, Any] = {
+    "is_related": False,
+    "negative": 0.0,
+    "neutral": 0.0,
+    "positive": 0.0,
+    "label": "무관",
+    "explanation": "국민연금과 관련 없음",
+}
+
+# 분석이 실패했을 때 쓰는 결과. 무관(UNRELATED_RESULT)과 구분되도록 감성 값은
+# 비우고 ERROR_KEY 를 단다 (캐시하지 않음, OrderedWriter 참고).
+ERROR_KEY = "sentiment_error"
+ERROR_RESULT: Dict[str, Any] = {
+    "is_related": None,
+    "negative": None,
+    "neutral": None,
+    "positive": None,
+    "label": None,
+    "explanation": "분석 실패",
+    ERROR_KEY: True,
+}
+
+# 429 를 받은 요청을 다시 보내는 최대 횟수
+MAX_RATE_LIMIT_ATTEMPTS = 6
+
+T = TypeVar("T")
+
+
+def analyze_text(client: GrokClient, tm: TextAndMeta) -> Dict[str, Any]:
+    """
+    텍스트 한 건에 대해 Grok 감성분석을 수행하고 sentiment 필드 dict를 반환한다.
+    예외는 호출한 쪽에서 처리한다 (실패는 캐시하지 않고 ERROR_RESULT 로 기록).
+    """
+    return client.analyze_sentiment(tm.text, tm.meta)
 
-def analyze_one(
-    client: GrokClient,
-    index: int,
-    obj: Dict[str, Any],
-) -> Tuple[int, Dict[str, Any]]:
+
+def call_limited(limiter: AdaptiveLimiter, fn: Callable[..., T], *args: Any) -> T:
     """
-    한 레코드에 대해 Grok 감성분석을 수행하고,
-    원본 + sentiment 필드가 합쳐진 dict를 반환한다.
+    limiter 가 허락하는 동시 요청 수 안에서 fn(*args) 를 부른다.
+    429 면 limiter 가 한도를 줄이고 기다리게 한 뒤 다시 보낸다.
     """
+    for attempt in range(1, MAX_RATE_LIMIT_ATTEMPTS + 1):
+        with limiter.slot() as slot:
+            try:
+                result = fn(*args)
+            except Exception as exc:
+                if not is_rate_limit_error(exc) or attempt == MAX_RATE_LIMIT_ATTEMPTS:
+                    raise
+                slot.rate_limited(retry_after_seconds(exc))
+                continue
+            slot.ok()
+            return result
+    raise AssertionError("unreachable")
+
+
+def analyze_limited(
+    client: GrokClient, limiter: AdaptiveLimiter, tm: TextAndMeta
+) -> Dict[str, Any]:
+    return call_limited(limiter, analyze_text, client, tm)
+
+
+def analyze_batch(
+    client: GrokClient, limiter: AdaptiveLimiter, items: List[TextAndMeta]
+) -> List[Tuple[Optional[Dict[str, Any]], str]]:
+    """
+    items 를 한 번의 요청으로 분석한다 (GrokClient.analyze_sentiment_batch).
+    배치 응답에서 형식이 맞지 않은 항목(배치 요청 자체가 실패하면 전부)은
+    한 건씩 다시 요청하고, 그것도 실패한 항목은 None (ERROR_RESULT, 캐시 안 함).
+    항목이 하나면 그냥 한 건 요청 (예외는 호출한 쪽에서 처리).
+    항목마다 (결과, 그 결과를 만든 프롬프트 버전) 을 돌려준다 (캐시 키용).
+    """
+    if len(items) == 1:
+        return [(analyze_limited(client, limiter, items[0]), PROMPT_VERSION)]
+
+    pairs = [(tm.text, tm.meta) for tm in items]
     try:
-        tm = extract_text_and_meta(obj)
-        result = client.analyze_sentiment(tm.text, tm.meta)
+        results = call_limited(limiter, client.analyze_sentiment_batch, pairs)
     except Exception as exc:
-        logger.warning("[WARN] 레코드 index=%d 분석 실패: %s", index, repr(exc))
-        # 안전한 fallback (규칙에 맞게 무관 처리)
-        result = {
-            "is_related": False,
-            "negative": 0.0,
-            "neutral": 0.0,
-            "positive": 0.0,
-            "label": "무관",
-            "explanation": "국민연금과 관련 없음",
-        }
+        logger.warning(
+            "[WARN] 배치 요청(%d개) 실패, 한 건씩 다시 요청: %s", len(items), repr(exc)
+        )
+        results = [None] * len(items)
+
+    retry_idx = [i for i, r in enumerate(results) if r is None]
+    if retry_idx and len(retry_idx) < len(items):
+        logger.warning(
+            "[WARN] 배치 응답 %d개 중 %d개 형식 오류, 한 건씩 다시 요청",
+            len(items),
+            len(retry_idx),
+        )
+    versions = [BATCH_PROMPT_VERSION] * len(items)
+    for i in retry_idx:
+        versions[i] = PROMPT_VERSION
+        try:
+            results[i] = analyze_limited(client, limiter, items[i])
+        except Exception as exc:
+            logger.warning(
+                "[WARN] id=%s 분석 실패: %s", items[i].meta.get("id"), repr(exc)
+            )
+    return list(zip(results, versions))
+
+
+class BatchBuffer:
+    """
+    캐시 미스 텍스트를 모아 배치 요청 하나로 묶는다.
+    max_items 개가 차거나, 입력 토큰 추정치가 max_tokens 를 넘기 전에 내보낸다.
+    (혼자서 max_tokens 를 넘는 긴 글은 한 건짜리 배치가 된다)
+    """
+
+    def __init__(self, max_items: int, max_tokens: int) -> None:
+        self.max_items = max(1, max_items)
+        self.max_tokens = max_tokens
+        self.keys: List[str] = []
+        self.items: List[TextAndMeta] = []
+        self.tokens = 0
+
+    def __len__(self) -> int:
+        return len(self.items)
+
+    def fits(self, tm: TextAndMeta) -> bool:
+        if not self.items:
+            return True
+        return (
+            len(self.items) < self.max_items
+            and self.tokens + estimate_tokens(tm.text) <= self.max_tokens
+        )
+
+    def add(self, key: str, tm: TextAndMeta) -> None:
+        self.keys.append(key)
+        self.items.append(tm)
+        self.tokens += estimate_tokens(tm.text)
+
+    def full(self) -> bool:
+        return len(self.items) >= self.max_items or self.tokens >= self.max_tokens
 
-    merged = {**obj, **result}
-    return index, merged
+    def take(self) -> Tuple[List[str], List[TextAndMeta]]:
+        keys, items = self.keys, self.items
+        self.keys, self.items, self.tokens = [], [], 0
+        return keys, items
+
+
+def default_cache_path(output_path: str | Path) -> Path:
+    """같은 출력 폴더의 감성분석 실행끼리 캐시를 공유한다."""
+    return Path(output_path).parent / "grok_cache.sqlite"
 
 
 # ---------- 전체 파일 처리 ----------
 
+# 대기 중인 레코드: (입력 인덱스, 원본 레코드, 다음 입력 위치)
+Waiting = List[Tuple[int, Dict[str, Any], Optional[int]]]
+
 
 def process_file(
     input_path: str | Path,
     output_path: str | Path,
     limit: Optional[int] = None,
-    workers: int = 4,  # 수정: 기본 4
+    workers: int = 8,
+    cache_path: Optional[str | Path] = None,
+    use_cache: bool = True,
+    invalidate: Optional[str] = None,
+    resume: bool = False,
+    window: Optional[int] = None,
+    checkpoint_every: int = 100,
+    latency_target: Optional[float] = 30.0,
+    batch_size: int = 1,
+    batch_tokens: int = 2000,
+    local_model: Optional[str | Path] = None,
+    local_batch: int = 64,
+    local_threads: Optional[int] = None,
+    local_threshold: float = 0.9,
+    local_label_threshold: float = 0.8,
 ) -> None:
-    records = read_jsonl(input_path, limit=limit)
-    total = len(records)
-    if total == 0:
-        logger.warning("[WARN] 입력에 유효한 레코드가 없습니다.")
+    """
+    입력을 한 건씩 읽어 분석하고, 결과를 입력 순서대로 바로 출력에 이어 쓴다.
+
+    - workers: 동시 요청 수 상한. 실제 동시 요청 수는 AdaptiveLimiter
+      (ml/adaptive_limit.py)가 429/지연에 맞춰 1 ~ workers 사이에서 조절한다.
+    - window: 읽었지만 아직 출력에 못 쓴 레코드 수 상한 (기본 workers*8).
+      메모리는 입력 크기가 아니라 window 에 비례한다.
+    - resume=True: 지난 실행의 진행 상태(<output>.progress.json)를 읽어, 이미 쓴
+      레코드는 건너뛰고 출력에 이어 쓴다. limit 은 이미 쓴 것까지 합친 수.
+    - use_cache=True 이면 결과 캐시(ml/result_cache.py)를 먼저 조회하고,
+      미스인 텍스트만 (같은 텍스트는 한 번만) API 로 분석해 캐시에 저장한다.
+      invalidate: "stale" 이면 현재 프롬프트 버전(단건/배치 둘 다)/모델이 아닌
+      캐시 행을, "all" 이면 전부 지운 뒤 시작한다.
+    - batch_size > 1: 캐시 미스 텍스트를 최대 batch_size 개, 입력 토큰 추정
+      batch_tokens 이하로 묶어 한 번의 요청으로 분석한다 (BatchBuffer).
+      배치 결과는 프롬프트가 달라 BATCH_PROMPT_VERSION 으로 따로 캐시하고,
+      한 건씩 다시 보낸 항목은 PROMPT_VERSION 으로 캐시한다. 캐시 조회는 배치
+      버전을 먼저, 없으면 단건 버전을 본다.
+    - local_model: 로컬 ONNX 모델 디렉터리(ml/local_model.py). 주면 캐시 미스를
+      local_batch 개씩 로컬 모델로 먼저 판정하고(LocalTier, ml/nps_sentiment.py),
+      확신이 낮은 행만 Grok 으로 보낸다. 로컬 판정 결과는 캐시하지 않는다.
+      local_threshold: 무관/관련 판정 확률 기준, local_label_threshold: 감성 라벨 기준.
+    """
+    workers = max(1, workers)
+    window = max(1, window or workers * 8)
+
+    progress = Progress()
+    if resume and _is_parquet(output_path):
+        logger.warning("[WARN] .parquet 출력은 재시작을 지원하지 않아 처음부터 처리합니다.")
+    elif resume:
+        progress = load_progress(input_path, output_path)
+        if progress.done:
+            logger.info("[INFO] 이전 실행에서 쓴 %d개 레코드는 건너뜁니다.", progress.done)
+
+    if limit is not None and progress.done >= limit:
+        logger.info("[INFO] 이미 %d개 레코드를 처리했습니다.", progress.done)
         return
 
-    logger.info("[INFO] 총 %d개 레코드 처리 예정, workers=%d", total, workers)
+    if _is_parquet(input_path):
+        records = iter_records(input_path, skip=progress.done)
+    else:
+        records = iter_records(input_path, start=progress.input_offset or 0)
 
     client = GrokClient()
-
-    results: Dict[int, Dict[str, Any]] = {}
-    processed = 0
-    success_count = 0  # 추가: 성공률 로깅
-
-    if workers <= 1:
-        for idx, obj in enumerate(records):
-            _, merged = analyze_one(client, idx, obj)
-            results[idx] = merged
-            processed += 1
-            success_count += 1 if merged.get("is_related") else 0  # 예시
-            if processed % 10 == 0 or processed == total:
-                logger.info(
-                    "[INFO] 처리 완료: %d/%d (성공률: %.2f%%)",
-                    processed,
-                    total,
-                    (success_count / processed * 100) if processed > 0 else 0,
+    limiter = AdaptiveLimiter(
+        workers, initial=min(workers, 4), latency_target=latency_target
+    )
+    logger.info("[INFO] 처리 시작: 동시 요청 최대 %d, window=%d", workers, window)
+
+    cache: Optional[SentimentCache] = None
+    if use_cache:
+        single = batch_size <= 1
+        cache = SentimentCache(
+            cache_path or default_cache_path(output_path),
+            model=client.model,
+            prompt_version=PROMPT_VERSION if single else BATCH_PROMPT_VERSION,
+            # 배치 모드도 단건 재요청 결과를 쓴다 (analyze_batch)
+            lookup_versions=(
+                (PROMPT_VERSION,) if single else (BATCH_PROMPT_VERSION, PROMPT_VERSION)
+            ),
+        )
+        if invalidate:
+            removed = cache.invalidate(everything=invalidate == "all")
+            logger.info("[INFO] 캐시 무효화(%s): %d개 삭제", invalidate, removed)
+
+    local: Optional[LocalTier] = None
+    if local_model is not None:
+        from .local_model import LocalSentimentModel
+
+        local = LocalTier(
+            LocalSentimentModel(
+                local_model, threads=local_threads, max_batch=local_batch
+            ),
+            unrelated_threshold=local_threshold,
+            related_threshold=local_threshold,
+            label_threshold=local_label_threshold,
+        )
+    # 로컬 모델 판정을 기다리는 캐시 미스
+    local_buf: List[Tuple[str, TextAndMeta]] = []
+
+    writer = OrderedWriter(input_path, output_path, progress, checkpoint_every)
+    in_flight: Dict[Future, List[str]] = {}
+    batch = BatchBuffer(batch_size, batch_tokens)
+    # 텍스트 키 → 그 결과를 기다리는 레코드들 (같은 텍스트는 한 번만 요청)
+    # (캐시를 끄면 레코드마다 따로 분석: 키 = 레코드 번호)
+    waiting: Dict[str, Waiting] = {}
+    # 캐시 키 → 그 텍스트 (결과를 만든 프롬프트 버전의 키로 저장할 때 쓴다)
+    texts: Dict[str, TextAndMeta] = {}
+    duplicates = 0
+    requests = 0
+
+    def write(idx: int, merged: Dict[str, Any], offset: Optional[int]) -> None:
+        writer.put(idx, merged, offset)
+        if writer.written and writer.written % 50 == 0:
+            logger.info(
+                "[INFO] 처리 완료: %d개 (이번 실행 %d, 관련 비율: %.2f%%), "
+                "동시 요청 한도 %d, 진행 중 %d",
+                writer.next_index,
+                writer.written,
+                writer.related / writer.written * 100,
+                limiter.limit,
+                len(in_flight),
+            )
+
+    def complete(
+        key: str, result: Optional[Dict[str, Any]], version: Optional[str] = None
+    ) -> None:
+        """version: 결과를 만든 프롬프트 버전 (None = 캐시하지 않음)."""
+        tm = texts.pop(key, None)
+        if cache is not None and result is not None and version and tm is not None:
+            cache.put(cache.key(tm.text, tm.meta, version), result, version)
+        merged = result if result is not None else ERROR_RESULT
+        for idx, obj, offset in waiting.pop(key):
+            write(idx, {**obj, **merged}, offset)
+
+    def drain(block: bool) -> None:
+        if not in_flight:
+            return
+        done, _ = wait(
+            in_flight, timeout=None if block else 0, return_when=FIRST_COMPLETED
+        )
+        for future in done:
+            keys = in_flight.pop(future)
+            try:
+                results = future.result()
+            except Exception as exc:
+                logger.warning(
+                    "[WARN] 레코드 index=%d 분석 실패: %s",
+                    waiting[keys[0]][0][0],
+                    repr(exc),
                 )
-    else:
-        with ThreadPoolExecutor(max_workers=workers) as executor:
-            futures = {
-                executor.submit(analyze_one, client, idx, obj): idx
-                for idx, obj in enumerate(records)
-            }
-
-            for future in as_completed(futures):
-                idx = futures[future]
-                try:
-                    _, merged = future.result()
-                    success_count += 1 if merged.get("is_related") else 0
-                except Exception as exc:
-                    logger.warning(
-                        "[WARN] index=%d future 처리 중 예외: %s", idx, repr(exc)
-                    )
-                    merged = {
-                        **records[idx],
-                        "is_related": False,
-                        "negative": 0.0,
-                        "neutral": 0.0,
-                        "positive": 0.0,
-                        "label": "무관",
-                        "explanation": "국민연금과 관련 없음",
-                    }
-                results[idx] = merged
-                processed += 1
-                if processed % 10 == 0 or processed == total:
-                    logger.info(
-                        "[INFO] 처리 완료: %d/%d (성공률: %.2f%%)",
-                        processed,
-                        total,
-                        (success_count / processed * 100) if processed > 0 else 0,
-                    )
-
-    # 인덱스 순서대로 정렬해서 출력
-    ordered_records = [results[i] for i in range(total)]
-    write_jsonl(output_path, ordered_records)
-    logger.info("[INFO] 모든 작업 완료. 결과: %s", Path(output_path).resolve())
+                results = [(None, "")] * len(keys)
+            for key, (result, version) in zip(keys, results):
+                complete(key, result, version)
+
+    def submit() -> None:
+        nonlocal requests
+        keys, items = batch.take()
+        in_flight[executor.submit(analyze_batch, client, limiter, items)] = keys
+        requests += 1
+
+    def send(key: str, tm: TextAndMeta) -> None:
+        if not batch.fits(tm):
+            submit()
+        batch.add(key, tm)
+        if batch.full():
+            submit()
+
+    def screen() -> None:
+        assert local is not None
+        results = local.screen([tm.text for _, tm in local_buf])
+        for (key, tm), result in zip(local_buf, results):
+            if result is not None:
+                complete(key, result.to_dict())
+            else:
+                send(key, tm)
+        local_buf.clear()
+
+    def flush() -> None:
+        if local_buf:
+            screen()
+        if batch:
+            submit()
+
+    executor = ThreadPoolExecutor(max_workers=workers)
+    try:
+        for idx, (offset, obj) in enumerate(records, start=progress.done):
+            if limit is not None and idx >= limit:
+                break
+            # 아직 못 쓴 레코드가 window 만큼 쌓이면 앞쪽이 끝날 때까지 기다린다
+            # (앞쪽이 로컬 판정/배치 대기에 있을 수 있으니 모인 것부터 보낸다)
+            while idx - writer.next_index >= window:
+                flush()
+                drain(block=True)
+
+            tm = extract_text_and_meta(obj)
+            if cache is None:
+                key = f"#{idx}"
+            elif not tm.text.strip():
+                # API 를 부르지 않는 경우라 캐시도 거치지 않음
+                write(idx, {**obj, **UNRELATED_RESULT}, offset)
+                continue
+            else:
+                key = cache.key(tm.text, tm.meta)
+                if key not in waiting:
+                    hit = cache.lookup(tm.text, tm.meta)
+                    if hit is not None:
+                        write(idx, {**obj, **hit}, offset)
+                        continue
+
+            if key in waiting:
+                duplicates += 1
+                waiting[key].append((idx, obj, offset))
+                continue
+            waiting[key] = [(idx, obj, offset)]
+            texts[key] = tm
+            if local is None:
+                send(key, tm)
+            else:
+                local_buf.append((key, tm))
+                if len(local_buf) >= local_batch:
+                    screen()
+            drain(block=False)
+
+        flush()
+        while in_flight:
+            drain(block=True)
+    finally:
+        # 중단돼도 (Ctrl-C, 예외) 앞에서부터 이어 쓴 결과와 진행 상태는 남긴다
+        executor.shutdown(wait=False, cancel_futures=True)
+        writer.close()
+        logger.info(
+            "[INFO] API 요청 %d건 (실행 내 중복 %d개), 429 %d회, 느린 응답 %d회, "
+            "최종 동시 요청 한도 %d",
+            requests,
+            duplicates,
+            limiter.rate_limited,
+            limiter.slow,
+            limiter.limit,
+        )
+        if local is not None:
+            logger.info(
+                "[INFO] 로컬 모델 판정 %d건, Grok 으로 넘긴 것 %d건",
+                local.screened,
+                local.escalated,
+            )
+        if cache is not None:
+            stats = cache.stats
+            logger.info(
+                "[INFO] 캐시 적중: %d/%d (%.1f%%), 캐시 크기 %d (%s)",
+                stats.hits,
+                stats.lookups,
+                stats.hit_rate * 100,
+                len(cache),
+                cache.path,
+            )
+            cache.close()
+
+    if writer.next_index == 0:
+        logger.warning("[WARN] 입력에 유효한 레코드가 없습니다.")
+        return
+    logger.info(
+        "[INFO] 모든 작업 완료: 총 %d개. 결과: %s",
+        writer.next_index,
+        Path(output_path).resolve(),
+    )
 
 
 # ---------- CLI 엔트리포인트 ----------
@@ -268,7 +803,10 @@ def main(argv: Optional[List[str]] = None) -> None:
         "--output",
         "-o",
         required=True,
-        help="출력 JSONL 경로 (예: sentiment_output_data/youtube_sentiment.jsonl)",
+        help=(
+            "출력 JSONL 경로 (예: sentiment_output_data/youtube_sentiment.jsonl), "
+            ".parquet 로 끝나면 Parquet 데이터셋"
+        ),
     )
     parser.add_argument(
         "--limit",
@@ -281,8 +819,103 @@ def main(argv: Optional[List[str]] = None) -> None:
         "--workers",
         "-w",
         type=int,
-        default=4,  # 수정: 기본 4
-        help="동시 요청에 사용할 워커 수 (기본: 4)",
+        default=8,
+        help=(
+            "동시 요청 수 상한 (기본: 8). 4 에서 시작해 429/응답 지연에 맞춰 "
+            "자동으로 줄이고 늘린다."
+        ),
+    )
+    parser.add_argument(
+        "--window",
+        type=int,
+        default=None,
+        help="읽었지만 아직 출력에 못 쓴 레코드 수 상한 (기본: workers*8)",
+    )
+    parser.add_argument(
+        "--latency-target",
+        type=float,
+        default=30.0,
+        help="응답이 이 초보다 오래 걸리면 동시 요청 수를 줄인다 (0: 지연 무시)",
+    )
+    parser.add_argument(
+        "--resume",
+        action="store_true",
+        help=(
+            "지난 실행의 진행 상태(<output>.progress.json)를 읽어 이미 쓴 레코드는 "
+            "건너뛰고 이어서 처리 (JSONL 출력만)"
+        ),
+    )
+    parser.add_argument(
+        "--checkpoint-every",
+        type=int,
+        default=100,
+        help="진행 상태를 저장하는 간격(레코드 수, 기본: 100)",
+    )
+    parser.add_argument(
+        "--batch-size",
+        type=int,
+        default=1,
+        help=(
+            "한 번의 요청에 묶어 분석할 최대 레코드 수 (기본 1: 배치 안 함). "
+            "짧은 댓글이 많을 때 요청 수와 프롬프트 토큰을 줄인다."
+        ),
+    )
+    parser.add_argument(
+        "--batch-tokens",
+        type=int,
+        default=2000,
+        help="배치 하나의 입력 토큰 추정치 상한 (기본: 2000)",
+    )
+    parser.add_argument(
+        "--local-model",
+        default=None,
+        help=(
+            "로컬 ONNX 감성 모델 디렉터리 (model.onnx, tokenizer.json). 주면 로컬 "
+            "모델로 먼저 판정하고 확신이 낮은 행만 Grok 으로 보낸다."
+        ),
+    )
+    parser.add_argument(
+        "--local-batch",
+        type=int,
+        default=64,
+        help="로컬 모델에 한 번에 넣는 최대 레코드 수 (기본: 64)",
+    )
+    parser.add_argument(
+        "--local-threads",
+        type=int,
+        default=None,
+        help="로컬 모델 추론 스레드 수 (기본: CPU 코어 수)",
+    )
+    parser.add_argument(
+        "--local-threshold",
+        type=float,
+        default=0.9,
+        help="로컬 모델이 무관/관련을 직접 판정하는 확률 기준 (기본: 0.9)",
+    )
+    parser.add_argument(
+        "--local-label-threshold",
+        type=float,
+        default=0.8,
+        help="로컬 모델이 부정/중립/긍정을 직접 판정하는 확률 기준 (기본: 0.8)",
+    )
+    parser.add_argument(
+        "--cache",
+        default=None,
+        help="결과 캐시 SQLite 경로 (기본: 출력 폴더의 grok_cache.sqlite)",
+    )
+    parser.add_argument(
+        "--no-cache",
+        action="store_true",
+        help="결과 캐시를 쓰지 않고 모든 레코드를 API 로 분석",
+    )
+    parser.add_argument(
+        "--invalidate-cache",
+        choices=("stale", "all"),
+        default=None,
+        help=(
+            "시작 전에 캐시 정리: stale = 현재 프롬프트 버전(단건/배치)/모델이 "
+            "아닌 결과 삭제, all = 전부 삭제"
+        ),
     )
 
     args = parser.parse_args(argv)
@@ -292,6 +925,20 @@ def main(argv: Optional[List[str]] = None) -> None:
         output_path=args.output,
         limit=args.limit,
         workers=args.workers,
+        cache_path=args.cache,
+        use_cache=not args.no_cache,
+        invalidate=args.invalidate_cache,
+        resume=args.resume,
+        window=args.window,
+        checkpoint_every=args.checkpoint_every,
+        latency_target=args.latency_target or None,
+        batch_size=args.batch_size,
+        batch_tokens=args.batch_tokens,
+        local_model=args.local_model,
+        local_batch=args.local_batch,
+        local_threads=args.local_threads,
+        local_threshold=args.local_threshold,
+        local_label_threshold=args.local_label_threshold,
     )
 
 
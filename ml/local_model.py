@@ -0,0 +1,126 @@
+# ml/local_model.py
+"""
+로컬(CPU) 감성 분류 모델: Grok 앞단의 1차 판정용 (ml/nps_sentiment.py 의 LocalTier).
+
+ONNX Runtime 으로 양자화된 한/영 문장 분류 모델을 돌린다.
+의존성(onnxruntime, tokenizers)은 이 모듈을 쓸 때만 필요하다 (lazy import):
+  uv sync --extra local   (또는 pip install 'nps-senti[local]')
+
+모델 디렉터리 구성:
+  model_dir/
+    model.onnx       # 입력: input_ids, attention_mask (+ token_type_ids), 출력: logits
+    tokenizer.json   # HuggingFace tokenizers 형식
+    config.json      # 선택: {"labels": ["무관", "부정", "중립", "긍정"], "max_length": 256}
+
+모델 파일은 저장소에 들어 있지 않다. 직접 만들어서 경로를 --local-model 로 준다:
+  1. 한국어 문장 분류 체크포인트(HuggingFace transformers, 예: klue/roberta-base)를
+     Grok 결과(grok_sentiment_cli 출력의 label: 무관/부정/중립/긍정)로 4클래스
+     미세조정한다.
+  2. optimum-cli export onnx --model <체크포인트> --task text-classification <dir>
+     로 model.onnx 와 tokenizer.json 을 내보낸다.
+  3. config.json 의 labels 를 모델 logits 순서(체크포인트의 id2label)대로 적는다.
+  4. quantize_model(<dir>/model.onnx, <dir>/model.int8.onnx) 로 int8 동적 양자화한 뒤
+     model.onnx 자리에 둔다 (CPU 에서 2~4배 빠르다).
+
+배치: 한 번에 들어온 텍스트들을 길이순으로 정렬해 max_batch 개씩 묶고 묶음 안에서
+가장 긴 길이에 맞춰서만 패딩한다 (짧은 댓글이 긴 글 길이만큼 패딩되지 않게).
+묶음 하나는 ONNX Runtime 이 intra_op 스레드(기본: CPU 코어 수)로 나눠 계산한다.
+"""
+
+from __future__ import annotations
+
+import json
+import logging
+import os
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Sequence
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_LABELS = ("무관", "부정", "중립", "긍정")
+
+
+class LocalSentimentModel:
+    def __init__(
+        self,
+        model_dir: str | Path,
+        *,
+        threads: Optional[int] = None,
+        max_batch: int = 64,
+    ) -> None:
+        try:
+            import onnxruntime as ort
+            from tokenizers import Tokenizer
+        except ImportError as exc:
+            raise ImportError(
+                "로컬 모델에는 onnxruntime, tokenizers 가 필요합니다: "
+                "uv sync --extra local (또는 pip install 'nps-senti[local]')"
+            ) from exc
+
+        self.model_dir = Path(model_dir)
+        config: Dict[str, Any] = {}
+        config_path = self.model_dir / "config.json"
+        if config_path.exists():
+            config = json.loads(config_path.read_text(encoding="utf-8"))
+        self.labels: List[str] = list(config.get("labels") or DEFAULT_LABELS)
+        missing = set(DEFAULT_LABELS) - set(self.labels)
+        if missing:
+            raise ValueError(f"config.json labels 에 없는 라벨: {sorted(missing)}")
+        self.max_length = int(config.get("max_length", 256))
+        self.max_batch = max(1, max_batch)
+
+        options = ort.SessionOptions()
+        options.intra_op_num_threads = threads or os.cpu_count() or 1
+        options.graph_optimization_level = ort.GraphOptimizationLevel.ORT_ENABLE_ALL
+        self.session = ort.InferenceSession(
+            str(self.model_dir / "model.onnx"),
+            options,
+            providers=["CPUExecutionProvider"],
+        )
+        self.input_names = {i.name for i in self.session.get_inputs()}
+
+        self.tokenizer = Tokenizer.from_file(str(self.model_dir / "tokenizer.json"))
+        self.tokenizer.enable_truncation(self.max_length)
+        self.tokenizer.no_padding()  # 패딩은 묶음마다 직접
+
+        logger.info(
+            "[INFO] 로컬 모델 로드: %s (threads=%d, max_batch=%d)",
+            self.model_dir,
+            options.intra_op_num_threads,
+            self.max_batch,
+        )
+
+    def predict_proba(self, texts: Sequence[str]) -> List[Dict[str, float]]:
+        """텍스트마다 {라벨: 확률} (입력 순서 그대로)."""
+        import numpy as np
+
+        out: List[Dict[str, float]] = [{} for _ in texts]
+        order = sorted(range(len(texts)), key=lambda i: len(texts[i]))
+        for start in range(0, len(order), self.max_batch):
+            chunk = order[start : start + self.max_batch]
+            encodings = self.tokenizer.encode_batch([texts[i] for i in chunk])
+            width = max(1, max(len(e.ids) for e in encodings))
+            ids = np.zeros((len(chunk), width), dtype=np.int64)
+            mask = np.zeros((len(chunk), width), dtype=np.int64)
+            for row, enc in enumerate(encodings):
+                ids[row, : len(enc.ids)] = enc.ids
+                mask[row, : len(enc.ids)] = 1
+
+            feeds = {"input_ids": ids, "attention_mask": mask}
+            if "token_type_ids" in self.input_names:
+                feeds["token_type_ids"] = np.zeros_like(ids)
+            logits = self.session.run(None, feeds)[0]
+
+            logits = logits - logits.max(axis=1, keepdims=True)
+            probs = np.exp(logits)
+            probs /= probs.sum(axis=1, keepdims=True)
+            for row, i in enumerate(chunk):
+                out[i] = dict(zip(self.labels, (float(p) for p in probs[row])))
+        return out
+
+
+def quantize_model(src: str | Path, dst: str | Path) -> None:
+    """fp32 ONNX 모델을 int8 동적 양자화 (가중치만 int8, CPU 추론용)."""
+    from onnxruntime.quantization import QuantType, quantize_dynamic
+
+    quantize_dynamic(str(src), str(dst), weight_type=QuantType.QInt8)
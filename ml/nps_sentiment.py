@@ -3,7 +3,7 @@ from __future__ import annotations
 import json
 import logging  # 추가: 바이어스 로그
 from dataclasses import asdict, dataclass
-from typing import Any, Dict
+from typing import Any, Dict, List, Optional, Protocol, Sequence, Tuple
 
 from .grok_client import GrokClient
 
@@ -273,3 +273,88 @@ def analyze_single_comment(
 
     # ✅ source도 같이 넘겨서 parse_grok_response에서 dcinside 보정 가능
     return parse_grok_response({**result, "text": comment, "source": source})
+
+
+# ---------- 로컬 1차 판정 (Grok 앞단) ----------
+
+
+class LocalModel(Protocol):
+    def predict_proba(self, texts: Sequence[str]) -> List[Dict[str, float]]: ...
+
+
+class LocalTier:
+    """
+    로컬 분류 모델(ml/local_model.py)로 먼저 판정하고, 확신이 있는 행만
+    SentimentResult 로 돌려준다. 나머지(None)는 GrokClient 로 넘긴다.
+
+      - P(무관) >= unrelated_threshold → 무관
+      - P(관련) >= related_threshold 이고, 관련 라벨 안에서 정규화한
+        부정/중립/긍정 중 가장 큰 값 >= label_threshold → 그 분포로 판정
+    """
+
+    def __init__(
+        self,
+        model: LocalModel,
+        *,
+        unrelated_threshold: float = 0.9,
+        related_threshold: float = 0.9,
+        label_threshold: float = 0.8,
+    ) -> None:
+        self.model = model
+        self.unrelated_threshold = unrelated_threshold
+        self.related_threshold = related_threshold
+        self.label_threshold = label_threshold
+        self.screened = 0
+        self.escalated = 0
+
+    def _decide(self, probs: Dict[str, float]) -> Optional[SentimentResult]:
+        p_unrelated = probs.get("무관", 0.0)
+        if p_unrelated >= self.unrelated_threshold:
+            return parse_grok_response({"is_related": False})
+        if 1.0 - p_unrelated < self.related_threshold:
+            return None
+
+        neg, neu, pos = probs.get("부정", 0.0), probs.get("중립", 0.0), probs.get("긍정", 0.0)
+        related = neg + neu + pos
+        if related <= 0.0:
+            return None
+        confidence = max(neg, neu, pos) / related
+        if confidence < self.label_threshold:
+            return None
+        return parse_grok_response(
+            {
+                "is_related": True,
+                "negative": neg,
+                "neutral": neu,
+                "positive": pos,
+                "explanation": f"로컬 모델 판정 (신뢰도 {confidence:.2f})",
+            }
+        )
+
+    def screen(self, texts: Sequence[str]) -> List[Optional[SentimentResult]]:
+        results = [self._decide(p) for p in self.model.predict_proba(texts)]
+        decided = sum(1 for r in results if r is not None)
+        self.screened += decided
+        self.escalated += len(results) - decided
+        return results
+
+
+def analyze_comments(
+    items: Sequence[Tuple[str, str]],
+    client: GrokClient | None = None,
+    local: LocalTier | None = None,
+) -> List[SentimentResult]:
+    """
+    (comment, source) 여러 건을 분석한다. local 이 있으면 로컬 모델로 먼저 판정하고,
+    확신이 낮은 행만 Grok 으로 보낸다.
+    """
+    results: List[Optional[SentimentResult]] = [None] * len(items)
+    if local is not None:
+        results = local.screen([comment for comment, _ in items])
+
+    for i, (comment, source) in enumerate(items):
+        if results[i] is None:
+            if client is None:
+                client = GrokClient()
+            results[i] = analyze_single_comment(comment, source, client=client)
+    return [r for r in results if r is not None]
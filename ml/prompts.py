@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import hashlib
 from textwrap import dedent
 
 SYSTEM_PROMPT_NPS = dedent(
@@ -68,6 +69,53 @@ SYSTEM_PROMPT_NPS = dedent(
 )
 
 
+# 여러 댓글을 한 번의 요청으로 분석할 때(GrokClient.analyze_sentiment_batch)
+# SYSTEM_PROMPT_NPS 뒤에 붙이는 지시.
+BATCH_INSTRUCTIONS = dedent(
+    """
+    [여러 항목 한 번에 분석]
+    - 이번 요청에는 분석할 글이 여러 개 들어 있습니다.
+      각 글은 ITEM_START id=<번호> 와 ITEM_END 사이에 있습니다.
+    - 각 항목은 서로 독립적인 글입니다. 다른 항목의 내용을 참고하지 말고
+      위 판단 기준대로 항목마다 따로 판단하세요.
+    - 위 출력 형식의 JSON 객체를 항목마다 하나씩 만들고, "id" 에 항목 번호를 넣어
+      항목 순서대로 JSON 배열 하나로만 출력하세요 (다른 말 X):
+    [
+    {
+    "id": 0,
+    "is_related": true,
+    "negative": 0.00,
+    "neutral": 0.00,
+    "positive": 0.00,
+    "explanation": "한~두줄 설명"
+    },
+    ...
+    ]
+    """
+)
+
+SYSTEM_PROMPT_NPS_BATCH = SYSTEM_PROMPT_NPS + BATCH_INSTRUCTIONS
+
+
+def _prompt_hash(prompt: str) -> str:
+    return hashlib.sha256(prompt.encode("utf-8")).hexdigest()[:12]
+
+
+# 결과 캐시(ml/result_cache.py) 키에 들어가는 프롬프트 버전.
+# SYSTEM_PROMPT_NPS 가 바뀌면 해시가 바뀌어 예전 캐시는 자동으로 무효가 된다.
+# user 프롬프트 조립 방식(GrokClient.build_user_prompt 등)을 바꿨을 때는
+# PROMPT_REVISION 을 올린다.
+# 배치 요청은 프롬프트가 달라 결과도 따로 캐시한다 (BATCH_PROMPT_VERSION).
+# 2: 캐시 키에 doc_type/lang/published_at 추가 (invalidate() 로 예전 행 정리)
+PROMPT_REVISION = 2
+PROMPT_VERSION = f"{PROMPT_REVISION}-{_prompt_hash(SYSTEM_PROMPT_NPS)}"
+BATCH_PROMPT_VERSION = (
+    f"{PROMPT_REVISION}-batch-{_prompt_hash(SYSTEM_PROMPT_NPS_BATCH)}"
+)
+# 지금 쓰는 프롬프트 버전 전부 (캐시 invalidate("stale") 가 남기는 버전)
+CURRENT_PROMPT_VERSIONS = (PROMPT_VERSION, BATCH_PROMPT_VERSION)
+
+
 def build_user_message(comment: str, source: str) -> str:
     """
     모델에 넘길 user 메시지 포맷.
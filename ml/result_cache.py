@@ -0,0 +1,202 @@
+# ml/result_cache.py
+"""
+Grok 감성분석 결과 캐시 (SQLite, 표준 라이브러리만 사용).
+
+키 = sha256(정규화 텍스트, source, doc_type, lang, published_at, 프롬프트 버전, 모델명).
+  - 다른 스레드에 다시 올라온 같은 댓글, 이전 실행에서 이미 분석한 레코드는
+    API 를 부르지 않고 저장된 결과를 쓴다.
+  - source 도 키에 넣는다: 프롬프트(dcinside 규칙)와 후처리(_normalize_result)가
+    source 에 따라 결과를 바꾸기 때문.
+  - doc_type/lang/published_at 은 build_user_prompt 가 모델에 보내는 헤더라
+    결과에 영향을 줄 수 있으므로 함께 넣는다. id 는 레코드마다 달라 넣지 않는다
+    (넣으면 같은 댓글도 적중하지 않음).
+  - 프롬프트 버전(ml/prompts.py 의 PROMPT_VERSION)은 SYSTEM_PROMPT_NPS 의 해시를
+    포함하므로 프롬프트를 고치면 예전 결과는 자동으로 적중하지 않는다.
+    invalidate() 로 예전 버전 행을 지울 수 있다.
+  - 결과는 실제로 그 결과를 만든 프롬프트의 버전으로 저장한다 (배치 모드에서
+    한 건씩 다시 보낸 항목은 PROMPT_VERSION). 조회는 lookup_versions 를 순서대로
+    본다. invalidate() 는 현재 버전들(CURRENT_PROMPT_VERSIONS)을 모두 남기므로
+    한 모드에서 정리해도 다른 모드의 결과는 지워지지 않는다.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import json
+import logging
+import re
+import sqlite3
+import threading
+import time
+import unicodedata
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Dict, Mapping, Optional, Sequence
+
+from ml.prompts import CURRENT_PROMPT_VERSIONS, PROMPT_VERSION
+
+logger = logging.getLogger(__name__)
+
+_SPACE_RE = re.compile(r"\s+")
+# build_user_prompt 헤더 중 캐시 키에 넣는 메타 필드 (id 제외, 모듈 설명 참고)
+KEY_META_FIELDS = ("source", "doc_type", "lang", "published_at")
+
+_SCHEMA = """
+CREATE TABLE IF NOT EXISTS sentiment_cache (
+    key TEXT PRIMARY KEY,
+    model TEXT NOT NULL,
+    prompt_version TEXT NOT NULL,
+    result TEXT NOT NULL,
+    created_at REAL NOT NULL
+)
+"""
+
+
+def normalize_text(text: str) -> str:
+    """캐시 키용 정규화: NFC + 앞뒤 공백 제거 + 연속 공백을 하나로."""
+    return _SPACE_RE.sub(" ", unicodedata.normalize("NFC", text or "")).strip()
+
+
+@dataclass
+class CacheStats:
+    lookups: int = 0
+    hits: int = 0
+    writes: int = 0
+
+    @property
+    def hit_rate(self) -> float:
+        return self.hits / self.lookups if self.lookups else 0.0
+
+
+class SentimentCache:
+    """
+    path 의 SQLite 파일에 분석 결과를 저장한다.
+    get/put 은 여러 스레드에서 불러도 되도록 잠금으로 감싼다.
+    put 은 commit_every 건마다 한 번 커밋한다 (close() 에서 나머지 커밋).
+
+    prompt_version: key()/put() 의 기본 버전 (이 실행이 주로 보내는 프롬프트).
+    lookup_versions: lookup() 이 보는 버전들 (기본: prompt_version 하나).
+    """
+
+    def __init__(
+        self,
+        path: str | Path,
+        *,
+        model: str,
+        prompt_version: str = PROMPT_VERSION,
+        lookup_versions: Optional[Sequence[str]] = None,
+        commit_every: int = 100,
+    ) -> None:
+        self.path = Path(path)
+        self.model = model
+        self.prompt_version = prompt_version
+        self.lookup_versions = tuple(lookup_versions or (prompt_version,))
+        self.commit_every = max(1, commit_every)
+        self.stats = CacheStats()
+        self._uncommitted = 0
+        self._lock = threading.Lock()
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        self._conn = sqlite3.connect(str(self.path), check_same_thread=False)
+        self._conn.execute("PRAGMA journal_mode=WAL")
+        self._conn.execute(_SCHEMA)
+        self._conn.commit()
+
+    def key(
+        self,
+        text: str,
+        meta: Mapping[str, Any],
+        prompt_version: Optional[str] = None,
+    ) -> str:
+        fields = [str(meta.get(name) or "") for name in KEY_META_FIELDS]
+        version = prompt_version or self.prompt_version
+        payload = [normalize_text(text), *fields, version, self.model]
+        raw = json.dumps(payload, ensure_ascii=False).encode("utf-8")
+        return hashlib.sha256(raw).hexdigest()
+
+    def get(self, key: str) -> Optional[Dict[str, Any]]:
+        with self._lock:
+            self.stats.lookups += 1
+            row = self._conn.execute(
+                "SELECT result FROM sentiment_cache WHERE key = ?", (key,)
+            ).fetchone()
+            if row is None:
+                return None
+            self.stats.hits += 1
+        return json.loads(row[0])
+
+    def lookup(self, text: str, meta: Mapping[str, Any]) -> Optional[Dict[str, Any]]:
+        """lookup_versions 를 순서대로 조회 (통계는 한 번의 조회로 센다)."""
+        keys = [self.key(text, meta, version) for version in self.lookup_versions]
+        with self._lock:
+            self.stats.lookups += 1
+            for key in keys:
+                row = self._conn.execute(
+                    "SELECT result FROM sentiment_cache WHERE key = ?", (key,)
+                ).fetchone()
+                if row is not None:
+                    self.stats.hits += 1
+                    return json.loads(row[0])
+        return None
+
+    def put(
+        self, key: str, result: Dict[str, Any], prompt_version: Optional[str] = None
+    ) -> None:
+        """key 는 같은 prompt_version 으로 만든 key() 여야 한다."""
+        with self._lock:
+            self._conn.execute(
+                "INSERT OR REPLACE INTO sentiment_cache VALUES (?, ?, ?, ?, ?)",
+                (
+                    key,
+                    self.model,
+                    prompt_version or self.prompt_version,
+                    json.dumps(result, ensure_ascii=False),
+                    time.time(),
+                ),
+            )
+            self.stats.writes += 1
+            self._uncommitted += 1
+            if self._uncommitted >= self.commit_every:
+                self._conn.commit()
+                self._uncommitted = 0
+
+    def invalidate(
+        self,
+        *,
+        everything: bool = False,
+        keep_versions: Sequence[str] = CURRENT_PROMPT_VERSIONS,
+    ) -> int:
+        """
+        현재 모델이 아니거나 keep_versions(기본: 단건/배치 프롬프트의 현재 버전)
+        에도 prompt_version 에도 없는 버전의 행을 지운다. everything=True 면 전부.
+        지운 행 수를 돌려준다.
+        """
+        keep = sorted({*keep_versions, self.prompt_version, *self.lookup_versions})
+        with self._lock:
+            if everything:
+                cur = self._conn.execute("DELETE FROM sentiment_cache")
+            else:
+                marks = ", ".join("?" * len(keep))
+                cur = self._conn.execute(
+                    "DELETE FROM sentiment_cache "
+                    f"WHERE prompt_version NOT IN ({marks}) OR model != ?",
+                    (*keep, self.model),
+                )
+            self._conn.commit()
+            return cur.rowcount
+
+    def __len__(self) -> int:
+        with self._lock:
+            return self._conn.execute(
+                "SELECT COUNT(*) FROM sentiment_cache"
+            ).fetchone()[0]
+
+    def close(self) -> None:
+        with self._lock:
+            self._conn.commit()
+            self._conn.close()
+
+    def __enter__(self) -> "SentimentCache":
+        return self
+
+    def __exit__(self, *exc: Any) -> None:
+        self.close()
@@ -98,14 +98,17 @@ class FlattenedRecord:
 # ---------- 입력: 원본 JSONL → RawPost ----------
 
 
-def load_raw_posts(path: str | Path) -> Iterator[RawPost]:
+def load_raw_posts(
+    path: str | Path, lines: Optional[Iterable[str]] = None
+) -> Iterator[RawPost]:
     """
     forum_dcinside.jsonl 을 읽어서 RawPost 시퀀스로 반환.
     extra.forum.comments 에서 댓글 목록을 가져온다.
+    lines 를 주면 파일 대신 그 줄들을 읽는다 (증분 처리: Checkpoint.iter_lines).
     """
     p = Path(path)
     with p.open("r", encoding="utf-8") as f:
-        for line_no, line in enumerate(f, start=1):
+        for line_no, line in enumerate(f if lines is None else lines, start=1):
             line = line.strip()
             if not line:
                 continue
@@ -2,17 +2,42 @@
 from __future__ import annotations
 
 import argparse
+from functools import partial
 from pathlib import Path
-from typing import Iterable, List
+from typing import Any, Dict, Iterable, Iterator, List
 
 from .stage1_models_io import load_raw_posts, write_flattened_jsonl, FlattenedRecord
 from .stage2_transform import flatten_post
+from ..preprocess_merge.columnar import is_parquet_path, write_parquet_dataset
+from ..preprocess_merge.incremental import Checkpoint, write_dict_lines
+from ..preprocess_merge.sharded import (
+    iter_sharded_records,
+    shard_bounds,
+    write_sharded,
+)
+
+
+def dcinside_shard(
+    lines: Iterable[str],
+    stats: Dict[str, int],
+    *,
+    in_path: Path,
+    max_comment_len: int,
+) -> Iterator[Dict[str, Any]]:
+    """병렬 실행(preprocess_merge/sharded.py)용 변환: shard 의 원본 줄 → 레코드 dict."""
+    for post in load_raw_posts(in_path, lines=lines):
+        stats["posts"] = stats.get("posts", 0) + 1
+        for rec in flatten_post(post, max_comment_len=max_comment_len):
+            yield rec.to_dict()
 
 
 def preprocess_dcinside(
     input_path: str | Path,
     output_path: str | Path,
     max_comment_len: int = 200,
+    incremental: bool = False,
+    jobs: int = 1,
+    ordered: bool = True,
 ) -> None:
     """
     forum_dcinside.jsonl → (본문+댓글+시간, 클린 제목, doc_type/parent_id 포함) 전처리 JSONL.
@@ -27,6 +52,12 @@ def preprocess_dcinside(
               → repo_root/preprocess/preprocessing_data/ 아래에 생성
           * 디렉터리 포함 상대경로면:
               → repo_root 기준 그대로 사용
+
+    incremental=True 이면 지난 실행 이후 입력에 붙은 줄만 처리해 출력에 이어 쓴다
+    (JSONL 출력만).
+
+    jobs > 1 이면 입력을 줄 경계 구간으로 나눠 jobs 개 프로세스에서 처리한다
+    (ordered=False 면 끝난 구간부터 써서 순서가 섞인다).
     """
     # .../nps-senti-crawl/preprocess/preprocess_dcinside/stage3_cli.py
     # parents[2] → .../nps-senti-crawl (repo root)
@@ -52,12 +83,43 @@ def preprocess_dcinside(
 
     out_path.parent.mkdir(parents=True, exist_ok=True)
 
+    ckpt = Checkpoint(
+        out_path,
+        stage="dcinside",
+        inputs=[in_path],
+        enabled=incremental and not is_parquet_path(out_path),
+    )
+
+    if jobs > 1:
+        start, end = shard_bounds(ckpt, in_path)
+        transform = partial(
+            dcinside_shard, in_path=in_path, max_comment_len=max_comment_len
+        )
+        options: Dict[str, Any] = dict(jobs=jobs, start=start, end=end, ordered=ordered)
+        if is_parquet_path(out_path):
+            write_parquet_dataset(
+                out_path, iter_sharded_records(in_path, transform, **options)
+            )
+        else:
+            with ckpt.open_output() as fw:
+                write_sharded(in_path, transform, fw, **options)
+            ckpt.commit()
+        return
+
     def generate_records() -> Iterable[FlattenedRecord]:
-        for post in load_raw_posts(in_path):
+        lines = ckpt.iter_lines(in_path) if ckpt.enabled else None
+        for post in load_raw_posts(in_path, lines=lines):
             for rec in flatten_post(post, max_comment_len=max_comment_len):
                 yield rec
 
-    write_flattened_jsonl(out_path, generate_records())
+    if is_parquet_path(out_path):
+        write_parquet_dataset(out_path, (r.to_dict() for r in generate_records()))
+    elif ckpt.enabled:
+        with ckpt.open_output() as fw:
+            write_dict_lines(fw, (r.to_dict() for r in generate_records()))
+        ckpt.commit()
+    else:
+        write_flattened_jsonl(out_path, generate_records())
 
 
 def main(argv: List[str] | None = None) -> None:
@@ -76,7 +138,8 @@ def main(argv: List[str] | None = None) -> None:
         required=True,
         help=(
             "전처리 결과 JSONL 파일명 또는 경로.\n"
-            "파일명만 주면 preprocess/preprocessing_data/ 아래에 생성됨."
+            "파일명만 주면 preprocess/preprocessing_data/ 아래에 생성됨.\n"
+            ".parquet 로 끝나면 Parquet 데이터셋(source/month 파티션)으로 저장."
         ),
     )
     parser.add_argument(
@@ -86,12 +149,32 @@ def main(argv: List[str] | None = None) -> None:
         default=200,
         help="combined_text에 포함될 댓글 내용 최대 길이 (길면 가운데를 ... 으로 축약)",
     )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        help="지난 실행 이후 입력에 새로 붙은 줄만 처리해서 출력에 이어 쓴다 (JSONL 출력만).",
+    )
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        default=1,
+        help="입력을 줄 경계 구간으로 나눠 처리할 프로세스 수 (기본 1: 단일 프로세스)",
+    )
+    parser.add_argument(
+        "--unordered",
+        action="store_true",
+        help="병렬 처리 시 끝난 구간부터 바로 쓴다 (출력 순서가 입력 순서와 달라짐)",
+    )
 
     args = parser.parse_args(argv)
     preprocess_dcinside(
         input_path=args.input,
         output_path=args.output,
         max_comment_len=args.max_comment_len,
+        incremental=args.incremental,
+        jobs=args.jobs,
+        ordered=not args.unordered,
     )
 
 
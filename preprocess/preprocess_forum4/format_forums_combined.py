@@ -2,6 +2,7 @@ from __future__ import annotations
 
 import argparse
 import json
+import sys
 from pathlib import Path
 from typing import Callable, Iterator, List, Dict, Iterable, Optional
 import re
@@ -9,10 +10,14 @@ import re
 try:
     # ppomppu/theqoo 전처리 결과 제너레이터 가져오기
     from .format_ppomppu import iter_formatted_rows as iter_ppomppu_rows  # type: ignore
+    from .format_ppomppu import INPUT_PATH as PPOMPPU_INPUT  # type: ignore
     from .format_theqoo import iter_formatted_rows as iter_theqoo_rows  # type: ignore
+    from .format_theqoo import INPUT_PATH as THEQOO_INPUT  # type: ignore
 except ImportError:  # 직접 실행할 때 fallback
     from format_ppomppu import iter_formatted_rows as iter_ppomppu_rows  # type: ignore
+    from format_ppomppu import INPUT_PATH as PPOMPPU_INPUT  # type: ignore
     from format_theqoo import iter_formatted_rows as iter_theqoo_rows  # type: ignore
+    from format_theqoo import INPUT_PATH as THEQOO_INPUT  # type: ignore
 
 
 # 🔹 프로젝트 루트: .../nps-senti
@@ -26,18 +31,31 @@ DATA_DIR = BASE_DIR / "data_crawl"
 # 출력 디렉토리: 루트/preprocess/preprocessing_data
 PREPROCESSING_DIR = BASE_DIR / "preprocess" / "preprocessing_data"
 
+# source → 원본 JSONL (증분 처리 매니페스트에 입력별 offset 으로 기록)
+SOURCE_INPUTS: Dict[str, Path] = {
+    "mlbpark": DATA_DIR / "forum_mlbpark.jsonl",
+    "ppomppu": PPOMPPU_INPUT,
+    "bobaedream": DATA_DIR / "forum_bobaedream.jsonl",
+    "theqoo": THEQOO_INPUT,
+}
+
 
 # ---------------------------------------------------------------------------
 # 공통 유틸
 # ---------------------------------------------------------------------------
 
 
-def read_jsonl(path: Path) -> Iterator[dict]:
-    """UTF-8 JSONL을 한 줄씩 안전하게 읽는다."""
+def read_jsonl(
+    path: Path, lines: Optional[Iterable[str]] = None
+) -> Iterator[dict]:
+    """
+    UTF-8 JSONL을 한 줄씩 안전하게 읽는다.
+    lines 를 주면 파일 대신 그 줄들을 읽는다 (증분 처리: Checkpoint.iter_lines).
+    """
     if not path.exists():
         raise FileNotFoundError(path)
     with path.open("r", encoding="utf-8") as f:
-        for line_no, raw in enumerate(f, 1):
+        for line_no, raw in enumerate(f if lines is None else lines, 1):
             line = raw.strip()
             if not line:
                 continue
@@ -153,7 +171,9 @@ def extract_post_body_mlbpark(post: dict) -> str:
     return text.strip()
 
 
-def iter_mlbpark_rows() -> Iterator[dict]:
+def iter_mlbpark_rows(
+    lines: Optional[Iterable[str]] = None,
+) -> Iterator[dict]:
     """
     mlbpark 원본 forum_mlbpark.jsonl → 공통 스키마로 변환.
 
@@ -181,8 +201,8 @@ def iter_mlbpark_rows() -> Iterator[dict]:
       - comment_text      = 댓글 내용
       - comment_publishedAt = 댓글 시각(있으면)
     """
-    path = DATA_DIR / "forum_mlbpark.jsonl"
-    for post in read_jsonl(path):
+    path = SOURCE_INPUTS["mlbpark"]
+    for post in read_jsonl(path, lines):
         post_id = str(post.get("id") or "").strip()
         if not post_id:
             continue
@@ -250,15 +270,17 @@ def first_paragraph(text: str | None) -> str | None:
     return snippet or None
 
 
-def iter_bobaedream_rows() -> Iterator[dict]:
+def iter_bobaedream_rows(
+    lines: Optional[Iterable[str]] = None,
+) -> Iterator[dict]:
     """
     bobaedream 원본 forum_bobaedream.jsonl → 공통 스키마로 변환.
 
     comment 레코드 id 규칙:
       - id = f"{post_id}_{idx}"
     """
-    path = DATA_DIR / "forum_bobaedream.jsonl"
-    for post in read_jsonl(path):
+    path = SOURCE_INPUTS["bobaedream"]
+    for post in read_jsonl(path, lines):
         post_id = str(post.get("id") or "").strip()
         if not post_id:
             continue
@@ -302,7 +324,8 @@ def iter_bobaedream_rows() -> Iterator[dict]:
 # ---------------------------------------------------------------------------
 
 
-FORMATTERS: Dict[str, Callable[[], Iterator[dict]]] = {
+# 각 포맷터는 lines(증분 처리 시 새 줄만)를 받는다. None 이면 파일 전체.
+FORMATTERS: Dict[str, Callable[[Optional[Iterable[str]]], Iterator[dict]]] = {
     "mlbpark": iter_mlbpark_rows,
     "ppomppu": iter_ppomppu_rows,
     "bobaedream": iter_bobaedream_rows,
@@ -331,6 +354,11 @@ def build_parser() -> argparse.ArgumentParser:
         default=PREPROCESSING_DIR / "new_forum_combined_comments_formatted.jsonl",
         help="Path for the combined JSONL output.",
     )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        help="Only format lines appended to each source since the last run.",
+    )
     return parser
 
 
@@ -347,12 +375,29 @@ def main(argv: List[str] | None = None) -> int:
     rows_written = 0
     args.output.parent.mkdir(parents=True, exist_ok=True)
 
-    with args.output.open("w", encoding="utf-8") as f_out:
+    try:
+        from ..preprocess_merge.incremental import Checkpoint
+    except ImportError:  # 직접 실행할 때 fallback
+        sys.path.insert(0, str(BASE_DIR))
+        from preprocess.preprocess_merge.incremental import Checkpoint
+
+    # 소스 구성이 바뀌면 stage 이름이 달라져 전체 처리로 돌아간다
+    ckpt = Checkpoint(
+        args.output,
+        stage="forum_combined:" + ",".join(selected),
+        inputs=[SOURCE_INPUTS[src] for src in selected],
+        enabled=args.incremental,
+    )
+
+    with ckpt.open_output() as f_out:
         for source in selected:
             formatter = FORMATTERS[source]
-            for row in formatter():
+            path = SOURCE_INPUTS[source]
+            lines = ckpt.iter_lines(path) if ckpt.enabled and path.exists() else None
+            for row in formatter(lines):
                 f_out.write(json.dumps(row, ensure_ascii=False) + "\n")
                 rows_written += 1
+    ckpt.commit()
 
     print(
         json.dumps(
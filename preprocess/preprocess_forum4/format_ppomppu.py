@@ -1,10 +1,12 @@
 # preprocess/preprocess_forum4/format_ppomppu.py
 from __future__ import annotations
 
+import argparse
 import json
+import sys
 from datetime import datetime
 from pathlib import Path
-from typing import Iterator
+from typing import Iterable, Iterator, List, Optional
 
 BASE_DIR = Path(__file__).resolve().parents[2]
 INPUT_PATH = BASE_DIR / "data_crawl" / "forum_ppomppu.jsonl"
@@ -14,6 +16,7 @@ OUTPUT_PATH = (
     / "preprocessing_data"
     / "forum_ppomppu_comments_formatted.jsonl"
 )
+STAGE = "forum_ppomppu"
 ENCODINGS = ("utf-8", "utf-8-sig", "cp949", "euc-kr", "latin-1")
 STOP_EXACT = {
     "목록보기",
@@ -45,7 +48,19 @@ PUNCT_ONLY = {"|", "△", "▽", "▶", "▲", "▼"}
 EVENT_KEYWORDS = ("이벤트", "쿠폰", "체험단", "핫딜", "세일", "특가")
 
 
-def read_jsonl(path: Path) -> Iterator[dict]:
+def read_jsonl(
+    path: Path, lines: Optional[Iterable[str]] = None
+) -> Iterator[dict]:
+    if lines is not None:
+        # 증분 처리: Checkpoint.iter_lines 가 UTF-8 로 읽어 둔 새 줄
+        for line_no, raw in enumerate(lines, 1):
+            line = raw.strip()
+            if line:
+                try:
+                    yield json.loads(line)
+                except json.JSONDecodeError as err:
+                    raise ValueError(f"{path} line +{line_no}: {err.msg}") from err
+        return
     last_err: Exception | None = None
     for enc in ENCODINGS:
         try:
@@ -183,8 +198,10 @@ def should_skip_post(title: str) -> bool:
     return False
 
 
-def iter_formatted_rows() -> Iterator[dict]:
-    for post in read_jsonl(INPUT_PATH):
+def iter_formatted_rows(
+    lines: Optional[Iterable[str]] = None,
+) -> Iterator[dict]:
+    for post in read_jsonl(INPUT_PATH, lines):
         post_id = str(post.get("id") or "").strip()
         if not post_id:
             continue
@@ -236,21 +253,49 @@ def iter_formatted_rows() -> Iterator[dict]:
             }
 
 
-def main() -> None:
+def make_checkpoint(incremental: bool):
+    """--incremental 이면 출력 옆 매니페스트로 지난 실행 이후의 입력 꼬리만 처리."""
+    try:
+        from ..preprocess_merge.incremental import Checkpoint
+    except ImportError:  # 직접 실행할 때 fallback
+        sys.path.insert(0, str(BASE_DIR))
+        from preprocess.preprocess_merge.incremental import Checkpoint
+    return Checkpoint(
+        OUTPUT_PATH, stage=STAGE, inputs=[INPUT_PATH], enabled=incremental
+    )
+
+
+def parse_args(argv: Optional[List[str]] = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        description="Format forum_ppomppu.jsonl into post/comment rows."
+    )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        help="Only format lines appended to the input since the last run.",
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv: Optional[List[str]] = None) -> None:
+    args = parse_args(argv)
     if not INPUT_PATH.exists():
         raise FileNotFoundError(INPUT_PATH)
     OUTPUT_PATH.parent.mkdir(parents=True, exist_ok=True)
+    ckpt = make_checkpoint(args.incremental)
+    lines = ckpt.iter_lines(INPUT_PATH) if ckpt.enabled else None
     total = 0
     posts = 0
     comments = 0
-    with OUTPUT_PATH.open("w", encoding="utf-8") as f_out:
-        for row in iter_formatted_rows():
+    with ckpt.open_output() as f_out:
+        for row in iter_formatted_rows(lines):
             f_out.write(json.dumps(row, ensure_ascii=False) + "\n")
             total += 1
             if row["doc_type"] == "post":
                 posts += 1
             else:
                 comments += 1
+    ckpt.commit()
     rel = OUTPUT_PATH.relative_to(BASE_DIR)
     print(f"Wrote {posts} posts and {comments} comments ({total} rows) to {rel}")
 
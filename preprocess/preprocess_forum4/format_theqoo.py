@@ -1,8 +1,10 @@
 from __future__ import annotations
 
+import argparse
 import json
+import sys
 from pathlib import Path
-from typing import Iterator
+from typing import Iterable, Iterator, List, Optional
 
 
 # 프로젝트 루트: .../nps-senti
@@ -19,12 +21,27 @@ OUTPUT_PATH = (
     / "forum_theqoo_comments_formatted.jsonl"
 )
 
+# 증분 처리 매니페스트의 단계 이름
+STAGE = "forum_theqoo"
+
 # 반드시 read_jsonl보다 위에 정의되어 있어야 함
 ENCODINGS = ("utf-8", "utf-8-sig", "cp949", "euc-kr", "latin-1")
 
 
-def read_jsonl(path: Path) -> Iterator[dict]:
+def read_jsonl(
+    path: Path, lines: Optional[Iterable[str]] = None
+) -> Iterator[dict]:
     """JSONL 파일을 여러 인코딩 후보로 시도하면서 안전하게 읽는다."""
+    if lines is not None:
+        # 증분 처리: Checkpoint.iter_lines 가 UTF-8 로 읽어 둔 새 줄
+        for line_no, raw in enumerate(lines, 1):
+            line = raw.strip()
+            if line:
+                try:
+                    yield json.loads(line)
+                except json.JSONDecodeError as err:
+                    raise ValueError(f"{path} line +{line_no}: {err.msg}") from err
+        return
     last_err: Exception | None = None
     for enc in ENCODINGS:
         try:
@@ -69,7 +86,9 @@ def clean_text(text: str | None) -> str | None:
     return cleaned or None
 
 
-def iter_formatted_rows() -> Iterator[dict]:
+def iter_formatted_rows(
+    lines: Optional[Iterable[str]] = None,
+) -> Iterator[dict]:
     """
     forum_theqoo.jsonl → 공통 포맷(post + comments)으로 변환.
 
@@ -96,7 +115,7 @@ def iter_formatted_rows() -> Iterator[dict]:
           parent_id     = post_id
           text          = 게시글 본문(text)과 동일 (댓글 맥락용)
     """
-    for post in read_jsonl(INPUT_PATH):
+    for post in read_jsonl(INPUT_PATH, lines):
         post_id = str(post.get("id") or "").strip()
         if not post_id:
             continue
@@ -159,17 +178,45 @@ def iter_formatted_rows() -> Iterator[dict]:
             }
 
 
-def main() -> None:
+def make_checkpoint(incremental: bool):
+    """--incremental 이면 출력 옆 매니페스트로 지난 실행 이후의 입력 꼬리만 처리."""
+    try:
+        from ..preprocess_merge.incremental import Checkpoint
+    except ImportError:  # 직접 실행할 때 fallback
+        sys.path.insert(0, str(BASE_DIR))
+        from preprocess.preprocess_merge.incremental import Checkpoint
+    return Checkpoint(
+        OUTPUT_PATH, stage=STAGE, inputs=[INPUT_PATH], enabled=incremental
+    )
+
+
+def parse_args(argv: Optional[List[str]] = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        description="Format forum_theqoo.jsonl into post/comment rows."
+    )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        help="Only format lines appended to the input since the last run.",
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv: Optional[List[str]] = None) -> None:
+    args = parse_args(argv)
     if not INPUT_PATH.exists():
         raise FileNotFoundError(INPUT_PATH)
 
     OUTPUT_PATH.parent.mkdir(parents=True, exist_ok=True)
+    ckpt = make_checkpoint(args.incremental)
+    lines = ckpt.iter_lines(INPUT_PATH) if ckpt.enabled else None
 
     total = 0
-    with OUTPUT_PATH.open("w", encoding="utf-8") as f_out:
-        for row in iter_formatted_rows():
+    with ckpt.open_output() as f_out:
+        for row in iter_formatted_rows(lines):
             f_out.write(json.dumps(row, ensure_ascii=False) + "\n")
             total += 1
+    ckpt.commit()
 
     rel = OUTPUT_PATH.relative_to(BASE_DIR)
     print(f"Wrote {total} rows (posts + comments) to {rel}")
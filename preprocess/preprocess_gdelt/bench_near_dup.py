@@ -0,0 +1,168 @@
+"""
+near-duplicate 엔진 벤치마크: MinHash-LSH vs 기존 SequenceMatcher 경로.
+
+통신사 기사 재전송과 비슷한 합성 코퍼스를 만든다.
+  - 원문: 무작위 한글 단어로 된 기사
+  - 중복: 앞선 원문 하나를 골라 일부 단어 치환 + 매체명 꼬리 추가
+즉 어떤 행이 중복인지 정답을 알고 있으므로 recall/precision 을 잴 수 있다.
+
+SequenceMatcher 경로는 후보 비교가 제곱으로 늘어나 전체 코퍼스에서 돌리기 어려워
+앞쪽 --baseline-rows 행에서만 두 엔진을 같이 측정하고, MinHash 는 전체 행에서도 잰다.
+
+Usage:
+  python -m preprocess.preprocess_gdelt.bench_near_dup \
+    [--rows 1000000] [--baseline-rows 20000] [--report bench.json]
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import random
+import time
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence, Tuple
+
+from .dedup_gdelt import SequenceDeduper, normalize_text
+from .near_dup import MinHashLSH
+
+TAILS = ["연합뉴스", "뉴시스", "뉴스1", "YONHAP", "Reuters", "AP"]
+
+
+def make_vocab(rng: random.Random, size: int) -> List[str]:
+    # 가~힣 범위 음절 2~4개짜리 단어
+    return [
+        "".join(chr(rng.randint(0xAC00, 0xD7A3)) for _ in range(rng.randint(2, 4)))
+        for _ in range(size)
+    ]
+
+
+def make_corpus(
+    rows: int,
+    *,
+    dup_rate: float = 0.3,
+    edit_rate: float = 0.03,
+    words: Tuple[int, int] = (80, 200),
+    vocab_size: int = 20000,
+    seed: int = 7,
+) -> Tuple[List[str], List[bool]]:
+    """(정규화된 텍스트 목록, 정답 중복 플래그)"""
+    rng = random.Random(seed)
+    vocab = make_vocab(rng, vocab_size)
+    texts: List[str] = []
+    is_dup: List[bool] = []
+    originals: List[List[str]] = []
+    for _ in range(rows):
+        if originals and rng.random() < dup_rate:
+            toks = list(rng.choice(originals))
+            for pos in range(len(toks)):
+                if rng.random() < edit_rate:
+                    toks[pos] = rng.choice(vocab)
+            toks.append(rng.choice(TAILS))
+            is_dup.append(True)
+        else:
+            toks = [rng.choice(vocab) for _ in range(rng.randint(*words))]
+            originals.append(toks)
+            is_dup.append(False)
+        texts.append(normalize_text(" ".join(toks)))
+    return texts, is_dup
+
+
+def score(flags: Sequence[bool], truth: Sequence[bool]) -> Dict[str, float]:
+    tp = sum(1 for f, t in zip(flags, truth) if f and t)
+    fp = sum(1 for f, t in zip(flags, truth) if f and not t)
+    fn = sum(1 for f, t in zip(flags, truth) if t and not f)
+    return {
+        "recall": round(tp / (tp + fn), 4) if tp + fn else 1.0,
+        "precision": round(tp / (tp + fp), 4) if tp + fp else 1.0,
+    }
+
+
+def run_minhash(texts: Sequence[str], threshold: float) -> Tuple[List[bool], float]:
+    start = time.perf_counter()
+    index = MinHashLSH(threshold)
+    for s in texts:
+        index.add(s)
+    flags = index.duplicates()
+    return flags, time.perf_counter() - start
+
+
+def run_sequence(texts: Sequence[str], threshold: float) -> Tuple[List[bool], float]:
+    start = time.perf_counter()
+    deduper = SequenceDeduper(threshold)
+    flags = [deduper.check(s) is not None for s in texts]
+    return flags, time.perf_counter() - start
+
+
+def report(
+    name: str, flags: Sequence[bool], truth: Sequence[bool], elapsed: float
+) -> Dict[str, float]:
+    result = {
+        "engine": name,
+        "rows": len(flags),
+        "seconds": round(elapsed, 2),
+        "rows_per_sec": round(len(flags) / elapsed, 1) if elapsed else 0.0,
+        **score(flags, truth),
+    }
+    print(
+        f"[BENCH] {name:<9} rows={result['rows']:<8} "
+        f"{result['seconds']:>8.2f}s {result['rows_per_sec']:>10.1f} rows/s "
+        f"recall={result['recall']:.4f} precision={result['precision']:.4f}"
+    )
+    return result
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    ap = argparse.ArgumentParser(
+        description="Benchmark MinHash-LSH vs SequenceMatcher near-duplicate detection."
+    )
+    ap.add_argument("--rows", type=int, default=1_000_000, help="Corpus size")
+    ap.add_argument(
+        "--baseline-rows",
+        type=int,
+        default=20_000,
+        help="Leading rows on which both engines are compared (0: skip baseline)",
+    )
+    ap.add_argument("--dup-rate", type=float, default=0.3)
+    ap.add_argument("--edit-rate", type=float, default=0.03)
+    ap.add_argument("--minhash-threshold", type=float, default=0.80)
+    ap.add_argument("--sequence-threshold", type=float, default=0.90)
+    ap.add_argument("--seed", type=int, default=7)
+    ap.add_argument("--report", type=Path, default=None, help="Write results JSON")
+    args = ap.parse_args(argv)
+
+    start = time.perf_counter()
+    texts, truth = make_corpus(
+        args.rows, dup_rate=args.dup_rate, edit_rate=args.edit_rate, seed=args.seed
+    )
+    print(
+        f"[BENCH] corpus rows={len(texts)} dups={sum(truth)} "
+        f"built in {time.perf_counter() - start:.1f}s"
+    )
+
+    results: List[Dict[str, float]] = []
+    n = min(args.baseline_rows, len(texts))
+    if n:
+        flags, elapsed = run_sequence(texts[:n], args.sequence_threshold)
+        results.append(report("sequence", flags, truth[:n], elapsed))
+        flags, elapsed = run_minhash(texts[:n], args.minhash_threshold)
+        results.append(report("minhash", flags, truth[:n], elapsed))
+    if len(texts) > n:
+        flags, elapsed = run_minhash(texts, args.minhash_threshold)
+        results.append(report("minhash", flags, truth, elapsed))
+
+    if args.report:
+        payload = {
+            "args": {
+                k: str(v) if isinstance(v, Path) else v for k, v in vars(args).items()
+            },
+            "results": results,
+        }
+        args.report.write_text(
+            json.dumps(payload, ensure_ascii=False, indent=2), encoding="utf-8"
+        )
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -123,9 +123,33 @@ def build_wrappers(records: List[Dict]) -> List[ArticleWrapper]:
     return wrappers
 
 
+def minhash_keep_flags(
+    wrappers: List[ArticleWrapper], text_sim_threshold: float
+) -> List[bool]:
+    """
+    제목이 달라도 본문이 거의 같은 기사를 찾는다 (같은 lang 안에서만).
+    긴 본문을 먼저 넣어 fine_deduplicate 와 마찬가지로 가장 긴 기사가 남는다.
+    """
+    from .near_dup import near_duplicate_flags  # lazy import (numpy)
+
+    order = sorted(
+        range(len(wrappers)), key=lambda k: len(wrappers[k].text), reverse=True
+    )
+    dup = near_duplicate_flags(
+        [wrappers[k].text for k in order],
+        text_sim_threshold,
+        groups=[wrappers[k].lang for k in order],
+    )
+    keep_flags = [True] * len(wrappers)
+    for k, is_dup in zip(order, dup):
+        keep_flags[wrappers[k].idx] = not is_dup
+    return keep_flags
+
+
 def fine_deduplicate(
     records: List[Dict],
     text_sim_threshold: float = 0.90,
+    method: str = "title",
 ) -> List[Dict]:
     """
     2차 미세 중복 제거:
@@ -138,9 +162,24 @@ def fine_deduplicate(
 
     => 제목 꼬리( | 연합뉴스 등) 제거 + 본문 유사도 기반 "거의 같은 기사"만 날리고,
        내용이 다른 기사들은 남겨두어 정보 손실을 최소화한다.
+
+    method="minhash" 이면 제목 그룹 대신 MinHash-LSH(near_dup.py)로
+    같은 lang 의 모든 기사 중 본문 5-gram Jaccard >= text_sim_threshold 인
+    기사를 찾는다 (제목만 바꿔 다시 올린 통신사 기사 등).
     """
     wrappers = build_wrappers(records)
 
+    if method == "minhash":
+        keep_flags = minhash_keep_flags(wrappers, text_sim_threshold)
+        deduped = [rec for rec, keep in zip(records, keep_flags) if keep]
+        print(
+            f"[INFO] 2차 미세 중복 제거(minhash): 원본 {len(records)}개 -> "
+            f"{len(deduped)}개 (제거 {len(records) - len(deduped)}개)"
+        )
+        return deduped
+    if method != "title":
+        raise ValueError(f"unknown method: {method}")
+
     # (lang, title_norm) 기준 그룹핑
     groups: Dict[Tuple[str, str], List[ArticleWrapper]] = {}
     for w in wrappers:
@@ -202,6 +241,12 @@ def build_parser() -> argparse.ArgumentParser:
         default=0.90,
         help="본문 Jaccard 유사도 임계값 (기본 0.90: 거의 완전 동일한 기사만 제거)",
     )
+    parser.add_argument(
+        "--method",
+        choices=("title", "minhash"),
+        default="title",
+        help="title: 같은 제목 그룹 안에서 비교 (기본), minhash: 제목과 무관하게 본문 MinHash-LSH",
+    )
     return parser
 
 
@@ -216,7 +261,9 @@ def main(argv: List[str] | None = None) -> int:
     records = list(read_jsonl(args.input))
     print(f"[INFO] 원본 레코드 수: {len(records)}")
 
-    deduped = fine_deduplicate(records, text_sim_threshold=args.text_sim_threshold)
+    deduped = fine_deduplicate(
+        records, text_sim_threshold=args.text_sim_threshold, method=args.method
+    )
     write_jsonl(args.output, deduped)
 
     print(f"[INFO] 최종 레코드 수: {len(deduped)}")
@@ -2,25 +2,36 @@
 Deduplicate a JSONL file of GDELT-preprocessed rows using:
 
 1) Exact-text dedup (fast, hard duplicates)
-2) Token-based candidate filtering + SequenceMatcher for near-duplicates
+2) Near-duplicates: MinHash + LSH banding (default), or the older
+   token-based candidate filtering + SequenceMatcher (--method sequence)
 
 Usage:
   python -m preprocess.preprocess_gdelt.dedup_gdelt \
-    --input <in.jsonl> --output <out.jsonl> [--threshold 0.90]
+    --input <in.jsonl> --output <out.jsonl> [--method minhash] [--threshold 0.80] \
+    [--incremental]
 """
 
 from __future__ import annotations
 
 import argparse
+import hashlib
 import json
 import re
 from difflib import SequenceMatcher
 from pathlib import Path
-from typing import Dict, List, Set
+from typing import Dict, Iterable, Iterator, List, Optional, Set
+
+import numpy as np
+
+from .near_dup import MinHashLSH
+from ..preprocess_merge.incremental import Checkpoint, complete_end, iter_line_range
 
 RE_WHITESPACE = re.compile(r"\s+")
 RE_PUNCT = re.compile(r"[\W_]+", flags=re.UNICODE)
 
+DEDUP_METHODS = ("minhash", "sequence")
+DEFAULT_THRESHOLDS = {"minhash": 0.80, "sequence": 0.90}
+
 
 def normalize_text(s: str) -> str:
     """
@@ -82,120 +93,230 @@ def is_near_duplicate_with_candidates(
     return False
 
 
+class SequenceDeduper:
+    """
+    기존 방식: 앞 토큰 역색인으로 후보를 모은 뒤 SequenceMatcher 비교.
+    check(s) 는 중복이면 "exact"/"near", 남기면 None 을 돌려주고 상태를 갱신한다.
+    후보 집합이 커지면 비용이 제곱으로 늘어나므로 비교/벤치마크 용도로 남겨둔다.
+    """
+
+    def __init__(self, threshold: float = 0.90, max_tokens_for_index: int = 8):
+        self.threshold = threshold
+        self.max_tokens_for_index = max_tokens_for_index
+        self.kept_texts: List[str] = []  # 정규화된 전체 텍스트
+        self.inverted_index: Dict[str, Set[int]] = {}  # token -> {kept index}
+        # exact-text dedup 용: 정규화된 text → 첫 번째 인덱스
+        self.exact_text_index: Dict[str, int] = {}
+
+    def _keep(self, s: str, tokens: Set[str]) -> None:
+        cur_idx = len(self.kept_texts)
+        self.kept_texts.append(s)
+        self.exact_text_index[s] = cur_idx
+        for t in tokens:
+            self.inverted_index.setdefault(t, set()).add(cur_idx)
+
+    def check(self, s: str) -> Optional[str]:
+        # ---------- 1) exact-text dedup ----------
+        if s in self.exact_text_index:
+            return "exact"
+
+        toks = tokenise(s)
+        if not toks:
+            # 텍스트가 없거나 토큰화가 안되면(전부 숫자/공백 등) 그냥 살린다.
+            self._keep(s, set())
+            return None
+
+        # ---------- 2) token 기반 후보 수집 ----------
+        tokens_for_index = toks[: self.max_tokens_for_index]
+        candidate_indices: Set[int] = set()
+        for t in tokens_for_index:
+            idx_set = self.inverted_index.get(t)
+            if idx_set:
+                candidate_indices.update(idx_set)
+
+        # 후보가 하나라도 있으면 SequenceMatcher로 near-duplicate 검사
+        if candidate_indices and is_near_duplicate_with_candidates(
+            s, list(candidate_indices), self.kept_texts, self.threshold
+        ):
+            return "near"
+
+        self._keep(s, set(tokens_for_index))
+        return None
+
+
+def iter_jsonl_rows(
+    path: Path, lines: Optional[Iterable[str]] = None
+) -> Iterator[Optional[Dict]]:
+    """
+    라인마다 row(dict)를, 빈 줄/깨진 줄이면 None 을 돌려준다.
+    lines 를 주면 파일 대신 그 줄들을 읽는다 (증분 처리).
+    """
+    with path.open("r", encoding="utf-8") as infile:
+        for line in infile if lines is None else lines:
+            line = line.strip()
+            if not line:
+                yield None
+                continue
+            try:
+                yield json.loads(line)
+            except Exception:
+                # 깨진 라인은 스킵
+                yield None
+
+
+def _bounded_lines(ckpt: Checkpoint, path: Path, end: int) -> Iterable[str]:
+    """minhash 두 회차가 읽는 줄: 증분이면 지난 커밋 이후 ~ end, 아니면 0 ~ end."""
+    if ckpt.enabled:
+        return ckpt.iter_lines(path, end=end)
+    return (line for _, line in iter_line_range(path, 0, end))
+
+
+def exact_key(s: str) -> bytes:
+    return hashlib.blake2b(s.encode("utf-8"), digest_size=16).digest()
+
+
+EXACT_KEY_BYTES = 16
+LSH_STATE = "lsh.npz"
+EXACT_STATE = "exact.npy"
+
+
+def load_exact_keys(path: Path) -> Set[bytes]:
+    if not path.exists():
+        return set()
+    arr = np.load(path)
+    return {row.tobytes() for row in arr}
+
+
+def save_exact_keys(path: Path, keys: Set[bytes]) -> None:
+    buf = b"".join(sorted(keys))
+    arr = np.frombuffer(buf, dtype=np.uint8).reshape(-1, EXACT_KEY_BYTES)
+    with path.open("wb") as f:
+        np.save(f, arr)
+
+
 def dedup_jsonl(
     input_path: Path,
     output_path: Path,
-    threshold: float = 0.90,
+    threshold: Optional[float] = None,
     max_tokens_for_index: int = 8,
+    method: str = "minhash",
+    incremental: bool = False,
 ) -> Dict:
     """
     GDELT 전처리 JSONL 파일에서 near-duplicate를 제거한다.
 
     - 1단계: exact-text dedup
         같은 normalize_text(title+text)를 가진 행은 바로 중복으로 간주하고 스킵.
-    - 2단계: token-based candidate 필터 + SequenceMatcher
-        완전 동일은 아니지만, 매우 비슷한 텍스트를 threshold 기준으로 제거.
+    - 2단계: near-duplicate
+        method="minhash" (기본): 문자 5-gram MinHash + LSH banding (near_dup.py).
+            입력을 두 번 읽는다(1회차 서명 계산, 2회차 출력). 거의 선형 시간.
+            두 회차 모두 시작할 때의 마지막 완전한 줄까지만 읽는다.
+        method="sequence": token 후보 필터 + SequenceMatcher (기존 방식).
 
     params
     -------
-    threshold: SequenceMatcher similarity threshold (0~1).
+    threshold:
+        minhash 는 5-gram Jaccard 추정치 하한 (기본 0.80),
+        sequence 는 SequenceMatcher similarity 하한 (기본 0.90).
     max_tokens_for_index:
-        한 문서에 대해서 역색인에 등록/조회에 사용할 토큰 수 상한.
+        (sequence) 한 문서에 대해서 역색인에 등록/조회에 사용할 토큰 수 상한.
+    incremental:
+        (minhash) 지난 실행 이후 입력에 붙은 줄만 처리해서 출력에 이어 쓴다.
+        exact 키 집합과 남긴 문서의 MinHash 서명을 출력 옆에 저장해 두므로
+        새 행은 이전 실행에서 남긴 행과도 비교된다. sequence 는 전체 처리.
     """
-    kept_texts: List[str] = []  # 정규화된 전체 텍스트
-    kept_tokens: List[Set[str]] = []  # 인덱싱에 사용된 토큰 집합
-    inverted_index: Dict[str, Set[int]] = {}  # token -> {kept index}
+    if method not in DEDUP_METHODS:
+        raise ValueError(f"unknown dedup method: {method}")
+    if threshold is None:
+        threshold = DEFAULT_THRESHOLDS[method]
 
-    # 🔥 exact-text dedup 용: 정규화된 text → 첫 번째 인덱스
-    exact_text_index: Dict[str, int] = {}
-
-    kept_count = 0
     total = 0
+    kept_count = 0
     duplicates_near = 0
     duplicates_exact = 0
 
-    with (
-        input_path.open("r", encoding="utf-8") as infile,
-        output_path.open("w", encoding="utf-8") as outfile,
-    ):
-        for line in infile:
+    if method == "sequence":
+        deduper = SequenceDeduper(threshold, max_tokens_for_index)
+        with output_path.open("w", encoding="utf-8") as outfile:
+            for row in iter_jsonl_rows(input_path):
+                total += 1
+                if row is None:
+                    continue
+                verdict = deduper.check(row_key_text(row))
+                if verdict == "exact":
+                    duplicates_exact += 1
+                elif verdict == "near":
+                    duplicates_near += 1
+                else:
+                    outfile.write(json.dumps(row, ensure_ascii=False) + "\n")
+                    kept_count += 1
+    else:
+        ckpt = Checkpoint(
+            output_path,
+            stage=f"dedup_gdelt:minhash:{threshold}",
+            inputs=[input_path],
+            enabled=incremental,
+        )
+        # 1회차: exact dedup + 서명 계산 (본문은 메모리에 남기지 않는다)
+        index = MinHashLSH(threshold)
+        seen: Set[bytes] = set()
+        preloaded = 0
+        if ckpt.resume:
+            seen = load_exact_keys(ckpt.state_path(EXACT_STATE))
+            lsh_path = ckpt.state_path(LSH_STATE)
+            if lsh_path.exists():
+                with lsh_path.open("rb") as f:
+                    preloaded = index.load(f)
+        exact_rows: Set[int] = set()
+        # 두 회차가 같은 줄을 읽도록 끝(마지막 완전한 줄)을 1회차 전에 정해 둔다.
+        # 크롤러가 쓰는 중인 줄과 그 뒤에 붙는 줄은 다음 실행 몫
+        end = complete_end(input_path)
+        lines = _bounded_lines(ckpt, input_path, end)
+        for pos, row in enumerate(iter_jsonl_rows(input_path, lines)):
             total += 1
-            line = line.strip()
-            if not line:
-                continue
-            try:
-                row = json.loads(line)
-            except Exception:
-                # 깨진 라인은 스킵
+            if row is None:
                 continue
-
             s = row_key_text(row)
-
-            # ---------- 1) exact-text dedup ----------
-            if s in exact_text_index:
-                # text(제목+본문)까지 완전히 같은 경우 → 무조건 중복 처리
-                duplicates_exact += 1
-                continue
-
-            if not s:
-                # 텍스트가 전혀 없으면 비교가 어려우니 그냥 살린다.
-                outfile.write(json.dumps(row, ensure_ascii=False) + "\n")
-                kept_texts.append("")
-                kept_tokens.append(set())
-                exact_text_index[""] = kept_count
-                kept_count += 1
+            key = exact_key(s)
+            if key in seen:
+                exact_rows.add(pos)
                 continue
-
-            toks = tokenise(s)
-            if not toks:
-                # 토큰화가 안되면(전부 숫자/공백 등) 그냥 살린다.
-                outfile.write(json.dumps(row, ensure_ascii=False) + "\n")
-                kept_texts.append(s)
-                kept_tokens.append(set())
-                exact_text_index[s] = kept_count
-                kept_count += 1
-                continue
-
-            # ---------- 2) token 기반 후보 수집 ----------
-            tokens_for_index = toks[:max_tokens_for_index]
-            candidate_indices: Set[int] = set()
-            for t in tokens_for_index:
-                idx_set = inverted_index.get(t)
-                if idx_set:
-                    candidate_indices.update(idx_set)
-
-            # 후보가 하나라도 있으면 SequenceMatcher로 near-duplicate 검사
-            if candidate_indices:
-                if is_near_duplicate_with_candidates(
-                    s, list(candidate_indices), kept_texts, threshold
-                ):
+            seen.add(key)
+            index.add(s)
+        if ckpt.enabled:
+            save_exact_keys(ckpt.pending_state_path(EXACT_STATE), seen)
+        del seen
+        near_flags = index.duplicates()
+        if ckpt.enabled:
+            with ckpt.pending_state_path(LSH_STATE).open("wb") as f:
+                index.save(f, near_flags)
+
+        # 2회차: 같은 순서로 다시 읽으며 남길 행만 쓴다
+        # (1회차가 읽은 곳까지만 — 그 사이 크롤러가 덧붙인 줄은 다음 실행 몫)
+        added = preloaded
+        lines = _bounded_lines(ckpt, input_path, end)
+        with ckpt.open_output() as outfile:
+            for pos, row in enumerate(iter_jsonl_rows(input_path, lines)):
+                if row is None:
+                    continue
+                if pos in exact_rows:
+                    duplicates_exact += 1
+                    continue
+                is_near = near_flags[added]
+                added += 1
+                if is_near:
                     duplicates_near += 1
                     continue
-
-            # ---------- keep ----------
-            outfile.write(json.dumps(row, ensure_ascii=False) + "\n")
-            cur_idx = kept_count
-
-            kept_texts.append(s)
-            tokset = set(tokens_for_index)
-            kept_tokens.append(tokset)
-
-            # exact-text 인덱스 갱신
-            exact_text_index[s] = cur_idx
-
-            # 역색인 갱신
-            for t in tokset:
-                if t not in inverted_index:
-                    inverted_index[t] = set()
-                inverted_index[t].add(cur_idx)
-
-            kept_count += 1
+                outfile.write(json.dumps(row, ensure_ascii=False) + "\n")
+                kept_count += 1
+        ckpt.commit()
 
     return {
         "total": total,
         "kept": kept_count,
         "duplicates_exact": duplicates_exact,
         "duplicates_near": duplicates_near,
+        "method": method,
         "output": str(output_path),
     }
 
@@ -209,18 +330,38 @@ def main(argv=None):
     )
     ap.add_argument("--input", "-i", required=True, help="Input JSONL path")
     ap.add_argument("--output", "-o", required=True, help="Output JSONL path")
+    ap.add_argument(
+        "--method",
+        choices=DEDUP_METHODS,
+        default="minhash",
+        help="Near-duplicate engine (default: minhash)",
+    )
     ap.add_argument(
         "--threshold",
         "-t",
         type=float,
-        default=0.90,
-        help="Similarity threshold (0-1) for SequenceMatcher (near-duplicates)",
+        default=None,
+        help=(
+            "Similarity threshold (0-1) for near-duplicates "
+            "(default: 0.80 Jaccard for minhash, 0.90 ratio for sequence)"
+        ),
     )
     ap.add_argument(
         "--max-tokens",
         type=int,
         default=8,
-        help="Number of tokens per document to index for candidate search (default: 8)",
+        help=(
+            "Number of tokens per document to index for candidate search "
+            "(sequence method, default: 8)"
+        ),
+    )
+    ap.add_argument(
+        "--incremental",
+        action="store_true",
+        help=(
+            "Only dedup lines appended to the input since the last run "
+            "(minhash method; state is kept next to the output)"
+        ),
     )
     args = ap.parse_args(argv)
 
@@ -230,10 +371,15 @@ def main(argv=None):
         raise SystemExit(f"Input not found: {inp}")
 
     stats = dedup_jsonl(
-        inp, out, threshold=args.threshold, max_tokens_for_index=args.max_tokens
+        inp,
+        out,
+        threshold=args.threshold,
+        max_tokens_for_index=args.max_tokens,
+        method=args.method,
+        incremental=args.incremental,
     )
     print(
-        "Dedup complete:"
+        f"Dedup complete ({stats['method']}):"
         f" total={stats['total']},"
         f" kept={stats['kept']},"
         f" exact_dups={stats['duplicates_exact']},"
@@ -0,0 +1,242 @@
+"""
+MinHash + LSH(banding) 기반 near-duplicate 탐지.
+
+문서마다 문자 k-gram(기본 5) 집합의 MinHash 서명을 numpy 벡터 연산으로 만들고,
+서명을 band 단위로 묶은 키가 같은 문서끼리만 후보 쌍으로 비교한다.
+후보 쌍은 서명 일치 비율(= Jaccard 추정치)로 검증하므로 전체 비용은
+문서 수에 대해 거의 선형이다.
+
+사용 예:
+  index = MinHashLSH(threshold=0.8)
+  for text in texts:
+      index.add(text)
+  dup_flags = index.duplicates()  # add 순서 기준, 앞선 문서가 남고 뒤 문서가 중복
+
+증분 처리(dedup_gdelt --incremental)에서는 지난 실행까지 남긴 문서의 서명을
+save() 로 저장해 두고, 다음 실행에서 load() 로 먼저 올린 뒤 새 문서만 add() 한다.
+"""
+
+from __future__ import annotations
+
+import hashlib
+from typing import IO, Hashable, List, Optional, Sequence
+
+import numpy as np
+
+_PRIME = np.uint64(1099511628211)  # FNV-1a 64-bit prime (k-gram rolling hash)
+_MIX1 = np.uint64(0xBF58476D1CE4E5B9)
+_MIX2 = np.uint64(0x94D049BB133111EB)
+_VERIFY_CHUNK = 1 << 20
+
+
+def _mix64(h: np.ndarray) -> np.ndarray:
+    """splitmix64 finalizer (uint64 배열, overflow는 2^64 modulo로 감김)."""
+    h = h ^ (h >> np.uint64(30))
+    h = h * _MIX1
+    h = h ^ (h >> np.uint64(27))
+    h = h * _MIX2
+    return h ^ (h >> np.uint64(31))
+
+
+def _group_hash(group: Hashable) -> np.uint64:
+    digest = hashlib.blake2b(repr(group).encode("utf-8"), digest_size=8).digest()
+    return np.uint64(int.from_bytes(digest, "little"))
+
+
+class MinHashLSH:
+    """
+    add() 로 문서를 쌓고 duplicates() 로 중복 여부를 한 번에 계산한다.
+
+    - threshold: 서명 기준 Jaccard 추정치 하한 (문자 k-gram 집합 기준)
+    - num_perm / bands: 서명 길이와 band 수. rows = num_perm // bands.
+      기본 64/16(rows=4)은 Jaccard 0.8 쌍을 거의 100% 후보로 잡는다.
+    - min_chars: 이보다 짧은 텍스트는 비교하지 않는다(항상 유지).
+    - max_bucket: 같은 band 키를 가진 문서가 아주 많을 때(상용구 등)
+      각 문서를 바로 앞 max_bucket 개와만 비교해 비용을 제한한다.
+    - group: add(text, group=...) 로 주면 같은 group 끼리만 중복으로 본다.
+    """
+
+    def __init__(
+        self,
+        threshold: float = 0.8,
+        *,
+        num_perm: int = 64,
+        bands: int = 16,
+        shingle: int = 5,
+        max_chars: int = 10000,
+        min_chars: int = 1,
+        max_bucket: int = 64,
+        seed: int = 1,
+    ) -> None:
+        if num_perm % bands:
+            raise ValueError("num_perm must be a multiple of bands")
+        self.threshold = float(threshold)
+        self.num_perm = int(num_perm)
+        self.bands = int(bands)
+        self.rows = self.num_perm // self.bands
+        self.shingle = max(1, int(shingle))
+        self.max_chars = int(max_chars)
+        self.min_chars = max(1, int(min_chars))
+        self.max_bucket = max(1, int(max_bucket))
+        rng = np.random.default_rng(seed)
+        # multiply-shift 해시: (a * x + b) >> 32, a는 홀수
+        self._a = rng.integers(1, 2**63, size=self.num_perm, dtype=np.uint64)
+        self._a |= np.uint64(1)
+        self._b = rng.integers(0, 2**63, size=self.num_perm, dtype=np.uint64)
+        self._sigs: List[np.ndarray] = []
+        self._groups: List[np.uint64] = []
+        self._rows: List[int] = []  # 서명이 있는 문서의 add 순번
+        self._count = 0
+
+    def __len__(self) -> int:
+        return self._count
+
+    def shingle_hashes(self, text: str) -> np.ndarray:
+        """문자 k-gram의 64비트 해시 집합 (정렬, 중복 제거)."""
+        cps = np.frombuffer(
+            text[: self.max_chars].encode("utf-32-le"), dtype=np.uint32
+        ).astype(np.uint64)
+        k = min(self.shingle, len(cps))
+        n = len(cps) - k + 1
+        h = np.zeros(n, dtype=np.uint64)
+        for j in range(k):
+            h = h * _PRIME + cps[j : j + n]
+        return np.unique(_mix64(h))
+
+    def signature(self, text: str) -> np.ndarray:
+        hashes = self.shingle_hashes(text)
+        mixed = hashes[None, :] * self._a[:, None] + self._b[:, None]
+        return (mixed >> np.uint64(32)).min(axis=1).astype(np.uint32)
+
+    def add(self, text: str, group: Hashable = None) -> int:
+        """문서를 추가하고 add 순번을 돌려준다."""
+        row = self._count
+        self._count += 1
+        if text and len(text) >= self.min_chars:
+            self._sigs.append(self.signature(text))
+            self._groups.append(_group_hash(group))
+            self._rows.append(row)
+        return row
+
+    def _band_keys(
+        self, sigs: np.ndarray, groups: np.ndarray, band: int
+    ) -> np.ndarray:
+        cols = sigs[:, band * self.rows : (band + 1) * self.rows].astype(np.uint64)
+        key = groups ^ np.uint64(band + 1)
+        for c in range(cols.shape[1]):
+            key = _mix64(key ^ cols[:, c])
+        return key
+
+    def candidate_pairs(self) -> np.ndarray:
+        """(i, j) 후보 쌍 배열 (서명 행 기준, i < j, 중복 없음)."""
+        if len(self._sigs) < 2:
+            return np.empty((0, 2), dtype=np.int64)
+        sigs = np.vstack(self._sigs)
+        groups = np.array(self._groups, dtype=np.uint64)
+        n = len(sigs)
+        found: List[np.ndarray] = []
+        for band in range(self.bands):
+            keys = self._band_keys(sigs, groups, band)
+            # stable 정렬이라 같은 키 안에서는 add 순서가 유지된다 (i < j)
+            order = np.argsort(keys, kind="stable")
+            sorted_keys = keys[order]
+            for d in range(1, min(self.max_bucket, n - 1) + 1):
+                same = sorted_keys[:-d] == sorted_keys[d:]
+                if not same.any():
+                    break
+                i = order[:-d][same].astype(np.int64)
+                j = order[d:][same].astype(np.int64)
+                found.append(i * n + j)
+        if not found:
+            return np.empty((0, 2), dtype=np.int64)
+        codes = np.unique(np.concatenate(found))
+        return np.stack([codes // n, codes % n], axis=1)
+
+    def _params(self) -> np.ndarray:
+        return np.concatenate([self._a, self._b]).view(np.uint8)
+
+    def save(self, fp: IO[bytes], flags: Sequence[bool]) -> int:
+        """
+        duplicates() 결과에서 남긴 문서의 서명/그룹만 저장하고 개수를 돌려준다.
+        해시 파라미터도 같이 저장해서 다른 설정으로 load() 하는 것을 막는다.
+        """
+        kept = [pos for pos, row in enumerate(self._rows) if not flags[row]]
+        sigs = (
+            np.vstack([self._sigs[pos] for pos in kept])
+            if kept
+            else np.empty((0, self.num_perm), dtype=np.uint32)
+        )
+        groups = np.array([self._groups[pos] for pos in kept], dtype=np.uint64)
+        np.savez(
+            fp,
+            sigs=sigs,
+            groups=groups,
+            params=self._params(),
+            shingle=np.array([self.shingle, self.max_chars]),
+        )
+        return len(kept)
+
+    def load(self, fp: IO[bytes]) -> int:
+        """
+        save() 한 서명을 앞쪽 문서로 올리고 개수를 돌려준다 (add 전에 호출).
+        이 문서들은 서로 중복이 아니므로 duplicates() 에서 항상 남는다.
+        """
+        if self._count:
+            raise RuntimeError("load() must be called before add()")
+        data = np.load(fp)
+        same = np.array_equal(data["params"], self._params()) and np.array_equal(
+            data["shingle"], [self.shingle, self.max_chars]
+        )
+        if not same or data["sigs"].shape[1:] != (self.num_perm,):
+            raise ValueError("saved MinHash state uses different parameters")
+        sigs, groups = data["sigs"], data["groups"]
+        for pos in range(len(sigs)):
+            self._sigs.append(sigs[pos])
+            self._groups.append(groups[pos])
+            self._rows.append(pos)
+        self._count = len(sigs)
+        return self._count
+
+    def duplicates(self) -> List[bool]:
+        """
+        add 순서 기준 중복 플래그. 앞에서 남긴(중복이 아닌) 문서와
+        threshold 이상 비슷한 문서만 True.
+        """
+        flags = [False] * self._count
+        pairs = self.candidate_pairs()
+        if not len(pairs):
+            return flags
+        sigs = np.vstack(self._sigs)
+        groups = np.array(self._groups, dtype=np.uint64)
+        # 후보 쌍 검증은 메모리를 제한하려고 구간별로 나눠 계산한다
+        keep: List[np.ndarray] = []
+        for start in range(0, len(pairs), _VERIFY_CHUNK):
+            block = pairs[start : start + _VERIFY_CHUNK]
+            a, b = block[:, 0], block[:, 1]
+            sim = (sigs[a] == sigs[b]).mean(axis=1)
+            keep.append(block[(sim >= self.threshold) & (groups[a] == groups[b])])
+        verified = np.concatenate(keep)
+        i, j = verified[:, 0], verified[:, 1]
+        # j 오름차순으로 처리하면 i(< j)의 판정은 이미 확정되어 있다
+        order = np.lexsort((i, j))
+        dropped = np.zeros(len(sigs), dtype=bool)
+        for a, b in zip(i[order].tolist(), j[order].tolist()):
+            if not dropped[a]:
+                dropped[b] = True
+        for pos in np.flatnonzero(dropped).tolist():
+            flags[self._rows[pos]] = True
+        return flags
+
+
+def near_duplicate_flags(
+    texts: Sequence[str],
+    threshold: float = 0.8,
+    *,
+    groups: Optional[Sequence[Hashable]] = None,
+    **options,
+) -> List[bool]:
+    """texts 순서 기준 중복 플래그 (앞 문서 우선). options는 MinHashLSH 인자."""
+    index = MinHashLSH(threshold, **options)
+    for pos, text in enumerate(texts):
+        index.add(text, groups[pos] if groups is not None else None)
+    return index.duplicates()
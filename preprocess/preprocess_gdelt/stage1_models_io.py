@@ -77,14 +77,17 @@ class FlattenedGdeltArticle:
 # ---------- 입력: 안전 JSON 로더 ----------
 
 
-def load_raw_gdelt(path: str | Path) -> Iterator[RawGdeltArticle]:
+def load_raw_gdelt(
+    path: str | Path, lines: Optional[Iterable[str]] = None
+) -> Iterator[RawGdeltArticle]:
     """
     gdelt.jsonl 을 한 줄씩 읽으면서 JSONDecodeError 방어하며 RawGdeltArticle로 변환.
     깨진 줄/비어 있는 줄은 경고 로그만 남기고 스킵한다.
+    lines 를 주면 파일 대신 그 줄들을 읽는다 (증분 처리: Checkpoint.iter_lines).
     """
     p = Path(path)
     with p.open("r", encoding="utf-8") as f:
-        for line_no, line in enumerate(f, start=1):
+        for line_no, line in enumerate(f if lines is None else lines, start=1):
             line = line.strip()
             if not line:
                 continue
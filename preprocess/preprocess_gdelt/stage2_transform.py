@@ -3,6 +3,8 @@ from __future__ import annotations
 
 from datetime import datetime, timezone
 from typing import List, Optional, Dict
+import hashlib
+import json
 import logging
 import re
 from urllib.parse import urlparse, urlunparse, parse_qsl, urlencode
@@ -164,6 +166,7 @@ def normalize_url_for_key(url: str) -> str:
 
 def deduplicate_records(
     records: List[FlattenedGdeltArticle],
+    seen: Optional[Dict[str, List[str]]] = None,
 ) -> List[FlattenedGdeltArticle]:
     """
     GDELT 기사 중복 제거 (강화 버전).
@@ -180,6 +183,10 @@ def deduplicate_records(
     이렇게 하면
       - 2296/2297처럼 제목/내용이 거의 같은 기사의 중복을 잡으면서
       - 제목만 같고 내용이 다른 건 그대로 여러 개 유지할 수 있다.
+
+    seen(증분 처리용): 그룹 키 → 이전 실행에서 남긴 text 의 sha1 목록.
+      주어지면 이전 출력과 text 가 똑같은 기사는 버리고, 이번에 남긴 것을 추가한다.
+      (이전 출력과의 비교는 완전 일치만 본다. 유사 중복은 dedup_gdelt 단계에서 처리)
     """
 
     from collections import defaultdict
@@ -265,8 +272,20 @@ def deduplicate_records(
             key = ("id", rec.id)
         groups[key].append(rec)
 
+    def text_sha1(rec: FlattenedGdeltArticle) -> str:
+        return hashlib.sha1((rec.text or "").encode("utf-8")).hexdigest()
+
     deduped: List[FlattenedGdeltArticle] = []
     total_merged = 0
+    total_seen = 0
+
+    if seen is not None:
+        for key, recs in groups.items():
+            before = set(seen.get(json.dumps(key, ensure_ascii=False), ()))
+            if before:
+                fresh = [rec for rec in recs if text_sha1(rec) not in before]
+                total_seen += len(recs) - len(fresh)
+                groups[key] = fresh
 
     # 2단계: 각 그룹 안에서 text 유사도 기반 dedup
     for key, recs in groups.items():
@@ -287,6 +306,13 @@ def deduplicate_records(
             if not merged:
                 selected.append(rec)
         deduped.extend(selected)
+        if seen is not None and selected:
+            seen.setdefault(json.dumps(key, ensure_ascii=False), []).extend(
+                text_sha1(rec) for rec in selected
+            )
+
+    if total_seen > 0:
+        logger.info("[INFO] GDELT 이전 실행 출력과 같은 기사 %d개 제외", total_seen)
 
     if total_merged > 0:
         logger.info(
@@ -3,15 +3,26 @@ from __future__ import annotations
 
 import argparse
 import logging
+from dataclasses import asdict
+from functools import partial
 from pathlib import Path
-from typing import List, Optional, Set
+from typing import Any, Dict, Iterable, Iterator, List, Optional, Set
 
 from .stage1_models_io import (
     load_raw_gdelt,
     write_flattened_jsonl,
     FlattenedGdeltArticle,
+    RawGdeltArticle,
 )
 from .stage2_transform import flatten_article, deduplicate_records
+from ..preprocess_merge.columnar import is_parquet_path, write_parquet_dataset
+from ..preprocess_merge.incremental import (
+    Checkpoint,
+    load_json_state,
+    save_json_state,
+    write_dict_lines,
+)
+from ..preprocess_merge.sharded import iter_sharded_records, shard_bounds
 
 
 logger = logging.getLogger(__name__)
@@ -21,12 +32,51 @@ logging.basicConfig(
 )
 
 
+def flatten_filtered(
+    raws: Iterable[RawGdeltArticle],
+    stats: Dict[str, int],
+    *,
+    lang_set: Optional[Set[str]],
+    min_length: int,
+    max_length: Optional[int],
+) -> Iterator[FlattenedGdeltArticle]:
+    """언어/길이 필터 + 클리닝. stats 에 raw(원본 수) / used(남은 수)를 센다."""
+    for raw in raws:
+        stats["raw"] = stats.get("raw", 0) + 1
+
+        if lang_set is not None:
+            lang = (raw.lang or "").strip()
+            if lang not in lang_set:
+                continue
+
+        rec = flatten_article(raw, min_length=min_length, max_length=max_length)
+        if rec is None:
+            continue
+
+        stats["used"] = stats.get("used", 0) + 1
+        yield rec
+
+
+def gdelt_shard(
+    lines: Iterable[str], stats: Dict[str, int], *, in_path: Path, **filters: Any
+) -> Iterator[Dict[str, Any]]:
+    """
+    병렬 실행(preprocess_merge/sharded.py)용 변환.
+    dedup 에 url 이 필요하므로 to_dict() 가 아니라 필드 전체를 넘긴다.
+    """
+    raws = load_raw_gdelt(in_path, lines=lines)
+    for rec in flatten_filtered(raws, stats, **filters):
+        yield asdict(rec)
+
+
 def preprocess_gdelt(
     input_path: str | Path,
     output_path: str | Path,
     min_length: int = 0,
     max_length: Optional[int] = None,
     lang_filter: Optional[List[str]] = None,
+    incremental: bool = False,
+    jobs: int = 1,
 ) -> None:
     """
     GDELT 원본 JSONL → 전처리 JSONL.
@@ -37,6 +87,12 @@ def preprocess_gdelt(
     - 언어 필터 (ko/en 등)
     - 중복 제거 (lang+title+date 기준)
     - 최종 출력: id, source, lang, title, text, published_at
+
+    incremental=True 이면 지난 실행 이후 입력에 붙은 줄만 처리해 출력에 이어 쓴다
+    (JSONL 출력만). 중복 제거용 그룹 키/텍스트 해시는 <출력>.dedup.json 에 남긴다.
+
+    jobs > 1 이면 클리닝/필터를 줄 경계 구간별로 jobs 개 프로세스에서 돌리고,
+    구간 결과를 입력 순서대로 모아서 중복 제거한다 (결과는 jobs=1 과 같다).
     """
     in_path = Path(input_path).resolve()
     out_path = Path(output_path).resolve()
@@ -59,33 +115,53 @@ def preprocess_gdelt(
         lang_set,
     )
 
-    raw_iter = load_raw_gdelt(in_path)
-
-    flattened: List[FlattenedGdeltArticle] = []
-    total_raw = 0
-    total_used = 0
-
-    for raw in raw_iter:
-        total_raw += 1
-
-        if lang_set is not None:
-            lang = (raw.lang or "").strip()
-            if lang not in lang_set:
-                continue
-
-        rec = flatten_article(raw, min_length=min_length, max_length=max_length)
-        if rec is None:
-            continue
-
-        flattened.append(rec)
-        total_used += 1
+    ckpt = Checkpoint(
+        out_path,
+        stage="gdelt",
+        inputs=[in_path],
+        enabled=incremental and not is_parquet_path(out_path),
+    )
+    filters: Dict[str, Any] = dict(
+        lang_set=lang_set, min_length=min_length, max_length=max_length
+    )
+    stats: Dict[str, int] = {}
+    flattened: List[FlattenedGdeltArticle]
+    if jobs > 1:
+        start, end = shard_bounds(ckpt, in_path)
+        transform = partial(gdelt_shard, in_path=in_path, **filters)
+        records = iter_sharded_records(
+            in_path, transform, stats, jobs=jobs, start=start, end=end
+        )
+        flattened = [FlattenedGdeltArticle(**d) for d in records]
+    else:
+        raw_iter = load_raw_gdelt(
+            in_path, lines=ckpt.iter_lines(in_path) if ckpt.enabled else None
+        )
+        flattened = list(flatten_filtered(raw_iter, stats, **filters))
 
-    logger.info("[INFO] 원본 %d개 중 필터링 후 %d개 남음", total_raw, total_used)
+    logger.info(
+        "[INFO] 원본 %d개 중 필터링 후 %d개 남음",
+        stats.get("raw", 0),
+        stats.get("used", 0),
+    )
 
-    deduped = deduplicate_records(flattened)
+    seen = None
+    if ckpt.enabled:
+        seen = (
+            load_json_state(ckpt.state_path("dedup.json"), {}) if ckpt.resume else {}
+        )
+    deduped = deduplicate_records(flattened, seen=seen)
     logger.info("[INFO] 중복 제거 후 최종 %d개", len(deduped))
 
-    write_flattened_jsonl(out_path, deduped)
+    if is_parquet_path(out_path):
+        write_parquet_dataset(out_path, (rec.to_dict() for rec in deduped))
+    elif ckpt.enabled:
+        with ckpt.open_output() as fw:
+            write_dict_lines(fw, (rec.to_dict() for rec in deduped))
+        save_json_state(ckpt.pending_state_path("dedup.json"), seen)
+        ckpt.commit()
+    else:
+        write_flattened_jsonl(out_path, deduped)
     logger.info("[INFO] GDELT 전처리 완료: %s", out_path)
 
 
@@ -103,7 +179,10 @@ def main(argv: Optional[List[str]] = None) -> None:
         "--output",
         "-o",
         required=True,
-        help="출력 JSONL 경로 (예: preprocess/preprocessing_data/gdelt_clean.jsonl)",
+        help=(
+            "출력 JSONL 경로 (예: preprocess/preprocessing_data/gdelt_clean.jsonl), "
+            ".parquet 로 끝나면 Parquet 데이터셋"
+        ),
     )
     parser.add_argument(
         "--min-length",
@@ -123,6 +202,18 @@ def main(argv: Optional[List[str]] = None) -> None:
         default=None,
         help='언어 필터 (예: "ko,en" → ko/en만 사용, 기본=None: 전체 사용)',
     )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        help="지난 실행 이후 입력에 새로 붙은 줄만 처리해서 출력에 이어 쓴다 (JSONL 출력만).",
+    )
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        default=1,
+        help="클리닝/필터를 나눠 처리할 프로세스 수 (기본 1: 단일 프로세스)",
+    )
 
     args = parser.parse_args(argv)
 
@@ -136,6 +227,8 @@ def main(argv: Optional[List[str]] = None) -> None:
         min_length=args.min_length,
         max_length=args.max_length,
         lang_filter=lang_list,
+        incremental=args.incremental,
+        jobs=args.jobs,
     )
 
 
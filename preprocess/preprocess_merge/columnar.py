@@ -0,0 +1,224 @@
+"""
+전처리 / 감성분석 결과의 Parquet 데이터셋 입출력 (pyarrow 필요, 선택 기능).
+
+출력 경로가 ".parquet" 로 끝나면 JSONL 대신 이 형식을 쓴다.
+경로는 hive 파티션 디렉터리가 된다:
+
+  <out>.parquet/source=youtube/month=2024-01/part-00000-0.parquet
+
+스키마는 UnifiedRow 필드 + doc_type/parent_id/url + 감성분석 결과 컬럼으로 고정이고,
+그 밖의 키는 extra(JSON 문자열) 컬럼 하나에 보존한다. 대시보드는 필요한 컬럼과
+파티션(source, month)만 읽을 수 있다.
+"""
+
+from __future__ import annotations
+
+import json
+import re
+from pathlib import Path
+from typing import Any, Dict, Iterable, Iterator, List, Tuple
+
+PARQUET_SUFFIX = ".parquet"
+PARTITION_COLS = ("source", "month")
+UNKNOWN_PARTITION = "unknown"
+
+# (컬럼명, 타입) — 순서가 곧 파일 스키마 순서
+STRING, INT, FLOAT, BOOL = "string", "int64", "float64", "bool"
+UNIFIED_COLUMNS: Tuple[Tuple[str, str], ...] = (
+    ("id", STRING),
+    ("source", STRING),
+    ("lang", STRING),
+    ("title", STRING),
+    ("text", STRING),
+    ("published_at", STRING),
+    ("comment_index", INT),
+    ("comment_text", STRING),
+    ("comment_publishedAt", STRING),
+    ("doc_type", STRING),
+    ("parent_id", STRING),
+    ("url", STRING),
+    # 감성분석 결과 (ml/grok_sentiment_cli)
+    ("is_related", BOOL),
+    ("negative", FLOAT),
+    ("neutral", FLOAT),
+    ("positive", FLOAT),
+    ("label", STRING),
+    ("explanation", STRING),
+)
+# UnifiedRow.to_dict 에 항상 있는 필드 (읽을 때 None 이어도 키를 유지)
+CORE_FIELDS = (
+    "id",
+    "source",
+    "lang",
+    "title",
+    "text",
+    "published_at",
+    "comment_index",
+    "comment_text",
+    "comment_publishedAt",
+)
+EXTRA_COL = "extra"
+
+_MONTH_RE = re.compile(r"^(\d{4})-(\d{2})")
+# JSONL 에서 문자열로 들어온 bool 값 ("false" 를 True 로 만들지 않도록 명시적으로 해석)
+_TRUE_STRINGS = {"true", "t", "yes", "y", "1"}
+_FALSE_STRINGS = {"false", "f", "no", "n", "0"}
+_COLUMN_NAMES = {name for name, _ in UNIFIED_COLUMNS}
+
+
+def is_parquet_path(path: str | Path) -> bool:
+    return Path(path).suffix.lower() == PARQUET_SUFFIX
+
+
+def _pyarrow():
+    try:
+        import pyarrow as pa  # lazy import (선택 의존성)
+        import pyarrow.dataset as ds
+        import pyarrow.parquet as pq
+    except ImportError as exc:
+        raise ImportError(
+            "Parquet 출력/입력에는 pyarrow 가 필요합니다: "
+            "uv sync --extra parquet (또는 pip install 'nps-senti[parquet]')"
+        ) from exc
+    return pa, ds, pq
+
+
+def arrow_schema():
+    pa, _, _ = _pyarrow()
+    types = {
+        STRING: pa.string(),
+        INT: pa.int64(),
+        FLOAT: pa.float64(),
+        BOOL: pa.bool_(),
+    }
+    fields = [pa.field(name, types[kind]) for name, kind in UNIFIED_COLUMNS]
+    fields.append(pa.field(EXTRA_COL, pa.string()))
+    fields.append(pa.field("month", pa.string()))
+    return pa.schema(fields)
+
+
+def month_of(published_at: Any) -> str:
+    m = _MONTH_RE.match(str(published_at or "").strip())
+    return f"{m.group(1)}-{m.group(2)}" if m else UNKNOWN_PARTITION
+
+
+def _coerce(value: Any, kind: str) -> Any:
+    if value is None or value == "":
+        return None
+    try:
+        if kind == INT:
+            return int(value)
+        if kind == FLOAT:
+            return float(value)
+        if kind == BOOL:
+            return _coerce_bool(value)
+    except (TypeError, ValueError):
+        return None
+    if isinstance(value, (dict, list)):
+        return json.dumps(value, ensure_ascii=False)
+    return str(value)
+
+
+def _coerce_bool(value: Any) -> bool | None:
+    if isinstance(value, bool):
+        return value
+    if isinstance(value, (int, float)):
+        return bool(value)
+    text = str(value).strip().lower()
+    if text in _TRUE_STRINGS:
+        return True
+    if text in _FALSE_STRINGS:
+        return False
+    return None  # 알 수 없는 값은 결측으로
+
+
+class ParquetDatasetWriter:
+    """
+    record(dict)를 모아 rows_per_flush 개마다 파티션 파일로 쓴다.
+    열 때 기존 데이터셋의 *.parquet 파일은 지운다 (JSONL 의 "w" 모드와 같은 의미).
+    """
+
+    def __init__(self, root: str | Path, rows_per_flush: int = 100_000) -> None:
+        self.root = Path(root)
+        self.rows_per_flush = max(1, rows_per_flush)
+        self.rows = 0
+        self._schema = arrow_schema()
+        self._buf: Dict[str, List[Any]] = {name: [] for name in self._schema.names}
+        self._pending = 0
+        self._flushes = 0
+        if self.root.is_dir():
+            for old in self.root.rglob(f"*{PARQUET_SUFFIX}"):
+                if old.is_file():
+                    old.unlink()
+        self.root.mkdir(parents=True, exist_ok=True)
+
+    def write(self, record: Dict[str, Any]) -> None:
+        for name, kind in UNIFIED_COLUMNS:
+            self._buf[name].append(_coerce(record.get(name), kind))
+        source = self._buf["source"][-1]
+        self._buf["source"][-1] = source or UNKNOWN_PARTITION
+        extra = {k: v for k, v in record.items() if k not in _COLUMN_NAMES}
+        self._buf[EXTRA_COL].append(
+            json.dumps(extra, ensure_ascii=False) if extra else None
+        )
+        self._buf["month"].append(month_of(record.get("published_at")))
+        self._pending += 1
+        self.rows += 1
+        if self._pending >= self.rows_per_flush:
+            self.flush()
+
+    def flush(self) -> None:
+        if not self._pending:
+            return
+        pa, _, pq = _pyarrow()
+        table = pa.Table.from_pydict(self._buf, schema=self._schema)
+        pq.write_to_dataset(
+            table,
+            root_path=str(self.root),
+            partition_cols=list(PARTITION_COLS),
+            basename_template=f"part-{self._flushes:05d}-{{i}}{PARQUET_SUFFIX}",
+            existing_data_behavior="overwrite_or_ignore",
+        )
+        self._flushes += 1
+        self._buf = {name: [] for name in self._schema.names}
+        self._pending = 0
+
+    def close(self) -> None:
+        self.flush()
+
+    def __enter__(self) -> "ParquetDatasetWriter":
+        return self
+
+    def __exit__(self, *exc: Any) -> None:
+        self.close()
+
+
+def write_parquet_dataset(
+    root: str | Path, records: Iterable[Dict[str, Any]]
+) -> int:
+    """records 를 Parquet 데이터셋으로 저장하고 행 수를 돌려준다."""
+    with ParquetDatasetWriter(root) as writer:
+        for rec in records:
+            writer.write(rec)
+    return writer.rows
+
+
+def iter_parquet_records(
+    root: str | Path, batch_size: int = 10_000
+) -> Iterator[Dict[str, Any]]:
+    """
+    ParquetDatasetWriter 가 쓴 데이터셋을 record(dict)로 다시 읽는다.
+    (extra 컬럼은 원래 키로 풀고, month 파티션 컬럼은 버린다)
+    """
+    _, ds, _ = _pyarrow()
+    dataset = ds.dataset(str(root), format="parquet", partitioning="hive")
+    for batch in dataset.to_batches(batch_size=batch_size):
+        for row in batch.to_pylist():
+            extra = row.pop(EXTRA_COL, None)
+            row.pop("month", None)
+            rec = {
+                k: v for k, v in row.items() if k in CORE_FIELDS or v is not None
+            }
+            if extra:
+                rec.update(json.loads(extra))
+            yield rec
@@ -0,0 +1,220 @@
+"""
+증분 전처리용 체크포인트 매니페스트.
+
+크롤러는 원본 JSONL 에 줄을 덧붙이기만 하므로, 각 단계는 지난 실행 이후
+새로 붙은 꼬리만 처리해서 출력에 이어 쓰면 된다. 출력 파일 옆에
+<출력>.manifest.json 을 두고 입력 파일마다 다음을 기록한다:
+
+  - offset: 처리 완료한 바이트 위치 (항상 줄 끝)
+  - head_sha1 / tail_sha1: 파일 앞 4KB, offset 직전 4KB 의 해시
+    → 입력이 새로 쓰였거나 잘렸으면 전체를 다시 처리한다
+  - output_size: 커밋 시점의 출력 크기
+    → 커밋 전에 중단됐으면 다음 실행에서 그 뒤에 붙은 부분을 잘라낸다
+
+dedup 단계처럼 이전 결과를 알아야 하는 단계는 state_path() 에 상태를 저장한다.
+
+사용 예:
+  ckpt = Checkpoint(out_path, stage="youtube", inputs=[in_path], enabled=True)
+  with ckpt.open_output() as fw:
+      for line in ckpt.iter_lines(in_path):
+          ...
+  ckpt.commit()
+"""
+
+from __future__ import annotations
+
+import json
+import logging
+from pathlib import Path
+from typing import (
+    IO,
+    Any,
+    Dict,
+    Iterable,
+    Iterator,
+    List,
+    Optional,
+    Sequence,
+)
+
+# 공용 함수는 common/jsonl_state.py 에 있다 (ml/ 도 쓴다). 기존 import 경로를
+# 위해 여기서 다시 내보낸다.
+from common.jsonl_state import (  # noqa: F401
+    FINGERPRINT_BYTES,
+    complete_end,
+    fingerprint,
+    iter_line_range,
+    load_json_state,
+    save_json_state,
+)
+
+logger = logging.getLogger(__name__)
+
+MANIFEST_VERSION = 1
+
+
+class Checkpoint:
+    """
+    한 단계(stage)의 출력 하나에 대한 증분 처리 상태.
+
+    enabled=False 이면 항상 전체 처리(기존 동작)이고 매니페스트도 쓰지 않는다.
+    enabled=True 여도 매니페스트가 없거나, 단계 이름이 다르거나, 입력/출력이
+    기록과 맞지 않으면 전체 처리로 돌아간다 (resume == False).
+
+    rewrite=True 는 출력을 이어 쓰지 않고 매번 새로 쓰는 단계(merge)용이다.
+    이때는 출력 크기가 커밋 시점과 정확히 같아야 이어서 처리한다.
+    """
+
+    def __init__(
+        self,
+        output_path: str | Path,
+        stage: str,
+        inputs: Sequence[str | Path],
+        *,
+        enabled: bool = True,
+        rewrite: bool = False,
+    ) -> None:
+        self.output_path = Path(output_path)
+        self.stage = stage
+        self.inputs = [Path(p) for p in inputs]
+        self.enabled = enabled
+        self.rewrite = rewrite
+        self.manifest_path = self.output_path.with_name(
+            self.output_path.name + ".manifest.json"
+        )
+        self._manifest = self._load() if enabled else None
+        self.resume = self._manifest is not None
+        self._ends: Dict[str, int] = {}
+        self._pending_states: List[str] = []
+
+    @staticmethod
+    def _key(path: Path) -> str:
+        return str(path.resolve())
+
+    def _load(self) -> Optional[Dict[str, Any]]:
+        if not self.manifest_path.exists() or not self.output_path.exists():
+            return None
+        try:
+            manifest = json.loads(self.manifest_path.read_text(encoding="utf-8"))
+        except (OSError, json.JSONDecodeError) as exc:
+            logger.warning("[WARN] 매니페스트 읽기 실패, 전체 처리: %s", exc)
+            return None
+        if (
+            manifest.get("version") != MANIFEST_VERSION
+            or manifest.get("stage") != self.stage
+        ):
+            return None
+        size = self.output_path.stat().st_size
+        recorded_size = int(manifest.get("output_size", 0))
+        if size < recorded_size or (self.rewrite and size != recorded_size):
+            logger.warning("[WARN] 출력이 매니페스트와 맞지 않음, 전체 처리")
+            return None
+        recorded = manifest.get("inputs") or {}
+        for path in self.inputs:
+            entry = recorded.get(self._key(path))
+            if entry is None:
+                continue  # 새 입력: 처음부터
+            offset = int(entry.get("offset", 0))
+            if not path.exists() or path.stat().st_size < offset:
+                logger.warning("[WARN] 입력이 줄어듦, 전체 처리: %s", path)
+                return None
+            now = fingerprint(path, offset)
+            if (
+                now["head_sha1"] != entry.get("head_sha1")
+                or now["tail_sha1"] != entry.get("tail_sha1")
+            ):
+                logger.warning("[WARN] 입력 내용이 바뀜, 전체 처리: %s", path)
+                return None
+        return manifest
+
+    def start_offset(self, path: str | Path) -> int:
+        if self._manifest is None:
+            return 0
+        entry = (self._manifest.get("inputs") or {}).get(self._key(Path(path)))
+        return int(entry.get("offset", 0)) if entry else 0
+
+    def iter_lines(
+        self, path: str | Path, end: Optional[int] = None
+    ) -> Iterator[str]:
+        """
+        지난 커밋 이후에 붙은 완전한 줄만 돌려준다.
+        (크롤러가 쓰는 중인 마지막 줄은 다음 실행으로 미룬다)
+        같은 꼬리를 두 번 읽는 단계는 두 번째에 end=end_offset(path) 를 준다.
+        """
+        p = Path(path)
+        start = self.start_offset(p)
+        self._ends[self._key(p)] = start
+        offset = start
+        for offset, line in iter_line_range(p, start, end):
+            self._ends[self._key(p)] = offset
+            yield line
+        if self.resume:
+            logger.info("[INFO] 증분 처리: %s (%d → %d 바이트)", p, start, offset)
+
+    def mark_done(self, path: str | Path, end: int) -> None:
+        """iter_lines() 를 쓰지 않고 [start_offset, end) 를 직접 읽은 단계용."""
+        self._ends[self._key(Path(path))] = end
+
+    def end_offset(self, path: str | Path) -> int:
+        """iter_lines() 가 마지막으로 읽은 위치."""
+        return self._ends.get(self._key(Path(path)), self.start_offset(path))
+
+    def open_output(self, encoding: str = "utf-8") -> IO[str]:
+        """이어 쓸 때는 커밋되지 않은 꼬리를 잘라낸 뒤 append, 아니면 새로 쓴다."""
+        self.output_path.parent.mkdir(parents=True, exist_ok=True)
+        if self._manifest is None:
+            return self.output_path.open("w", encoding=encoding)
+        size = int(self._manifest.get("output_size", 0))
+        with self.output_path.open("r+b") as f:
+            f.truncate(size)
+        return self.output_path.open("a", encoding=encoding)
+
+    def state_path(self, name: str) -> Path:
+        """단계별 상태 파일 (예: dedup 키 집합, LSH 서명). resume 일 때만 읽는다."""
+        return self.output_path.with_name(f"{self.output_path.name}.{name}")
+
+    def pending_state_path(self, name: str) -> Path:
+        """
+        새 상태를 쓸 임시 경로. commit() 이 매니페스트를 쓴 뒤에 제자리로 옮긴다.
+        (중간에 끊기면 상태가 출력보다 뒤처질 뿐 앞서지는 않는다 → 행 손실 없음)
+        """
+        self._pending_states.append(name)
+        final = self.state_path(name)
+        return final.with_name(final.name + ".pending")
+
+    def commit(self) -> None:
+        if not self.enabled:
+            return
+        inputs: Dict[str, Any] = {}
+        if self._manifest is not None:
+            inputs.update(self._manifest.get("inputs") or {})
+        for path in self.inputs:
+            key = self._key(path)
+            if key in self._ends:
+                inputs[key] = fingerprint(path, self._ends[key])
+        manifest = {
+            "version": MANIFEST_VERSION,
+            "stage": self.stage,
+            "output_size": self.output_path.stat().st_size,
+            "inputs": inputs,
+        }
+        tmp = self.manifest_path.with_name(self.manifest_path.name + ".tmp")
+        tmp.write_text(
+            json.dumps(manifest, ensure_ascii=False, indent=2), encoding="utf-8"
+        )
+        tmp.replace(self.manifest_path)
+        self._manifest = manifest
+        for name in self._pending_states:
+            final = self.state_path(name)
+            final.with_name(final.name + ".pending").replace(final)
+        self._pending_states = []
+
+
+def write_dict_lines(fw: IO[str], records: Iterable[Dict[str, Any]]) -> int:
+    """open_output() 으로 연 파일에 dict 를 JSONL 로 쓰고 줄 수를 돌려준다."""
+    n = 0
+    for rec in records:
+        fw.write(json.dumps(rec, ensure_ascii=False))
+        fw.write("\n")
+        n += 1
+    return n
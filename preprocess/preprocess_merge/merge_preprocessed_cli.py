@@ -3,12 +3,17 @@ from __future__ import annotations
 
 import argparse
 import glob
+import heapq
 import json
 import logging
+import os
+import shutil
+import tempfile
+from concurrent.futures import ProcessPoolExecutor
 from dataclasses import dataclass
-from datetime import datetime
+from datetime import datetime, timedelta
 from pathlib import Path
-from typing import Any, Dict, Iterator, List, Optional, Tuple
+from typing import Any, Dict, Iterable, Iterator, List, Optional, Tuple
 
 logger = logging.getLogger(__name__)
 logging.basicConfig(level=logging.INFO, format="%(levelname)s: %(message)s")
@@ -137,9 +142,35 @@ class UnifiedRow:
 # ---------- JSONL 로딩 ----------
 
 
-def iter_jsonl(path: Path) -> Iterator[Dict[str, Any]]:
+def _is_parquet(path: Path) -> bool:
+    return path.suffix.lower() == ".parquet"
+
+
+def iter_input(
+    path: Path, start: int = 0, end: Optional[int] = None
+) -> Iterator[Dict[str, Any]]:
+    """
+    입력 하나를 읽는다: JSONL 파일, 또는 .parquet 데이터셋 (columnar.py).
+    start/end 는 JSONL 의 바이트 구간 (증분 처리에서 새로 붙은 꼬리만 읽을 때).
+    """
+    if _is_parquet(path):
+        # lazy import: pyarrow 는 선택 의존성
+        from preprocess.preprocess_merge.columnar import iter_parquet_records
+
+        return iter_parquet_records(path)
+    return iter_jsonl(path, start, end)
+
+
+def iter_jsonl(
+    path: Path, start: int = 0, end: Optional[int] = None
+) -> Iterator[Dict[str, Any]]:
+    lines: Optional[Iterable[str]] = None
+    if start or end is not None:
+        from preprocess.preprocess_merge.incremental import iter_line_range
+
+        lines = (line for _, line in iter_line_range(path, start, end))
     with path.open("r", encoding="utf-8") as f:
-        for line_no, line in enumerate(f, start=1):
+        for line_no, line in enumerate(f if lines is None else lines, start=1):
             line = line.strip()
             if not line:
                 continue
@@ -204,29 +235,6 @@ def choose_better_row(a: UnifiedRow, b: UnifiedRow) -> UnifiedRow:
     return b
 
 
-def deduplicate_rows(rows: List[UnifiedRow]) -> List[UnifiedRow]:
-    chosen: Dict[Tuple[Any, ...], UnifiedRow] = {}
-    order: List[Tuple[Any, ...]] = []
-
-    for row in rows:
-        key = make_key(row)
-        if key not in chosen:
-            chosen[key] = row
-            order.append(key)
-        else:
-            better = choose_better_row(chosen[key], row)
-            chosen[key] = better
-
-    if len(order) != len(chosen):
-        logger.info(
-            "[INFO] 통합 과정에서 중복 제거: 원본 %d → %d (key = source,id,comment_index,comment_text)",
-            len(rows),
-            len(chosen),
-        )
-
-    return [chosen[k] for k in order]
-
-
 def parse_iso_for_sort(s: Optional[str]) -> Optional[datetime]:
     """
     ISO-8601 문자열을 datetime으로 파싱 (정렬용).
@@ -253,25 +261,207 @@ def parse_iso_for_sort(s: Optional[str]) -> Optional[datetime]:
         return None
 
 
-def sort_rows(rows: List[UnifiedRow]) -> List[UnifiedRow]:
+_MICROSECOND = timedelta(microseconds=1)
+
+
+def time_sort_value(row: UnifiedRow) -> int:
     """
-    정렬 기준:
+    정렬 기준 시각 (datetime.min 기준 마이크로초):
       1) comment_publishedAt (있으면)
       2) 없으면 published_at
-      3) 그래도 없으면 원래 순서 유지
+      3) 그래도 없으면 0 (= datetime.min, 맨 앞)
+    같은 값끼리는 원래 순서(파일 순서, 파일 안의 줄 순서)를 유지한다.
     """
+    dt = parse_iso_for_sort(row.comment_publishedAt) or parse_iso_for_sort(
+        row.published_at
+    )
+    # datetime.min은 offset-naive이므로 안전 (parse_iso_for_sort도 offset-naive 반환)
+    return (dt - datetime.min) // _MICROSECOND if dt else 0
 
-    def sort_key(idx_row: Tuple[int, UnifiedRow]):
-        idx, r = idx_row
-        dt_comment = parse_iso_for_sort(r.comment_publishedAt)
-        dt_main = parse_iso_for_sort(r.published_at)
-        dt = dt_comment or dt_main
-        # datetime.min은 offset-naive이므로 안전 (parse_iso_for_sort도 offset-naive 반환)
-        return (dt or datetime.min, idx)
 
-    indexed = list(enumerate(rows))
-    indexed.sort(key=sort_key)
-    return [r for _, r in indexed]
+# ---------- 외부 정렬 (sorted run → k-way merge) ----------
+#
+# run 파일의 한 줄은 JSON 배열 [정렬키, file_no, line_no, row_dict].
+# (file_no, line_no) 는 원래 입력 순서이며 같은 정렬키 안에서의 순서를 보장한다.
+#   - dedup 단계 run: 정렬키 = make_key 를 JSON 문자열로 만든 값
+#   - 시간 정렬 단계 run: 정렬키 = time_sort_value (정렬 안 하면 0)
+
+# run 하나에 담는 최대 행 수 (프로세스당 메모리 상한)
+DEFAULT_RUN_ROWS = 200_000
+
+
+def _record_order(rec: List[Any]) -> List[Any]:
+    return rec[:3]
+
+
+def fold_duplicates(records: Iterable[List[Any]]) -> Iterator[List[Any]]:
+    """
+    dedup 키 순으로 정렬된 record 에서 같은 키를 하나로 합친다.
+    choose_better_row 를 입력 순서대로 적용한 결과를 남기고,
+    위치(file_no, line_no)는 처음 나온 행의 것을 쓴다.
+    """
+    cur: Optional[List[Any]] = None
+    cur_row: Optional[UnifiedRow] = None
+    for rec in records:
+        if cur is not None and rec[0] == cur[0]:
+            row = UnifiedRow.from_raw(rec[3])
+            if row is not None and cur_row is not None:
+                better = choose_better_row(cur_row, row)
+                if better is row:
+                    cur_row = row
+                    cur[3] = rec[3]
+            continue
+        if cur is not None:
+            yield cur
+        cur = list(rec)
+        cur_row = UnifiedRow.from_raw(rec[3])
+    if cur is not None:
+        yield cur
+
+
+class RunWriter:
+    """record 를 모아 run_rows 개마다 정렬해서 run 파일로 내보낸다."""
+
+    def __init__(
+        self, run_dir: Path, prefix: str, run_rows: int, fold: bool = False
+    ) -> None:
+        self.run_dir = run_dir
+        self.prefix = prefix
+        self.run_rows = max(1, run_rows)
+        self.fold = fold
+        self.paths: List[Path] = []
+        self._buf: List[List[Any]] = []
+
+    def add(self, rec: List[Any]) -> None:
+        self._buf.append(rec)
+        if len(self._buf) >= self.run_rows:
+            self.flush()
+
+    def flush(self) -> None:
+        if not self._buf:
+            return
+        self._buf.sort(key=_record_order)
+        records: Iterable[List[Any]] = self._buf
+        if self.fold:
+            records = fold_duplicates(records)
+        path = self.run_dir / f"{self.prefix}-{len(self.paths):05d}.jsonl"
+        with path.open("w", encoding="utf-8") as fw:
+            for rec in records:
+                fw.write(json.dumps(rec, ensure_ascii=False))
+                fw.write("\n")
+        self.paths.append(path)
+        self._buf = []
+
+
+def iter_run(path: Path) -> Iterator[List[Any]]:
+    with path.open("r", encoding="utf-8") as f:
+        for line in f:
+            yield json.loads(line)
+
+
+def merge_runs(paths: List[Path]) -> Iterator[List[Any]]:
+    """정렬된 run 들을 k-way merge (heapq.merge, 파일당 한 줄씩만 메모리에 둔다)."""
+    return heapq.merge(*(iter_run(p) for p in paths), key=_record_order)
+
+
+@dataclass
+class RunResult:
+    paths: List[Path]
+    total_raw: int
+    total_valid: int
+    summary: Dict[str, Dict[str, int]]
+
+
+def _dedup_sort_key(row: UnifiedRow) -> str:
+    return json.dumps(make_key(row), ensure_ascii=False)
+
+
+def build_runs(
+    file_no: int,
+    path: Path,
+    run_dir: Path,
+    run_rows: int,
+    drop_duplicates: bool,
+    sort_by_time: bool,
+    start: int = 0,
+    end: Optional[int] = None,
+) -> RunResult:
+    """
+    입력 파일 하나를 읽어 정렬된 run 들로 내보낸다 (파일별로 병렬 실행).
+    dedup 을 하면 make_key 순 run (run 안에서 같은 키는 미리 합침),
+    아니면 바로 시간 정렬 run 을 만든다. start/end 는 iter_input 참고.
+    """
+    writer = RunWriter(run_dir, f"in{file_no:04d}", run_rows, fold=drop_duplicates)
+    summary: Dict[str, Dict[str, int]] = {}
+    total_raw = 0
+    total_valid = 0
+    for obj in iter_input(path, start, end):
+        total_raw += 1
+        row = UnifiedRow.from_raw(obj)
+        if row is None:
+            continue
+        if drop_duplicates:
+            key: Any = _dedup_sort_key(row)
+        else:
+            key = time_sort_value(row) if sort_by_time else 0
+        writer.add([key, file_no, total_valid, row.to_dict()])
+        add_to_summary(summary, row)
+        total_valid += 1
+    writer.flush()
+    return RunResult(writer.paths, total_raw, total_valid, summary)
+
+
+# ---------- near-duplicate (옵션) ----------
+
+# near-dup 비교에서 제외할 짧은 텍스트 길이 ("ㅋㅋㅋ" 같은 댓글끼리 묶이지 않도록)
+NEAR_DUP_MIN_CHARS = 50
+
+
+def drop_near_duplicates(
+    path: Path, threshold: float
+) -> Tuple[Dict[str, Dict[str, int]], int]:
+    """
+    MinHash-LSH(preprocess_gdelt/near_dup.py)로 통합 결과에서 거의 같은 행을 제거한다.
+    댓글 행은 comment_text, 나머지는 title+text 로 비교하고,
+    같은 source 의 같은 종류(본문/댓글) 행끼리만 중복으로 본다.
+    파일을 두 번 읽으며(서명 계산 → 다시 쓰기) 메모리에는 서명만 둔다.
+    시간순 결과에 적용하므로 더 이른 행이 남는다.
+    """
+    # lazy import: python -m preprocess.preprocess_merge.merge_preprocessed_cli 로 실행
+    from preprocess.preprocess_gdelt.near_dup import MinHashLSH
+
+    index = MinHashLSH(threshold, min_chars=NEAR_DUP_MIN_CHARS)
+    for obj in iter_jsonl(path):
+        row = UnifiedRow.from_raw(obj)
+        if row is None:
+            index.add("")
+            continue
+        is_comment = row.comment_index is not None
+        text = row.comment_text if is_comment else f"{row.title}\n{row.text}"
+        index.add(text or "", (row.source, is_comment))
+    flags = index.duplicates()
+
+    summary: Dict[str, Dict[str, int]] = {}
+    written = 0
+    tmp_path = path.with_name(path.name + ".tmp")
+    with tmp_path.open("w", encoding="utf-8") as fw:
+        for obj, dup in zip(iter_jsonl(path), flags):
+            if dup:
+                continue
+            fw.write(json.dumps(obj, ensure_ascii=False))
+            fw.write("\n")
+            row = UnifiedRow.from_raw(obj)
+            if row is not None:
+                add_to_summary(summary, row)
+            written += 1
+    tmp_path.replace(path)
+    logger.info(
+        "[INFO] near-duplicate 제거 (threshold=%.2f): %d → %d",
+        threshold,
+        len(flags),
+        written,
+    )
+    return summary, written
 
 
 # ---------- 통합 메인 로직 ----------
@@ -303,35 +493,83 @@ def expand_input_paths(patterns: List[str]) -> List[Path]:
     return paths
 
 
-def summarize_by_source(rows: List[UnifiedRow]) -> Dict[str, Dict[str, int]]:
+def add_to_summary(summary: Dict[str, Dict[str, int]], r: UnifiedRow) -> None:
     """
     소스 / doc_type별 개수 집계.
     doc_type이 없으면 "unknown"으로 칠함.
     """
-    summary: Dict[str, Dict[str, int]] = {}
-    for r in rows:
-        src = r.source or "unknown"
-        doc_type = str(r.raw.get("doc_type") or "unknown")
-        bucket = summary.setdefault(src, {})
-        bucket[doc_type] = bucket.get(doc_type, 0) + 1
-    return summary
+    src = r.source or "unknown"
+    doc_type = str(r.raw.get("doc_type") or "unknown")
+    bucket = summary.setdefault(src, {})
+    bucket[doc_type] = bucket.get(doc_type, 0) + 1
 
 
-def log_summary(prefix: str, rows: List[UnifiedRow]) -> None:
-    summary = summarize_by_source(rows)
+def merge_summaries(
+    summaries: Iterable[Dict[str, Dict[str, int]]],
+) -> Dict[str, Dict[str, int]]:
+    merged: Dict[str, Dict[str, int]] = {}
+    for summary in summaries:
+        for src, type_counts in summary.items():
+            bucket = merged.setdefault(src, {})
+            for doc_type, cnt in type_counts.items():
+                bucket[doc_type] = bucket.get(doc_type, 0) + cnt
+    return merged
+
+
+def log_summary(prefix: str, summary: Dict[str, Dict[str, int]]) -> None:
     logger.info("[INFO] %s 레코드 요약:", prefix)
     for src, type_counts in sorted(summary.items()):
         parts = [f"{dt}:{cnt}" for dt, cnt in sorted(type_counts.items())]
         logger.info("  - %s → %s", src, ", ".join(parts))
 
 
+def _build_all_runs(
+    sources: List[Tuple[Path, int, Optional[int]]],
+    run_dir: Path,
+    run_rows: int,
+    drop_duplicates: bool,
+    sort_by_time: bool,
+    jobs: int,
+) -> List[RunResult]:
+    """sources: (경로, 시작 바이트, 끝 바이트) — 입력 순서가 곧 file_no."""
+    args = [
+        (file_no, p, run_dir, run_rows, drop_duplicates, sort_by_time, start, end)
+        for file_no, (p, start, end) in enumerate(sources)
+    ]
+    paths = [p for p, _, _ in sources]
+    workers = min(jobs, len(paths))
+    if workers <= 1:
+        return [build_runs(*a) for a in args]
+    with ProcessPoolExecutor(max_workers=workers) as pool:
+        futures = [pool.submit(build_runs, *a) for a in args]
+        return [f.result() for f in futures]
+
+
 def merge_preprocessed(
     input_patterns: List[str],
     output_path: str | Path,
     *,
     drop_duplicates: bool = True,
     sort_by_time: bool = True,
+    near_dup_threshold: Optional[float] = None,
+    run_rows: int = DEFAULT_RUN_ROWS,
+    jobs: Optional[int] = None,
+    tmp_dir: Optional[str | Path] = None,
+    incremental: bool = False,
 ) -> None:
+    """
+    외부 정렬로 통합한다. 메모리에는 run 하나(run_rows 행)와
+    merge 중인 run 파일당 한 줄만 올라가므로 코퍼스 크기와 무관하다.
+
+    1) 입력 파일별(병렬): 유효 행을 run_rows 개씩 정렬해 임시 run 으로 내보냄
+    2) dedup: make_key 순으로 k-way merge 하며 같은 키를 choose_better_row 로 합치고,
+       결과를 시간 정렬 run 으로 다시 내보냄
+    3) 시간 정렬 run 을 k-way merge 하며 바로 출력 파일에 씀
+
+    incremental=True (JSONL 입출력만): 지난 통합 결과를 맨 앞 입력으로 두고
+    각 입력은 지난 실행 이후 붙은 꼬리만 읽는다. 이전 결과는 이미 중복 제거/정렬돼
+    있으므로 결과는 전체 재처리와 같다 (같은 시각 행들의 순서만 다를 수 있음).
+    """
     paths = expand_input_paths(input_patterns)
     if not paths:
         raise FileNotFoundError(f"입력 파일을 찾을 수 없습니다: {input_patterns}")
@@ -340,54 +578,112 @@ def merge_preprocessed(
     for p in paths:
         logger.info("  - %s", p)
 
-    unified_rows: List[UnifiedRow] = []
-    total_raw = 0
-    total_valid = 0
-
-    for p in paths:
-        for obj in iter_jsonl(p):
-            total_raw += 1
-            row = UnifiedRow.from_raw(obj)
-            if row is None:
-                continue
-            unified_rows.append(row)
-            total_valid += 1
-
-    logger.info(
-        "[INFO] 원본 레코드 %d개 중 유효 레코드 %d개",
-        total_raw,
-        total_valid,
-    )
+    jobs = jobs or os.cpu_count() or 1
+    out_path = Path(output_path)
 
-    if not unified_rows:
-        logger.warning(
-            "[WARN] 유효한 레코드가 없습니다. 출력 파일을 생성하지 않습니다."
+    sources: List[Tuple[Path, int, Optional[int]]] = [(p, 0, None) for p in paths]
+    ckpt = None
+    if incremental and not any(_is_parquet(p) for p in [out_path, *paths]):
+        from preprocess.preprocess_merge.incremental import Checkpoint, complete_end
+
+        ckpt = Checkpoint(
+            out_path,
+            stage=(
+                f"merge:dedup={drop_duplicates}:sort={sort_by_time}"
+                f":near={near_dup_threshold}"
+            ),
+            inputs=paths,
+            rewrite=True,
         )
-        return
-
-    log_summary("통합 전", unified_rows)
-
-    if drop_duplicates:
-        unified_rows = deduplicate_rows(unified_rows)
-
-    if sort_by_time:
-        unified_rows = sort_rows(unified_rows)
-
-    log_summary("중복제거/정렬 후", unified_rows)
+        sources = []
+        if ckpt.resume:
+            sources.append((out_path, 0, None))
+        for p in paths:
+            end = complete_end(p)
+            ckpt.mark_done(p, end)
+            sources.append((p, ckpt.start_offset(p), end))
+    elif incremental:
+        logger.warning("[WARN] Parquet 입출력은 증분 처리하지 않고 전체를 다시 통합합니다.")
+
+    with tempfile.TemporaryDirectory(prefix="merge_runs_", dir=tmp_dir) as tmp:
+        run_dir = Path(tmp)
+        results = _build_all_runs(
+            sources, run_dir, run_rows, drop_duplicates, sort_by_time, jobs
+        )
+        total_raw = sum(r.total_raw for r in results)
+        total_valid = sum(r.total_valid for r in results)
+        run_paths = [p for r in results for p in r.paths]
 
-    out_path = Path(output_path)
-    if out_path.parent and not out_path.parent.exists():
-        out_path.parent.mkdir(parents=True, exist_ok=True)
+        logger.info(
+            "[INFO] 원본 레코드 %d개 중 유효 레코드 %d개",
+            total_raw,
+            total_valid,
+        )
 
-    with out_path.open("w", encoding="utf-8") as fw:
-        for row in unified_rows:
-            fw.write(json.dumps(row.to_dict(), ensure_ascii=False))
-            fw.write("\n")
+        if not total_valid:
+            logger.warning(
+                "[WARN] 유효한 레코드가 없습니다. 출력 파일을 생성하지 않습니다."
+            )
+            return
+
+        log_summary("통합 전", merge_summaries(r.summary for r in results))
+
+        if drop_duplicates:
+            writer = RunWriter(run_dir, "sorted", run_rows)
+            kept = 0
+            for rec in fold_duplicates(merge_runs(run_paths)):
+                row = UnifiedRow.from_raw(rec[3])
+                key = time_sort_value(row) if (sort_by_time and row) else 0
+                writer.add([key, rec[1], rec[2], rec[3]])
+                kept += 1
+            writer.flush()
+            for p in run_paths:
+                p.unlink()
+            run_paths = writer.paths
+            if kept != total_valid:
+                logger.info(
+                    "[INFO] 통합 과정에서 중복 제거: 원본 %d → %d (key = source,id,comment_index,comment_text)",
+                    total_valid,
+                    kept,
+                )
 
+        if out_path.parent and not out_path.parent.exists():
+            out_path.parent.mkdir(parents=True, exist_ok=True)
+
+        # Parquet 출력이면 JSONL 로 한 번 모은 뒤 데이터셋으로 옮긴다
+        # (증분 처리는 이전 결과를 입력으로 읽는 중이므로 임시 파일에 쓴 뒤 교체)
+        parquet_out = _is_parquet(out_path)
+        staged = parquet_out or ckpt is not None
+        jsonl_path = run_dir / "merged.jsonl" if staged else out_path
+
+        summary: Dict[str, Dict[str, int]] = {}
+        written = 0
+        with jsonl_path.open("w", encoding="utf-8") as fw:
+            for rec in merge_runs(run_paths):
+                fw.write(json.dumps(rec[3], ensure_ascii=False))
+                fw.write("\n")
+                row = UnifiedRow.from_raw(rec[3])
+                if row is not None:
+                    add_to_summary(summary, row)
+                written += 1
+
+        if near_dup_threshold is not None:
+            summary, written = drop_near_duplicates(jsonl_path, near_dup_threshold)
+
+        if parquet_out:
+            from preprocess.preprocess_merge.columnar import write_parquet_dataset
+
+            write_parquet_dataset(out_path, iter_jsonl(jsonl_path))
+        elif staged:
+            shutil.move(str(jsonl_path), str(out_path))
+            if ckpt is not None:
+                ckpt.commit()
+
+    log_summary("중복제거/정렬 후", summary)
     logger.info(
         "[INFO] 최종 통합 결과: %s (총 %d개 레코드)",
         out_path,
-        len(unified_rows),
+        written,
     )
 
 
@@ -406,25 +702,61 @@ def main(argv: Optional[List[str]] = None) -> None:
         help=(
             "통합할 전처리 JSONL 경로들 (여러 개 가능, glob 패턴 허용). "
             '예: -i "preprocess/preprocessing_data/*.jsonl" '
-            "또는 -i yt_comments1.jsonl yt_comments2.jsonl"
+            "또는 -i yt_comments1.jsonl yt_comments2.jsonl "
+            "(.parquet 데이터셋도 입력 가능)"
         ),
     )
     parser.add_argument(
         "--output",
         "-o",
         required=True,
-        help="통합 결과 JSONL 경로",
+        help="통합 결과 JSONL 경로 (.parquet 로 끝나면 source/month 파티션 Parquet 데이터셋)",
     )
     parser.add_argument(
         "--no-dedup",
         action="store_true",
         help="중복 제거를 하지 않으려면 지정",
     )
+    parser.add_argument(
+        "--near-dup-threshold",
+        type=float,
+        default=None,
+        help=(
+            "지정하면 MinHash-LSH로 near-duplicate도 제거 (5-gram Jaccard 하한, "
+            "예: 0.8). python -m 으로 실행해야 한다"
+        ),
+    )
     parser.add_argument(
         "--no-sort",
         action="store_true",
         help="시간 기준 정렬을 하지 않으려면 지정",
     )
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        default=None,
+        help="입력 파일별 run 생성 병렬 프로세스 수 (기본: CPU 수)",
+    )
+    parser.add_argument(
+        "--run-rows",
+        type=int,
+        default=DEFAULT_RUN_ROWS,
+        help=f"외부 정렬 run 하나의 최대 행 수 = 메모리 상한 (기본 {DEFAULT_RUN_ROWS})",
+    )
+    parser.add_argument(
+        "--tmp-dir",
+        default=None,
+        help="정렬 run 임시 파일 위치 (기본: 시스템 임시 디렉터리)",
+    )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        help=(
+            "지난 통합 결과 + 입력에 새로 붙은 줄만 읽어 다시 통합 (JSONL 입출력만). "
+            "python -m 으로 실행해야 한다"
+        ),
+    )
 
     args = parser.parse_args(argv)
 
@@ -433,6 +765,11 @@ def main(argv: Optional[List[str]] = None) -> None:
         output_path=args.output,
         drop_duplicates=not args.no_dedup,
         sort_by_time=not args.no_sort,
+        near_dup_threshold=args.near_dup_threshold,
+        run_rows=args.run_rows,
+        jobs=args.jobs,
+        tmp_dir=args.tmp_dir,
+        incremental=args.incremental,
     )
 
 
@@ -0,0 +1,173 @@
+"""
+전처리 단계 공용 병렬 실행기.
+
+입력 JSONL 을 줄 경계에 맞춘 바이트 구간(shard)으로 나누고, 프로세스 풀에서
+각 구간에 같은 변환(transform)을 돌린다. 워커는 결과를 shard 별 임시 JSONL 에
+쓰고, 부모는 그 파일을 입력 순서대로(ordered) 또는 끝난 순서대로 이어 붙인다.
+부모는 줄을 다시 파싱하지 않고 파일을 그대로 복사하므로 병목이 되지 않는다.
+
+transform 은 (lines, stats) → dict 이터러블 인 모듈 최상위 함수여야 한다
+(프로세스로 넘기므로 pickle 가능해야 함; 인자는 functools.partial 로 묶는다).
+  - lines: shard 의 줄들 (각 단계 loader 의 lines= 인자로 그대로 넘기면 된다)
+  - stats: 카운터 dict. 워커별 값이 합쳐져 돌아온다.
+
+사용 예:
+  transform = functools.partial(youtube_shard, in_path=in_path, min_length=0)
+  with out_path.open("w", encoding="utf-8") as fw:
+      rows, stats = write_sharded(in_path, transform, fw, jobs=32)
+"""
+
+from __future__ import annotations
+
+import json
+import shutil
+import tempfile
+from concurrent.futures import Future, ProcessPoolExecutor, as_completed
+from pathlib import Path
+from typing import (
+    IO,
+    Any,
+    Callable,
+    Dict,
+    Iterable,
+    Iterator,
+    List,
+    Optional,
+    Tuple,
+)
+
+from .incremental import Checkpoint, complete_end, iter_line_range
+
+Transform = Callable[[Iterable[str], Dict[str, int]], Iterable[Dict[str, Any]]]
+
+# shard 하나의 최소 크기 (너무 잘게 나누면 프로세스 왕복 비용이 커짐)
+MIN_SHARD_BYTES = 4 << 20
+# 워커당 shard 수 (크기가 고르지 않은 줄이 몰려도 놀지 않도록)
+SHARDS_PER_JOB = 4
+
+
+def split_ranges(
+    path: Path, parts: int, start: int = 0, end: Optional[int] = None
+) -> List[Tuple[int, int]]:
+    """[start, end) 를 줄 경계에서 최대 parts 개의 구간으로 나눈다."""
+    if end is None:
+        end = path.stat().st_size
+    if end <= start:
+        return []
+    step = max(1, (end - start) // max(1, parts))
+    bounds = [start]
+    with path.open("rb") as f:
+        pos = start + step
+        while pos < end:
+            f.seek(pos)
+            f.readline()  # 다음 줄 시작까지 건너뜀
+            cut = f.tell()
+            if cut >= end:
+                break
+            if cut > bounds[-1]:
+                bounds.append(cut)
+            pos = cut + step
+    bounds.append(end)
+    return list(zip(bounds[:-1], bounds[1:]))
+
+
+def plan_shards(
+    path: Path, jobs: int, start: int = 0, end: Optional[int] = None
+) -> List[Tuple[int, int]]:
+    if end is None:
+        end = path.stat().st_size
+    by_size = -(-(end - start) // MIN_SHARD_BYTES)
+    return split_ranges(path, min(jobs * SHARDS_PER_JOB, max(1, by_size)), start, end)
+
+
+def shard_bounds(ckpt: Checkpoint, path: Path) -> Tuple[int, Optional[int]]:
+    """
+    증분 처리와 함께 쓸 때 읽을 구간. 끝은 지금 있는 마지막 완전한 줄로 고정하고
+    매니페스트에도 그 위치를 처리 완료로 기록한다 (ckpt.commit() 시 저장).
+    """
+    if not ckpt.enabled:
+        return 0, None
+    end = complete_end(path)
+    ckpt.mark_done(path, end)
+    return ckpt.start_offset(path), end
+
+
+def _run_shard(
+    transform: Transform, path: Path, start: int, end: int, out_path: Path
+) -> Tuple[int, Dict[str, int]]:
+    stats: Dict[str, int] = {}
+    lines = (line for _, line in iter_line_range(path, start, end, partial=True))
+    rows = 0
+    with out_path.open("w", encoding="utf-8") as fw:
+        for rec in transform(lines, stats):
+            fw.write(json.dumps(rec, ensure_ascii=False))
+            fw.write("\n")
+            rows += 1
+    return rows, stats
+
+
+def _add_stats(total: Dict[str, int], stats: Dict[str, int]) -> None:
+    for k, v in stats.items():
+        total[k] = total.get(k, 0) + v
+
+
+def iter_shard_outputs(
+    path: Path,
+    transform: Transform,
+    *,
+    jobs: int,
+    start: int = 0,
+    end: Optional[int] = None,
+    ordered: bool = True,
+    tmp_dir: Optional[str | Path] = None,
+) -> Iterator[Tuple[Path, int, Dict[str, int]]]:
+    """
+    shard 결과 파일을 (경로, 행 수, stats) 로 돌려준다.
+    ordered=True 면 입력 순서대로, 아니면 먼저 끝난 shard 부터.
+    돌려받은 파일은 다음 shard 로 넘어갈 때 지운다.
+    """
+    path = Path(path)
+    ranges = plan_shards(path, jobs, start, end)
+    if not ranges:
+        return
+    with tempfile.TemporaryDirectory(prefix="shards_", dir=tmp_dir) as tmp:
+        with ProcessPoolExecutor(max_workers=min(jobs, len(ranges))) as pool:
+            futures: Dict[Future, Path] = {}
+            for i, (s, e) in enumerate(ranges):
+                out = Path(tmp) / f"shard-{i:05d}.jsonl"
+                futures[pool.submit(_run_shard, transform, path, s, e, out)] = out
+            done = futures.keys() if ordered else as_completed(futures)
+            for fut in done:
+                rows, stats = fut.result()
+                out = futures[fut]
+                yield out, rows, stats
+                out.unlink()
+
+
+def write_sharded(
+    path: Path, transform: Transform, fw: IO[str], **options: Any
+) -> Tuple[int, Dict[str, int]]:
+    """shard 결과를 fw 에 이어 쓰고 (총 행 수, 합친 stats) 를 돌려준다."""
+    total = 0
+    stats: Dict[str, int] = {}
+    for out, rows, shard_stats in iter_shard_outputs(path, transform, **options):
+        with out.open("r", encoding="utf-8") as f:
+            shutil.copyfileobj(f, fw)
+        total += rows
+        _add_stats(stats, shard_stats)
+    return total, stats
+
+
+def iter_sharded_records(
+    path: Path,
+    transform: Transform,
+    stats: Optional[Dict[str, int]] = None,
+    **options: Any,
+) -> Iterator[Dict[str, Any]]:
+    """shard 결과를 dict 로 다시 읽어 돌려준다 (Parquet 출력, 전역 dedup 용)."""
+    for out, _, shard_stats in iter_shard_outputs(path, transform, **options):
+        if stats is not None:
+            _add_stats(stats, shard_stats)
+        with out.open("r", encoding="utf-8") as f:
+            for line in f:
+                yield json.loads(line)
@@ -3,14 +3,22 @@ from __future__ import annotations
 
 import argparse
 import logging
+from functools import partial
 from pathlib import Path
-from typing import List, Optional
+from typing import Any, Dict, Iterable, Iterator, List, Optional
 
 from .stage1_models_io import (
     load_raw_youtube,
     write_flattened_jsonl,
 )
 from .stage2_transform import flatten_many_videos_to_comments
+from ..preprocess_merge.columnar import is_parquet_path, write_parquet_dataset
+from ..preprocess_merge.incremental import Checkpoint, write_dict_lines
+from ..preprocess_merge.sharded import (
+    iter_sharded_records,
+    shard_bounds,
+    write_sharded,
+)
 
 
 logger = logging.getLogger(__name__)
@@ -20,12 +28,33 @@ logging.basicConfig(
 )
 
 
+def youtube_shard(
+    lines: Iterable[str],
+    stats: Dict[str, int],
+    *,
+    in_path: Path,
+    min_length: int,
+    lang_filter: Optional[List[str]],
+) -> Iterator[Dict[str, Any]]:
+    """병렬 실행(preprocess_merge/sharded.py)용 변환: shard 의 원본 줄 → 레코드 dict."""
+    records = flatten_many_videos_to_comments(
+        load_raw_youtube(in_path, lines=lines),
+        min_length=min_length,
+        lang_filter=lang_filter,
+    )
+    stats["records"] = stats.get("records", 0) + len(records)
+    return (rec.to_dict() for rec in records)
+
+
 def preprocess_youtube_comments(
     input_path: str | Path,
     output_path: str | Path,
     *,
     min_length: int = 0,
     lang_filter: Optional[List[str]] = None,
+    incremental: bool = False,
+    jobs: int = 1,
+    ordered: bool = True,
 ) -> None:
     """
     youtube.jsonl → "영상 + 댓글 1개 = 1줄" 스키마 JSONL 생성.
@@ -44,6 +73,12 @@ def preprocess_youtube_comments(
         "comment_text": <str|null>,      # 댓글 없는 경우: null
         "comment_publishedAt": <str|null> # 댓글 없는 경우: null
       }
+
+    incremental=True 이면 지난 실행 이후 입력에 붙은 줄만 처리해 출력에 이어 쓴다
+    (JSONL 출력만, preprocess_merge/incremental.py).
+
+    jobs > 1 이면 입력을 줄 경계 구간으로 나눠 jobs 개 프로세스에서 처리한다
+    (preprocess_merge/sharded.py). ordered=False 면 끝난 구간부터 써서 순서가 섞인다.
     """
     in_path = Path(input_path)
     out_path = Path(output_path)
@@ -53,14 +88,54 @@ def preprocess_youtube_comments(
 
     out_path.parent.mkdir(parents=True, exist_ok=True)
 
-    raw_iter = load_raw_youtube(in_path)
+    ckpt = Checkpoint(
+        out_path,
+        stage="youtube",
+        inputs=[in_path],
+        enabled=incremental and not is_parquet_path(out_path),
+    )
+
+    if jobs > 1:
+        start, end = shard_bounds(ckpt, in_path)
+        transform = partial(
+            youtube_shard,
+            in_path=in_path,
+            min_length=min_length,
+            lang_filter=lang_filter,
+        )
+        options: Dict[str, Any] = dict(jobs=jobs, start=start, end=end, ordered=ordered)
+        if is_parquet_path(out_path):
+            total = write_parquet_dataset(
+                out_path, iter_sharded_records(in_path, transform, **options)
+            )
+        else:
+            with ckpt.open_output() as fw:
+                total, _ = write_sharded(in_path, transform, fw, **options)
+            ckpt.commit()
+        logger.info(
+            "[INFO] 최종 YouTube 댓글 기반 레코드: %s (총 %d개, jobs=%d)",
+            out_path,
+            total,
+            jobs,
+        )
+        return
+
+    lines = ckpt.iter_lines(in_path) if ckpt.enabled else None
+    raw_iter = load_raw_youtube(in_path, lines=lines)
     records = flatten_many_videos_to_comments(
         raw_iter,
         min_length=min_length,
         lang_filter=lang_filter,
     )
 
-    write_flattened_jsonl(out_path, records)
+    if is_parquet_path(out_path):
+        write_parquet_dataset(out_path, (rec.to_dict() for rec in records))
+    elif ckpt.enabled:
+        with ckpt.open_output() as fw:
+            write_dict_lines(fw, (rec.to_dict() for rec in records))
+        ckpt.commit()
+    else:
+        write_flattened_jsonl(out_path, records)
     logger.info(
         "[INFO] 최종 YouTube 댓글 기반 레코드: %s (총 %d개)",
         out_path,
@@ -82,7 +157,7 @@ def main(argv: Optional[List[str]] = None) -> None:
         "--output",
         "-o",
         required=True,
-        help="전처리 결과 JSONL 경로",
+        help="전처리 결과 JSONL 경로 (.parquet 로 끝나면 Parquet 데이터셋)",
     )
     parser.add_argument(
         "--min-length",
@@ -96,6 +171,23 @@ def main(argv: Optional[List[str]] = None) -> None:
         default="ko",
         help="lang 필터 (쉼표로 여러 개 가능). 예: ko 또는 ko,en. 빈 문자열이면 필터 없음.",
     )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        help="지난 실행 이후 입력에 새로 붙은 줄만 처리해서 출력에 이어 쓴다 (JSONL 출력만).",
+    )
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        default=1,
+        help="입력을 줄 경계 구간으로 나눠 처리할 프로세스 수 (기본 1: 단일 프로세스)",
+    )
+    parser.add_argument(
+        "--unordered",
+        action="store_true",
+        help="병렬 처리 시 끝난 구간부터 바로 쓴다 (출력 순서가 입력 순서와 달라짐)",
+    )
 
     args = parser.parse_args(argv)
 
@@ -108,6 +200,9 @@ def main(argv: Optional[List[str]] = None) -> None:
         output_path=args.output,
         min_length=args.min_length,
         lang_filter=lang_list,
+        incremental=args.incremental,
+        jobs=args.jobs,
+        ordered=not args.unordered,
     )
 
 
@@ -5,3 +5,7 @@ from pathlib import Path
 ROOT = Path(__file__).resolve().parents[1]
 if str(ROOT) not in sys.path:
     sys.path.insert(0, str(ROOT))
+# The dashboard imports itself as 'nps_dashboard' (run from viz/)
+VIZ = ROOT / "viz"
+if str(VIZ) not in sys.path:
+    sys.path.insert(1, str(VIZ))
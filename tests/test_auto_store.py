@@ -0,0 +1,223 @@
+import json
+import threading
+from datetime import datetime, timezone
+from types import SimpleNamespace
+
+from crawl.core.auto.runner import AutoCrawler
+from crawl.core.auto.scheduler import RoundPlan
+from crawl.core.auto.state import AutoState
+from crawl.core.auto.store import SharedStateStore
+from crawl.core.config import load_config
+from crawl.core.models import Candidate
+
+JAN = datetime(2025, 1, 1, tzinfo=timezone.utc)
+FEB = datetime(2025, 2, 1, tzinfo=timezone.utc)
+MAR = datetime(2025, 3, 1, tzinfo=timezone.utc)
+
+
+def _plan(state: AutoState) -> RoundPlan:
+    state.youtube.consume(101)
+    state.youtube_kw_cursor += 1
+    return RoundPlan(
+        windows={"gdelt": [(JAN, FEB), (FEB, MAR)], "youtube": [(JAN, FEB)]},
+        youtube_keywords=["국민연금"],
+        include_forums=False,
+        max_fetch=50,
+    )
+
+
+def test_plan_round_queues_once_and_applies_quota(tmp_path):
+    store = SharedStateStore(tmp_path / "auto.sqlite")
+    assert store.plan_round(_plan) == 3
+    # Tasks still open: a second planner (another worker) only joins the queue
+    assert store.plan_round(_plan) is None
+    state = store.snapshot()
+    assert state.youtube.used_today == 101
+    assert state.youtube_kw_cursor == 1
+    assert store.task_counts() == {"pending": 3}
+
+
+def test_claim_lease_expiry_and_complete(tmp_path):
+    store = SharedStateStore(tmp_path / "auto.sqlite", max_attempts=2)
+    store.plan_round(_plan)
+    first = store.claim("w1", lease_sec=60)
+    second = store.claim("w2", lease_sec=60)
+    assert first is not None and second is not None
+    assert first.id != second.id
+    assert first.keywords == [] and first.max_fetch == 50
+
+    # w1 died: an expired lease is handed to the next worker
+    store._conn().execute("UPDATE tasks SET lease_until = 0 WHERE id = ?", (first.id,))
+    retry = store.claim("w3", lease_sec=60)
+    assert retry is not None and retry.id == first.id and retry.attempts == 2
+    assert not store.renew(first, lease_sec=60)
+    assert store.renew(retry, lease_sec=60)
+
+    store._conn().execute(
+        "INSERT INTO forum_cursors (board, page) VALUES ('https://b/', 9)"
+    )
+    store.complete(
+        retry,
+        stored=0,
+        fetched=4,
+        discovered=10,
+        duplicates_skipped=0,
+        forum_pages={"https://a/": 3, "https://b/": 2},
+    )
+    state = store.snapshot()
+    # Cursors never move backwards; an empty window goes on cooldown
+    assert state.forum_cursors == {"https://a/": 4, "https://b/": 9}
+    assert state.cooldowns == {"2025-01": {"gdelt": 3}}
+    assert store.task_counts()["done"] == 1
+
+
+def test_complete_after_lost_lease_is_dropped(tmp_path):
+    store = SharedStateStore(tmp_path / "auto.sqlite")
+    store.plan_round(_plan)
+    stale = store.claim("w1", lease_sec=60)
+    assert stale is not None
+    store._conn().execute("UPDATE tasks SET lease_until = 0 WHERE id = ?", (stale.id,))
+    owner = store.claim("w2", lease_sec=60)
+    assert owner is not None and owner.id == stale.id
+
+    # The old owner finishing late must not mark done or move cursors/cooldowns
+    assert not store.complete(
+        stale,
+        stored=0,
+        fetched=0,
+        discovered=0,
+        duplicates_skipped=0,
+        forum_pages={"https://a/": 7},
+    )
+    store.fail(stale, "late")
+    state = store.snapshot()
+    assert state.forum_cursors == {} and state.cooldowns == {}
+    assert store.task_counts() == {"leased": 1, "pending": 2}
+    assert store.complete(
+        owner, stored=5, fetched=5, discovered=5, duplicates_skipped=0
+    )
+
+
+def test_record_stored_counts_are_atomic_across_threads(tmp_path):
+    path = tmp_path / "auto.sqlite"
+    SharedStateStore(path)
+    doc = SimpleNamespace(published_at="2025-01-15T00:00:00Z")
+
+    def work(worker: int) -> None:
+        # Separate store objects stand in for separate worker processes
+        store = SharedStateStore(path)
+        for i in range(50):
+            url = f"https://x/{worker}/{i}"
+            cand = Candidate(url=url, source="gdelt", discovered_via={})
+            store.record_stored(doc, cand)  # type: ignore[arg-type]
+        store.close()
+
+    threads = [threading.Thread(target=work, args=(w,)) for w in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    state = SharedStateStore(path).snapshot()
+    assert state.counts == {"2025-01": {"gdelt": 200}}
+    assert state.stored_by_source == {"gdelt": 200}
+
+
+def test_record_stored_counts_a_url_once_across_shards(tmp_path):
+    path = tmp_path / "auto.sqlite"
+    doc = SimpleNamespace(published_at="2025-01-15T00:00:00Z")
+    first, second = SharedStateStore(path), SharedStateStore(path)
+    cand = Candidate(url="https://x/a?utm_source=t", source="gdelt", discovered_via={})
+    assert first.record_stored(doc, cand)  # type: ignore[arg-type]
+    # Same page via another shard (and another tracking parameter)
+    again = Candidate(url="https://x/a", source="gdelt", discovered_via={})
+    assert not second.record_stored(doc, again)  # type: ignore[arg-type]
+    assert first.snapshot().counts == {"2025-01": {"gdelt": 1}}
+
+
+def test_run_worker_drains_queue(monkeypatch, tmp_path):
+    config = load_config()
+    config.output.root = tmp_path
+    runner = AutoCrawler(config, state_path=tmp_path / "_auto_state.json")
+    store = SharedStateStore(tmp_path / "auto.sqlite")
+    store.plan_round(_plan)
+    seen = []
+
+    def fake_window(source, start, end, **kwargs):  # noqa: ARG001
+        seen.append((source, start, kwargs["youtube_keywords"]))
+        if source == "youtube":
+            raise RuntimeError("quota exceeded")
+        stats = SimpleNamespace(
+            stored=2, fetched=3, discovered={"gdelt": 5}, duplicates_skipped=0
+        )
+        return stats, {}
+
+    monkeypatch.setattr(runner, "_run_window", fake_window)
+    totals = runner.run_worker(store, worker_id="w1", max_tasks=3)
+    runner.close()
+    assert totals["tasks"] == 2 and totals["failed"] == 1
+    assert totals["stored"] == 4 and totals["discovered"] == 10
+    assert ("youtube", JAN, ["국민연금"]) in seen
+    # The failed task is back in the queue for another attempt
+    assert store.task_counts() == {"done": 2, "pending": 1}
+
+
+def test_worker_shards_are_exclusive_and_reused(tmp_path):
+    from crawl.core.auto.shards import WorkerShard
+
+    config = load_config()
+    config.output.root = tmp_path
+    first = WorkerShard.acquire(tmp_path)
+    second = WorkerShard.acquire(tmp_path)
+    assert (first.name, second.name) == ("w0", "w1")
+    shard_cfg = first.config_for(config)
+    assert shard_cfg.output.root == tmp_path / "_workers" / "w0"
+    # The HTTP cache stays shared; the base config is untouched
+    assert shard_cfg.http_cache.root == tmp_path / "_http_cache"
+    assert config.output.root == tmp_path
+    try:
+        WorkerShard.acquire(tmp_path, "w1")
+    except RuntimeError:
+        pass
+    else:
+        raise AssertionError("a locked shard must not be handed out twice")
+    # A restarted worker takes the freed slot back (and its index)
+    first.release()
+    again = WorkerShard.acquire(tmp_path)
+    assert again.name == "w0"
+    again.release()
+    second.release()
+
+
+def _shard_line(i: int, url: str) -> str:
+    record = {"id": f"doc-{i}", "url": url, "source": "ppomppu", "title": str(i)}
+    return json.dumps(record) + "\n"
+
+
+def test_merge_worker_shards_appends_new_lines_and_drops_duplicates(tmp_path):
+    from crawl.core.auto.shards import merge_worker_shards
+
+    name = "forum_ppomppu.jsonl"
+    for shard in ("w0", "w1"):
+        (tmp_path / "_workers" / shard).mkdir(parents=True)
+    w0 = tmp_path / "_workers" / "w0" / name
+    w1 = tmp_path / "_workers" / "w1" / name
+    w0.write_text(_shard_line(1, "https://p/1") + _shard_line(2, "https://p/2"))
+    # w1 stored page 2 too, plus a line it is still writing
+    w1.write_text(_shard_line(3, "https://p/2") + '{"id": "doc-4"')
+
+    stats = merge_worker_shards(tmp_path)
+    assert stats is not None
+    assert (stats.merged, stats.duplicates) == (2, 1)
+    merged = [json.loads(line)["id"] for line in (tmp_path / name).open()]
+    assert merged == ["doc-1", "doc-2"]
+
+    # Only the tail is read next time; a rewritten shard is read again but
+    # its already merged documents are dropped by the root index
+    with w1.open("a") as f:
+        f.write(', "url": "https://p/4"}\n')
+    w0.write_text(_shard_line(1, "https://p/1") + _shard_line(5, "https://p/5"))
+    stats = merge_worker_shards(tmp_path)
+    assert stats is not None
+    assert (stats.merged, stats.duplicates) == (2, 1)
+    merged = [json.loads(line)["id"] for line in (tmp_path / name).open()]
+    assert merged == ["doc-1", "doc-2", "doc-5", "doc-4"]
@@ -0,0 +1,40 @@
+from benchmarks.cases import FIXTURE_URLS, FORUM_SITES, crawl_cases, read_fixture
+from benchmarks.harness import Benchmark, compare, measure
+from crawl.core.discovery.forums import ForumsDiscoverer
+
+
+def test_measure_reports_throughput_and_allocations():
+    def run() -> int:
+        _ = [str(i) for i in range(1000)]
+        return 1000
+
+    result = measure(Benchmark("toy", "test", run, "item"), repeat=2, warmup=0)
+    assert result.units == 1000
+    assert result.repeat == 2
+    assert result.units_per_sec > 0
+    assert result.peak_kib > 0
+
+
+def test_compare_flags_only_slowdowns_beyond_tolerance():
+    def bench(name: str, ups: float):  # type: ignore[no-untyped-def]
+        result = measure(Benchmark(name, "test", lambda: 1), repeat=1, trace=False)
+        result.units_per_sec = ups
+        return result
+
+    results = [bench("same", 95.0), bench("slower", 50.0), bench("new", 1.0)]
+    regressions = compare(results, {"same": 100.0, "slower": 100.0}, tolerance=0.1)
+    assert [r.name for r in regressions] == ["slower"]
+    assert regressions[0].ratio == 0.5
+
+
+def test_listing_fixtures_match_parsers():
+    discoverer = ForumsDiscoverer(None, 5, "bench", {})
+    for site in FORUM_SITES:
+        parser = getattr(discoverer, f"_parse_{site}")
+        items = parser(FIXTURE_URLS[site][0], read_fixture(f"{site}_list.html"))
+        assert len(items) >= 40, site
+
+
+def test_crawl_cases_run_offline():
+    for bench in crawl_cases(loops=1):
+        assert bench.run() >= 1, bench.name
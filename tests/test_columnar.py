@@ -0,0 +1,64 @@
+import pytest
+
+from preprocess.preprocess_merge.columnar import (
+    BOOL,
+    INT,
+    _coerce,
+    iter_parquet_records,
+    write_parquet_dataset,
+)
+
+
+def test_coerce_parses_bool_strings_explicitly():
+    assert _coerce("false", BOOL) is False
+    assert _coerce("False", BOOL) is False
+    assert _coerce("0", BOOL) is False
+    assert _coerce("true", BOOL) is True
+    assert _coerce(" yes ", BOOL) is True
+    assert _coerce(True, BOOL) is True
+    assert _coerce(0, BOOL) is False
+    # Unknown strings are missing values, not truthy
+    assert _coerce("maybe", BOOL) is None
+    assert _coerce("", BOOL) is None
+    assert _coerce("12", INT) == 12
+
+
+def test_parquet_round_trip_keeps_bools_and_extra(tmp_path):
+    pytest.importorskip("pyarrow")
+    records = [
+        {
+            "id": "a",
+            "source": "youtube",
+            "lang": "ko",
+            "title": "t",
+            "text": "x",
+            "published_at": "2024-01-05T00:00:00Z",
+            "comment_index": None,
+            "comment_text": None,
+            "comment_publishedAt": None,
+            "is_related": "false",
+            "negative": 0.5,
+            "note": {"k": 1},
+        },
+        {
+            "id": "b",
+            "source": "gdelt",
+            "lang": "ko",
+            "title": "u",
+            "text": "y",
+            "published_at": "2024-02-01T00:00:00Z",
+            "comment_index": 3,
+            "comment_text": "c",
+            "comment_publishedAt": "2024-02-02T00:00:00Z",
+            "is_related": True,
+        },
+    ]
+    root = tmp_path / "out.parquet"
+    assert write_parquet_dataset(root, records) == 2
+    assert (root / "source=youtube" / "month=2024-01").is_dir()
+    back = {rec["id"]: rec for rec in iter_parquet_records(root)}
+    assert back["a"]["is_related"] is False
+    assert back["a"]["note"] == {"k": 1}
+    assert back["a"]["comment_index"] is None
+    assert back["b"]["is_related"] is True
+    assert back["b"]["comment_index"] == 3
@@ -0,0 +1,99 @@
+import json
+
+import pytest
+
+
+def _row(i, label="negative"):
+    probs = {"negative": 0.1, "neutral": 0.1, "positive": 0.1}
+    probs[label] = 0.8
+    return {
+        "id": f"r{i}",
+        "source": "dcinside",
+        "lang": "ko",
+        "text": f"국민연금 글 {i}",
+        "published_at": f"2024-03-{i % 5 + 1:02d}T01:00:00Z",
+        "is_related": True,
+        "sentiment": probs,
+    }
+
+
+def _write(path, rows, mode="w"):
+    with path.open(mode, encoding="utf-8") as f:
+        for row in rows:
+            f.write(json.dumps(row, ensure_ascii=False) + "\n")
+
+
+def _cube_modules():
+    pytest.importorskip("pandas")
+    pytest.importorskip("streamlit")
+    from nps_dashboard import cube
+
+    return cube
+
+
+def _totals(cube_mod, df):
+    out = cube_mod.rollup(df, ["date", "sentiment_label"])
+    return sorted(
+        (str(r.date), str(r.sentiment_label), int(r.n), round(r.score_sum, 6))
+        for r in out.itertuples()
+    )
+
+
+def _rebuilt(cube_mod, data, tmp_path):
+    return cube_mod.update_cube(data, tmp_path / "fresh", rebuild=True)
+
+
+def test_cube_adds_only_the_appended_lines(tmp_path, monkeypatch):
+    cube = _cube_modules()
+    data = tmp_path / "data"
+    data.mkdir()
+    src = data / "out.jsonl"
+    _write(src, [_row(i) for i in range(6)])
+    cube.update_cube(data, tmp_path / "cube")
+
+    _write(src, [_row(i, "positive") for i in range(6, 10)], mode="a")
+    reads = []
+    read_jsonl_from = cube.read_jsonl_from
+
+    def spy(path, start=0):
+        reads.append(start)
+        return read_jsonl_from(path, start)
+
+    monkeypatch.setattr(cube, "read_jsonl_from", spy)
+    result = cube.update_cube(data, tmp_path / "cube")
+    assert reads and reads[0] > 0
+    assert int(result["n"].sum()) == 10
+    assert _totals(cube, result) == _totals(cube, _rebuilt(cube, data, tmp_path))
+
+
+def test_cube_recomputes_a_file_rewritten_with_the_same_head(tmp_path, monkeypatch):
+    cube = _cube_modules()
+    # Hash only the first line's worth of bytes so the head really is unchanged
+    monkeypatch.setattr(cube, "HEAD_BYTES", 64)
+    data = tmp_path / "data"
+    data.mkdir()
+    src = data / "out.jsonl"
+    rows = [_row(i) for i in range(6)]
+    _write(src, rows)
+    cube.update_cube(data, tmp_path / "cube")
+
+    # Same first lines, last one rewritten with another label plus a new line
+    _write(src, rows[:-1] + [_row(5, "positive"), _row(6, "neutral")])
+    result = cube.update_cube(data, tmp_path / "cube")
+    assert int(result["n"].sum()) == 7
+    assert _totals(cube, result) == _totals(cube, _rebuilt(cube, data, tmp_path))
+
+    labels = cube.rollup(result, ["sentiment_label"]).set_index("sentiment_label")
+    assert int(labels.loc["negative", "n"]) == 5
+
+
+def test_cube_rebuilds_on_a_broken_manifest(tmp_path):
+    cube = _cube_modules()
+    data = tmp_path / "data"
+    data.mkdir()
+    _write(data / "out.jsonl", [_row(i) for i in range(4)])
+    cube.update_cube(data, tmp_path / "cube")
+
+    (tmp_path / "cube" / "manifest.json").write_text("{", encoding="utf-8")
+    result = cube.update_cube(data, tmp_path / "cube")
+    assert int(result["n"].sum()) == 4
@@ -0,0 +1,57 @@
+import pytest
+
+
+def _frame(pd):
+    return pd.DataFrame(
+        {
+            "source": pd.Categorical(["youtube", "gdelt", "youtube"]),
+            "text": ["a", "b", "c"],
+            "sentiment.negative": [0.1, 0.2, 0.3],
+        }
+    )
+
+
+def test_snapshot_round_trip_selects_rows_and_columns(tmp_path):
+    pd = pytest.importorskip("pandas")
+    pytest.importorskip("pyarrow")
+    pytest.importorskip("streamlit")
+    from nps_dashboard.data import read_snapshot, write_snapshot
+
+    write_snapshot(_frame(pd), tmp_path, "data", ["sig"])
+    df = read_snapshot(tmp_path, "data", ["sig"], ("youtube",), ["source", "text"])
+    assert list(df.columns) == ["source", "text"]
+    assert df["text"].tolist() == ["a", "c"]
+    assert read_snapshot(tmp_path, "data", ["other"]) is None
+    assert not list(tmp_path.glob("*.tmp"))
+
+
+def test_broken_snapshot_manifest_is_a_cache_miss(tmp_path):
+    pd = pytest.importorskip("pandas")
+    pytest.importorskip("pyarrow")
+    pytest.importorskip("streamlit")
+    from nps_dashboard.data import read_snapshot, write_snapshot
+
+    write_snapshot(_frame(pd), tmp_path, "data", ["sig"])
+    (tmp_path / "manifest.json").write_text('["half-writ', encoding="utf-8")
+    assert read_snapshot(tmp_path, "data", ["sig"]) is None
+
+
+def test_load_rows_filters_by_date_on_the_snapshot(tmp_path, monkeypatch):
+    pd = pytest.importorskip("pandas")
+    pytest.importorskip("pyarrow")
+    pytest.importorskip("streamlit")
+    from nps_dashboard import data
+
+    df = _frame(pd).assign(
+        date=pd.to_datetime(["2024-01-01", "2024-01-02", None]),
+    )
+    data.write_snapshot(df, tmp_path, "data", ["sig"])
+    monkeypatch.setattr(data, "SNAPSHOT_PATH", str(tmp_path))
+    # Any fallback to the full load would fail here
+    monkeypatch.setattr(data, "load_data", None)
+
+    day = pd.Timestamp("2024-01-02")
+    rows = data.load_rows("data", ("youtube", "gdelt"), (day, day), ["sig"])
+    assert rows["text"].tolist() == ["b"]
+    in_memory = data.filter_rows(df, ("youtube", "gdelt"), (day, day))
+    assert in_memory["text"].tolist() == ["b"]
@@ -1,4 +1,4 @@
-from datetime import datetime, timezone
+from datetime import datetime, timedelta, timezone
 from typing import Any, Protocol
 
 from crawl.core.discovery.gdelt import GdeltDiscoverer, GdeltConfig
@@ -57,3 +57,82 @@ def test_gdelt_seendate_with_time_is_parsed():
     assert cand.timestamp.tzinfo is not None
     assert cand.timestamp.year == 2025
     assert cand.timestamp.hour == 14 and cand.timestamp.minute == 30
+
+
+class CountingSession:
+    def __init__(self, payloads):  # type: ignore[no-untyped-def]
+        self.payloads = list(payloads)
+        self.params: list[dict] = []
+
+    def get(self, url: str, params=None, timeout=None):  # noqa: ARG002
+        self.params.append(dict(params or {}))
+        payload = self.payloads.pop(0) if len(self.payloads) > 1 else self.payloads[0]
+        if payload == 429:
+            resp = DummyResp({})
+            resp.status_code = 429
+            resp.headers = {"Retry-After": "0"}  # type: ignore[attr-defined]
+            return resp
+        return DummyResp(payload)
+
+
+def _gdelt(session, cache, start, end):  # type: ignore[no-untyped-def]
+    return GdeltDiscoverer(
+        session=session,
+        keywords=["pension"],
+        languages=["en"],
+        start_date=start,
+        end_date=end,
+        request_timeout=5,
+        config=GdeltConfig(
+            chunk_days=30, max_attempts=3, max_concurrency=1, pause_between_requests=0
+        ),
+        cache=cache,
+    )
+
+
+def test_gdelt_closed_window_is_served_from_cache(tmp_path):
+    from crawl.core.discovery.gdelt_cache import GdeltWindowCache
+
+    start = datetime(2024, 1, 1, tzinfo=timezone.utc)
+    end = datetime(2024, 1, 31, tzinfo=timezone.utc)
+    payload = {"articles": [{"url": "https://e.com/a", "seendate": "20240105"}]}
+    cache = GdeltWindowCache(tmp_path)
+
+    first = CountingSession([payload])
+    assert len(_gdelt(first, cache, start, end).discover()) == 1
+    second = CountingSession([payload])
+    cands = _gdelt(second, cache, start, end).discover()
+    assert [c.url for c in cands] == ["https://e.com/a"]
+    assert second.params == []
+
+
+def test_gdelt_live_window_requeries_incrementally(tmp_path):
+    from crawl.core.discovery.gdelt_cache import GdeltWindowCache
+
+    now = datetime.now(timezone.utc)
+    start = now - timedelta(days=10)
+    cache = GdeltWindowCache(tmp_path, live_ttl_sec=0, settle_sec=3600)
+    old = {"articles": [{"url": "https://e.com/old"}]}
+    new = {"articles": [{"url": "https://e.com/new"}]}
+
+    _gdelt(CountingSession([old]), cache, start, now).discover()
+    session = CountingSession([new])
+    later = now + timedelta(minutes=5)
+    cands = _gdelt(session, cache, start, later).discover()
+    assert {c.url for c in cands} == {"https://e.com/old", "https://e.com/new"}
+    # Only the span since (last fetch - settle) was asked for
+    since = datetime.strptime(session.params[0]["startdatetime"], "%Y%m%d%H%M%S")
+    assert since.replace(tzinfo=timezone.utc) > start
+
+
+def test_gdelt_429_backs_off_shared_limiter():
+    payload = {"articles": [{"url": "https://e.com/a"}]}
+    session = CountingSession([429, payload])
+    start = datetime(2024, 1, 1, tzinfo=timezone.utc)
+    gd = _gdelt(session, None, start, start + timedelta(days=5))
+    gd.limiter.max_limit = gd.limiter._limit = 4
+    gd.limiter.cooldown = 0.0
+    assert len(gd.discover()) == 1
+    assert gd.limiter.rate_limited == 1
+    assert gd.limiter.limit == 2
+    assert len(session.params) == 2
@@ -0,0 +1,100 @@
+import time
+
+import requests
+
+from crawl.core.extract.sessions import CommentSessionPool
+
+
+def test_pool_reuses_site_session_and_shared_cookies():
+    jar = requests.cookies.RequestsCookieJar()
+    jar.set("ci_c", "token", domain=".dcinside.com")
+    pool = CommentSessionPool(cookies=jar)
+    session = pool.session("dcinside")
+    assert pool.session("dcinside") is session
+    assert session.cookies is jar
+
+    calls: list[str] = []
+    session.get = lambda url, **_kw: calls.append(url)  # type: ignore[method-assign]
+    # The article fetch already left cookies for the host: no priming GET
+    pool.prime("dcinside", "https://gall.dcinside.com/board/view/?id=x&no=1")
+    assert calls == []
+
+    other = pool.session("mlbpark")
+    other.get = lambda url, **_kw: calls.append(url)  # type: ignore[method-assign]
+    pool.prime("mlbpark", "https://mlbpark.donga.com/mp/b.php?b=bullpen&id=1")
+    pool.prime("mlbpark", "https://mlbpark.donga.com/mp/b.php?b=bullpen&id=2")
+    assert calls == ["https://mlbpark.donga.com/mp/b.php?b=bullpen&id=1"]
+
+
+def test_pool_backs_off_failed_logins_and_paces_hosts():
+    pool = CommentSessionPool(per_host_pause_sec={"theqoo.net": 0.05})
+    attempts: list[int] = []
+
+    def failing_login(_session) -> bool:  # type: ignore[no-untyped-def]
+        attempts.append(1)
+        return False
+
+    assert not pool.login("theqoo", failing_login)
+    assert not pool.login("theqoo", failing_login)
+    assert len(attempts) == 1
+
+    t0 = time.monotonic()
+    for _ in range(3):
+        pool.wait_turn("https://theqoo.net/index.php")
+    assert time.monotonic() - t0 >= 0.09
+
+
+def test_pool_worker_kwargs_carry_cookies_and_split_pacing():
+    import pickle
+
+    from crawl.core.config import QualityConfig
+    from crawl.core.extract import pool as extract_pool
+
+    jar = requests.cookies.RequestsCookieJar()
+    jar.set("PHPSESSID", "abc", domain=".theqoo.net")
+    adapter = requests.adapters.HTTPAdapter(pool_maxsize=7)
+    parent = CommentSessionPool(
+        adapter=adapter, cookies=jar, per_host_pause_sec={"theqoo.net": 0.5}
+    )
+    # Spawned workers receive the kwargs pickled
+    kwargs = pickle.loads(pickle.dumps(parent.worker_kwargs(processes=4)))
+    quality = QualityConfig(min_keyword_hits=1)
+    extract_pool.init_extract_worker(
+        ["국민연금"], ["ko"], quality, "run", comment_sessions=kwargs
+    )
+    extractor, _ = extract_pool.worker_extractor()
+    child = extractor.comment_sessions
+    assert child is not parent
+    assert child.cookies.get("PHPSESSID") == "abc"
+    assert child.adapter is not None and child.adapter._pool_maxsize == 7
+    # Four processes at 2.0s each keep the host at one request per 0.5s
+    assert child.per_host_pause_sec == {"theqoo.net": 2.0}
+
+
+def test_login_only_on_auth_failure_and_cooled_down():
+    from types import SimpleNamespace
+
+    from crawl.core.extract.sessions import auth_failed
+
+    def response(status: int, url: str = "https://theqoo.net/index.php", history=()):
+        return SimpleNamespace(status_code=status, url=url, history=list(history))
+
+    assert auth_failed(response(403))
+    assert auth_failed(response(401))
+    redirect = SimpleNamespace(headers={"Location": "/?act=dispMemberLoginForm"})
+    assert auth_failed(response(200, history=[redirect]))
+    # An empty comment list (200, no redirect) or a server error is not auth
+    assert not auth_failed(response(200))
+    assert not auth_failed(response(500))
+
+    pool = CommentSessionPool()
+    attempts: list[int] = []
+
+    def good_login(_session) -> bool:  # type: ignore[no-untyped-def]
+        attempts.append(1)
+        return True
+
+    # Concurrent auth failures reuse the fresh login instead of repeating it
+    assert pool.login("ppomppu", good_login)
+    assert pool.login("ppomppu", good_login)
+    assert len(attempts) == 1
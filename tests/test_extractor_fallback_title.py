@@ -38,3 +38,51 @@ def test_extractor_uses_head_title_when_json_missing():
     doc, quality = extractor.build_document(cand, _build_fetch_result(html), run_id="t")
     assert doc is not None
     assert doc.title == "정상 제목"
+
+
+def test_build_document_parses_page_once(monkeypatch):
+    from crawl.core.extract import parsed
+
+    parses: list[str] = []
+    original = parsed.parse_html
+
+    def counting_parse(html: str, parser: str):  # type: ignore[no-untyped-def]
+        parses.append(parser)
+        return original(html, parser)
+
+    monkeypatch.setattr(parsed, "parse_html", counting_parse)
+    extractor = Extractor(
+        keywords=["국민연금"],
+        allowed_languages=["ko"],
+        quality_config=QualityConfig(min_keyword_hits=0),
+    )
+    # Empty extraction: forum fallback title, comment augmentation, date
+    # inference and the derived title all look at the same page
+    extractor._run_trafilatura = lambda _html, _url: None  # type: ignore[method-assign]
+    cand = Candidate(
+        url="https://gall.dcinside.com/board/view/?id=pension&no=1",
+        source="dcinside",
+        discovered_via={"type": "forum"},
+        title="원제",
+    )
+    html = "<html><head><title>국민연금 제목</title></head><body>본문</body></html>"
+    extractor.build_document(cand, _build_fetch_result(html), run_id="t")
+    assert parses == ["html.parser"]
+
+
+def test_run_trafilatura_falls_back_to_plain_text(monkeypatch):
+    from crawl.core.extract import extractor as extractor_module
+
+    def fake_extract(html, url=None, output_format=None):  # type: ignore[no-untyped-def]
+        # JSON output empty while plain text still finds the body
+        return None if output_format == "json" else " 국민연금 본문 "
+
+    monkeypatch.setattr(extractor_module.trafilatura, "extract", fake_extract)
+    extractor = Extractor(
+        keywords=["국민연금"],
+        allowed_languages=["ko"],
+        quality_config=QualityConfig(min_keyword_hits=0),
+    )
+    result = extractor._run_trafilatura("<html></html>", "https://www.example.com/")
+    assert result is not None
+    assert result.text == "국민연금 본문"
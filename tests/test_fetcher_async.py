@@ -0,0 +1,103 @@
+import time
+from datetime import datetime
+
+import requests
+
+from crawl.core.fetch.async_engine import AsyncFetchEngine, TokenBucket
+from crawl.core.fetch.fetcher import Fetcher, FetcherConfig
+from crawl.core.models import Candidate, FetchResult
+
+
+def _result(url: str) -> FetchResult:
+    return FetchResult(
+        url=url,
+        fetched_from="live",
+        status_code=200,
+        html="<html><body>ok</body></html>",
+        snapshot_url=url,
+        encoding="utf-8",
+        fetched_at=datetime.utcnow(),
+    )
+
+
+def test_token_bucket_delay_uses_interval():
+    now = [0.0]
+    bucket = TokenBucket(2.0, clock=lambda: now[0])
+    assert bucket.delay() == 0.0
+    bucket._tokens -= 1.0  # consume the single token
+    assert abs(bucket.delay() - 2.0) < 1e-9
+    now[0] = 1.5
+    assert abs(bucket.delay() - 0.5) < 1e-9
+
+
+def test_async_engine_paces_slow_host_without_blocking_others(monkeypatch):
+    fetcher = Fetcher(
+        session=requests.Session(),
+        timeout=3,
+        config=FetcherConfig(
+            pause_seconds=0.0, per_host_pause_sec={"slow.example": 0.2}
+        ),
+    )
+    starts: dict[str, float] = {}
+
+    def fake_fetch(cand: Candidate) -> FetchResult:
+        starts[cand.url] = time.monotonic()
+        return _result(cand.url)
+
+    monkeypatch.setattr(fetcher, "fetch_unpaced", fake_fetch)
+
+    slow = [
+        Candidate(
+            url=f"https://www.slow.example/{i}",
+            source="dcinside",
+            discovered_via={"type": "forum"},
+        )
+        for i in range(3)
+    ]
+    fast = [
+        Candidate(
+            url=f"https://fast.example/{i}",
+            source="gdelt",
+            discovered_via={"type": "gdelt"},
+        )
+        for i in range(6)
+    ]
+    engine = AsyncFetchEngine(fetcher, concurrency=2)
+
+    t0 = time.monotonic()
+    done = list(
+        engine.run(slow + fast, lambda cand, res, _elapsed: (cand.url, res is not None))
+    )
+    assert len(done) == 9 and all(ok for _, ok in done)
+
+    slow_starts = sorted(starts[c.url] for c in slow)
+    gaps = [b - a for a, b in zip(slow_starts, slow_starts[1:])]
+    assert all(gap >= 0.19 for gap in gaps)
+    # Unpaced hosts finish while the slow host is still waiting for tokens
+    assert max(starts[c.url] for c in fast) - t0 < 0.2
+
+
+def test_async_engine_reports_candidates_whose_fetch_raised(monkeypatch):
+    fetcher = Fetcher(
+        session=requests.Session(),
+        timeout=3,
+        config=FetcherConfig(pause_seconds=0.0),
+    )
+
+    def broken_fetch(cand: Candidate) -> FetchResult:
+        if cand.url.endswith("/1"):
+            raise ValueError("unexpected")
+        return _result(cand.url)
+
+    monkeypatch.setattr(fetcher, "fetch_unpaced", broken_fetch)
+    cands = [
+        Candidate(url=f"https://a.example/{i}", source="gdelt", discovered_via={})
+        for i in range(3)
+    ]
+    engine = AsyncFetchEngine(fetcher, concurrency=2)
+    done = dict(engine.run(cands, lambda cand, res, _elapsed: (cand.url, res)))
+    # The failure comes back as a body-less result instead of disappearing
+    assert len(done) == 3
+    failed = done["https://a.example/1"]
+    assert failed is not None and failed.html is None and failed.status_code == 0
+    assert engine.active == 0
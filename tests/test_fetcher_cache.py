@@ -0,0 +1,103 @@
+from crawl.core.fetch.cache import ResponseCache
+from crawl.core.fetch.fetcher import Fetcher
+from crawl.core.models import Candidate
+
+
+class _Response:
+    def __init__(self, status_code: int, body: bytes = b"", headers=None) -> None:
+        self.status_code = status_code
+        self.content = body
+        self.headers = headers or {}
+        self.apparent_encoding = "utf-8"
+
+    def raise_for_status(self) -> None:
+        if self.status_code >= 400:
+            raise RuntimeError(self.status_code)
+
+
+class _Session:
+    def __init__(self, responses):  # type: ignore[no-untyped-def]
+        self.responses = list(responses)
+        self.requests: list[dict] = []
+
+    def get(self, url, headers=None, timeout=None):  # type: ignore[no-untyped-def]
+        self.requests.append(dict(headers or {}))
+        return self.responses.pop(0)
+
+
+_HTML = "<html><body>국민연금 본문</body></html>".encode("utf-8")
+_HEADERS = {
+    "ETag": '"v1"',
+    "Last-Modified": "Wed, 01 Jan 2025 00:00:00 GMT",
+    "Content-Type": "text/html; charset=utf-8",
+}
+
+
+def _cand(source: str = "dcinside") -> Candidate:
+    return Candidate(
+        url="https://gall.dcinside.com/board/view/?id=pension&no=1",
+        source=source,
+        discovered_via={"type": "forum"},
+    )
+
+
+def test_cache_revalidates_and_short_circuits_on_304(tmp_path):
+    session = _Session([_Response(200, _HTML, _HEADERS), _Response(304)])
+    cache = ResponseCache(tmp_path)
+    fetcher = Fetcher(session, timeout=3, cache=cache)  # type: ignore[arg-type]
+    fetcher.config.pause_seconds = 0
+
+    first = fetcher.fetch(_cand())
+    assert first is not None and first.fetched_from == "live"
+    assert not first.not_modified
+
+    second = fetcher.fetch(_cand())
+    assert session.requests[1]["If-None-Match"] == '"v1"'
+    assert session.requests[1]["If-Modified-Since"] == _HEADERS["Last-Modified"]
+    assert second is not None and second.not_modified
+    assert second.fetched_from == "cache"
+    assert second.html is not None and "국민연금" in second.html
+
+
+def test_cache_serves_fresh_entries_per_source_ttl(tmp_path):
+    session = _Session([_Response(200, _HTML, _HEADERS), _Response(200, _HTML, {})])
+    cache = ResponseCache(tmp_path, ttl_sec={"gdelt": 3600})
+    fetcher = Fetcher(session, timeout=3, cache=cache)  # type: ignore[arg-type]
+    fetcher.config.pause_seconds = 0
+
+    assert fetcher.fetch(_cand("gdelt")) is not None
+    hit = fetcher.fetch(_cand("gdelt"))
+    assert len(session.requests) == 1
+    assert hit is not None and hit.fetched_from == "cache" and not hit.not_modified
+
+    # Other sources (default TTL 0) always revalidate
+    assert fetcher.fetch(_cand("dcinside")) is not None
+    assert len(session.requests) == 2
+    # Identical bodies are stored once
+    assert len(list((tmp_path / "blobs").rglob("*"))) == 2  # one dir + one blob
+
+
+def test_cache_evicts_expired_then_oldest_entries(tmp_path):
+    cache = ResponseCache(tmp_path)
+    for i in range(4):
+        cache.store(f"https://example.com/{i}", 200, b"x" * 100 + bytes([i]), {})
+    # Two more URLs share the body of /3: the blob must outlive /3's entry
+    cache.store("https://example.com/dup", 200, b"x" * 100 + bytes([3]), {})
+    old = cache.lookup("https://example.com/0")
+    assert old is not None
+    old["stored_at"] -= 3600
+    cache._save_entry("https://example.com/0", old)
+
+    capped = ResponseCache(tmp_path, max_age_sec=60, max_bytes=260)
+    # /0 expired; then /1 goes to get under 80% of the cap (208 bytes)
+    assert capped.evicted == 2
+    assert capped.lookup("https://example.com/0") is None
+    assert capped.lookup("https://example.com/1") is None
+    dup = capped.lookup("https://example.com/dup")
+    assert dup is not None and capped.load_body(dup) is not None
+    assert len(list((tmp_path / "blobs").rglob("*/*"))) == 2
+
+    # Storing past the cap prunes again during the run
+    capped.store("https://example.com/new", 200, b"y" * 101, {})
+    assert capped.lookup("https://example.com/new") is not None
+    assert capped.lookup("https://example.com/2") is None
@@ -252,3 +252,103 @@ def test_pagination_and_limit():
     res = d.discover()["dcinside"]
     # 동일 글이 페이지마다 반복되어도 중복 없이 2건만 수집되어야 함
     assert len(res) == 2
+
+
+class SlowSession:
+    """목록 요청마다 delay초가 걸리는 세션 (URL 그대로 본문에 담아 반환)."""
+
+    def __init__(self, delay: float):
+        import threading
+
+        self.delay = delay
+        self.calls: list[tuple[str, float]] = []
+        self._lock = threading.Lock()
+
+    def get(self, url, timeout=None):  # noqa: ARG002
+        import time
+
+        with self._lock:
+            self.calls.append((url, time.monotonic()))
+        time.sleep(self.delay)
+        return DummyResp(url)
+
+
+def _fake_parser(base_url, html):  # noqa: ARG001
+    # 페이지마다 고유 글 2건 (정규화가 page 파라미터를 지우므로 경로에 담음)
+    thread = html.replace("?", "/view/")
+    return [
+        (f"{thread}/{i}", f"t{i}", {"author": None, "published_at": None})
+        for i in range(2)
+    ]
+
+
+def _slow_discoverer(cfg, delay: float):
+    session = SlowSession(delay)
+    d = ForumsDiscoverer(
+        session=session,
+        request_timeout=5,
+        user_agent="ua",
+        sites_config=cfg,
+        board_cursors={"https://b.example.com/list?id=x": 4},
+    )
+    d.robots.allowed = lambda _url: True  # type: ignore[attr-defined]
+    d._get_parser = lambda _site: _fake_parser  # type: ignore[method-assign]
+    return d, session
+
+
+def test_discover_runs_sites_concurrently_and_keeps_cursors():
+    import time
+
+    cfg = {
+        "dcinside": ForumSiteConfig(
+            enabled=True,
+            boards=["https://a.example.com/list?id=x"],
+            max_pages=2,
+            pause_between_requests=0,
+        ),
+        "ppomppu": ForumSiteConfig(
+            enabled=True,
+            boards=["https://b.example.com/list?id=x"],
+            max_pages=2,
+            pause_between_requests=0,
+        ),
+    }
+    d, session = _slow_discoverer(cfg, delay=0.3)
+    t0 = time.monotonic()
+    res = d.discover()
+    elapsed = time.monotonic() - t0
+    # 순차라면 4 x 0.3초; 사이트(호스트)별로 병렬이면 약 2 x 0.3초
+    assert elapsed < 1.0
+    assert list(res) == ["dcinside", "ppomppu"]
+    assert [c.discovered_via["page"] for c in res["dcinside"]] == [1, 1, 2, 2]
+    assert [c.discovered_via["page"] for c in res["ppomppu"]] == [4, 4, 5, 5]
+    assert d.last_board_pages == {
+        "https://a.example.com/list?id=x": 2,
+        "https://b.example.com/list?id=x": 5,
+    }
+    assert len(session.calls) == 4
+
+
+def test_discover_paces_boards_of_one_host():
+    cfg = {
+        "dcinside": ForumSiteConfig(
+            enabled=True,
+            boards=[
+                "https://a.example.com/list?id=x",
+                "https://a.example.com/list?id=y",
+            ],
+            max_pages=1,
+            per_board_limit=1,
+            pause_between_requests=0.3,
+        ),
+    }
+    d, session = _slow_discoverer(cfg, delay=0.0)
+    res = d.discover()
+    # 게시판별 한도: 게시판마다 1건
+    assert [c.discovered_via["board"] for c in res["dcinside"]] == cfg[
+        "dcinside"
+    ].boards
+    starts = sorted(t for _url, t in session.calls)
+    assert len(starts) == 2
+    # 같은 호스트는 병렬로 돌아도 pause_between_requests 간격 유지
+    assert starts[1] - starts[0] >= 0.29
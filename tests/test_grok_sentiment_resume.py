@@ -0,0 +1,106 @@
+import json
+
+from ml import grok_sentiment_cli as cli
+
+SENTIMENT = {
+    "is_related": True,
+    "negative": 0.7,
+    "neutral": 0.2,
+    "positive": 0.1,
+    "label": "부정",
+    "explanation": "보험료 인상 반대",
+}
+
+
+class FakeClient:
+    """Stands in for GrokClient; texts in `fail` raise like a failed request."""
+
+    model = "fake-model"
+    fail: set = set()
+    calls: list = []
+
+    def analyze_sentiment(self, text, meta):
+        FakeClient.calls.append(meta["id"])
+        if meta["id"] in FakeClient.fail:
+            raise RuntimeError("upstream error")
+        return dict(SENTIMENT)
+
+
+def _write_input(path, n=10):
+    rows = [
+        {"id": f"c{i}", "source": "youtube", "title": f"국민연금 댓글 {i}", "text": "본문"}
+        for i in range(n)
+    ]
+    path.write_text(
+        "".join(json.dumps(r, ensure_ascii=False) + "\n" for r in rows),
+        encoding="utf-8",
+    )
+
+
+def _output(path):
+    return [json.loads(line) for line in path.read_text(encoding="utf-8").splitlines()]
+
+
+def _run(src, out, monkeypatch, *, fail=(), **kwargs):
+    monkeypatch.setattr(cli, "GrokClient", FakeClient)
+    FakeClient.fail = set(fail)
+    FakeClient.calls = []
+    kwargs.setdefault("workers", 1)
+    cli.process_file(src, out, resume=True, checkpoint_every=1, **kwargs)
+    return FakeClient.calls
+
+
+def test_resume_restarts_at_the_first_failed_record(tmp_path, monkeypatch):
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    _write_input(src)
+    _run(src, out, monkeypatch, fail={"c3", "c6"})
+    rows = _output(out)
+    assert [r["id"] for r in rows] == [f"c{i}" for i in range(10)]
+    assert [i for i, r in enumerate(rows) if r.get(cli.ERROR_KEY)] == [3, 6]
+    assert json.loads(cli.progress_path(out).read_text())["done"] == 3
+
+    # Everything from the first failure on is redone; later successes are cached
+    calls = _run(src, out, monkeypatch)
+    assert calls == ["c3", "c6"]
+    rows = _output(out)
+    assert [r["id"] for r in rows] == [f"c{i}" for i in range(10)]
+    assert not any(r.get(cli.ERROR_KEY) for r in rows)
+
+
+def test_resume_after_interrupt_writes_each_record_once(tmp_path, monkeypatch):
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    _write_input(src)
+    _run(src, out, monkeypatch, limit=4, use_cache=False)
+    # A crash mid-write leaves a partial line past the saved progress
+    with out.open("a", encoding="utf-8") as f:
+        f.write('{"id": "c4", "sou')
+
+    calls = _run(src, out, monkeypatch, use_cache=False, workers=3)
+    assert sorted(calls) == [f"c{i}" for i in range(4, 10)]
+    assert [r["id"] for r in _output(out)] == [f"c{i}" for i in range(10)]
+
+
+def test_resume_starts_over_when_the_input_was_rewritten(tmp_path, monkeypatch):
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    _write_input(src)
+    _run(src, out, monkeypatch, limit=5, use_cache=False)
+    _write_input(src, n=3)
+
+    calls = _run(src, out, monkeypatch, use_cache=False)
+    assert calls == ["c0", "c1", "c2"]
+    assert [r["id"] for r in _output(out)] == ["c0", "c1", "c2"]
+
+
+def test_ordered_writer_holds_later_records_until_the_gap_fills(tmp_path):
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    src.write_text("x\n" * 3, encoding="utf-8")
+    writer = cli.OrderedWriter(src, out, cli.Progress(), checkpoint_every=1)
+    writer.put(2, {"n": 2}, 6)
+    writer.put(1, {"n": 1}, 4)
+    assert writer.next_index == 0 and out.read_bytes() == b""
+    writer.put(0, {"n": 0}, 2)
+    writer.close()
+    assert [r["n"] for r in _output(out)] == [0, 1, 2]
+    progress = cli.load_progress(src, out)
+    assert progress.done == 3 and progress.input_offset == 6
+    assert progress.output_bytes == out.stat().st_size
@@ -0,0 +1,75 @@
+import json
+
+from preprocess.preprocess_merge.incremental import Checkpoint, write_dict_lines
+
+
+def _write_lines(path, rows, *, mode="w", partial=None):
+    with path.open(mode, encoding="utf-8") as f:
+        for row in rows:
+            f.write(json.dumps(row) + "\n")
+        if partial is not None:
+            f.write(partial)  # a line the crawler is still writing
+
+
+def _run(in_path, out_path, *, commit=True):
+    ckpt = Checkpoint(out_path, stage="test", inputs=[in_path])
+    with ckpt.open_output() as fw:
+        rows = [json.loads(line) for line in ckpt.iter_lines(in_path)]
+        write_dict_lines(fw, ({"n": row["n"] * 10} for row in rows))
+    if commit:
+        ckpt.commit()
+    return ckpt, [row["n"] for row in rows]
+
+
+def _output(out_path):
+    return [json.loads(line)["n"] for line in out_path.read_text().splitlines()]
+
+
+def test_checkpoint_resumes_from_the_appended_tail(tmp_path):
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    _write_lines(src, [{"n": 1}, {"n": 2}])
+    ckpt, seen = _run(src, out)
+    assert not ckpt.resume and seen == [1, 2]
+
+    _write_lines(src, [{"n": 3}], mode="a", partial='{"n": 4')
+    ckpt, seen = _run(src, out)
+    # Only the new complete line; the half-written one waits for the next run
+    assert ckpt.resume and seen == [3]
+    assert _output(out) == [10, 20, 30]
+
+    with src.open("a", encoding="utf-8") as f:
+        f.write("}\n")
+    _, seen = _run(src, out)
+    assert seen == [4]
+    assert _output(out) == [10, 20, 30, 40]
+
+
+def test_checkpoint_falls_back_to_full_run_when_input_rewritten(tmp_path):
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    _write_lines(src, [{"n": 1}, {"n": 2}])
+    _run(src, out)
+
+    # Rewritten in place: the recorded head/tail fingerprint no longer matches
+    _write_lines(src, [{"n": 7}, {"n": 8}, {"n": 9}])
+    ckpt, seen = _run(src, out)
+    assert not ckpt.resume and seen == [7, 8, 9]
+    assert _output(out) == [70, 80, 90]
+
+
+def test_checkpoint_truncates_output_written_after_the_last_commit(tmp_path):
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    _write_lines(src, [{"n": 1}])
+    _run(src, out)
+
+    # Crash between the output write and commit(): rows 2 and 3 are on disk
+    # but not in the manifest, and the pending state is never promoted
+    _write_lines(src, [{"n": 2}, {"n": 3}], mode="a")
+    ckpt, _ = _run(src, out, commit=False)
+    ckpt.pending_state_path("keys").write_text("new")
+    assert _output(out) == [10, 20, 30]
+
+    ckpt, seen = _run(src, out)
+    assert ckpt.resume and seen == [2, 3]
+    # The uncommitted tail was cut before appending again: no duplicated rows
+    assert _output(out) == [10, 20, 30]
+    assert not ckpt.state_path("keys").exists()
@@ -0,0 +1,28 @@
+from crawl.core.keywords import KeywordMatcher
+
+
+def test_matcher_counts_overlapping_hits_in_one_pass():
+    matcher = KeywordMatcher(["국민연금", "국민연금공단", "연금", "NPS", ""])
+    counts = matcher.counts("국민연금공단 발표: 연금 보험료, nps 기금")
+    assert counts == {"국민연금": 1, "국민연금공단": 1, "연금": 2, "NPS": 1}
+    assert matcher.hits("연금") == ["연금"]
+    assert len(matcher) == 4
+
+
+def test_matcher_folds_spacing_case_and_width():
+    matcher = KeywordMatcher(["국민연금", "국 민 연 금", "NPS Korea"])
+    # Variants of one folded keyword are credited once, to the first configured
+    assert matcher.counts("국 민연금") == {"국민연금": 1}
+    assert matcher.counts("국민연금, 국민 연금") == {"국민연금": 2}
+    assert matcher.hits("ＮＰＳ  korea") == ["NPS Korea"]
+    assert not matcher.matches("연금 이야기")
+    assert not KeywordMatcher([]).matches("국민연금")
+
+
+def test_matcher_does_not_match_across_word_boundaries():
+    matcher = KeywordMatcher(["연금", "NPS"])
+    assert not matcher.matches("공연 금지")
+    assert not matcher.matches("plan pseudo")
+    assert matcher.counts("연 금 개혁, n p s") == {"연금": 1, "NPS": 1}
+    # Unspaced hits inside a word still count (국민연금 contains 연금)
+    assert matcher.counts("국민연금 공연 금지") == {"연금": 1}
@@ -0,0 +1,55 @@
+import json
+
+from preprocess.preprocess_merge.merge_preprocessed_cli import merge_preprocessed
+
+
+def _row(i, *, source="dcinside", text=None, day=None, comment=None):
+    return {
+        "id": f"p{i}",
+        "source": source,
+        "lang": "ko",
+        "title": f"제목 {i}",
+        "text": text if text is not None else f"국민연금 본문 {i}",
+        "published_at": f"2024-01-{day or (i % 28) + 1:02d}T00:00:00Z",
+        "comment_index": None if comment is None else comment,
+        "comment_text": None if comment is None else f"댓글 {i}-{comment}",
+        "comment_publishedAt": None,
+    }
+
+
+def _write(path, rows):
+    path.write_text(
+        "".join(json.dumps(r, ensure_ascii=False) + "\n" for r in rows),
+        encoding="utf-8",
+    )
+
+
+def _inputs(tmp_path):
+    a = [_row(i) for i in range(40)]
+    a += [_row(i, comment=c) for i in range(0, 40, 4) for c in range(2)]
+    # Same key again: longer text wins, rows on the same day keep input order
+    b = [_row(i, text=f"국민연금 본문 {i} (수정본, 더 긴 텍스트)") for i in range(0, 40, 3)]
+    b += [_row(i, day=5) for i in range(40, 60)]
+    b += [_row(i, source="youtube") for i in range(10)]
+    _write(tmp_path / "a.jsonl", a)
+    _write(tmp_path / "b.jsonl", b)
+    return [str(tmp_path / "a.jsonl"), str(tmp_path / "b.jsonl")]
+
+
+def test_spilled_merge_matches_in_memory_merge(tmp_path):
+    inputs = _inputs(tmp_path)
+    in_memory = tmp_path / "in_memory.jsonl"
+    spilled = tmp_path / "spilled.jsonl"
+    # One run per input vs. runs of 3 rows each (many spilled files per input)
+    merge_preprocessed(inputs, in_memory, run_rows=10_000, jobs=1)
+    merge_preprocessed(inputs, spilled, run_rows=3, jobs=2)
+
+    expected = in_memory.read_text(encoding="utf-8")
+    assert spilled.read_text(encoding="utf-8") == expected
+    rows = [json.loads(line) for line in expected.splitlines()]
+    keys = [(r["source"], r["id"], r["comment_index"]) for r in rows]
+    assert len(keys) == len(set(keys)) == 40 + 20 + 20 + 10
+    assert rows == sorted(rows, key=lambda r: r["published_at"])
+    longer = {r["id"]: r["text"] for r in rows if r["source"] == "dcinside"}
+    assert longer["p3"].endswith("(수정본, 더 긴 텍스트)")
+    assert longer["p1"] == "국민연금 본문 1"
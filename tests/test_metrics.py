@@ -0,0 +1,87 @@
+import json
+
+from crawl.core.fetch.fetcher import Fetcher
+from crawl.core.metrics import (
+    OTHER_HOST,
+    Histogram,
+    JsonSnapshotWriter,
+    PipelineMetrics,
+    url_host,
+)
+from crawl.core.models import Candidate
+
+
+class _Response:
+    status_code = 200
+    content = "<html><body>국민연금</body></html>".encode("utf-8")
+    headers = {"Content-Type": "text/html; charset=utf-8"}
+    apparent_encoding = "utf-8"
+
+    def raise_for_status(self) -> None:
+        return None
+
+
+class _Session:
+    def get(self, url, headers=None, timeout=None):  # type: ignore[no-untyped-def]
+        return _Response()
+
+
+def test_histogram_buckets_and_quantiles():
+    hist = Histogram((0.1, 1.0, 10.0))
+    for value in [0.05] * 50 + [0.5] * 49 + [5.0]:
+        hist.observe(value)
+    assert hist.counts == [50, 49, 1, 0]
+    assert hist.count == 100
+    assert hist.quantile(0.5) <= 0.1
+    assert 0.1 < hist.quantile(0.9) <= 1.0
+    assert hist.quantile(1.0) <= hist.max == 5.0
+
+
+def test_hosts_beyond_limit_fold_into_other():
+    metrics = PipelineMetrics(max_hosts=2)
+    for host in ("a.com", "b.com", "c.com", "d.com"):
+        metrics.observe("fetch", 0.2, source="gdelt", host=host)
+    hosts = {row["host"] for row in metrics.snapshot()["histograms"]}
+    assert hosts == {"a.com", "b.com", OTHER_HOST}
+    assert metrics.stage_histogram("fetch", source="gdelt").count == 4
+
+
+def test_prometheus_text_is_cumulative():
+    metrics = PipelineMetrics(buckets=(0.1, 1.0))
+    metrics.observe("store", 0.05, source="dcinside", host="dcinside.com")
+    metrics.observe("store", 0.5, source="dcinside", host="dcinside.com")
+    metrics.inc("pace_sleep_sec", 1.5, source="dcinside", host="dcinside.com")
+    text = metrics.to_prometheus()
+    labels = 'stage="store",source="dcinside",host="dcinside.com"'
+    assert "# TYPE crawler_stage_seconds histogram" in text
+    assert f'crawler_stage_seconds_bucket{{{labels},le="0.1"}} 1' in text
+    assert f'crawler_stage_seconds_bucket{{{labels},le="+Inf"}} 2' in text
+    assert f"crawler_stage_seconds_count{{{labels}}} 2" in text
+    assert 'crawler_pace_sleep_sec_total{source="dcinside"' in text
+
+
+def test_json_snapshot_writer(tmp_path):
+    metrics = PipelineMetrics()
+    metrics.observe("extract", 0.3, source="youtube")
+    path = tmp_path / "metrics.json"
+    JsonSnapshotWriter(metrics, path, interval_sec=60).write()
+    payload = json.loads(path.read_text(encoding="utf-8"))
+    assert payload["histograms"][0]["stage"] == "extract"
+    assert payload["histograms"][0]["count"] == 1
+
+
+def test_fetcher_records_fetch_decode_and_pacing():
+    metrics = PipelineMetrics()
+    fetcher = Fetcher(_Session(), timeout=3, metrics=metrics)  # type: ignore[arg-type]
+    fetcher.config.pause_seconds = 0.01
+    cand = Candidate(
+        url="https://www.ppomppu.co.kr/zboard/view.php?no=1",
+        source="ppomppu",
+        discovered_via={"type": "forum"},
+    )
+    assert fetcher.fetch(cand) is not None
+    assert metrics.stage_histogram("fetch", source="ppomppu").count == 1
+    assert metrics.stage_histogram("decode", source="ppomppu").count == 1
+    assert metrics.counter("pace_sleep_sec") > 0
+    assert url_host(cand.url) == "ppomppu.co.kr"
+    assert metrics.summary()["fetch_p50_sec"] >= 0
@@ -0,0 +1,94 @@
+import io
+import json
+import random
+
+import pytest
+
+
+WORDS = (
+    "국민연금 기금 운용 수익률 보험료 인상 소득대체율 개혁안 국회 정부 청년 세대 "
+    "노후 대비 공단 발표 논의 반대 찬성 여론 조사 고갈 시점 전망 정책 토론 "
+    "납부 기간 연장 수급 연령 상향 재정 계산 위원회 보고서 이사장 투자 해외 주식"
+).split()
+
+
+def _articles():
+    """(text, group) in crawl order: reposts follow both runs' originals."""
+    rng = random.Random(7)
+    base = [" ".join(rng.sample(WORDS, 20)) for _ in range(30)]
+    group = [i % 2 for i in range(30)]
+    # A trailing edit keeps the 5-gram Jaccard above 0.9
+    first = [(base[i], group[i]) for i in range(20)]
+    first += [(base[i] + " (종합)", group[i]) for i in (0, 5)]
+    second = [(base[i], group[i]) for i in range(20, 30)]
+    second += [(base[i] + " (종합)", group[i]) for i in (10, 22, 25)]
+    return first, second
+
+
+def test_minhash_save_load_matches_a_full_run():
+    pytest.importorskip("numpy")
+    from preprocess.preprocess_gdelt.near_dup import MinHashLSH, near_duplicate_flags
+
+    first_run, second_run = _articles()
+    texts = [text for text, _ in first_run + second_run]
+    groups = [group for _, group in first_run + second_run]
+    full = near_duplicate_flags(texts, 0.8, groups=groups)
+    assert sum(full) == 5
+
+    first = MinHashLSH(0.8)
+    for text, group in first_run:
+        first.add(text, group)
+    first_flags = first.duplicates()
+    buf = io.BytesIO()
+    kept = first.save(buf, first_flags)
+    assert kept == first_flags.count(False)
+
+    # Next run: the kept signatures come first, then only the new documents
+    buf.seek(0)
+    second = MinHashLSH(0.8)
+    assert second.load(buf) == kept
+    for text, group in second_run:
+        second.add(text, group)
+    second_flags = second.duplicates()
+    assert not any(second_flags[:kept])
+    assert first_flags + second_flags[kept:] == full
+
+
+def test_minhash_load_rejects_other_parameters():
+    pytest.importorskip("numpy")
+    from preprocess.preprocess_gdelt.near_dup import MinHashLSH
+
+    index = MinHashLSH(0.8)
+    index.add("국민연금 개혁안 발표")
+    buf = io.BytesIO()
+    index.save(buf, index.duplicates())
+    buf.seek(0)
+    with pytest.raises(ValueError):
+        MinHashLSH(0.8, seed=2).load(buf)
+
+
+def test_dedup_passes_stop_at_the_same_line(tmp_path, monkeypatch):
+    pytest.importorskip("numpy")
+    from preprocess.preprocess_gdelt import dedup_gdelt
+
+    first_run, _ = _articles()
+    src, out = tmp_path / "in.jsonl", tmp_path / "out.jsonl"
+    with src.open("w", encoding="utf-8") as f:
+        for i, (text, _) in enumerate(first_run):
+            f.write(json.dumps({"id": i, "title": "", "text": text}) + "\n")
+        f.write('{"id": 99, "text": "쓰는 중')
+
+    duplicates = dedup_gdelt.MinHashLSH.duplicates
+
+    def append_then_flag(self):
+        # The crawler finishes its line and adds more between the two passes
+        with src.open("a", encoding="utf-8") as f:
+            f.write('"}\n' + json.dumps({"id": 100, "text": "새 기사 본문"}) + "\n")
+        return duplicates(self)
+
+    monkeypatch.setattr(dedup_gdelt.MinHashLSH, "duplicates", append_then_flag)
+    stats = dedup_gdelt.dedup_jsonl(src, out)
+    ids = [json.loads(line)["id"] for line in out.read_text().splitlines()]
+    assert stats["total"] == len(first_run)
+    assert len(ids) == stats["kept"] == len(first_run) - 2
+    assert 99 not in ids and 100 not in ids
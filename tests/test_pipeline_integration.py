@@ -1,3 +1,4 @@
+import threading
 from pathlib import Path
 from datetime import datetime
 
@@ -57,3 +58,162 @@ def test_pipeline_runs_with_forum_candidates(tmp_path, monkeypatch):
     bd_file = Path(tmp_path) / "forum_bobaedream.jsonl"
     assert dc_file.exists() and dc_file.stat().st_size > 0
     assert bd_file.exists() and bd_file.stat().st_size > 0
+
+
+def test_pipeline_async_fetch_mode_stores_documents(tmp_path, monkeypatch):
+    config = load_config()
+    config.output = OutputConfig(root=Path(tmp_path))
+    config.quality.min_keyword_hits = 0
+    config.limits.fetch_mode = "async"
+
+    pipeline = UnifiedPipeline(config)
+    cands = [
+        Candidate(
+            url=f"https://example.com/{i}",
+            source="dcinside",
+            discovered_via={"type": "forum", "site": "dcinside"},
+            title="국민연금 관련 글",
+        )
+        for i in range(3)
+    ]
+    monkeypatch.setattr(pipeline, "discover", lambda: {"dcinside": cands})
+
+    def fake_fetch(_candidate: Candidate) -> FetchResult:
+        return FetchResult(
+            url=_candidate.url,
+            fetched_from="live",
+            status_code=200,
+            html="<html><head><title>국민연금</title></head><body>국민연금 본문 내용</body></html>",
+            snapshot_url=_candidate.url,
+            encoding="utf-8",
+            fetched_at=datetime.utcnow(),
+        )
+
+    monkeypatch.setattr(pipeline.fetcher, "fetch_unpaced", fake_fetch)
+
+    stats = pipeline.run()
+    assert stats.fetched == 3
+    assert stats.stored == 3
+    assert (Path(tmp_path) / "forum_dcinside.jsonl").exists()
+
+
+def test_pipeline_streams_candidates_before_discovery_finishes(tmp_path, monkeypatch):
+    config = load_config()
+    config.output = OutputConfig(root=Path(tmp_path))
+    config.quality.min_keyword_hits = 0
+    config.limits.stream_discovery = True
+    config.limits.fetch_concurrency = 1
+
+    pipeline = UnifiedPipeline(config)
+    first_fetch = threading.Event()
+    early = Candidate(
+        url="https://example.com/early",
+        source="dcinside",
+        discovered_via={"type": "forum", "site": "dcinside"},
+    )
+    late = Candidate(
+        url="https://example.com/late",
+        source="gdelt",
+        discovered_via={"type": "gdelt"},
+    )
+
+    def fake_discover():
+        sink = pipeline._discovery_sink
+        assert sink is not None
+        sink([early, early])
+        # Discovery is still running while the first candidate is fetched
+        assert first_fetch.wait(5)
+        return {"dcinside": [early], "gdelt": [late]}
+
+    def fake_fetch(_candidate: Candidate) -> FetchResult:
+        first_fetch.set()
+        return FetchResult(
+            url=_candidate.url,
+            fetched_from="live",
+            status_code=200,
+            html="<html><head><title>국민연금</title></head><body>국민연금 본문</body></html>",
+            snapshot_url=_candidate.url,
+            encoding="utf-8",
+            fetched_at=datetime.utcnow(),
+        )
+
+    monkeypatch.setattr(pipeline, "discover", fake_discover)
+    monkeypatch.setattr(pipeline.fetcher, "fetch", fake_fetch)
+
+    stats = pipeline.run()
+    assert stats.discovered == {"dcinside": 1, "gdelt": 1}
+    assert stats.fetched == 2
+    assert stats.stored == 2
+
+
+def test_pipeline_extracts_in_process_pool(tmp_path, monkeypatch):
+    config = load_config()
+    config.output = OutputConfig(root=Path(tmp_path))
+    config.quality.min_keyword_hits = 0
+    config.limits.stream_discovery = False
+    config.limits.extract_processes = 2
+    config.limits.extract_queue_size = 2
+
+    pipeline = UnifiedPipeline(config)
+    cands = [
+        Candidate(
+            url=f"https://news.example.com/{i}",
+            source="gdelt",
+            discovered_via={"type": "gdelt"},
+            title="국민연금 기사",
+        )
+        for i in range(5)
+    ]
+    monkeypatch.setattr(pipeline, "discover", lambda: {"gdelt": cands})
+
+    def fake_fetch(_candidate: Candidate) -> FetchResult:
+        return FetchResult(
+            url=_candidate.url,
+            fetched_from="live",
+            status_code=200,
+            html="<html><head><title>국민연금</title></head><body>국민연금 본문</body></html>",
+            snapshot_url=_candidate.url,
+            encoding="utf-8",
+            fetched_at=datetime.utcnow(),
+        )
+
+    monkeypatch.setattr(pipeline.fetcher, "fetch", fake_fetch)
+
+    stats = pipeline.run()
+    assert stats.stored == 5
+    assert stats.stage_metrics["extract_submitted"] == 5
+    assert 1 <= stats.stage_metrics["extract_pending_max"] <= 2
+
+
+def test_pipeline_extracts_not_modified_pages(tmp_path, monkeypatch):
+    # 304 재검증 결과도 인덱스에 없는 URL이면 캐시 본문으로 추출해 저장해야 함
+    config = load_config()
+    config.output = OutputConfig(root=Path(tmp_path))
+    config.quality.min_keyword_hits = 0
+
+    pipeline = UnifiedPipeline(config)
+    cand = Candidate(
+        url="https://example.com/304",
+        source="dcinside",
+        discovered_via={"type": "forum", "site": "dcinside"},
+        title="국민연금 관련 글",
+    )
+    monkeypatch.setattr(pipeline, "discover", lambda: {"dcinside": [cand]})
+
+    def fake_fetch(_candidate: Candidate) -> FetchResult:
+        return FetchResult(
+            url=_candidate.url,
+            fetched_from="cache",
+            status_code=200,
+            html="<html><head><title>국민연금</title></head><body>국민연금 본문</body></html>",
+            snapshot_url=_candidate.url,
+            encoding="utf-8",
+            fetched_at=datetime.utcnow(),
+            not_modified=True,
+        )
+
+    monkeypatch.setattr(pipeline.fetcher, "fetch", fake_fetch)
+
+    stats = pipeline.run()
+    assert stats.not_modified == 1
+    assert stats.stored == 1
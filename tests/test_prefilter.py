@@ -0,0 +1,76 @@
+from crawl.core.config import PrefilterConfig
+from crawl.core.models import Candidate
+from crawl.core.prefilter import TitlePrefilter
+from crawl.core.scheduling import CandidateScheduler
+
+
+def _cand(i: int, title: str, board: str = "https://theqoo.net/square") -> Candidate:
+    return Candidate(
+        url=f"https://theqoo.net/square/{i}",
+        source="theqoo",
+        discovered_via={"type": "forum", "site": "theqoo", "board": board},
+        title=title,
+    )
+
+
+def test_prefilter_skips_off_topic_titles_and_reports_quality():
+    config = PrefilterConfig(
+        enabled=True,
+        mode="skip",
+        topical_boards=["gall.dcinside.com/mgallery/board/lists/?id=pension"],
+        audit_rate=0.0,
+    )
+    prefilter = TitlePrefilter(["국민연금", "연금개혁"], config)
+    on_topic = _cand(1, "국민 연금 고갈 언제?")
+    off_topic = _cand(2, "오늘 저녁 메뉴 추천")
+    topical = _cand(
+        3, "질문 있습니다", "https://gall.dcinside.com/mgallery/board/lists/?id=pension"
+    )
+    youtube = Candidate(url="https://youtu.be/x", source="youtube", discovered_via={})
+
+    assert [prefilter.admit(c) for c in (on_topic, off_topic, topical, youtube)] == [
+        True,
+        False,
+        True,
+        True,
+    ]
+    prefilter.observe(on_topic, relevant=True)
+    prefilter.observe(topical, relevant=False)
+    prefilter.observe(youtube, relevant=True)  # not scored, ignored
+    metrics = prefilter.metrics()
+    assert metrics["prefilter_scored"] == 3
+    assert metrics["prefilter_skipped"] == 1
+    assert metrics["prefilter_precision"] == 0.5
+    assert metrics["prefilter_recall"] == 1.0
+
+
+def test_prefilter_deprioritize_measures_recall_and_orders_last():
+    config = PrefilterConfig(enabled=True, mode="deprioritize")
+    prefilter = TitlePrefilter(["국민연금"], config)
+    off_topic = _cand(1, "잡담")
+    on_topic = _cand(2, "국민연금 개혁안")
+    assert prefilter.admit(off_topic) and prefilter.admit(on_topic)
+    prefilter.observe(on_topic, relevant=True)
+    prefilter.observe(off_topic, relevant=True)  # a miss the title check made
+    assert prefilter.metrics()["prefilter_recall"] == 0.5
+
+    scheduler = CandidateScheduler(tier=prefilter.tier)
+    scheduler.push(off_topic)
+    scheduler.push(on_topic)
+    assert [c.url for c in scheduler.drain()] == [on_topic.url, off_topic.url]
+
+
+def test_prefilter_forgets_candidates_without_a_verdict():
+    prefilter = TitlePrefilter(["국민연금"], PrefilterConfig(enabled=True))
+    cands = [_cand(i, "잡담") for i in range(3)]
+    for cand in cands:
+        assert prefilter.admit(cand)
+    # fetch 실패/인덱스 중복 등 품질 판정 없이 끝난 후보는 대기 목록에서 빠져야 함
+    prefilter.forget(cands[0])
+    prefilter.observe(cands[1], relevant=False)
+    prefilter.observe(cands[0], relevant=True)  # 이미 잊힌 후보: 집계하지 않음
+    assert len(prefilter._flagged) == 1
+    assert prefilter.outcomes.flagged_rejected == 1
+    assert prefilter.outcomes.flagged_relevant == 0
+    prefilter.clear_pending()
+    assert not prefilter._flagged
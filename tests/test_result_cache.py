@@ -0,0 +1,44 @@
+from ml.prompts import BATCH_PROMPT_VERSION, PROMPT_VERSION
+from ml.result_cache import SentimentCache
+
+META = {"source": "dcinside", "doc_type": "post", "lang": "ko"}
+RESULT = {"label": "negative", "confidence": 0.9}
+
+
+def test_lookup_finds_results_stored_under_either_prompt_version(tmp_path):
+    path = tmp_path / "cache.sqlite"
+    with SentimentCache(path, model="m", prompt_version=BATCH_PROMPT_VERSION) as c:
+        # A batch item that fell back to the single prompt keeps that version
+        c.put(c.key("보험료 인상 반대", META, PROMPT_VERSION), RESULT, PROMPT_VERSION)
+        c.put(c.key("기금 수익률 좋네", META), RESULT)
+
+    single = SentimentCache(path, model="m", lookup_versions=(PROMPT_VERSION,))
+    assert single.lookup("보험료  인상 반대", META) == RESULT
+    assert single.lookup("기금 수익률 좋네", META) is None
+    single.close()
+
+    batch = SentimentCache(
+        path,
+        model="m",
+        prompt_version=BATCH_PROMPT_VERSION,
+        lookup_versions=(BATCH_PROMPT_VERSION, PROMPT_VERSION),
+    )
+    assert batch.lookup("보험료 인상 반대", META) == RESULT
+    assert batch.lookup("기금 수익률 좋네", META) == RESULT
+    assert batch.stats.lookups == 2 and batch.stats.hits == 2
+    batch.close()
+
+
+def test_invalidate_keeps_both_current_prompt_versions(tmp_path):
+    path = tmp_path / "cache.sqlite"
+    with SentimentCache(path, model="m") as cache:
+        cache.put(cache.key("a", META), RESULT)
+        batch_key = cache.key("b", META, BATCH_PROMPT_VERSION)
+        cache.put(batch_key, RESULT, BATCH_PROMPT_VERSION)
+        cache.put(cache.key("c", META, "old"), RESULT, "old")
+        assert cache.invalidate() == 1
+        assert len(cache) == 2
+
+    with SentimentCache(path, model="other") as cache:
+        assert cache.invalidate() == 2
+        assert len(cache) == 0
@@ -0,0 +1,77 @@
+import threading
+from datetime import datetime, timedelta, timezone
+
+from crawl.core.models import Candidate
+from crawl.core.scheduling import CandidateQueue, CandidateScheduler
+
+
+def _cand(source: str, i: int, timestamp: datetime | None = None) -> Candidate:
+    return Candidate(
+        url=f"https://{source}.example/{i}",
+        source=source,
+        discovered_via={"type": source},
+        timestamp=timestamp,
+    )
+
+
+def test_candidate_queue_orders_by_source_priority():
+    q = CandidateQueue(["dcinside", "gdelt", "youtube"], maxsize=10)
+    q.put(_cand("youtube", 1))
+    q.put(_cand("other", 1))
+    q.put(_cand("gdelt", 1))
+    q.put(_cand("dcinside", 1))
+    q.put(_cand("gdelt", 2))
+    q.close()
+    order = [(c.source, c.url[-1]) for c in q]
+    assert order == [
+        ("dcinside", "1"),
+        ("gdelt", "1"),
+        ("gdelt", "2"),
+        ("youtube", "1"),
+        ("other", "1"),
+    ]
+
+
+def test_candidate_queue_blocks_producer_when_full():
+    q = CandidateQueue(["gdelt"], maxsize=1)
+    q.put(_cand("gdelt", 1))
+    done = threading.Event()
+
+    def _producer():
+        q.put(_cand("gdelt", 2))
+        done.set()
+
+    t = threading.Thread(target=_producer)
+    t.start()
+    assert not done.wait(0.1)
+    assert q.get() is not None
+    assert done.wait(2)
+    q.close()
+    assert q.get() is not None
+    assert q.get() is None
+    t.join()
+
+
+def test_scheduler_serves_newest_first_within_source():
+    base = datetime(2025, 1, 1, tzinfo=timezone.utc)
+    sched = CandidateScheduler(["gdelt"])
+    sched.push(_cand("gdelt", 1, base))
+    sched.push(_cand("gdelt", 2))
+    sched.push(_cand("gdelt", 3, base + timedelta(hours=1)))
+    sched.push(_cand("gdelt", 4))
+    assert [c.url[-1] for c in sched.drain()] == ["3", "1", "2", "4"]
+    assert len(sched) == 0 and sched.pop() is None
+
+
+def test_scheduler_weighted_interleaves_by_share():
+    sched = CandidateScheduler(
+        ["dcinside", "gdelt"], policy="weighted", weights={"gdelt": 2}
+    )
+    for i in range(6):
+        sched.push(_cand("dcinside", i))
+        sched.push(_cand("gdelt", i))
+    picks = [c.source for c in sched.drain()]
+    # gdelt gets two picks per dcinside pick until it runs dry
+    assert picks[:6].count("gdelt") == 4
+    assert picks[:3].count("dcinside") == 1
+    assert picks[-3:] == ["dcinside"] * 3
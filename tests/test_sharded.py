@@ -0,0 +1,60 @@
+import json
+
+from preprocess.preprocess_merge import sharded
+from preprocess.preprocess_youtube.stage3_cli import preprocess_youtube_comments
+
+
+def _video(i):
+    return {
+        "id": f"v{i}",
+        "source": "youtube",
+        "lang": "ko",
+        "title": f"국민연금 영상 {i}",
+        "text": f"설명 {i}",
+        "published_at": f"2024-02-{i % 28 + 1:02d}T00:00:00Z",
+        "extra": {
+            "youtube": {
+                "comments": [
+                    {"text": f"댓글 {i}-{c}", "publishedAt": "2024-02-01T00:00:00Z"}
+                    for c in range(i % 3)
+                ]
+            }
+        },
+    }
+
+
+def _write_input(path):
+    lines = [json.dumps(_video(i), ensure_ascii=False) for i in range(60)]
+    lines.insert(7, "{broken json")  # skipped by the loader either way
+    path.write_text("\n".join(lines) + "\n", encoding="utf-8")
+
+
+def test_sharded_youtube_stage_matches_single_process(tmp_path, monkeypatch):
+    src = tmp_path / "youtube.jsonl"
+    _write_input(src)
+    single = tmp_path / "single.jsonl"
+    preprocess_youtube_comments(src, single, jobs=1)
+
+    # Shrink the minimum shard size so the small input splits into many shards
+    monkeypatch.setattr(sharded, "MIN_SHARD_BYTES", 256)
+    assert len(sharded.plan_shards(src, jobs=4)) > 4
+    multi = tmp_path / "multi.jsonl"
+    preprocess_youtube_comments(src, multi, jobs=4)
+    assert multi.read_text(encoding="utf-8") == single.read_text(encoding="utf-8")
+
+    unordered = tmp_path / "unordered.jsonl"
+    preprocess_youtube_comments(src, unordered, jobs=4, ordered=False)
+    assert sorted(unordered.read_text(encoding="utf-8").splitlines()) == sorted(
+        single.read_text(encoding="utf-8").splitlines()
+    )
+
+
+def test_split_ranges_cut_on_line_boundaries(tmp_path):
+    src = tmp_path / "in.jsonl"
+    src.write_bytes(b"".join(b'{"n": %d}\n' % i for i in range(100)))
+    ranges = sharded.split_ranges(src, 7)
+    assert ranges[0][0] == 0 and ranges[-1][1] == src.stat().st_size
+    assert all(a[1] == b[0] for a, b in zip(ranges, ranges[1:]))
+    data = src.read_bytes()
+    for start, _ in ranges:
+        assert start == 0 or data[start - 1 : start] == b"\n"
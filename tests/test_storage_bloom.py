@@ -0,0 +1,55 @@
+import hashlib
+
+from crawl.core.storage.bloom import BloomFilter
+from crawl.core.storage.index import DocumentIndex
+
+
+def _key(i: int) -> bytes:
+    return b"U" + hashlib.sha1(f"https://example.com/{i}".encode()).digest()
+
+
+def test_bloom_has_no_false_negatives_and_low_fp_rate(tmp_path):
+    bloom = BloomFilter(5000, error_rate=0.01)
+    for i in range(5000):
+        bloom.add(_key(i))
+    assert all(_key(i) in bloom for i in range(5000))
+    false_pos = sum(1 for i in range(5000, 15000) if _key(i) in bloom)
+    assert false_pos / 10000 < 0.03
+
+    path = tmp_path / "f.bloom"
+    bloom.save(path)
+    loaded = BloomFilter.load(path)
+    assert loaded is not None and loaded.count == 5000
+    assert all(_key(i) in loaded for i in range(0, 5000, 97))
+
+
+def test_index_bloom_skips_exact_store_for_unseen_urls(tmp_path, monkeypatch):
+    idx = DocumentIndex(tmp_path, bloom_capacity=1000)
+    idx.add_url("https://example.com/seen")
+    idx.compact()
+    idx.flush()
+    assert (tmp_path / "_index.bloom").exists()
+
+    reopened = DocumentIndex(tmp_path, bloom_capacity=1000)
+    probes: list[bytes] = []
+    original = DocumentIndex._in_segment
+
+    def _spy(self, record):  # type: ignore[no-untyped-def]
+        probes.append(record)
+        return original(self, record)
+
+    monkeypatch.setattr(DocumentIndex, "_in_segment", _spy)
+    assert reopened.contains_url("https://example.com/seen")
+    misses = [reopened.contains_url(f"https://example.com/new/{i}") for i in range(200)]
+    assert not any(misses)
+    # Only the hit (and rare false positives) reach the memory-mapped segment
+    assert len(probes) < 10
+
+
+def test_index_rebuilds_stale_bloom(tmp_path):
+    idx = DocumentIndex(tmp_path)
+    idx.add("doc-1")
+    idx.flush()
+    # Bloom enabled later: built from the existing segment/log
+    reopened = DocumentIndex(tmp_path, bloom_capacity=100)
+    assert reopened.contains("doc-1")
@@ -0,0 +1,66 @@
+import json
+from pathlib import Path
+
+from crawl.core.storage.index import DocumentIndex
+
+
+def _write_jsonl(path: Path, records: list[dict], mode: str = "w") -> None:
+    with path.open(mode, encoding="utf-8") as fh:
+        for rec in records:
+            fh.write(json.dumps(rec, ensure_ascii=False) + "\n")
+
+
+def test_index_persists_across_reopen(tmp_path):
+    idx = DocumentIndex(tmp_path)
+    idx.add("doc-1")
+    idx.add_url("https://example.com/a?utm_source=x")
+    idx.flush()
+
+    reopened = DocumentIndex(tmp_path)
+    assert reopened.contains("doc-1")
+    assert reopened.contains_url("https://example.com/a")
+    assert not reopened.contains("doc-2")
+    assert (tmp_path / "_index.log").stat().st_size == 2 * 21
+
+
+def test_index_rescans_only_new_jsonl_tail(tmp_path, monkeypatch):
+    data = tmp_path / "gdelt.jsonl"
+    _write_jsonl(data, [{"id": "a", "url": "https://news.example/1"}])
+    DocumentIndex(tmp_path)
+    offsets = json.loads((tmp_path / "_index.offsets.json").read_text())
+    assert offsets["files"]["gdelt.jsonl"]["offset"] == data.stat().st_size
+
+    _write_jsonl(data, [{"id": "b", "url": "https://news.example/2"}], mode="a")
+    seen: list[bytes] = []
+    original = DocumentIndex._index_line
+
+    def _spy(self, raw):  # type: ignore[no-untyped-def]
+        seen.append(raw)
+        return original(self, raw)
+
+    monkeypatch.setattr(DocumentIndex, "_index_line", _spy)
+    idx = DocumentIndex(tmp_path)
+    assert len(seen) == 1
+    assert idx.contains("a") and idx.contains("b")
+    assert idx.contains_url("https://news.example/2")
+
+
+def test_index_imports_legacy_json_and_compacts(tmp_path):
+    (tmp_path / "_index.json").write_text(
+        json.dumps({"ids": ["old-1"], "urls": ["https://example.com/old"]}),
+        encoding="utf-8",
+    )
+    idx = DocumentIndex(tmp_path)
+    assert idx.contains("old-1")
+    assert idx.contains_url("https://example.com/old")
+
+    for i in range(10):
+        idx.add(f"new-{i}")
+    idx.compact()
+    assert (tmp_path / "_index.log").stat().st_size == 0
+    assert (tmp_path / "_index.seg").stat().st_size == 12 * 21
+
+    reopened = DocumentIndex(tmp_path)
+    assert reopened.contains("old-1")
+    assert all(reopened.contains(f"new-{i}") for i in range(10))
+    assert not reopened.contains("missing")
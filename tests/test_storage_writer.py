@@ -0,0 +1,100 @@
+import json
+from pathlib import Path
+
+from crawl.core.models import Document
+from crawl.core.storage.writer import BufferedJsonlWriter, MultiSourceJsonlWriter
+
+
+def _doc(i: int, source: str = "dcinside", kind: str = "forum") -> Document:
+    return Document(
+        id=f"doc-{i}",
+        source=source,
+        url=f"https://example.com/{i}",
+        snapshot_url=None,
+        title=f"title {i}",
+        text="국민연금 본문",
+        lang="ko",
+        published_at=None,
+        authors=[],
+        discovered_via={"type": kind},
+        quality={},
+        dup={},
+        crawl={},
+        extra={},
+    )
+
+
+def _read_lines(path: Path) -> list[dict]:
+    return [json.loads(line) for line in path.read_text(encoding="utf-8").splitlines()]
+
+
+def test_buffered_writer_matches_sync_output(tmp_path):
+    sync_dir = tmp_path / "sync"
+    buf_dir = tmp_path / "buffered"
+    sync = MultiSourceJsonlWriter(sync_dir)
+    buffered = BufferedJsonlWriter(buf_dir, batch_size=3, flush_interval_sec=60)
+    docs = [_doc(i) for i in range(5)] + [_doc(9, source="gdelt", kind="gdelt")]
+    for doc in docs:
+        sync.append(doc)
+        buffered.append(doc)
+    buffered.close()
+
+    for name in ("forum_dcinside.jsonl", "gdelt.jsonl"):
+        assert _read_lines(buf_dir / name) == _read_lines(sync_dir / name)
+
+
+def test_buffered_writer_flush_and_restart_after_close(tmp_path):
+    writer = BufferedJsonlWriter(tmp_path, batch_size=100, flush_interval_sec=60)
+    writer.append(_doc(1))
+    writer.flush()
+    assert len(_read_lines(tmp_path / "forum_dcinside.jsonl")) == 1
+
+    writer.close()
+    writer.append(_doc(2))  # thread restarts lazily
+    writer.close()
+    ids = [rec["id"] for rec in _read_lines(tmp_path / "forum_dcinside.jsonl")]
+    assert ids == ["doc-1", "doc-2"]
+
+
+def test_buffered_writer_zstd_or_plain_fallback(tmp_path):
+    writer = BufferedJsonlWriter(tmp_path, compression="zstd")
+    writer.append(_doc(1))
+    writer.close()
+    try:
+        import zstandard  # type: ignore[import-not-found]
+    except ImportError:
+        assert (tmp_path / "forum_dcinside.jsonl").exists()
+        return
+    raw = (tmp_path / "forum_dcinside.jsonl.zst").read_bytes()
+    reader = zstandard.ZstdDecompressor().stream_reader(raw, read_across_frames=True)
+    lines = reader.read().decode("utf-8").splitlines()
+    assert json.loads(lines[0])["id"] == "doc-1"
+
+
+def test_buffered_writer_reports_written_batches_and_keeps_failing(tmp_path):
+    written: list[str] = []
+    writer = BufferedJsonlWriter(
+        tmp_path,
+        batch_size=100,
+        flush_interval_sec=60,
+        on_written=lambda docs: written.extend(d.id for d in docs),
+    )
+    writer.append(_doc(1))
+    assert written == []  # still buffered
+    writer.flush()
+    assert written == ["doc-1"]
+
+    def _broken(path):  # type: ignore[no-untyped-def]
+        raise OSError("disk full")
+
+    writer._handle_for = _broken  # type: ignore[method-assign]
+    writer.append(_doc(2))
+    for call in (writer.flush, lambda: writer.append(_doc(3)), writer.close):
+        try:
+            call()
+        except RuntimeError:
+            pass
+        else:
+            raise AssertionError("writer error was not raised again")
+    # The failed batch was never reported, so it is not indexed as stored
+    assert written == ["doc-1"]
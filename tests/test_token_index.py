@@ -0,0 +1,50 @@
+import os
+
+import pytest
+
+
+def _token_index():
+    pytest.importorskip("pandas")
+    pytest.importorskip("wordcloud")
+    from nps_dashboard import token_index
+
+    return token_index
+
+
+TEXTS = ["pension reform debate continues", "pension fund returns improved"]
+
+
+def test_token_index_reuses_saved_rows(tmp_path, monkeypatch):
+    ti = _token_index()
+    index = ti.TokenIndex("en")
+    assert index.update(TEXTS) == 2
+    index.save(tmp_path)
+
+    loaded = ti.get_token_index("en", tmp_path)
+    assert len(loaded) == 2 and ti.text_key(TEXTS[0]) in loaded
+    assert ti.get_token_index("en", tmp_path) is loaded
+
+    calls = []
+    monkeypatch.setattr(ti, "tokenize", lambda *a: calls.append(a) or [])
+    assert loaded.update(TEXTS + ["new pension article"]) == 1
+    assert len(calls) == 1
+
+
+def test_token_index_reloads_a_changed_file_and_drops_old_versions(
+    tmp_path, monkeypatch
+):
+    ti = _token_index()
+    index = ti.TokenIndex("en")
+    index.update(TEXTS[:1])
+    fp = index.save(tmp_path)
+    first = ti.get_token_index("en", tmp_path)
+
+    index.update(TEXTS)
+    index.save(tmp_path)
+    stat = fp.stat()
+    os.utime(fp, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1_000_000))
+    second = ti.get_token_index("en", tmp_path)
+    assert second is not first and len(second) == 2
+
+    monkeypatch.setattr(ti, "TOKENIZER_VERSION", ti.TOKENIZER_VERSION + 1)
+    assert len(ti.TokenIndex.load("en", tmp_path)) == 0
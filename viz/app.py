@@ -5,8 +5,14 @@ import numpy as np
 import streamlit as st
 import altair as alt
 
-from nps_dashboard.config import DATA_PATH, ARTICLE_SOURCES, SENTIMENT_OPTIONS
-from nps_dashboard.data import load_data
+from nps_dashboard.config import (
+    DATA_PATH,
+    CUBE_PATH,
+    ARTICLE_SOURCES,
+    SENTIMENT_OPTIONS,
+)
+from nps_dashboard.cube import data_signature, filter_cube, load_cube, rollup
+from nps_dashboard.data import load_rows
 from nps_dashboard.wordcloud_tools import generate_wordcloud_image
 from nps_dashboard.chart_helpers import (
     render_chart_with_selection,
@@ -38,6 +44,20 @@ def get_wordcloud_image(
     )
 
 
+@st.cache_data(show_spinner=False)
+def load_filtered_rows(
+    sources: tuple[str, ...],
+    date_range: tuple[pd.Timestamp, pd.Timestamp] | None,
+    signature: tuple,
+) -> pd.DataFrame:
+    """
+    드릴다운 표본/워드클라우드/정책 분석용 원본 행 (필터 적용).
+    차트는 집계 큐브로 그리므로 원본 행은 필터가 바뀔 때만 스냅샷에서 다시
+    읽는다 (전체 행을 메모리에 올리지 않는다, nps_dashboard/data.py load_rows).
+    """
+    return load_rows(DATA_PATH, sources, date_range, signature)
+
+
 def _build_article_sample_rows(day_articles: pd.DataFrame) -> list[dict[str, str]]:
     samples: list[dict[str, str]] = []
     if day_articles.empty:
@@ -110,14 +130,20 @@ st.subheader("by. FullRunAI Team")
 # ----------------------
 # 1. 데이터 로딩
 # ----------------------
-df_raw = load_data(DATA_PATH)
+# 차트는 (날짜, 시간, 사이트, 언어, 감성) 집계 큐브(nps_dashboard/cube.py)로 그린다.
+# 입력 파일이 바뀌면(signature) 바뀐 파일 몫만 다시 집계한다.
+data_sig = data_signature(DATA_PATH)
+cube_all = load_cube(DATA_PATH, CUBE_PATH, data_sig)
+if cube_all.empty:
+    st.warning("감성분석 결과 데이터가 없습니다.")
+    st.stop()
 
 # ------------------------------------------------------------
 # 글로벌 필터: 소스 + 기간
 # ------------------------------------------------------------
 st.markdown("### ⚙️ 필터 (전체 적용)")
 
-available_sources_all = sorted(df_raw["source"].dropna().unique().tolist())
+available_sources_all = sorted(cube_all["source"].dropna().unique().tolist())
 filter_left, filter_right, filter_meta = st.columns([1.6, 1.6, 1.8])
 
 with filter_left:
@@ -129,8 +155,8 @@ with filter_left:
 
 with filter_right:
     picked_range = None
-    if "date" in df_raw.columns and df_raw["date"].notna().any():
-        valid_dates = df_raw["date"].dropna()
+    if cube_all["date"].notna().any():
+        valid_dates = cube_all["date"].dropna()
         min_date = valid_dates.min().date()
         max_date = valid_dates.max().date()
         default_start = max_date - pd.Timedelta(days=90)
@@ -151,56 +177,61 @@ if not selected_sources_global:
     st.stop()
 
 # 필터 적용 (전체)
-df_filtered = df_raw.copy()
-
-if selected_sources_global:
-    df_filtered = df_filtered[
-        df_filtered["source"].isin(selected_sources_global)
-    ].copy()
-
+date_range = None
 if picked_range and isinstance(picked_range, (list, tuple)) and len(picked_range) == 2:
     start_date, end_date = picked_range
     start_ts = pd.Timestamp(start_date)
     end_ts = (
         pd.Timestamp(end_date) + pd.Timedelta(days=1) - pd.Timedelta(microseconds=1)
     )
-    df_filtered = df_filtered[
-        (df_filtered["date"].notna())
-        & (df_filtered["date"].between(start_ts, end_ts, inclusive="both"))
-    ].copy()
+    date_range = (start_ts, end_ts)
 
-if df_filtered.empty:
+cube_filtered = filter_cube(
+    cube_all, selected_sources_global, *(date_range or (None, None))
+)
+
+if cube_filtered.empty:
     st.warning("선택한 조건에 해당하는 데이터가 없습니다. 필터를 조정해주세요.")
     st.stop()
 
-# 댓글/기사 데이터 분리
-df_comments = df_filtered[~df_filtered["source"].isin(ARTICLE_SOURCES)].copy()
-df_articles = df_filtered[df_filtered["source"].isin(ARTICLE_SOURCES)].copy()
+# 댓글/기사 데이터 분리 (큐브)
+cube_comments = cube_filtered[~cube_filtered["source"].isin(ARTICLE_SOURCES)]
+cube_articles = cube_filtered[cube_filtered["source"].isin(ARTICLE_SOURCES)]
+
+# 원본 행: 워드클라우드 / 드릴다운 표본 / 정책 분석에만 사용
+df_filtered = load_filtered_rows(
+    tuple(sorted(selected_sources_global)), date_range, data_sig
+)
+df_comments = df_filtered[~df_filtered["source"].isin(ARTICLE_SOURCES)]
+df_articles = df_filtered[df_filtered["source"].isin(ARTICLE_SOURCES)]
 
 # 기존 코드 호환용: df는 댓글 데이터
 df = df_comments
 
-if "date" in df_articles:
-    df_articles["date_only"] = df_articles["date"].dt.date  # type: ignore
+total_comments = int(cube_comments["n"].sum())
+article_count = int(cube_articles["n"].sum())
 
 with filter_meta:
-    st.metric("필터 적용 댓글 수", f"{len(df_comments):,}")
-    st.caption(f"기사(gdelt) {len(df_articles):,}건은 별도 섹션에서 요약")
+    st.metric("필터 적용 댓글 수", f"{total_comments:,}")
+    st.caption(f"기사(gdelt) {article_count:,}건은 별도 섹션에서 요약")
 
 # ============================================================
 # 2. 종합 분석 (단독)
 # ============================================================
 st.markdown("## 1️⃣ 종합 분석 - 전체")
 
-total_comments = len(df)
+label_counts = (
+    rollup(cube_comments, ["sentiment_label"]).set_index("sentiment_label")["n"]
+    if total_comments > 0
+    else pd.Series(dtype="int64")
+)
 if total_comments > 0:
-    neg_ratio = (df["sentiment_label"] == "negative").mean()
-    pos_ratio = (df["sentiment_label"] == "positive").mean()
+    neg_ratio = label_counts.get("negative", 0) / total_comments
+    pos_ratio = label_counts.get("positive", 0) / total_comments
 else:
     neg_ratio = pos_ratio = 0.0
 
 comment_data_available = total_comments > 0
-article_count = len(df_articles)
 
 col1, col2, col3, col4 = st.columns(4)
 with col1:
@@ -225,11 +256,9 @@ if comment_data_available:
     # (1) 전체 긍/중립/부정 비율 파이차트
     with pie_col1:
         sent_pie = (
-            df[df["sentiment_label"].isin(SENTIMENT_OPTIONS)]
-            .groupby("sentiment_label")
-            .size()
-            .reindex(SENTIMENT_OPTIONS, fill_value=0)
+            label_counts.reindex(SENTIMENT_OPTIONS, fill_value=0)
             .rename("count")
+            .rename_axis("sentiment_label")
             .reset_index()
         )
 
@@ -255,10 +284,9 @@ if comment_data_available:
     # (2) 사이트별 댓글 비율 파이차트
     with pie_col2:
         site_counts = (
-            df[df["source"] != "gdelt"]["source"]
-            .value_counts()
-            .rename_axis("source")
-            .reset_index(name="count")
+            rollup(cube_comments[cube_comments["source"] != "gdelt"], ["source"])
+            .rename(columns={"n": "count"})[["source", "count"]]
+            .sort_values("count", ascending=False, kind="stable")
         )
         site_order = [
             s for s in site_counts["source"].unique().tolist() if s != "gdelt"
@@ -327,20 +355,17 @@ if comment_data_available:
         "forums": ["bobaedream", "dcinside", "mlbpark", "theqoo"],
     }
 
-    available_sources = sorted(df["source"].dropna().unique().tolist())
+    available_sources = sorted(cube_comments["source"].dropna().unique().tolist())
     GROUPS["forums"] = sorted(
         [s for s in available_sources if s not in set(GROUPS["videos"])]
     )
-    df_sites = df.copy()
+    source_sent = rollup(cube_comments, ["source", "sentiment_label"]).rename(
+        columns={"n": "count"}
+    )[["source", "sentiment_label", "count"]]
 
-    if df_sites.empty:
+    if source_sent.empty:
         st.warning("댓글 데이터가 없습니다.")
     else:
-        source_sent = (
-            df_sites.groupby(["source", "sentiment_label"], observed=True)
-            .size()
-            .reset_index(name="count")
-        )
 
         source_order = [
             s
@@ -395,12 +420,16 @@ if comment_data_available:
 
     st.markdown("### 리커트 차트 (사이트별 부정/중립/긍정 균형)")
 
-    if not df_sites.empty:
+    if not source_sent.empty:
         df_likert = (
-            df_sites[df_sites["sentiment_label"].isin(SENTIMENT_OPTIONS)]
-            .groupby(["source", "sentiment_label"])
-            .size()
-            .unstack(fill_value=0)
+            source_sent[source_sent["sentiment_label"].isin(SENTIMENT_OPTIONS)]
+            .pivot_table(
+                index="source",
+                columns="sentiment_label",
+                values="count",
+                aggfunc="sum",
+                fill_value=0,
+            )
             .reindex(columns=SENTIMENT_OPTIONS, fill_value=0)
         )
 
@@ -495,66 +524,23 @@ st.divider()
 if comment_data_available:
     st.markdown("## 3️⃣ 기간별 분석")
 
-    if "date" in df.columns and df["date"].notna().any():
-        df_time = df[df["date"].notna()].copy()
+    cube_time = cube_comments[cube_comments["date"].notna()]
+    if not cube_time.empty:
+        # 드릴다운 표본용 원본 행 (sentiment_score / date_only / hour_int 는
+        # load_data 에서 미리 계산됨)
+        df_sc = df[df["date"].notna()]
 
-        if df_time.empty:
+        if cube_time["n"].sum() == 0:
             st.warning("해당 기간의 댓글 데이터가 없습니다.")
         else:
-            df_sc = df_time.copy()
-
-            prob_cols = [
-                "sentiment.negative",
-                "sentiment.neutral",
-                "sentiment.positive",
-            ]
-            if all(c in df_sc.columns for c in prob_cols):
-                for c in prob_cols:
-                    df_sc[c] = pd.to_numeric(df_sc[c], errors="coerce").fillna(0.0)
-
-                s = (
-                    df_sc["sentiment.negative"]
-                    + df_sc["sentiment.neutral"]
-                    + df_sc["sentiment.positive"]
-                )
-                s = s.replace(0, np.nan)
-                df_sc["sentiment.negative"] = (df_sc["sentiment.negative"] / s).fillna(
-                    0.0
-                )
-                df_sc["sentiment.neutral"] = (df_sc["sentiment.neutral"] / s).fillna(
-                    0.0
-                )
-                df_sc["sentiment.positive"] = (df_sc["sentiment.positive"] / s).fillna(
-                    0.0
-                )
-
-                df_sc["sentiment_score"] = (
-                    df_sc["sentiment.positive"] - df_sc["sentiment.negative"]
-                ).astype("float32")
-                df_sc["sentiment_score"] = df_sc["sentiment_score"].clip(-1.0, 1.0)
-            else:
-                SENTIMENT_TO_SCORE = {"negative": -1.0, "neutral": 0.0, "positive": 1.0}
-                df_sc = df_sc[df_sc["sentiment_label"].isin(SENTIMENT_OPTIONS)].copy()
-                df_sc["sentiment_score"] = (
-                    df_sc["sentiment_label"].map(SENTIMENT_TO_SCORE).astype("float32")
-                )
-
-            df_sc["date_only"] = df_sc["date"].dt.date  # type: ignore
-            if "hour" in df_sc.columns:
-                df_sc["hour_int"] = (
-                    pd.to_numeric(df_sc["hour"], errors="coerce")
-                    .round()
-                    .astype("Int64")
-                )
-
             st.markdown("### 날짜별 감성 스코어 (-1 ~ +1)")
 
             MA_DAYS = 7
             daily_score = (
-                df_sc.dropna(subset=["date", "sentiment_score"])
-                .groupby("date")["sentiment_score"]
-                .agg(score="mean", n="size")
-                .reset_index()
+                rollup(cube_time[cube_time["n_score"] > 0], ["date"])
+                .rename(columns={"mean_score": "score", "n_score": "n"})[
+                    ["date", "score", "n"]
+                ]
                 .sort_values("date")
             )
             daily_score["ma"] = (
@@ -624,13 +610,12 @@ if comment_data_available:
             st.markdown("### 시간대별 감성 스코어 (-1 ~ +1)")
 
             MA_HOURS = 3
-            hour_score = (
-                df_sc.dropna(subset=["hour_int", "sentiment_score"])
-                .groupby("hour_int")["sentiment_score"]
-                .agg(score="mean", n="size")
-                .reset_index()
-                .rename(columns={"hour_int": "hour"})
-            )
+            hour_score = rollup(
+                cube_time[(cube_time["hour"] >= 0) & (cube_time["n_score"] > 0)],
+                ["hour"],
+            ).rename(columns={"mean_score": "score", "n_score": "n"})[
+                ["hour", "score", "n"]
+            ]
             hour_score["hour"] = hour_score["hour"].astype(int)
             hour_score = hour_score.sort_values("hour")
             hour_score["ma"] = (
@@ -704,7 +689,9 @@ if comment_data_available:
             bar_col1, bar_col2 = st.columns(2)
 
             with bar_col1:
-                daily_counts = df_time.groupby("date").size().reset_index(name="count")
+                daily_counts = rollup(cube_time, ["date"]).rename(
+                    columns={"n": "count"}
+                )[["date", "count"]]
 
                 date_sel_volume = alt.selection_point(
                     name="date_volume_select",
@@ -745,10 +732,10 @@ if comment_data_available:
 
             # ---- 시간대별 댓글 수 ----
             with bar_col2:
-                if "hour" in df_time.columns:
-                    hour_counts = (
-                        df_time.groupby("hour").size().reset_index(name="count")
-                    )
+                if (cube_time["hour"] >= 0).any():
+                    hour_counts = rollup(
+                        cube_time[cube_time["hour"] >= 0], ["hour"]
+                    ).rename(columns={"n": "count"})[["hour", "count"]]
 
                     hour_sel_volume = alt.selection_point(
                         name="hour_volume_select",
@@ -802,12 +789,11 @@ else:
 st.divider()
 st.markdown("## 📰 기사 인사이트 (gdelt)")
 
-if df_articles.empty:
+if cube_articles.empty:
     st.info("선택한 조건에 해당하는 기사(gdelt) 데이터가 없습니다.")
 else:
-    article_count = len(df_articles)
-    date_min = df_articles["date"].min() if "date" in df_articles else None
-    date_max = df_articles["date"].max() if "date" in df_articles else None
+    date_min = cube_articles["date"].min()
+    date_max = cube_articles["date"].max()
 
     col_a1, col_a2 = st.columns(2)
     with col_a1:
@@ -819,11 +805,10 @@ else:
             st.metric("기간", "날짜 정보 없음")
 
     st.markdown("### 기사 발행량 추이")
-    if "date" in df_articles and df_articles["date"].notna().any():
+    if cube_articles["date"].notna().any():
         daily_articles = (
-            df_articles.groupby("date")
-            .size()
-            .reset_index(name="count")
+            rollup(cube_articles[cube_articles["date"].notna()], ["date"])
+            .rename(columns={"n": "count"})[["date", "count"]]
             .sort_values("date")
         )
 
@@ -864,7 +849,7 @@ else:
                 )
             else:
                 day_articles = df_articles[
-                    df_articles["date"].dt.date == selected_article_date  # type: ignore
+                    df_articles["date_only"] == selected_article_date
                 ].copy()
                 if day_articles.empty:
                     st.info("선택한 날짜의 기사 데이터를 찾지 못했습니다.")
@@ -900,14 +885,15 @@ else:
     else:
         st.info("기사 날짜 정보가 없어 추이를 표시할 수 없습니다.")
 
-    if "sentiment_label" in df_articles:
+    if cube_articles["sentiment_label"].isin(SENTIMENT_OPTIONS).any():
         st.markdown("### 기사 감성 분포")
         art_sent = (
-            df_articles[df_articles["sentiment_label"].isin(SENTIMENT_OPTIONS)]
-            .groupby("sentiment_label")
-            .size()
+            rollup(cube_articles, ["sentiment_label"])
+            .set_index("sentiment_label")["n"]
             .reindex(SENTIMENT_OPTIONS, fill_value=0)
-            .reset_index(name="count")
+            .rename("count")
+            .rename_axis("sentiment_label")
+            .reset_index()
         )
         pie_articles = (
             alt.Chart(art_sent)
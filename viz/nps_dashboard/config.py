@@ -7,6 +7,12 @@ VIZ_DIR = Path(__file__).resolve().parent.parent
 ROOT_DIR = VIZ_DIR.parent
 
 DATA_PATH = str(ROOT_DIR / "sentiment_output_data")
+# 집계 큐브(nps_dashboard/cube.py) 저장 폴더: DATA_PATH 밖에 둔다 (입력으로 읽히지 않게)
+CUBE_PATH = str(ROOT_DIR / ".cache" / "dashboard_cube")
+# load_data 가 정리된 행을 Arrow 파일로 저장해 두는 폴더 (입력이 바뀔 때만 다시 만듦)
+SNAPSHOT_PATH = str(ROOT_DIR / ".cache" / "dashboard_snapshot")
+# 워드클라우드 토큰 인덱스(nps_dashboard/token_index.py) 저장 폴더
+TOKEN_INDEX_PATH = str(ROOT_DIR / ".cache" / "token_index")
 STOPWORDS_EN_PATH = str(VIZ_DIR / "stopwords" / "stopwords-en.txt")
 
 
@@ -0,0 +1,352 @@
+"""
+대시보드 집계 큐브.
+
+감성분석 결과 행을 (date, hour, source, lang, sentiment_label) 단위로 미리 집계해
+작은 표로 저장한다. 차트는 이 큐브만 다시 합쳐서 그리고, 원본 행은 드릴다운 표본
+(선택 구간의 explanation / 기사 제목 등)에만 쓴다.
+
+측정값은 모두 합이라 어떤 필터/차원으로 다시 묶어도 정확하다:
+  n            행 수
+  n_score      sentiment_score 가 있는 행 수
+  score_sum    sentiment_score 합 (평균 = score_sum / n_score)
+  negative_sum / neutral_sum / positive_sum  확률 합
+
+증분 갱신: 입력 파일(또는 Parquet 데이터셋)마다 큐브 행을 따로 들고 있고
+(file 컬럼), manifest.json 에 파일 크기/수정 시각과 집계한 끝 위치(done)를 적어 둔다.
+  - 바뀌지 않은 파일: 그대로
+  - 뒤에 줄이 붙은 .jsonl (done 앞의 처음/마지막 HEAD_BYTES 가 같고 done 이 줄
+    경계): 붙은 줄만 집계해 더함. 잘랐다가 다시 쓴 파일은 앞부분이 같아도 done
+    직전 바이트가 달라지므로 처음부터 다시 집계한다.
+  - 그 밖에 바뀐 파일: 그 파일 몫만 다시 집계, 없어진 파일: 그 몫을 뺌
+
+오프라인 실행 (viz 폴더에서):
+  python -m nps_dashboard.cube            # config.DATA_PATH → config.CUBE_PATH
+  python -m nps_dashboard.cube --rebuild  # 처음부터 다시
+"""
+
+from __future__ import annotations
+
+import argparse
+import hashlib
+import json
+import logging
+import os
+import uuid
+from pathlib import Path
+from typing import Any
+
+import pandas as pd
+import streamlit as st
+
+from nps_dashboard.config import CUBE_PATH, DATA_PATH
+from nps_dashboard.data import (
+    _read_one_file,
+    find_data_files,
+    find_parquet_roots,
+    prepare_frame,
+    read_jsonl_from,
+    read_parquet,
+    records_frame,
+)
+
+logger = logging.getLogger(__name__)
+
+CUBE_DIMS = ["date", "hour", "source", "lang", "sentiment_label"]
+CUBE_MEASURES = [
+    "n",
+    "n_score",
+    "score_sum",
+    "negative_sum",
+    "neutral_sum",
+    "positive_sum",
+]
+CUBE_VERSION = 1
+
+# .jsonl 이 뒤에만 붙었는지 확인할 때 비교하는 done 앞의 처음/마지막 부분 크기
+HEAD_BYTES = 64 * 1024
+
+
+# ----------------------
+# 집계
+# ----------------------
+def aggregate(df: pd.DataFrame) -> pd.DataFrame:
+    """prepare_frame 을 거친 행 → 큐브 행 (hour 없음 = -1, lang 없음 = "")."""
+    if df.empty:
+        return pd.DataFrame(columns=CUBE_DIMS + CUBE_MEASURES)
+
+    def column(name: str) -> pd.Series:
+        if name in df.columns:
+            return pd.to_numeric(df[name], errors="coerce")
+        return pd.Series(float("nan"), index=df.index)
+
+    score = column("sentiment_score")
+    lang = df["lang"] if "lang" in df.columns else pd.Series("", index=df.index)
+    work = pd.DataFrame(
+        {
+            "date": df["date"],
+            "hour": pd.to_numeric(df["hour"], errors="coerce").fillna(-1).astype(int),
+            "source": df["source"].astype(str),
+            "lang": lang.astype(object).fillna("").astype(str),
+            "sentiment_label": df["sentiment_label"].astype(str),
+            "n": 1,
+            "n_score": score.notna().astype(int),
+            "score_sum": score.fillna(0.0),
+            "negative_sum": column("sentiment.negative").fillna(0.0),
+            "neutral_sum": column("sentiment.neutral").fillna(0.0),
+            "positive_sum": column("sentiment.positive").fillna(0.0),
+        }
+    )
+    return _regroup(work, CUBE_DIMS)
+
+
+def _regroup(cube: pd.DataFrame, dims: list[str]) -> pd.DataFrame:
+    return cube.groupby(dims, dropna=False, observed=True, as_index=False)[
+        CUBE_MEASURES
+    ].sum()
+
+
+def rollup(cube: pd.DataFrame, dims: list[str]) -> pd.DataFrame:
+    """
+    큐브를 dims 기준으로 다시 합친다. mean_score = score_sum / n_score 를 붙여 준다.
+    (dims 가 비면 전체 합계 1행)
+    """
+    if dims:
+        out = _regroup(cube, dims)
+    else:
+        out = pd.DataFrame([cube[CUBE_MEASURES].sum()])
+    out["mean_score"] = out["score_sum"] / out["n_score"].where(out["n_score"] > 0)
+    return out
+
+
+def filter_cube(
+    cube: pd.DataFrame,
+    sources: list[str] | None = None,
+    start: pd.Timestamp | None = None,
+    end: pd.Timestamp | None = None,
+) -> pd.DataFrame:
+    """source / 기간 필터. 기간을 주면 날짜가 없는 행은 빠진다 (원본 행 필터와 같음)."""
+    mask = pd.Series(True, index=cube.index)
+    if sources is not None:
+        mask &= cube["source"].isin(sources)
+    if start is not None and end is not None:
+        mask &= cube["date"].notna() & cube["date"].between(start, end)
+    return cube[mask]
+
+
+# ----------------------
+# 입력 단위 / 서명
+# ----------------------
+def _units(data_path: str | Path) -> dict[str, Path]:
+    """큐브를 따로 관리하는 입력 단위: .jsonl/.json 파일과 Parquet 데이터셋 루트."""
+    p = Path(data_path)
+    if p.suffix.lower() == ".parquet" or p.is_file():
+        return {p.name: p}
+    if not p.is_dir():
+        return {}
+    units = {str(fp.relative_to(p)): fp for fp in find_data_files(p)}
+    units.update({str(fp.relative_to(p)): fp for fp in find_parquet_roots(p)})
+    return units
+
+
+def _stat(path: Path) -> dict[str, int]:
+    if path.is_dir():
+        parts = sorted(path.rglob("*.parquet"))
+        return {
+            "size": sum(fp.stat().st_size for fp in parts),
+            "mtime_ns": max((fp.stat().st_mtime_ns for fp in parts), default=0),
+            "files": len(parts),
+        }
+    st_ = path.stat()
+    return {"size": st_.st_size, "mtime_ns": st_.st_mtime_ns}
+
+
+def data_signature(data_path: str | Path) -> tuple[Any, ...]:
+    """입력 파일들의 (이름, 크기, 수정 시각). 바뀌면 큐브/원본 캐시를 갱신한다."""
+    return tuple(
+        (key, *_stat(path).values()) for key, path in sorted(_units(data_path).items())
+    )
+
+
+def _sha1_range(path: Path, start: int, end: int) -> str:
+    with path.open("rb") as f:
+        f.seek(start)
+        return hashlib.sha1(f.read(max(0, end - start))).hexdigest()
+
+
+def _fingerprint(path: Path, done: int) -> dict[str, str]:
+    """done 앞의 처음/마지막 HEAD_BYTES 해시 (incremental.fingerprint 와 같은 방식)."""
+    return {
+        "head": _sha1_range(path, 0, min(done, HEAD_BYTES)),
+        "tail": _sha1_range(path, max(0, done - HEAD_BYTES), done),
+    }
+
+
+def _appended_only(path: Path, old: dict[str, Any], size: int) -> bool:
+    """이전에 집계한 [0, done) 이 그대로고 done 이 줄 경계인지."""
+    done = old.get("done")
+    if not isinstance(done, int) or not 0 < done <= size:
+        return False
+    with path.open("rb") as f:
+        f.seek(done - 1)
+        if f.read(1) != b"\n":
+            return False
+    fp = _fingerprint(path, done)
+    return old.get("head") == fp["head"] and old.get("tail") == fp["tail"]
+
+
+# ----------------------
+# 저장 (Parquet, pyarrow 가 없으면 pickle)
+# ----------------------
+def _cube_file(cube_dir: Path) -> Path:
+    try:
+        import pyarrow  # noqa: F401  # lazy import (선택 의존성)
+    except ImportError:
+        return cube_dir / "cube.pkl"
+    return cube_dir / "cube.parquet"
+
+
+def _read_cube(cube_dir: Path) -> pd.DataFrame:
+    fp = _cube_file(cube_dir)
+    if not fp.exists():
+        return pd.DataFrame(columns=["file", *CUBE_DIMS, *CUBE_MEASURES])
+    if fp.suffix == ".parquet":
+        return pd.read_parquet(fp)
+    return pd.read_pickle(fp)
+
+
+def _tmp_path(fp: Path) -> Path:
+    """동시에 갱신하는 프로세스끼리 겹치지 않는 임시 파일 이름."""
+    return fp.with_name(f"{fp.name}.{os.getpid()}.{uuid.uuid4().hex[:8]}.tmp")
+
+
+def _write_manifest(fp: Path, manifest: dict[str, Any]) -> None:
+    tmp = _tmp_path(fp)
+    tmp.write_text(json.dumps(manifest, ensure_ascii=False), encoding="utf-8")
+    tmp.replace(fp)
+
+
+def _write_cube(cube_dir: Path, cube: pd.DataFrame) -> None:
+    fp = _cube_file(cube_dir)
+    tmp = _tmp_path(fp)
+    if fp.suffix == ".parquet":
+        cube.to_parquet(tmp, index=False)
+    else:
+        cube.to_pickle(tmp)
+    tmp.replace(fp)
+
+
+# ----------------------
+# 증분 갱신
+# ----------------------
+def _aggregate_unit(path: Path, start: int = 0) -> tuple[pd.DataFrame, int | None]:
+    """입력 단위 하나(또는 .jsonl 의 start 이후)를 집계. (큐브 행, 읽은 끝 위치)"""
+    end: int | None = None
+    if path.is_dir() or path.suffix.lower() == ".parquet":
+        df = read_parquet(path)
+    elif path.suffix.lower() == ".jsonl":
+        records, end = read_jsonl_from(path, start)
+        df = records_frame(records)
+    else:
+        df = records_frame(_read_one_file(path))
+
+    if df.empty or "source" not in df.columns:
+        return aggregate(pd.DataFrame()), end
+    return aggregate(prepare_frame(df)), end
+
+
+def update_cube(
+    data_path: str | Path = DATA_PATH,
+    cube_dir: str | Path = CUBE_PATH,
+    *,
+    rebuild: bool = False,
+) -> pd.DataFrame:
+    """
+    data_path 의 감성분석 결과로 큐브를 갱신하고 (바뀐 입력만 다시 집계),
+    file 컬럼을 뺀 큐브를 돌려준다.
+    """
+    cube_dir = Path(cube_dir)
+    cube_dir.mkdir(parents=True, exist_ok=True)
+    manifest_path = cube_dir / "manifest.json"
+
+    manifest: dict[str, Any] = {"version": CUBE_VERSION, "files": {}}
+    cube = _read_cube(cube_dir)
+    if not rebuild and manifest_path.exists():
+        try:
+            loaded = json.loads(manifest_path.read_text(encoding="utf-8"))
+        except (OSError, ValueError):
+            loaded = None  # 깨진 manifest: 처음부터 다시
+        if isinstance(loaded, dict) and loaded.get("version") == CUBE_VERSION:
+            manifest = loaded
+    if not manifest["files"]:
+        cube = cube.iloc[0:0]
+
+    files: dict[str, Any] = manifest["files"]
+    units = _units(data_path)
+    parts: list[pd.DataFrame] = []
+    drop: set[str] = set(files) - set(units)
+    appended = recomputed = 0
+
+    for key, path in sorted(units.items()):
+        stat = _stat(path)
+        old = files.get(key)
+        if old is not None and old["stat"] == stat:
+            continue
+
+        start = 0
+        if old is not None and _appended_only(path, old, stat["size"]):
+            start = old["done"]  # 집계한 부분이 그대로인 .jsonl: 붙은 줄만
+            appended += 1
+        else:
+            drop.add(key)
+            recomputed += 1
+
+        rows, end = _aggregate_unit(path, start)
+        parts.append(rows.assign(file=key))
+        files[key] = {"stat": stat, "done": end}
+        if end:
+            files[key].update(_fingerprint(path, end))
+
+    for key in drop - set(units):
+        files.pop(key, None)
+
+    if parts or drop:
+        cube = pd.concat(
+            [cube[~cube["file"].isin(drop)], *parts], ignore_index=True
+        )
+        cube = _regroup(cube, ["file", *CUBE_DIMS])
+        _write_cube(cube_dir, cube)
+        _write_manifest(manifest_path, manifest)
+        logger.info(
+            "[INFO] 큐브 갱신: 이어 붙인 파일 %d, 다시 집계 %d, 삭제 %d → %d행",
+            appended,
+            recomputed,
+            len(drop - set(units)),
+            len(cube),
+        )
+
+    return _regroup(cube, CUBE_DIMS)
+
+
+@st.cache_data(show_spinner="집계 큐브 갱신 중...")
+def load_cube(
+    data_path: str, cube_dir: str, signature: tuple[Any, ...]
+) -> pd.DataFrame:
+    """대시보드용: signature(data_signature)가 바뀔 때만 update_cube 를 다시 부른다."""
+    return update_cube(data_path, cube_dir)
+
+
+def main(argv: list[str] | None = None) -> None:
+    logging.basicConfig(level=logging.INFO, format="%(levelname)s: %(message)s")
+    parser = argparse.ArgumentParser(description="대시보드 집계 큐브 생성/갱신")
+    parser.add_argument("--data", default=DATA_PATH, help="감성분석 결과 폴더/파일")
+    parser.add_argument("--cube", default=CUBE_PATH, help="큐브 저장 폴더")
+    parser.add_argument(
+        "--rebuild", action="store_true", help="증분 갱신 대신 처음부터 다시 집계"
+    )
+    args = parser.parse_args(argv)
+    cube = update_cube(args.data, args.cube, rebuild=args.rebuild)
+    print(f"cube rows: {len(cube):,}, 원본 행: {int(cube['n'].sum()):,}")
+
+
+if __name__ == "__main__":
+    main()
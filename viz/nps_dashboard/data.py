@@ -1,15 +1,51 @@
 from __future__ import annotations
 
 import json
+import logging
+import os
+import uuid
 from pathlib import Path
 from typing import Any, cast
 
+import numpy as np
 import pandas as pd
 import streamlit as st
 
+from .config import SNAPSHOT_PATH
+
+logger = logging.getLogger(__name__)
+
 JSONObj = dict[str, Any]
 
 
+def read_jsonl_from(p: Path, start: int = 0) -> tuple[list[JSONObj], int]:
+    """
+    .jsonl 을 start 바이트부터 읽는다. (레코드들, 마지막 완전한 줄의 끝 위치)
+    줄바꿈으로 끝나지 않은 마지막 줄(아직 쓰는 중)은 건너뛴다 (cube.py 증분 갱신용).
+    깨진 줄은 경고만 남기고 건너뛴다.
+    """
+    out: list[JSONObj] = []
+    end = start
+    bad = 0
+    with p.open("rb") as f:
+        f.seek(start)
+        for raw in f:
+            if not raw.endswith(b"\n"):
+                break
+            end += len(raw)
+            try:
+                obj = json.loads(raw.decode("utf-8"))
+            except ValueError:  # JSONDecodeError, UnicodeDecodeError
+                if raw.strip():
+                    bad += 1
+                continue
+            if isinstance(obj, dict):
+                out.append(cast(JSONObj, obj))
+    if bad:
+        logger.warning("[WARN] %s: 깨진 줄 %d개 건너뜀 (%d바이트부터)", p, bad, start)
+    return out, end
+
+
 def _read_one_file(p: Path) -> list[JSONObj]:
     """단일 파일(.jsonl / .json)에서 list[dict] 형태로 로드"""
     suffix = p.suffix.lower()
@@ -39,16 +75,124 @@ def _read_one_file(p: Path) -> list[JSONObj]:
     return []
 
 
+# Parquet 데이터셋(preprocess/preprocess_merge/columnar.py)에서 읽는 컬럼.
+# 필요한 컬럼만 읽고 is_related / source 조건은 파일 스캔 단계에서 거른다.
+PARQUET_COLUMNS = [
+    "doc_type",
+    "comment_text",
+    "text",
+    "title",
+    "explanation",
+    "source",
+    "lang",
+    "published_at",
+    "comment_publishedAt",
+    "is_related",
+    "negative",
+    "neutral",
+    "positive",
+]
+
+
+def find_parquet_roots(p: Path) -> list[Path]:
+    """폴더 안의 Parquet 데이터셋 루트(.parquet 디렉터리 또는 파일)"""
+    roots: list[Path] = []
+    for fp in sorted(p.rglob("*.parquet")):
+        inner = fp.relative_to(p).parts[:-1]
+        if any(part.endswith(".parquet") for part in inner):
+            continue  # 다른 데이터셋 안의 파티션 파일
+        roots.append(fp)
+    return roots
+
+
+def read_parquet(root: Path, sources: tuple[str, ...] | None = None) -> pd.DataFrame:
+    import pyarrow.dataset as ds  # lazy import (선택 의존성)
+
+    dataset = ds.dataset(str(root), format="parquet", partitioning="hive")
+    names = set(dataset.schema.names)
+    columns = [c for c in PARQUET_COLUMNS if c in names]
+
+    condition = None
+    if "is_related" in names:
+        condition = ds.field("is_related") == True  # noqa: E712
+    if sources and "source" in names:
+        in_sources = ds.field("source").isin(list(sources))
+        condition = in_sources if condition is None else condition & in_sources
+
+    return dataset.to_table(columns=columns, filter=condition).to_pandas()
+
+
+# 데이터가 아닌 부속 파일: 감성분석 진행 상태(ml/grok_sentiment_cli), 증분 병합
+# manifest(preprocess_merge/incremental), 큐브/스냅샷 manifest, 쓰는 중인 임시 파일
+_SIDECAR_SUFFIXES = (".progress.json", ".manifest.json")
+_SIDECAR_NAMES = {"manifest.json"}
+
+
+def _is_data_file(fp: Path) -> bool:
+    name = fp.name
+    if name in _SIDECAR_NAMES or name.endswith(_SIDECAR_SUFFIXES):
+        return False
+    return ".tmp" not in fp.suffixes
+
+
+def find_data_files(p: Path) -> list[Path]:
+    """폴더 안의 .jsonl / .json 파일 (부속 파일 제외, cube.data_signature 도 사용)"""
+    files = [*p.rglob("*.jsonl"), *p.rglob("*.json")]
+    return sorted(fp for fp in files if _is_data_file(fp))
+
+
 @st.cache_data
-def load_data(path: str) -> pd.DataFrame:
+def load_data(
+    path: str,
+    sources: tuple[str, ...] | None = None,
+    signature: Any = None,
+    columns: tuple[str, ...] | None = None,
+) -> pd.DataFrame:
+    """
+    .jsonl / .json 파일과 .parquet 데이터셋을 읽는다 (폴더면 하위 전체).
+    sources 를 주면 해당 source 만 남긴다 (Parquet은 파티션 단위로 건너뜀).
+    columns 를 주면 그 컬럼만 돌려준다 (스냅샷에서는 그 컬럼만 읽는다).
+
+    정리된 결과는 Arrow 스냅샷(SNAPSHOT_PATH)으로 저장해 두고, 입력 파일의
+    signature(cube.data_signature: 이름/크기/수정 시각)가 같으면 스냅샷만 읽는다.
+    signature 를 안 주면 여기서 계산한다.
+    """
+    if signature is None:
+        from .cube import data_signature  # cube 가 data 를 import 하므로 지연
+
+        signature = data_signature(path)
+
+    cols = list(columns) if columns is not None else None
+    df = read_snapshot(SNAPSHOT_PATH, path, signature, sources, cols)
+    if df is not None:
+        return df
+
+    df = _load_source_files(path)
+    write_snapshot(df, SNAPSHOT_PATH, path, signature)
+    if sources:
+        df = df[df["source"].isin(sources)].reset_index(drop=True)
+    if cols is not None:
+        df = df[[c for c in cols if c in df.columns]]
+    return df
+
+
+def _load_source_files(path: str) -> pd.DataFrame:
     p = Path(path)
 
     records: list[JSONObj] = []
+    parquet_roots: list[Path] = []
 
-    if p.is_dir():
-        files = sorted([*p.rglob("*.jsonl"), *p.rglob("*.json")])
-        if not files:
-            raise FileNotFoundError(f"데이터 폴더에 .jsonl/.json 파일이 없습니다: {p}")
+    if p.suffix.lower() == ".parquet":
+        if not p.exists():
+            raise FileNotFoundError(f"데이터 파일/폴더를 찾을 수 없습니다: {p}")
+        parquet_roots = [p]
+    elif p.is_dir():
+        files = find_data_files(p)
+        parquet_roots = find_parquet_roots(p)
+        if not files and not parquet_roots:
+            raise FileNotFoundError(
+                f"데이터 폴더에 .jsonl/.json/.parquet 파일이 없습니다: {p}"
+            )
 
         for fp in files:
             records.extend(_read_one_file(fp))
@@ -57,7 +201,214 @@ def load_data(path: str) -> pd.DataFrame:
             raise FileNotFoundError(f"데이터 파일/폴더를 찾을 수 없습니다: {p}")
         records = _read_one_file(p)
 
-    df: pd.DataFrame = pd.json_normalize(cast(list[dict[str, Any]], records))
+    frames: list[pd.DataFrame] = []
+    if records or not parquet_roots:
+        frames.append(records_frame(records))
+    frames.extend(read_parquet(root) for root in parquet_roots)
+    df: pd.DataFrame = (
+        frames[0] if len(frames) == 1 else pd.concat(frames, ignore_index=True)
+    )
+    return prepare_frame(df).reset_index(drop=True)
+
+
+# ----------------------
+# Arrow 스냅샷 (메모리 맵으로 읽기)
+# ----------------------
+def _snapshot_key(path: str, signature: Any) -> Any:
+    return json.loads(json.dumps([str(Path(path).resolve()), signature], default=str))
+
+
+def _snapshot_tmp(fp: Path) -> Path:
+    """동시에 저장하는 실행(여러 Streamlit 세션)끼리 겹치지 않는 임시 파일 이름."""
+    return fp.with_name(f"{fp.name}.{os.getpid()}.{uuid.uuid4().hex[:8]}.tmp")
+
+
+def read_snapshot(
+    snapshot_dir: str | Path,
+    path: str,
+    signature: Any,
+    sources: tuple[str, ...] | None = None,
+    columns: list[str] | None = None,
+    date_range: tuple[pd.Timestamp, pd.Timestamp] | None = None,
+) -> pd.DataFrame | None:
+    """
+    signature 가 같은 스냅샷이 있으면 읽는다 (없거나, manifest 가 깨졌거나,
+    pyarrow 가 없으면 None → 원본에서 다시 만든다).
+    columns 를 주면 그 컬럼만, date_range 를 주면 date 가 그 안(양끝 포함)인
+    행만 pandas 로 옮긴다 (filter_rows 와 같은 조건).
+    """
+    try:
+        import pyarrow as pa  # lazy import (선택 의존성)
+        import pyarrow.compute as pc
+    except ImportError:
+        return None
+
+    snapshot_dir = Path(snapshot_dir)
+    fp = snapshot_dir / "snapshot.arrow"
+    manifest = snapshot_dir / "manifest.json"
+    if not fp.exists() or not manifest.exists():
+        return None
+    try:
+        key = json.loads(manifest.read_text(encoding="utf-8"))
+    except (OSError, json.JSONDecodeError) as exc:
+        logger.warning("[WARN] 스냅샷 manifest 를 읽을 수 없어 다시 만듭니다: %s", exc)
+        return None
+    if key != _snapshot_key(path, signature):
+        return None
+
+    # 비압축 IPC 파일이라 메모리 맵 그대로 쓴다. 컬럼 선택/행 필터는 Arrow 에서
+    # 하고 남은 것만 pandas 로 옮긴다 (split_blocks: 컬럼을 한 블록으로 합치는
+    # 복사를 하지 않음 — null 없는 수치 컬럼은 맵을 그대로 가리킨다)
+    try:
+        with pa.memory_map(str(fp), "r") as source:
+            table = pa.ipc.open_file(source).read_all()
+    except (pa.ArrowInvalid, OSError) as exc:
+        logger.warning("[WARN] 스냅샷을 읽을 수 없어 다시 만듭니다: %s", exc)
+        return None
+    if columns is not None:
+        table = table.select([c for c in columns if c in table.column_names])
+    if sources and "source" in table.column_names:
+        mask = pc.is_in(
+            pc.cast(table["source"], pa.string()),
+            value_set=pa.array(list(sources), pa.string()),
+        )
+        table = table.filter(mask)
+    if date_range is not None and "date" in table.column_names:
+        col = table["date"]
+        start, end = (pa.scalar(ts.to_pydatetime(), col.type) for ts in date_range)
+        # null 날짜는 비교 결과가 null 이라 filter 에서 빠진다
+        table = table.filter(
+            pc.and_(pc.greater_equal(col, start), pc.less_equal(col, end))
+        )
+    return table.to_pandas(split_blocks=True)
+
+
+def filter_rows(
+    df: pd.DataFrame,
+    sources: tuple[str, ...] | None = None,
+    date_range: tuple[pd.Timestamp, pd.Timestamp] | None = None,
+) -> pd.DataFrame:
+    """source / 기간 필터 (기간을 주면 날짜가 없는 행은 빠진다)."""
+    if sources is not None:
+        df = df[df["source"].isin(sources)]
+    if date_range is not None:
+        start_ts, end_ts = date_range
+        df = df[
+            df["date"].notna()
+            & df["date"].between(start_ts, end_ts, inclusive="both")
+        ]
+    return df.reset_index(drop=True)
+
+
+def load_rows(
+    path: str,
+    sources: tuple[str, ...],
+    date_range: tuple[pd.Timestamp, pd.Timestamp] | None = None,
+    signature: Any = None,
+) -> pd.DataFrame:
+    """
+    필터에 맞는 원본 행만 읽는다 (드릴다운 표본/워드클라우드용).
+    스냅샷이 있으면 메모리 맵에서 필요한 행만 옮기고, 전체 행을 메모리에 들고
+    있지 않는다. 스냅샷이 없으면 load_data 로 한 번 만들고 (pyarrow 가 없으면
+    load_data 가 캐시한 전체 행에서) 거른다.
+    """
+    if signature is None:
+        from .cube import data_signature  # cube 가 data 를 import 하므로 지연
+
+        signature = data_signature(path)
+
+    df = read_snapshot(SNAPSHOT_PATH, path, signature, sources, date_range=date_range)
+    if df is not None:
+        return df
+    return filter_rows(load_data(path, signature=signature), sources, date_range)
+
+
+def write_snapshot(
+    df: pd.DataFrame, snapshot_dir: str | Path, path: str, signature: Any
+) -> None:
+    try:
+        import pyarrow as pa  # lazy import (선택 의존성)
+    except ImportError:
+        return
+
+    snapshot_dir = Path(snapshot_dir)
+    snapshot_dir.mkdir(parents=True, exist_ok=True)
+    fp = snapshot_dir / "snapshot.arrow"
+    manifest = snapshot_dir / "manifest.json"
+    tmp = _snapshot_tmp(fp)
+    try:
+        table = pa.Table.from_pandas(df, preserve_index=False)
+        with pa.OSFile(str(tmp), "wb") as sink:
+            with pa.ipc.new_file(sink, table.schema) as writer:
+                writer.write_table(table)
+    except (pa.ArrowInvalid, pa.ArrowTypeError, OSError) as exc:
+        logger.warning("[WARN] 스냅샷 저장 실패 (원본 파일로 계속): %s", exc)
+        tmp.unlink(missing_ok=True)
+        return
+    # 스냅샷을 바꾸는 동안 읽는 쪽이 옛 manifest 로 새 파일을 쓰지 않게 먼저 지운다
+    manifest.unlink(missing_ok=True)
+    tmp.replace(fp)
+    tmp = _snapshot_tmp(manifest)
+    tmp.write_text(
+        json.dumps(_snapshot_key(path, signature), ensure_ascii=False),
+        encoding="utf-8",
+    )
+    tmp.replace(manifest)
+
+
+# prepare_frame 이 쓰는 원본 키 (이 밖의 키는 json_normalize 전에 버린다)
+FRAME_COLUMNS = [
+    "doc_type",
+    "comment",
+    "comment_text",
+    "text",
+    "title",
+    "explanation",
+    "source",
+    "lang",
+    "published_at",
+    "comment_publishedAt",
+    "is_related",
+    "sentiment_label",
+    "sentiment.negative",
+    "sentiment.neutral",
+    "sentiment.positive",
+]
+SENTIMENT_CANDIDATES = {
+    "sentiment.negative": ["negative", "neg", "sentiment_negative", "neg_score"],
+    "sentiment.neutral": ["neutral", "neu", "sentiment_neutral", "neu_score"],
+    "sentiment.positive": ["positive", "pos", "sentiment_positive", "pos_score"],
+}
+RECORD_KEYS = {
+    *FRAME_COLUMNS,
+    "sentiment",
+    *(k for keys in SENTIMENT_CANDIDATES.values() for k in keys),
+}
+
+
+def records_frame(records: list[JSONObj]) -> pd.DataFrame:
+    """
+    레코드 → DataFrame. is_related 가 거짓인 레코드와 쓰지 않는 키는
+    json_normalize 전에 버린다 (is_related 가 없는 레코드는 prepare_frame 이 판단).
+    """
+    slim = [
+        {k: v for k, v in r.items() if k in RECORD_KEYS}
+        for r in records
+        if r.get("is_related", True)
+    ]
+    return pd.json_normalize(cast(list[dict[str, Any]], slim))
+
+
+def prepare_frame(
+    df: pd.DataFrame, sources: tuple[str, ...] | None = None
+) -> pd.DataFrame:
+    """
+    읽어 온 원본 행을 대시보드 스키마로 정리한다 (load_data / cube.py 공용):
+    관련 행만 남기고, 감성 컬럼 이름을 맞추고, KST 날짜/시간과
+    sentiment_label / sentiment_score 를 붙인다.
+    """
+    if sources and "source" in df.columns:
+        df = df[df["source"].astype(str).isin(sources)].copy()
 
     if "is_related" in df.columns:
         df = df[df["is_related"].fillna(False).astype(bool)].copy()
@@ -72,36 +423,14 @@ def load_data(path: str) -> pd.DataFrame:
         ]
         df = df.join(sent_norm)
 
-    candidates = {
-        "sentiment.negative": ["negative", "neg", "sentiment_negative", "neg_score"],
-        "sentiment.neutral": ["neutral", "neu", "sentiment_neutral", "neu_score"],
-        "sentiment.positive": ["positive", "pos", "sentiment_positive", "pos_score"],
-    }
-    for tgt, keys in candidates.items():
-        if tgt in df.columns:
-            continue
+    for tgt, keys in SENTIMENT_CANDIDATES.items():
         for k in keys:
             if k in df.columns:
-                df[tgt] = df[k]
+                # JSON(중첩 sentiment)과 Parquet(평평한 컬럼)이 섞여 있을 수 있음
+                df[tgt] = df[tgt].fillna(df[k]) if tgt in df.columns else df[k]
                 break
 
-    keep = [
-        "doc_type",
-        "comment",
-        "comment_text",
-        "text",
-        "title",
-        "explanation",
-        "source",
-        "published_at",
-        "comment_publishedAt",
-        "is_related",
-        "sentiment_label",
-        "sentiment.negative",
-        "sentiment.neutral",
-        "sentiment.positive",
-    ]
-    cols = [c for c in keep if c in df.columns]
+    cols = [c for c in FRAME_COLUMNS if c in df.columns]
     df = df[cols].copy()
 
     dt_raw = pd.Series(pd.NaT, index=df.index, dtype="datetime64[ns, UTC]")
@@ -154,8 +483,13 @@ def load_data(path: str) -> pd.DataFrame:
     df["date"] = dt_naive.normalize()
     df["hour"] = dt_naive.hour
 
-    if "source" in df.columns:
-        df["source"] = df["source"].astype("category")
+    # 원본 시각 문자열은 datetime 으로 옮겼으니 버린다
+    df = df.drop(columns=["published_at", "comment_publishedAt"], errors="ignore")
+
+    # 반복이 많은 문자열은 category (Arrow 스냅샷에서는 dictionary 인코딩)
+    for c in ("source", "lang", "doc_type"):
+        if c in df.columns:
+            df[c] = df[c].astype("category")
 
     for c in sentiment_cols:
         if c in df.columns:
@@ -173,4 +507,34 @@ def load_data(path: str) -> pd.DataFrame:
             ordered=True,
         )
 
+    df["date_only"] = df["date"].dt.date
+    df["hour_int"] = (
+        pd.to_numeric(df["hour"], errors="coerce").round().astype("Int64")
+    )
+    df["sentiment_score"] = sentiment_scores(df)
     return df
+
+
+SENTIMENT_TO_SCORE = {"negative": -1.0, "neutral": 0.0, "positive": 1.0}
+
+
+def sentiment_scores(df: pd.DataFrame) -> pd.Series:
+    """
+    행별 감성 스코어(-1 ~ +1) = positive - negative (세 확률 합으로 정규화,
+    합이 0이면 0). 확률 컬럼이 없으면 라벨 기준(-1/0/+1, unknown 은 NaN).
+    """
+    prob_cols = ["sentiment.negative", "sentiment.neutral", "sentiment.positive"]
+    if not all(c in df.columns for c in prob_cols):
+        return (
+            df["sentiment_label"]
+            .astype(str)
+            .map(SENTIMENT_TO_SCORE)
+            .astype("float32")
+        )
+
+    probs = df[prob_cols].apply(pd.to_numeric, errors="coerce").fillna(0.0)
+    total = probs.sum(axis=1).replace(0, np.nan)
+    score = (
+        (probs["sentiment.positive"] - probs["sentiment.negative"]) / total
+    ).fillna(0.0)
+    return score.clip(-1.0, 1.0).astype("float32")
@@ -0,0 +1,358 @@
+"""
+워드클라우드 / Sankey 용 토큰 인덱스.
+
+행 텍스트를 strip_web_noise → clean_text → 토큰화(ko: Okt 명사, en: 불용어/난수 토큰
+제거)한 결과를 텍스트 해시별로 한 번만 계산해 저장한다. 토큰은 어휘(vocab) id 목록으로
+들고 있어서, 선택 구간의 단어 통계는 행마다 id 목록을 찾아 세기만 하면 된다.
+
+Okt 는 JVM 기반이라 느리므로 오프라인에서 미리 채워 둔다 (viz 폴더에서):
+  python -m nps_dashboard.token_index                # config.DATA_PATH 전체, ko + en
+  python -m nps_dashboard.token_index --workers 8    # 프로세스 8개 (프로세스마다 Okt)
+
+인덱스에 없는 행은 대시보드에서 그 자리에서 토큰화하고 메모리 인덱스에만 더한다.
+토큰화 규칙(필터)을 바꾸면 TOKENIZER_VERSION 을 올려서 인덱스를 새로 만든다.
+"""
+
+from __future__ import annotations
+
+import argparse
+import hashlib
+import logging
+import os
+import pickle
+import threading
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Iterable, Protocol, cast
+
+import pandas as pd
+
+from .config import DATA_PATH, TOKEN_INDEX_PATH
+from .text_processing import (
+    clean_text,
+    get_en_stopwords,
+    is_english_word,
+    is_gibberish_en,
+    is_korean_word,
+    strip_web_noise,
+)
+
+logger = logging.getLogger(__name__)
+
+TOKENIZER_VERSION = 1
+LANGS = ("ko", "en")
+SENTIMENT_LABELS = ("negative", "neutral", "positive")
+TEXT_COLUMNS = ["comment", "comment_text", "text", "title"]
+
+# (선택) 정말 남기고 싶은 영어 약어를 예외 처리하고 싶으면 여기에 추가
+# 예: {"nps", "oecd"}
+EN_WHITELIST: set[str] = set()
+
+
+class OktLike(Protocol):
+    def nouns(self, phrase: str) -> list[str]: ...
+
+
+try:
+    from konlpy.tag import Okt as _Okt
+except Exception as e:  # pragma: no cover
+    _Okt = None
+    _KONLPY_IMPORT_ERROR = e
+else:
+    _KONLPY_IMPORT_ERROR = None
+
+
+def _require_okt() -> OktLike:
+    if _Okt is None:
+        raise ImportError(
+            "한국어 워드클라우드는 konlpy(Okt)가 필요합니다. "
+        ) from _KONLPY_IMPORT_ERROR
+
+    return cast(OktLike, _Okt())
+
+
+# ----------------------
+# 행 텍스트 / 토큰화
+# ----------------------
+def _text_column(s: pd.Series) -> pd.Series:
+    s = s.map(lambda v: " ".join(map(str, v)) if isinstance(v, (list, tuple)) else v)
+    return s.where(s.notna(), "").astype(str).str.strip()
+
+
+def row_labels(df: pd.DataFrame) -> pd.Series:
+    """sentiment_label (없으면 label). 세 감성 라벨 밖이면 NaN."""
+    label = pd.Series(pd.NA, index=df.index, dtype="object")
+    for col in ("sentiment_label", "label"):
+        if col in df.columns:
+            label = label.fillna(df[col])
+    return label.where(label.isin(SENTIMENT_LABELS))
+
+
+def row_texts(df: pd.DataFrame) -> pd.Series:
+    """
+    워드클라우드에 쓰는 행 텍스트 (감성 라벨이 없는 행/빈 텍스트는 NaN).
+    - doc_type == 'comment'면 comment_text만 사용 (없으면 comment fallback)
+    - 그 외에는 존재하는 텍스트 컬럼들을 합쳐 사용
+    """
+    cols = [c for c in TEXT_COLUMNS if c in df.columns]
+    if not cols:
+        return pd.Series(pd.NA, index=df.index, dtype="object")
+
+    parts = {c: _text_column(df[c]) for c in cols}
+    merged = pd.Series(
+        [" ".join(p for p in row if p) for row in zip(*parts.values())],
+        index=df.index,
+        dtype="object",
+    )
+
+    if "doc_type" in df.columns:
+        is_comment = df["doc_type"].eq("comment")
+        comment = pd.Series("", index=df.index, dtype="object")
+        if "comment_text" in df.columns:
+            comment = comment.where(df["comment_text"].isna(), parts["comment_text"])
+        if "comment" in df.columns:
+            fallback = df["comment_text"].isna() if "comment_text" in df else True
+            comment = comment.mask(fallback & df["comment"].notna(), parts["comment"])
+        merged = merged.mask(is_comment, comment)
+
+    texts = merged.where(merged.str.len() > 0)
+    return texts.where(row_labels(df).notna())
+
+
+def text_key(text: str) -> str:
+    return hashlib.sha1(text.encode("utf-8")).hexdigest()[:16]
+
+
+def tokenize(text: str, lang: str, okt: OktLike | None = None) -> list[str]:
+    """텍스트 하나 → 토큰 목록 (등장 순서/중복 유지)."""
+    cleaned = clean_text(strip_web_noise(text))
+    if not cleaned:
+        return []
+
+    if lang == "ko":
+        if okt is None:
+            okt = _require_okt()
+        tokens = (str(tok).strip() for tok in okt.nouns(cleaned))
+        return [tok for tok in tokens if len(tok) >= 2 and is_korean_word(tok)]
+
+    if lang == "en":
+        en_sw = get_en_stopwords()
+        out: list[str] = []
+        for tok in cleaned.split():
+            tok = tok.lower().strip()
+            if not is_english_word(tok) or tok in en_sw:
+                continue
+            if is_gibberish_en(tok, whitelist=EN_WHITELIST):
+                continue
+            out.append(tok)
+        return out
+
+    return []
+
+
+# 병렬 토큰화: 프로세스마다 Okt(JVM) 를 하나씩 띄운다
+_WORKER_OKT: OktLike | None = None
+
+
+def _init_worker(lang: str) -> None:
+    global _WORKER_OKT
+    _WORKER_OKT = _require_okt() if lang == "ko" else None
+
+
+def _tokenize_chunk(
+    lang: str, chunk: list[tuple[str, str]]
+) -> list[tuple[str, list[str]]]:
+    return [(key, tokenize(text, lang, _WORKER_OKT)) for key, text in chunk]
+
+
+# ----------------------
+# 인덱스
+# ----------------------
+class TokenIndex:
+    """
+    텍스트 해시 → 토큰 id 목록, 그리고 id → 토큰 문자열(vocab).
+
+    대시보드 세션(스레드)들이 한 인덱스를 같이 쓰므로 추가/저장은 잠금 안에서 한다.
+    rows/vocab 은 늘어나기만 해서, 이미 있는 id 를 읽는 쪽은 잠그지 않는다.
+    """
+
+    def __init__(self, lang: str) -> None:
+        self.lang = lang
+        self.vocab: list[str] = []
+        self.ids: dict[str, int] = {}
+        self.rows: dict[str, tuple[int, ...]] = {}
+        self._lock = threading.Lock()
+
+    def __len__(self) -> int:
+        return len(self.rows)
+
+    def __contains__(self, key: object) -> bool:
+        return key in self.rows
+
+    def add(self, key: str, tokens: list[str]) -> None:
+        with self._lock:
+            ids = []
+            for tok in tokens:
+                tid = self.ids.get(tok)
+                if tid is None:
+                    # vocab 에 먼저 넣어야 ids 로 찾은 id 가 항상 유효하다
+                    self.vocab.append(tok)
+                    tid = self.ids[tok] = len(self.vocab) - 1
+                ids.append(tid)
+            self.rows[key] = tuple(ids)
+
+    def update(
+        self, texts: Iterable[str], *, workers: int = 1, chunk_size: int = 256
+    ) -> int:
+        """인덱스에 없는 텍스트만 토큰화해서 더한다. 더한 개수를 돌려준다."""
+        keyed = ((text_key(text), text) for text in texts)
+        return self._add_missing(keyed, workers=workers, chunk_size=chunk_size)
+
+    def _add_missing(
+        self,
+        keyed: Iterable[tuple[str, str]],
+        *,
+        workers: int = 1,
+        chunk_size: int = 256,
+    ) -> int:
+        pending: dict[str, str] = {}
+        for key, text in keyed:
+            if key not in self.rows:
+                pending.setdefault(key, text)
+        if not pending:
+            return 0
+
+        items = list(pending.items())
+        if workers <= 1 or len(items) <= chunk_size:
+            okt = _require_okt() if self.lang == "ko" else None
+            for key, text in items:
+                self.add(key, tokenize(text, self.lang, okt))
+            return len(items)
+
+        chunks = [items[i : i + chunk_size] for i in range(0, len(items), chunk_size)]
+        with ProcessPoolExecutor(
+            max_workers=workers, initializer=_init_worker, initargs=(self.lang,)
+        ) as pool:
+            for done in pool.map(_tokenize_chunk, [self.lang] * len(chunks), chunks):
+                for key, tokens in done:
+                    self.add(key, tokens)
+        return len(items)
+
+    def word_stats(
+        self, df: pd.DataFrame
+    ) -> tuple[dict[str, int], dict[str, dict[str, int]]]:
+        """
+        df 행들의 (단어 → 등장 수, 단어 → 감성별 등장 수).
+        인덱스에 없는 행은 먼저 토큰화해서 더한다.
+        """
+        rows = pd.DataFrame({"text": row_texts(df), "label": row_labels(df)}).dropna()
+        if rows.empty:
+            return {}, {}
+        keys = rows["text"].map(text_key)
+        self._add_missing(zip(keys, rows["text"]))
+
+        rows["tid"] = keys.map(lambda k: list(self.rows[k]))
+        rows = rows.explode("tid").dropna(subset=["tid"])
+        if rows.empty:
+            return {}, {}
+
+        counts = (
+            rows.groupby(["tid", "label"]).size().unstack(fill_value=0)
+        ).reindex(columns=list(SENTIMENT_LABELS), fill_value=0)
+        freq = counts.sum(axis=1)
+        words = [self.vocab[int(tid)] for tid in counts.index]
+        return (
+            dict(zip(words, (int(v) for v in freq))),
+            {
+                w: {lab: int(v) for lab, v in zip(SENTIMENT_LABELS, row)}
+                for w, row in zip(words, counts.itertuples(index=False))
+            },
+        )
+
+    # 저장 / 로드
+    @staticmethod
+    def path(index_dir: str | Path, lang: str) -> Path:
+        return Path(index_dir) / f"{lang}.pkl"
+
+    def save(self, index_dir: str | Path = TOKEN_INDEX_PATH) -> Path:
+        fp = self.path(index_dir, self.lang)
+        fp.parent.mkdir(parents=True, exist_ok=True)
+        tmp = fp.with_name(fp.name + ".tmp")
+        with self._lock:
+            data = {
+                "version": TOKENIZER_VERSION,
+                "vocab": list(self.vocab),
+                "rows": dict(self.rows),
+            }
+        with tmp.open("wb") as f:
+            pickle.dump(data, f, protocol=pickle.HIGHEST_PROTOCOL)
+        tmp.replace(fp)
+        return fp
+
+    @classmethod
+    def load(cls, lang: str, index_dir: str | Path = TOKEN_INDEX_PATH) -> TokenIndex:
+        """저장된 인덱스 (없거나 TOKENIZER_VERSION 이 다르면 빈 인덱스)."""
+        index = cls(lang)
+        fp = cls.path(index_dir, lang)
+        if not fp.exists():
+            return index
+        with fp.open("rb") as f:
+            data = pickle.load(f)
+        if data.get("version") != TOKENIZER_VERSION:
+            logger.info("[INFO] 토큰 인덱스 버전이 달라 새로 만듭니다: %s", fp)
+            return index
+        index.vocab = data["vocab"]
+        index.ids = {tok: i for i, tok in enumerate(index.vocab)}
+        index.rows = data["rows"]
+        return index
+
+
+# 대시보드 프로세스 안에서 공유 (파일이 바뀌면 다시 읽음).
+# 세션 스레드가 동시에 불러도 한 번만 읽도록 _LOADED_LOCK 안에서 확인/로드한다.
+_LOADED: dict[tuple[str, str], tuple[int, TokenIndex]] = {}
+_LOADED_LOCK = threading.Lock()
+
+
+def get_token_index(lang: str, index_dir: str | Path = TOKEN_INDEX_PATH) -> TokenIndex:
+    fp = TokenIndex.path(index_dir, lang)
+    mtime = fp.stat().st_mtime_ns if fp.exists() else 0
+    with _LOADED_LOCK:
+        cached = _LOADED.get((str(index_dir), lang))
+        if cached is None or cached[0] != mtime:
+            cached = (mtime, TokenIndex.load(lang, index_dir))
+            _LOADED[(str(index_dir), lang)] = cached
+        return cached[1]
+
+
+def main(argv: list[str] | None = None) -> None:
+    from .data import load_data
+
+    logging.basicConfig(level=logging.INFO, format="%(levelname)s: %(message)s")
+    parser = argparse.ArgumentParser(description="워드클라우드용 토큰 인덱스 생성/갱신")
+    parser.add_argument("--data", default=DATA_PATH, help="감성분석 결과 폴더/파일")
+    parser.add_argument("--out", default=TOKEN_INDEX_PATH, help="인덱스 저장 폴더")
+    parser.add_argument("--lang", choices=LANGS, action="append", help="기본: ko, en")
+    parser.add_argument(
+        "--workers",
+        type=int,
+        default=os.cpu_count() or 1,
+        help="토큰화 프로세스 수 (ko 는 프로세스마다 JVM)",
+    )
+    parser.add_argument(
+        "--rebuild", action="store_true", help="기존 인덱스를 버리고 처음부터"
+    )
+    args = parser.parse_args(argv)
+
+    texts = row_texts(load_data(args.data)).dropna()
+    for lang in args.lang or LANGS:
+        index = TokenIndex(lang) if args.rebuild else TokenIndex.load(lang, args.out)
+        added = index.update(texts, workers=args.workers)
+        fp = index.save(args.out)
+        print(
+            f"[{lang}] 새로 토큰화 {added:,}건, 전체 {len(index):,}건, "
+            f"어휘 {len(index.vocab):,}개 → {fp}"
+        )
+
+
+if __name__ == "__main__":
+    main()
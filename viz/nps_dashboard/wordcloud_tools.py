@@ -1,85 +1,11 @@
 from __future__ import annotations
 
-from collections import Counter, defaultdict
-from typing import Protocol, cast
-
 import pandas as pd
 import plotly.graph_objects as go
 from wordcloud import WordCloud
 
 from .config import FONT_PATH
-from .text_processing import (
-    clean_text,
-    get_en_stopwords,
-    is_english_word,
-    is_korean_word,
-    strip_web_noise,  # ✅ 추가: Thread/URL/boilerplate 제거
-    is_gibberish_en,  # ✅ 추가: 난수 토큰 제거 휴리스틱
-)
-
-
-class OktLike(Protocol):
-    def nouns(self, phrase: str) -> list[str]: ...
-
-
-try:
-    from konlpy.tag import Okt as _Okt
-except Exception as e:  # pragma: no cover
-    _Okt = None
-    _KONLPY_IMPORT_ERROR = e
-else:
-    _KONLPY_IMPORT_ERROR = None
-
-
-def _require_okt() -> OktLike:
-    if _Okt is None:
-        raise ImportError(
-            "한국어 워드클라우드는 konlpy(Okt)가 필요합니다. "
-        ) from _KONLPY_IMPORT_ERROR
-
-    return cast(OktLike, _Okt())
-
-
-def _iter_row_text(row: pd.Series, df_cols: list[str]) -> str | None:
-    """
-    - doc_type == 'comment'면 comment_text만 사용 (없으면 comment fallback)
-    - 그 외에는 존재하는 텍스트 컬럼들을 합쳐 사용
-    """
-    label = row.get("sentiment_label") or row.get("label")
-    if label not in ("negative", "neutral", "positive"):
-        return None
-
-    doc_type = row.get("doc_type")
-
-    if doc_type == "comment":
-        v = row.get("comment_text")
-        if v is None or (isinstance(v, float) and pd.isna(v)):
-            v = row.get("comment")
-        if v is None or (isinstance(v, float) and pd.isna(v)):
-            return None
-        if isinstance(v, (list, tuple)):
-            v = " ".join(map(str, v))
-        s = str(v).strip()
-        return s or None
-
-    parts: list[str] = []
-    for c in df_cols:
-        v = row.get(c)
-        if v is None:
-            continue
-        try:
-            if pd.isna(v):
-                continue
-        except Exception:
-            pass
-        if isinstance(v, (list, tuple)):
-            v = " ".join(map(str, v))
-        s = str(v).strip()
-        if s:
-            parts.append(s)
-
-    merged = " ".join(parts).strip()
-    return merged or None
+from .token_index import get_token_index
 
 
 def compute_word_stats(
@@ -90,93 +16,16 @@ def compute_word_stats(
 ):
     """
     ko: KoNLPy(Okt) nouns 기반(한국어 불용어 파일 X)
-        - ✅ strip_web_noise 적용 (URL/boilerplate 제거)
-    en: wordcloud 기본 STOPWORDS + (선택) stopwords-en.txt
-        - ✅ strip_web_noise 적용
-        - ✅ is_gibberish_en 휴리스틱 적용 (난수 토큰 제거)
-    """
-    en_sw = get_en_stopwords()
-
-    # (선택) 정말 남기고 싶은 영어 약어를 예외 처리하고 싶으면 여기에 추가
-    # 예: {"nps", "oecd"}
-    en_whitelist: set[str] = set()
-
-    freq: Counter[str] = Counter()
-    sent_counts: dict[str, dict[str, int]] = defaultdict(
-        lambda: {"negative": 0, "neutral": 0, "positive": 0}
-    )
+    en: wordcloud 기본 STOPWORDS + (선택) stopwords-en.txt + is_gibberish_en
+    (둘 다 strip_web_noise / clean_text 를 먼저 적용)
 
-    text_cols_priority = [
-        c
-        for c in ["comment", "comment_text", "text", "title"]
-        if c in df_subset.columns
-    ]
-    if not text_cols_priority:
+    토큰화는 token_index.py 의 인덱스(텍스트 해시 → 토큰 id)로 미리 해 두고,
+    여기서는 선택된 행들의 토큰 id 만 센다. 인덱스에 없는 행만 그 자리에서 토큰화한다.
+    """
+    if lang not in ("ko", "en"):
         return [], {}, {}
 
-    if lang == "ko":
-        okt = _require_okt()
-
-        for _, row in df_subset.iterrows():
-            label = row.get("sentiment_label") or row.get("label")
-            if label not in ("negative", "neutral", "positive"):
-                continue
-
-            raw_text = _iter_row_text(row, text_cols_priority)
-            if not raw_text:
-                continue
-
-            # ✅ 추가: 웹/플랫폼 잡음 줄단위 및 URL 제거
-            raw_text = strip_web_noise(raw_text)
-
-            cleaned = clean_text(raw_text)
-            if not cleaned:
-                continue
-
-            tokens = okt.nouns(cleaned)
-            for tok in tokens:
-                tok = str(tok).strip()
-                if len(tok) < 2:
-                    continue
-                if not is_korean_word(tok):
-                    continue
-                freq[tok] += 1
-                sent_counts[tok][label] += 1
-
-    elif lang == "en":
-        for _, row in df_subset.iterrows():
-            label = row.get("sentiment_label") or row.get("label")
-            if label not in ("negative", "neutral", "positive"):
-                continue
-
-            raw_text = _iter_row_text(row, text_cols_priority)
-            if not raw_text:
-                continue
-
-            # ✅ 추가: Thread/Threads 홍보줄, URL, 저작권 boilerplate, dc official app 제거
-            raw_text = strip_web_noise(raw_text)
-
-            cleaned = clean_text(raw_text)
-            if not cleaned:
-                continue
-
-            for tok in cleaned.split():
-                tok = tok.lower().strip()
-
-                if not is_english_word(tok):
-                    continue
-                if tok in en_sw:
-                    continue
-
-                # ✅ 추가: 난수/ID/도메인 조각 제거
-                if is_gibberish_en(tok, whitelist=en_whitelist):
-                    continue
-
-                freq[tok] += 1
-                sent_counts[tok][label] += 1
-
-    else:
-        return [], {}, {}
+    freq, sent_counts = get_token_index(lang).word_stats(df_subset)
 
     words = [w for w, c in freq.items() if c >= min_freq]
     if not words: